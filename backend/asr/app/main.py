@@ -1,14 +1,20 @@
 """
 ASR Service - FastAPI Application
-음성을 텍스트로 변환하는 REST API
+음성을 텍스트로 변환하는 REST API (+ WebSocket 스트리밍)
 """
 
+import asyncio
+import io
+import json
 import logging
 import os
+import struct
 import tempfile
+import wave
 from contextlib import asynccontextmanager
+from typing import Dict, Optional, Set
 
-from fastapi import FastAPI, File, UploadFile, HTTPException
+from fastapi import FastAPI, File, UploadFile, HTTPException, WebSocket, WebSocketDisconnect
 from fastapi.middleware.cors import CORSMiddleware
 
 from .model import ASRModel
@@ -24,6 +30,55 @@ logger = logging.getLogger(__name__)
 # 전역 모델 인스턴스
 asr_model: ASRModel = None
 
+# 스트리밍 코덱별 임시 파일 확장자 (디코더가 확장자로 형식을 판단, PCM은 WAV로 감쌈)
+STREAM_CODEC_SUFFIXES = {"pcm": ".wav", "flac": ".flac", "opus": ".ogg"}
+
+# 스트리밍 바이너리 메시지 앞의 스트림 ID (리틀 엔디언 4바이트)
+STREAM_ID = struct.Struct("<I")
+
+# 스트림 하나가 모을 수 있는 최대 발화 길이 (초, PCM 기준 바이트로 환산해 압축 코덱에도 적용)
+STREAM_MAX_SECONDS = float(os.getenv("ASR_STREAM_MAX_SECONDS", "30"))
+STREAM_SAMPLE_RATES = range(8000, 48001)
+
+# PCM 스트림은 오디오가 이만큼(초) 늘 때마다 지금까지 받은 부분을 인식해 partial로 보냄 (0이면 끔)
+STREAM_PARTIAL_SECONDS = float(os.getenv("ASR_STREAM_PARTIAL_SECONDS", "1.0"))
+
+# end 시점에 final과 함께 인식할 앞부분 비율 (발화를 한 번에 보내도 final 전에 partial이 나가도록)
+STREAM_PREFIX_FRACTIONS = (0.5, 0.75)
+
+
+def _parse_stream_request(text: str) -> dict:
+    """스트리밍 제어 메시지 파싱 (형식이 틀리면 ValueError)"""
+    request = json.loads(text)
+    if not isinstance(request, dict):
+        raise ValueError("제어 메시지는 JSON 객체여야 합니다")
+    stream_id = request.get("id", 0)
+    if isinstance(stream_id, bool) or not isinstance(stream_id, int) or not 0 <= stream_id <= 0xFFFFFFFF:
+        raise ValueError(f"잘못된 스트림 id: {stream_id!r}")
+    return request
+
+
+def _transcribe_bytes(content: bytes, suffix: str) -> dict:
+    """오디오 바이트를 임시 파일로 저장해 인식 (블로킹)"""
+    with tempfile.NamedTemporaryFile(delete=False, suffix=suffix) as tmp_file:
+        tmp_file.write(content)
+        tmp_path = tmp_file.name
+    try:
+        return asr_model.transcribe(tmp_path)
+    finally:
+        os.unlink(tmp_path)
+
+
+def _pcm_to_wav(pcm: bytes, sample_rate: int) -> bytes:
+    """PCM s16le 모노 데이터를 WAV 바이트로 변환"""
+    buffer = io.BytesIO()
+    with wave.open(buffer, "wb") as wav_file:
+        wav_file.setnchannels(1)
+        wav_file.setsampwidth(2)
+        wav_file.setframerate(sample_rate)
+        wav_file.writeframes(pcm)
+    return buffer.getvalue()
+
 
 @asynccontextmanager
 async def lifespan(app: FastAPI):
@@ -74,12 +129,12 @@ async def health_check():
 
 @app.post("/transcribe", response_model=TranscriptionResponse)
 async def transcribe_audio(
-    audio: UploadFile = File(..., description="WAV 형식의 오디오 파일")
+    audio: UploadFile = File(..., description="WAV/FLAC/Ogg Opus 형식의 오디오 파일")
 ):
     """
     음성 파일을 텍스트로 변환
     
-    - **audio**: WAV 형식의 오디오 파일 (16kHz, 모노 권장)
+    - **audio**: WAV, FLAC, Ogg Opus 형식의 오디오 파일 (16kHz, 모노 권장)
     
     Returns:
         인식된 텍스트 및 메타데이터
@@ -88,7 +143,8 @@ async def transcribe_audio(
         raise HTTPException(status_code=503, detail="ASR 모델이 로드되지 않았습니다.")
     
     # 지원 형식 확인
-    allowed_types = ["audio/wav", "audio/wave", "audio/x-wav", "audio/mpeg", "audio/mp3"]
+    allowed_types = ["audio/wav", "audio/wave", "audio/x-wav", "audio/mpeg", "audio/mp3",
+                     "audio/flac", "audio/x-flac", "audio/ogg", "audio/opus"]
     if audio.content_type and audio.content_type not in allowed_types:
         raise HTTPException(
             status_code=400, 
@@ -96,17 +152,12 @@ async def transcribe_audio(
         )
     
     try:
-        # 임시 파일로 저장
-        with tempfile.NamedTemporaryFile(delete=False, suffix=".wav") as tmp_file:
-            content = await audio.read()
-            tmp_file.write(content)
-            tmp_path = tmp_file.name
+        # 임시 파일로 저장 (디코더가 확장자로 형식을 판단하므로 업로드 이름의 확장자 유지)
+        suffix = os.path.splitext(audio.filename or "")[1].lower() or ".wav"
+        content = await audio.read()
         
         # 음성 인식 수행
-        result = asr_model.transcribe(tmp_path)
-        
-        # 임시 파일 삭제
-        os.unlink(tmp_path)
+        result = _transcribe_bytes(content, suffix)
         
         return TranscriptionResponse(
             text=result["text"],
@@ -120,16 +171,207 @@ async def transcribe_audio(
         raise HTTPException(status_code=500, detail=f"음성 인식 중 오류 발생: {str(e)}")
 
 
-@app.post("/transcribe/stream")
-async def transcribe_stream(
-    audio: UploadFile = File(...)
-):
+@app.websocket("/transcribe/stream")
+async def transcribe_stream(websocket: WebSocket):
     """
-    스트리밍 음성 인식 (실시간)
+    스트리밍 음성 인식 (WebSocket, 연결 유지)
+    
+    C++ 클라이언트가 연결 하나를 계속 유지하며 발화마다 다음 순서로 보냅니다.
+    여러 발화가 한 연결에서 겹쳐도 되며, 응답은 id로 구분합니다.
+    
+    - 텍스트 `{"type": "start", "id": N, "codec": "pcm|flac|opus", "sample_rate": 16000}`
+    - 바이너리: 스트림 id(리틀 엔디언 4바이트) + 오디오 조각 (코덱 바이트 그대로 이어 붙임)
+    - 텍스트 `{"type": "end", "id": N}` 또는 `{"type": "cancel", "id": N}`
+    
+    응답:
+    - `{"type": "partial", "id": N, "text": ...}` (PCM, ASR_STREAM_PARTIAL_SECONDS마다 + end 시점의 앞부분, 선택)
+    - `{"type": "final", "id": N, "text": ..., "language": ..., "duration": ...}`
+    - `{"type": "error", "id": N, "message": ...}`
     
-    TODO: WebSocket 기반 실시간 스트리밍 구현
+    중간 결과는 스트림당 한 번에 하나만 인식하고(진행 중이면 다음 조각에서 다시 판단),
+    end를 받으면 아직 인식하지 않은 STREAM_PREFIX_FRACTIONS 앞부분을 final과 동시에
+    인식합니다. 그래서 클라이언트가 녹음을 마친 뒤 발화를 한 번에 보내도 final 전에
+    앞부분 partial을 받을 수 있습니다. partial은 더 긴 앞부분 순으로만 보내고,
+    final/error/cancel 뒤에는 보내지 않으므로 final보다 늦게 도착하지 않습니다.
+    
+    스트림 오디오가 ASR_STREAM_MAX_SECONDS를 넘으면 해당 스트림만 error로 끝내고,
+    형식이 틀린 제어 메시지는 error(id를 알 수 없으면 0)로 응답하며 연결은 유지합니다.
     """
-    raise HTTPException(status_code=501, detail="스트리밍 기능은 아직 구현되지 않았습니다.")
+    await websocket.accept()
+    streams: Dict[int, dict] = {}
+    tasks: Dict[int, asyncio.Task] = {}
+    partials: Set[asyncio.Task] = set()
+    send_lock = asyncio.Lock()
+    
+    async def send(message: dict, closing: Optional[dict] = None) -> None:
+        """메시지 전송 (closing 스트림은 같은 락 안에서 끝난 것으로 표시해 이후 partial을 막음)"""
+        async with send_lock:
+            if closing is not None:
+                closing["done"] = True
+            await websocket.send_text(json.dumps(message, ensure_ascii=False))
+    
+    async def recognize_partial(stream_id: int, stream: dict, audio: bytes) -> None:
+        """앞부분 audio를 인식해 partial 전송 (끝난 스트림이거나 더 긴 앞부분을 이미 보냈으면 버림)"""
+        try:
+            result = await asyncio.to_thread(
+                _transcribe_bytes, _pcm_to_wav(audio, stream["sample_rate"]), ".wav")
+            text = result["text"].strip()
+            if not text:
+                return
+            async with send_lock:
+                if stream["done"] or len(audio) <= stream["partial_sent"]:
+                    return
+                stream["partial_sent"] = len(audio)
+                await websocket.send_text(json.dumps(
+                    {"type": "partial", "id": stream_id, "text": text}, ensure_ascii=False))
+        except asyncio.CancelledError:
+            raise
+        except Exception as e:
+            # 중간 결과 실패는 무시 (final에서 전체를 다시 인식)
+            logger.warning(f"중간 인식 실패 (스트림 {stream_id}): {e}")
+    
+    def track_partial(coro) -> asyncio.Task:
+        task = asyncio.create_task(coro)
+        partials.add(task)
+        task.add_done_callback(partials.discard)
+        return task
+    
+    async def partial(stream_id: int, stream: dict, audio: bytes) -> None:
+        await recognize_partial(stream_id, stream, audio)
+        stream["partial_task"] = None
+        schedule_partial(stream_id, stream)
+    
+    def schedule_partial(stream_id: int, stream: dict) -> None:
+        """받은 오디오가 충분히 늘었고 진행 중인 중간 인식이 없으면 시작"""
+        if (not stream["partial_bytes"] or stream["partial_task"] is not None
+                or stream["ended"] or stream["failed"]
+                or len(stream["audio"]) - stream["partial_at"] < stream["partial_bytes"]
+                or asr_model is None or not asr_model.is_loaded):
+            return
+        stream["partial_at"] = len(stream["audio"])
+        stream["partial_task"] = track_partial(partial(stream_id, stream, bytes(stream["audio"])))
+    
+    def schedule_prefix_partials(stream_id: int, stream: dict) -> None:
+        """end 시점에 아직 인식하지 않은 앞부분을 final과 동시에 인식 (final보다 먼저 끝난 것만 전송)"""
+        audio = stream["audio"]
+        if (not stream["partial_bytes"] or len(audio) < stream["partial_bytes"]
+                or asr_model is None or not asr_model.is_loaded):
+            return
+        for fraction in STREAM_PREFIX_FRACTIONS:
+            cut = int(len(audio) * fraction) & ~1  # 샘플(2바이트) 경계
+            if cut > stream["partial_at"]:
+                track_partial(recognize_partial(stream_id, stream, bytes(audio[:cut])))
+    
+    async def finish(stream_id: int, stream: dict) -> None:
+        try:
+            if asr_model is None or not asr_model.is_loaded:
+                raise RuntimeError("ASR 모델이 로드되지 않았습니다.")
+            audio = bytes(stream["audio"])
+            if stream["codec"] == "pcm":
+                audio = _pcm_to_wav(audio, stream["sample_rate"])
+            # 추론은 블로킹이므로 스레드에서 실행해 다른 발화의 수신을 막지 않음
+            result = await asyncio.to_thread(
+                _transcribe_bytes, audio, STREAM_CODEC_SUFFIXES[stream["codec"]])
+            await send({
+                "type": "final",
+                "id": stream_id,
+                "text": result["text"],
+                "language": result.get("language", "ko"),
+                "duration": result.get("duration", 0.0),
+            }, closing=stream)
+        except asyncio.CancelledError:
+            stream["done"] = True  # end 뒤 cancel: 남은 앞부분 partial도 보내지 않음
+            raise
+        except Exception as e:
+            logger.error(f"스트리밍 인식 오류 (스트림 {stream_id}): {e}")
+            await send({"type": "error", "id": stream_id, "message": str(e)}, closing=stream)
+        finally:
+            tasks.pop(stream_id, None)
+    
+    try:
+        while True:
+            message = await websocket.receive()
+            if message["type"] == "websocket.disconnect":
+                break
+            
+            if message.get("bytes") is not None:
+                data = message["bytes"]
+                if len(data) < STREAM_ID.size:
+                    continue
+                (stream_id,) = STREAM_ID.unpack_from(data)
+                stream = streams.get(stream_id)
+                if stream is None or stream["failed"]:
+                    continue
+                if len(stream["audio"]) + len(data) - STREAM_ID.size > stream["max_bytes"]:
+                    # 실패로 표시만 하고 남김 (이어지는 조각/end는 조용히 버림)
+                    stream["failed"] = True
+                    stream["audio"] = bytearray()
+                    await send({"type": "error", "id": stream_id,
+                                "message": f"발화가 최대 길이({STREAM_MAX_SECONDS:g}초)를 넘었습니다"},
+                               closing=stream)
+                    continue
+                stream["audio"].extend(data[STREAM_ID.size:])
+                schedule_partial(stream_id, stream)
+                continue
+            
+            try:
+                request = _parse_stream_request(message.get("text") or "")
+            except ValueError as e:
+                logger.warning(f"잘못된 스트리밍 메시지: {e}")
+                await send({"type": "error", "id": 0, "message": f"잘못된 제어 메시지: {e}"})
+                continue
+            kind = request.get("type")
+            stream_id = request.get("id", 0)
+            
+            if kind == "start":
+                codec = request.get("codec", "pcm")
+                sample_rate = request.get("sample_rate", 16000)
+                if codec not in STREAM_CODEC_SUFFIXES:
+                    await send({"type": "error", "id": stream_id, "message": f"지원하지 않는 코덱: {codec}"})
+                    continue
+                if isinstance(sample_rate, bool) or not isinstance(sample_rate, int) \
+                        or sample_rate not in STREAM_SAMPLE_RATES:
+                    await send({"type": "error", "id": stream_id,
+                                "message": f"지원하지 않는 샘플링 레이트: {sample_rate!r}"})
+                    continue
+                streams[stream_id] = {
+                    "codec": codec,
+                    "sample_rate": sample_rate,
+                    "audio": bytearray(),
+                    "max_bytes": int(STREAM_MAX_SECONDS * sample_rate) * 2,
+                    "failed": False,
+                    "partial_bytes": int(STREAM_PARTIAL_SECONDS * sample_rate) * 2 if codec == "pcm" else 0,
+                    "partial_at": 0,
+                    "partial_sent": 0,
+                    "partial_task": None,
+                    "ended": False,
+                    "done": False,
+                }
+            elif kind == "end":
+                stream = streams.pop(stream_id, None)
+                if stream is None:
+                    await send({"type": "error", "id": stream_id, "message": "시작되지 않은 스트림"})
+                    continue
+                stream["ended"] = True  # 더 이상 오디오가 늘지 않으므로 조각 단위 중간 인식은 멈춤
+                if stream["failed"]:
+                    continue
+                tasks[stream_id] = asyncio.create_task(finish(stream_id, stream))
+                schedule_prefix_partials(stream_id, stream)
+            elif kind == "cancel":
+                stream = streams.pop(stream_id, None)
+                if stream is not None:
+                    stream["ended"] = True
+                    stream["done"] = True
+                task = tasks.pop(stream_id, None)
+                if task:
+                    task.cancel()
+            else:
+                logger.warning(f"알 수 없는 스트리밍 메시지: {kind}")
+    except WebSocketDisconnect:
+        pass
+    finally:
+        for task in list(tasks.values()) + list(partials):
+            task.cancel()
 
 
 if __name__ == "__main__":
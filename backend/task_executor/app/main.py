@@ -160,6 +160,31 @@ async def execute_task(request: TaskRequest):
         )
 
 
+@app.post("/prefetch")
+async def prefetch_task(request: TaskRequest):
+    """
+    작업 준비 (클라이언트의 추측 NLU 결과)
+    
+    발화가 끝나기 전에 호출되어 Google API 클라이언트 예열, 오늘 일정 조회 등을
+    미리 수행합니다. 실패해도 실제 /execute 요청에는 영향이 없습니다.
+    
+    - **intent**: 예상 의도
+    - **entities**: 지금까지 추출된 엔티티
+    """
+    task_info = INTENT_TASK_MAP.get(request.intent)
+    handler = task_handlers.get(task_info[0]) if task_info else None
+    if not handler:
+        return {"intent": request.intent, "prefetched": False}
+    
+    try:
+        prefetched = await handler.prefetch(task_info[1], request.entities or {})
+    except Exception as e:
+        logger.warning(f"작업 준비 실패 (무시): intent={request.intent}, {e}")
+        prefetched = False
+    
+    return {"intent": request.intent, "prefetched": prefetched}
+
+
 @app.post("/chat", response_model=ChatResponse)
 async def chat_with_llm(request: ChatRequest):
     """
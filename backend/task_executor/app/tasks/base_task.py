@@ -27,6 +27,19 @@ class BaseTask(ABC):
         """
         pass
     
+    async def prefetch(self, action: str, params: Dict[str, Any]) -> bool:
+        """
+        작업 준비 (추측 NLU 결과로 실제 실행 전에 호출, 부작용 없어야 함)
+        
+        Args:
+            action: 곧 실행될 가능성이 높은 액션 이름
+            params: 지금까지 추출된 작업 파라미터
+            
+        Returns:
+            준비한 것이 있는지 여부 (기본 구현은 아무것도 하지 않음)
+        """
+        return False
+    
     def validate_params(self, params: Dict[str, Any], required: list) -> bool:
         """파라미터 유효성 검사"""
         for key in required:
@@ -3,9 +3,11 @@ Calendar Task Handler
 Google Calendar API를 사용한 일정 작업
 """
 
+import asyncio
 import logging
+import time
 from datetime import datetime, timedelta
-from typing import Any, Dict, Optional
+from typing import Any, Dict, List, Optional, Tuple
 
 from dateutil import parser as date_parser
 
@@ -13,6 +15,9 @@ from .base_task import BaseTask
 
 logger = logging.getLogger(__name__)
 
+# prefetch로 받아 둔 하루 일정을 실제 요청에 쓸 수 있는 시간 (초)
+PREFETCH_TTL_SECONDS = 30.0
+
 
 class CalendarTask(BaseTask):
     """캘린더 작업 핸들러"""
@@ -22,6 +27,8 @@ class CalendarTask(BaseTask):
         self.credentials_path = credentials_path
         self.service = None
         self._initialized = False
+        # 날짜(YYYY-MM-DD) → (만료 시각, 일정 목록), 한 번 쓰면 버림
+        self._prefetched: Dict[str, Tuple[float, List[Dict[str, Any]]]] = {}
     
     def _init_service(self):
         """Google Calendar API 서비스 초기화"""
@@ -60,6 +67,10 @@ class CalendarTask(BaseTask):
         """
         self._init_service()
         
+        # 일정을 바꾸는 액션은 미리 받아 둔 일정을 무효화
+        if action in ("add", "update"):
+            self._prefetched.clear()
+        
         if action == "check":
             return await self._check_events(params)
         elif action == "add":
@@ -71,6 +82,27 @@ class CalendarTask(BaseTask):
         else:
             raise ValueError(f"지원하지 않는 액션: {action}")
     
+    async def prefetch(self, action: str, params: Dict[str, Any]) -> bool:
+        """
+        캘린더 작업 준비
+        
+        서비스를 예열하고, 일정 확인/삭제처럼 하루 일정을 조회하는 액션이면
+        해당 날짜(기본 오늘) 일정을 미리 받아 둡니다. 실제 요청이 오지 않으면
+        PREFETCH_TTL_SECONDS 뒤 만료됩니다.
+        """
+        self._init_service()
+        if not self.service:
+            return False
+        if action not in ("check", "delete"):
+            return True
+        
+        target_date = self._parse_date_entity(params.get("date", "오늘"))
+        # API 호출은 블로킹이므로 스레드에서 실행 (이벤트 루프의 다른 요청을 막지 않도록)
+        events = await asyncio.to_thread(self._fetch_events, target_date)
+        self._prefetched[target_date.date().isoformat()] = (
+            time.monotonic() + PREFETCH_TTL_SECONDS, events)
+        return True
+    
     def _parse_date_entity(self, date_str: str) -> datetime:
         """날짜 엔티티 파싱"""
         today = datetime.now()
@@ -131,31 +163,13 @@ class CalendarTask(BaseTask):
             date_str = params.get("date", "오늘")
             target_date = self._parse_date_entity(date_str)
             
-            # 하루 범위 설정
-            time_min = target_date.replace(hour=0, minute=0, second=0).isoformat() + 'Z'
-            time_max = target_date.replace(hour=23, minute=59, second=59).isoformat() + 'Z'
-            
-            events_result = self.service.events().list(
-                calendarId='primary',
-                timeMin=time_min,
-                timeMax=time_max,
-                maxResults=10,
-                singleEvents=True,
-                orderBy='startTime'
-            ).execute()
-            
-            events = events_result.get('items', [])
-            
-            event_list = []
-            for event in events:
-                start = event['start'].get('dateTime', event['start'].get('date'))
-                event_list.append({
-                    "id": event['id'],
-                    "title": event.get('summary', '(제목 없음)'),
-                    "start": start,
-                    "location": event.get('location', ''),
-                    "description": event.get('description', '')
-                })
+            # prefetch한 일정이 아직 유효하면 API 왕복 생략
+            key = target_date.date().isoformat()
+            prefetched = self._prefetched.pop(key, None)
+            if prefetched and prefetched[0] > time.monotonic():
+                event_list = prefetched[1]
+            else:
+                event_list = await asyncio.to_thread(self._fetch_events, target_date)
             
             return {
                 "success": True,
@@ -172,6 +186,33 @@ class CalendarTask(BaseTask):
                 "events": []
             }
     
+    def _fetch_events(self, target_date: datetime) -> List[Dict[str, Any]]:
+        """하루 일정 조회 (Google Calendar API)"""
+        # 하루 범위 설정
+        time_min = target_date.replace(hour=0, minute=0, second=0).isoformat() + 'Z'
+        time_max = target_date.replace(hour=23, minute=59, second=59).isoformat() + 'Z'
+        
+        events_result = self.service.events().list(
+            calendarId='primary',
+            timeMin=time_min,
+            timeMax=time_max,
+            maxResults=10,
+            singleEvents=True,
+            orderBy='startTime'
+        ).execute()
+        
+        event_list = []
+        for event in events_result.get('items', []):
+            start = event['start'].get('dateTime', event['start'].get('date'))
+            event_list.append({
+                "id": event['id'],
+                "title": event.get('summary', '(제목 없음)'),
+                "start": start,
+                "location": event.get('location', ''),
+                "description": event.get('description', '')
+            })
+        return event_list
+    
     async def _add_event(self, params: Dict[str, Any]) -> Dict[str, Any]:
         """일정 추가"""
         if not self.service:
@@ -267,6 +308,7 @@ class CalendarTask(BaseTask):
                 calendarId='primary',
                 eventId=event_id
             ).execute()
+            self._prefetched.clear()
             
             return {
                 "success": True,
@@ -66,6 +66,11 @@ class EmailTask(BaseTask):
         else:
             raise ValueError(f"지원하지 않는 액션: {action}")
     
+    async def prefetch(self, action: str, params: Dict[str, Any]) -> bool:
+        """Gmail 서비스 예열 (인증 정보 로드와 discovery 문서 빌드를 미리 수행)"""
+        self._init_service()
+        return self.service is not None
+    
     async def _check_emails(self, params: Dict[str, Any]) -> Dict[str, Any]:
         """새 이메일 확인"""
         if not self.service:
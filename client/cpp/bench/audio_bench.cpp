@@ -0,0 +1,329 @@
+/**
+ * @file audio_bench.cpp
+ * @brief 오디오 경로 마이크로벤치마크 (WAV 변환, VAD 커널, 리샘플링, 링 버퍼, 인코딩, 웨이크워드)
+ */
+
+#include "audio_capture.h"
+#include "audio_encoder.h"
+#include "audio_kernels.h"
+#include "audio_resampler.h"
+#include "log_mel_frontend.h"
+#include "ring_buffer.h"
+#include "voice_activity_detector.h"
+#include "wake_word_detector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+constexpr size_t kFrameSamples = kSampleRate / 100;   // 10 ms 프레임
+
+/**
+ * @brief 잡음 + 440 Hz 톤 (음성과 비슷한 에너지/영교차율)
+ */
+std::vector<int16_t> makeSignal(size_t count, int sampleRate = kSampleRate) {
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0f, 200.0f);
+    std::vector<int16_t> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float tone = 6000.0f * std::sin(2.0f * 3.14159265f * 440.0f * static_cast<float>(i) / sampleRate);
+        samples[i] = static_cast<int16_t>(tone + noise(rng));
+    }
+    return samples;
+}
+
+// ============================================================================
+// WAV 변환
+// ============================================================================
+
+void BM_ToWavBytes(benchmark::State& state) {
+    sion::AudioConfig config;
+    config.device = "null";
+    sion::AudioCapture capture(config);
+    const std::vector<int16_t> samples = makeSignal(static_cast<size_t>(state.range(0)) * kSampleRate);
+
+    for (auto _ : state) {
+        std::vector<uint8_t> wav = capture.toWavBytes(sion::Span<const int16_t>(samples));
+        benchmark::DoNotOptimize(wav.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(samples.size() * sizeof(int16_t)));
+}
+BENCHMARK(BM_ToWavBytes)->Arg(1)->Arg(10)->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// VAD 커널 (프레임 단위, 캡처 스레드 경로)
+// ============================================================================
+
+void BM_FrameFeatures(benchmark::State& state) {
+    const std::vector<int16_t> frame = makeSignal(kFrameSamples);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sion::kernels::computeFrameFeatures(frame.data(), frame.size()));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(sion::kernels::activeIsa());
+}
+BENCHMARK(BM_FrameFeatures);
+
+void BM_SumOfSquares(benchmark::State& state) {
+    const std::vector<int16_t> frame = makeSignal(kFrameSamples);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sion::kernels::sumOfSquares(frame.data(), frame.size()));
+    }
+    state.SetLabel(sion::kernels::activeIsa());
+}
+BENCHMARK(BM_SumOfSquares);
+
+void BM_SumOfSquaresScalar(benchmark::State& state) {
+    const std::vector<int16_t> frame = makeSignal(kFrameSamples);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sion::kernels::sumOfSquaresScalar(frame.data(), frame.size()));
+    }
+}
+BENCHMARK(BM_SumOfSquaresScalar);
+
+void BM_ZeroCrossings(benchmark::State& state) {
+    const std::vector<int16_t> frame = makeSignal(kFrameSamples);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sion::kernels::zeroCrossings(frame.data(), frame.size()));
+    }
+    state.SetLabel(sion::kernels::activeIsa());
+}
+BENCHMARK(BM_ZeroCrossings);
+
+void BM_ZeroCrossingsScalar(benchmark::State& state) {
+    const std::vector<int16_t> frame = makeSignal(kFrameSamples);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sion::kernels::zeroCrossingsScalar(frame.data(), frame.size()));
+    }
+}
+BENCHMARK(BM_ZeroCrossingsScalar);
+
+void BM_VadProcess(benchmark::State& state) {
+    // 1초 분량을 10 ms 프레임으로 넣음 (엔드포인트에 도달하지 않도록 톤을 유지)
+    const std::vector<int16_t> samples = makeSignal(kSampleRate);
+    sion::VoiceActivityDetector vad;
+    for (auto _ : state) {
+        vad.reset();
+        for (size_t offset = 0; offset < samples.size(); offset += kFrameSamples) {
+            benchmark::DoNotOptimize(vad.process(samples.data() + offset, kFrameSamples));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(samples.size() / kFrameSamples));
+}
+BENCHMARK(BM_VadProcess)->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// 리샘플링 (장치 주기 10 ms 단위)
+// ============================================================================
+
+void BM_ResampleFloatStereo48k(benchmark::State& state) {
+    constexpr size_t kFrames = 480;
+    std::vector<float> input(kFrames * 2);
+    for (size_t i = 0; i < kFrames; ++i) {
+        input[2 * i] = input[2 * i + 1] = 0.2f * std::sin(2.0f * 3.14159265f * 440.0f * static_cast<float>(i) / 48000.0f);
+    }
+
+    sion::InputFormat format;
+    format.sampleRate = 48000;
+    format.channels = 2;
+    format.format = sion::SampleFormat::Float32;
+    sion::AudioResampler resampler;
+    resampler.configure(format, kSampleRate);
+
+    std::vector<int16_t> out;
+    out.reserve(kFrameSamples * 2);
+    for (auto _ : state) {
+        out.clear();
+        resampler.process(input.data(), kFrames, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kFrames));
+    state.SetLabel(resampler.description());
+}
+BENCHMARK(BM_ResampleFloatStereo48k);
+
+void BM_ResampleInt16Mono44k(benchmark::State& state) {
+    constexpr size_t kFrames = 441;
+    const std::vector<int16_t> input = makeSignal(kFrames, 44100);
+
+    sion::InputFormat format;
+    format.sampleRate = 44100;
+    format.channels = 1;
+    format.format = sion::SampleFormat::Int16;
+    sion::AudioResampler resampler;
+    resampler.configure(format, kSampleRate);
+
+    std::vector<int16_t> out;
+    out.reserve(kFrameSamples * 2);
+    for (auto _ : state) {
+        out.clear();
+        resampler.process(input.data(), kFrames, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kFrames));
+    state.SetLabel(resampler.description());
+}
+BENCHMARK(BM_ResampleInt16Mono44k);
+
+// ============================================================================
+// 링 버퍼 처리량
+// ============================================================================
+
+void BM_RingBufferSingleThread(benchmark::State& state) {
+    sion::SpscRingBuffer<int16_t> ring(kSampleRate);
+    const std::vector<int16_t> frame = makeSignal(kFrameSamples);
+    std::vector<int16_t> out(kFrameSamples);
+
+    for (auto _ : state) {
+        ring.write(frame.data(), frame.size());
+        benchmark::DoNotOptimize(ring.read(out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kFrameSamples * sizeof(int16_t)));
+}
+BENCHMARK(BM_RingBufferSingleThread);
+
+void BM_RingBufferProducerConsumer(benchmark::State& state) {
+    // 생산자 스레드가 프레임 단위로 쓰고 벤치마크 스레드가 소비 (캐시 라인 공유 비용 포함)
+    sion::SpscRingBuffer<int16_t> ring(kSampleRate);
+    const std::vector<int16_t> frame = makeSignal(kFrameSamples);
+    std::atomic<bool> stop{false};
+    std::thread producer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (ring.write(frame.data(), frame.size()) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<int16_t> out(static_cast<size_t>(state.range(0)));
+    int64_t total = 0;
+    for (auto _ : state) {
+        size_t got = 0;
+        while (got < out.size()) {
+            const size_t n = ring.read(out.data() + got, out.size() - got);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            got += n;
+        }
+        total += static_cast<int64_t>(got);
+    }
+
+    stop = true;
+    producer.join();
+    state.SetBytesProcessed(total * static_cast<int64_t>(sizeof(int16_t)));
+}
+BENCHMARK(BM_RingBufferProducerConsumer)->Arg(160)->Arg(4096)->UseRealTime();
+
+// ============================================================================
+// 인코딩 (send 단계, 1초 분량)
+// ============================================================================
+
+void BM_EncodeFlac(benchmark::State& state) {
+    auto encoder = sion::createAudioEncoder(sion::protocol::AudioCodec::Flac);
+    if (!encoder) {
+        state.SkipWithError("FLAC 인코더 없음");
+        return;
+    }
+    const std::vector<int16_t> samples = makeSignal(kSampleRate);
+    std::vector<uint8_t> out;
+    out.reserve(samples.size() * sizeof(int16_t));
+
+    for (auto _ : state) {
+        out.clear();
+        encoder->begin(kSampleRate, 1, out);
+        encoder->encode(samples.data(), samples.size(), out);
+        encoder->finish(out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(samples.size() * sizeof(int16_t)));
+    state.counters["ratio"] = static_cast<double>(samples.size() * sizeof(int16_t)) / static_cast<double>(out.size());
+}
+BENCHMARK(BM_EncodeFlac)->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// 웨이크워드 (상시 실행 경로)
+// ============================================================================
+
+void BM_LogMelFrame(benchmark::State& state) {
+    sion::LogMelFrontend frontend;
+    frontend.configure(sion::LogMelConfig{});
+    const std::vector<int16_t> frame = makeSignal(static_cast<size_t>(frontend.getConfig().frameLength));
+    std::vector<float> mels(static_cast<size_t>(frontend.getConfig().numMels));
+
+    for (auto _ : state) {
+        frontend.compute(frame.data(), mels.data());
+        benchmark::DoNotOptimize(mels.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(sion::kernels::activeIsa());
+}
+BENCHMARK(BM_LogMelFrame);
+
+void BM_DotProductInt8(benchmark::State& state) {
+    std::mt19937 rng(7);
+    std::vector<int8_t> a(static_cast<size_t>(state.range(0)));
+    std::vector<int8_t> b(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<int8_t>(rng());
+        b[i] = static_cast<int8_t>(rng());
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sion::kernels::dotProductInt8(a.data(), b.data(), a.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(a.size()));
+    state.SetLabel(sion::kernels::activeIsa());
+}
+BENCHMARK(BM_DotProductInt8)->Arg(40)->Arg(144);
+
+void BM_DotProductInt8Scalar(benchmark::State& state) {
+    std::mt19937 rng(7);
+    std::vector<int8_t> a(static_cast<size_t>(state.range(0)));
+    std::vector<int8_t> b(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<int8_t>(rng());
+        b[i] = static_cast<int8_t>(rng());
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sion::kernels::dotProductInt8Scalar(a.data(), b.data(), a.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(a.size()));
+}
+BENCHMARK(BM_DotProductInt8Scalar)->Arg(40)->Arg(144);
+
+void BM_WakeWordSecond(benchmark::State& state) {
+    // 1초 분량의 특징 추출 + 추론 (시간 / 1초 = 상시 실행 CPU 점유율)
+    const char* model = std::getenv("SION_WAKEWORD_MODEL");
+    if (!model) {
+        state.SkipWithError("SION_WAKEWORD_MODEL 미지정");
+        return;
+    }
+    sion::WakeWordConfig config;
+    config.modelPath = model;
+    config.threshold = 2.0f;   // 검출되지 않는 값: 쉬는 구간 없이 계속 추론
+    sion::WakeWordDetector detector(config);
+    if (!detector.load(kSampleRate)) {
+        state.SkipWithError("웨이크워드 모델 로드 실패");
+        return;
+    }
+    const std::vector<int16_t> samples = makeSignal(kSampleRate);
+
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < samples.size(); offset += kFrameSamples) {
+            benchmark::DoNotOptimize(detector.process(samples.data() + offset, kFrameSamples));
+        }
+    }
+    state.SetLabel(sion::kernels::activeIsa());
+}
+BENCHMARK(BM_WakeWordSecond)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,60 @@
+/**
+ * @file bench_main.cpp
+ * @brief sion_bench 진입점
+ *
+ * 사용법:
+ *   sion_bench [--samples=<WAV/발화 저널 디렉토리>] [Google Benchmark 옵션...]
+ *   sion_bench --benchmark_filter=Replay        # 전체 파이프라인 재생만
+ *
+ * 브릿지/재생 벤치마크는 같은 실행 파일을 --echo-worker 모드로 띄워 워커로 사용합니다.
+ */
+
+#include "bench_support.h"
+#include "latency_trace.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef SION_BENCH_SAMPLES_DIR
+#define SION_BENCH_SAMPLES_DIR "tests/samples"
+#endif
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], sion::bench::kEchoWorkerFlag) == 0) {
+        return sion::bench::runEchoWorker();
+    }
+    sion::bench::setExecutablePath(argv[0]);
+
+    // 자체 옵션을 걸러낸 뒤 나머지는 Google Benchmark로 전달
+    std::string samplesDir = SION_BENCH_SAMPLES_DIR;
+    std::vector<char*> args;
+    for (int i = 0; i < argc; ++i) {
+        constexpr const char* kSamplesFlag = "--samples=";
+        if (std::strncmp(argv[i], kSamplesFlag, std::strlen(kSamplesFlag)) == 0) {
+            samplesDir = argv[i] + std::strlen(kSamplesFlag);
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    int benchArgc = static_cast<int>(args.size());
+
+    if (sion::bench::registerReplayBenchmarks(samplesDir) == 0) {
+        std::cerr << "[Bench] 재생할 WAV/저널 레코드가 없습니다: " << samplesDir << std::endl;
+    }
+
+    benchmark::Initialize(&benchArgc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(benchArgc, args.data())) {
+        return 1;
+    }
+
+    // 계측은 재생 벤치마크의 단계별 분포용 (마이크로벤치마크에는 기록 경로가 없음)
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    sion::trace::printReport(std::cout);
+    return 0;
+}
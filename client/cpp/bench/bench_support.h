@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef BENCH_SUPPORT_H
+#define BENCH_SUPPORT_H
+
+#include <string>
+
+namespace sion {
+namespace bench {
+
+/**
+ * @brief 에코 워커 모드 인자 (sion_bench가 자기 자신을 워커로 실행할 때 사용)
+ */
+constexpr const char* kEchoWorkerFlag = "--echo-worker";
+
+/**
+ * @brief 벤치마크 실행 파일 경로 (main()의 argv[0])
+ */
+const std::string& executablePath();
+
+/**
+ * @brief 실행 파일 경로 설정 (main()에서 한 번)
+ */
+void setExecutablePath(const std::string& path);
+
+/**
+ * @brief 루프백 에코 워커 실행 (stdin 프레임 → stdout 응답, EOF까지)
+ *
+ * Python 없이 브릿지 프로토콜을 그대로 구현하므로 왕복 시간에는
+ * 파이프/프레이밍/스레드 전환 비용만 포함됩니다.
+ * READY에서 모든 코덱을 알리고, END_OF_UTTERANCE마다 PARTIAL_RESULT와
+ * 받은 바이트 수를 담은 FINAL_RESULT를, COMMAND에는 같은 내용의 COMMAND_RESULT를,
+ * TRANSCRIPT에는 텍스트를 담은 FINAL_RESULT를, INTENT에는 페이로드를 그대로 담은 FINAL_RESULT를 보냅니다.
+ * SPECULATE는 응답 없이 무시합니다.
+ * @return 프로세스 종료 코드
+ */
+int runEchoWorker();
+
+/**
+ * @brief 디렉토리의 WAV 파일과 발화 저널 레코드마다 전체 파이프라인 재생 벤치마크 등록
+ *
+ * 발화 저널 세그먼트(.sionj)는 기록된 발화 하나하나를 "<세그먼트>#<번호>"로 등록하므로
+ * SION_JOURNAL_DIR 디렉토리를 그대로 --samples로 넘겨 실제 사용 중의 발화를 재생할 수 있습니다.
+ * @param samplesDir WAV/저널 디렉토리 (예: tests/samples)
+ * @return 등록한 재생 소스 수
+ */
+int registerReplayBenchmarks(const std::string& samplesDir);
+
+} // namespace bench
+} // namespace sion
+
+#endif // BENCH_SUPPORT_H
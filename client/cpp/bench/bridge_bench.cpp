@@ -0,0 +1,243 @@
+/**
+ * @file bridge_bench.cpp
+ * @brief 브릿지 왕복 및 전체 파이프라인 재생 벤치마크 (루프백 에코 워커 사용)
+ */
+
+#include "bench_support.h"
+
+#include "audio_capture.h"
+#include "audio_encoder.h"
+#include "capture_backend.h"
+#include "latency_trace.h"
+#include "python_bridge.h"
+#include "python_worker_pool.h"
+#include "utterance_journal.h"
+#include "voice_activity_detector.h"
+#include "voice_pipeline.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sion {
+namespace bench {
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+
+/**
+ * @brief 프로세스 전체에서 공유하는 에코 워커 (첫 사용 시 시작)
+ */
+PythonProcessBridge* echoBridge() {
+    static std::unique_ptr<PythonProcessBridge> bridge = [] {
+        auto instance = std::make_unique<PythonProcessBridge>(executablePath(), kEchoWorkerFlag);
+        if (!instance->start() || !instance->waitUntilReady(std::chrono::seconds(5))) {
+            std::cerr << "[Bench] 에코 워커를 시작할 수 없습니다" << std::endl;
+            instance.reset();
+        }
+        return instance;
+    }();
+    return bridge.get();
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    return values[index];
+}
+
+void setLatencyCounters(benchmark::State& state, const std::vector<double>& latenciesMs) {
+    state.counters["p50_ms"] = percentile(latenciesMs, 0.50);
+    state.counters["p95_ms"] = percentile(latenciesMs, 0.95);
+    state.counters["p99_ms"] = percentile(latenciesMs, 0.99);
+}
+
+// ============================================================================
+// 브릿지 왕복 (submit → FINAL_RESULT)
+// ============================================================================
+
+void BM_BridgeRoundTripPcm(benchmark::State& state) {
+    PythonProcessBridge* bridge = echoBridge();
+    if (!bridge) {
+        state.SkipWithError("에코 워커 없음");
+        return;
+    }
+
+    const std::vector<int16_t> samples(static_cast<size_t>(state.range(0)) * kSampleRate / 1000, 100);
+    for (auto _ : state) {
+        const uint32_t id = bridge->submitPcm(samples.data(), samples.size());
+        const std::string result = bridge->awaitResult(id);
+        if (result.empty()) {
+            state.SkipWithError("빈 응답");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(samples.size() * sizeof(int16_t)));
+}
+BENCHMARK(BM_BridgeRoundTripPcm)->Arg(0)->Arg(1000)->Arg(5000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+void BM_BridgeRoundTripFlac(benchmark::State& state) {
+    PythonProcessBridge* bridge = echoBridge();
+    auto encoder = createAudioEncoder(protocol::AudioCodec::Flac);
+    if (!bridge || !encoder) {
+        state.SkipWithError("에코 워커 또는 FLAC 인코더 없음");
+        return;
+    }
+
+    const std::vector<int16_t> samples(static_cast<size_t>(state.range(0)) * kSampleRate / 1000, 100);
+    for (auto _ : state) {
+        const uint32_t id = bridge->submitEncoded(samples.data(), samples.size(), kSampleRate, *encoder);
+        if (bridge->awaitResult(id).empty()) {
+            state.SkipWithError("빈 응답");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_BridgeRoundTripFlac)->Arg(1000)->Arg(5000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+void BM_BridgeCommand(benchmark::State& state) {
+    PythonProcessBridge* bridge = echoBridge();
+    if (!bridge) {
+        state.SkipWithError("에코 워커 없음");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bridge->sendCommand("ping"));
+    }
+}
+BENCHMARK(BM_BridgeCommand)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// ============================================================================
+// 전체 파이프라인 재생 (WAV/저널 레코드 → 캡처 → 인코딩/전송 → 에코 워커 → 결과 콜백)
+// ============================================================================
+
+/**
+ * @brief 파일(또는 저널 레코드) 하나를 푸시투토크 요청으로 반복 재생
+ *
+ * 파일 길이만큼 누른 뒤 떼는 것과 같으므로 무음 파일도 VAD와 무관하게 끝까지 전송됩니다.
+ * 측정 시간은 키 뗌부터 결과 콜백까지(사용자가 체감하는 지연)이고,
+ * 단계별 분포는 실행 후 trace 리포트로 출력됩니다.
+ */
+void BM_ReplayPipeline(benchmark::State& state, const std::string& path, protocol::AudioCodec codec) {
+    AudioConfig audioConfig;
+    audioConfig.device = std::string("file:") + path;
+    AudioCapture capture(audioConfig);
+    if (!capture.initialize()) {
+        state.SkipWithError("재생 파일을 열 수 없음");
+        return;
+    }
+
+    WorkerPoolConfig workerConfig;
+    workerConfig.pythonPath = executablePath();
+    workerConfig.scriptPath = kEchoWorkerFlag;
+    workerConfig.numWorkers = 1;
+    PythonWorkerPool workers(workerConfig);
+    if (!workers.start()) {
+        state.SkipWithError("에코 워커 풀 시작 실패");
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t completed = 0;
+
+    VadConfig vadConfig;
+    vadConfig.sampleRate = audioConfig.sampleRate;
+    VoicePipeline pipeline(capture, vadConfig, workers);
+    pipeline.setCodec(codec);
+    pipeline.setResultCallback([&](uint64_t requestId, const std::string&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        completed = requestId;
+        cv.notify_all();
+    });
+
+    std::vector<int16_t> samples;
+    loadReplayAudio(path, audioConfig.sampleRate, samples);
+    const auto duration = std::chrono::milliseconds(
+        static_cast<int64_t>(samples.size() * 1000 / static_cast<size_t>(audioConfig.sampleRate)));
+
+    std::vector<double> latenciesMs;
+    for (auto _ : state) {
+        const uint64_t requestId = pipeline.beginHold();
+        if (requestId == 0) {
+            state.SkipWithError("요청 거절");
+            break;
+        }
+        std::this_thread::sleep_for(duration);
+
+        const auto released = std::chrono::steady_clock::now();
+        pipeline.endHold();
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!cv.wait_for(lock, std::chrono::seconds(10), [&] { return completed == requestId; })) {
+            state.SkipWithError("결과 시간 초과");
+            break;
+        }
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - released).count();
+        state.SetIterationTime(elapsed);
+        latenciesMs.push_back(elapsed * 1000.0);
+    }
+
+    pipeline.shutdown();
+    workers.stop();
+    setLatencyCounters(state, latenciesMs);
+}
+
+} // namespace
+
+int registerReplayBenchmarks(const std::string& samplesDir) {
+    std::error_code error;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(samplesDir, error)) {
+        if (entry.is_regular_file()
+            && (entry.path().extension() == ".wav" || entry.path().extension() == UtteranceJournal::kExtension)) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    // 재생 소스 (이름, loadReplayAudio() 경로): WAV는 파일 하나, 저널 세그먼트는 기록된 발화마다
+    std::vector<std::pair<std::string, std::string>> sources;
+    for (const auto& file : files) {
+        const std::string name = file.stem().string();
+        if (file.extension() != UtteranceJournal::kExtension) {
+            sources.emplace_back(name, file.string());
+            continue;
+        }
+        UtteranceJournal::forEachRecord(file.string(), [&](size_t index, const JournalRecord& record) {
+            if (!record.samples.empty()) {
+                const std::string id = std::to_string(index);
+                sources.emplace_back(name + "#" + id, file.string() + "#" + id);
+            }
+            return true;
+        });
+    }
+
+    for (const auto& source : sources) {
+        for (protocol::AudioCodec codec : {protocol::AudioCodec::Pcm, protocol::AudioCodec::Flac}) {
+            benchmark::RegisterBenchmark(
+                ("BM_ReplayPipeline/" + source.first + "/" + protocol::audioCodecName(codec)).c_str(),
+                [path = source.second, codec](benchmark::State& state) { BM_ReplayPipeline(state, path, codec); })
+                ->UseManualTime()
+                ->Iterations(10)
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+    return static_cast<int>(sources.size());
+}
+
+} // namespace bench
+} // namespace sion
@@ -0,0 +1,120 @@
+/**
+ * @file echo_worker.cpp
+ * @brief 벤치마크용 루프백 에코 워커 (sion_bench --echo-worker)
+ */
+
+#include "bench_support.h"
+#include "bridge_protocol.h"
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace sion {
+namespace bench {
+
+namespace {
+
+std::string g_executablePath;
+
+bool readExact(void* data, size_t size) {
+    return size == 0 || std::fread(data, 1, size, stdin) == size;
+}
+
+class FrameWriter {
+public:
+    void write(protocol::MessageType type, uint32_t utteranceId, const std::string& payload) {
+        protocol::FrameHeader header;
+        header.type = type;
+        header.utteranceId = utteranceId;
+        header.sequence = m_sequence++;
+        header.payloadSize = static_cast<uint32_t>(payload.size());
+
+        uint8_t raw[protocol::kHeaderSize];
+        protocol::encodeHeader(header, raw);
+        std::fwrite(raw, 1, sizeof(raw), stdout);
+        std::fwrite(payload.data(), 1, payload.size(), stdout);
+        std::fflush(stdout);
+    }
+
+private:
+    uint32_t m_sequence = 0;
+};
+
+} // namespace
+
+const std::string& executablePath() {
+    return g_executablePath;
+}
+
+void setExecutablePath(const std::string& path) {
+    g_executablePath = path;
+}
+
+int runEchoWorker() {
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    FrameWriter writer;
+    writer.write(protocol::MessageType::Ready, 0, "pcm,flac,opus");
+
+    std::unordered_map<uint32_t, size_t> received;   // 발화별 누적 바이트
+    std::vector<uint8_t> payload;
+    uint8_t raw[protocol::kHeaderSize];
+
+    while (readExact(raw, sizeof(raw))) {
+        protocol::FrameHeader header;
+        if (!protocol::decodeHeader(raw, header)) {
+            std::fprintf(stderr, "[EchoWorker] 잘못된 프레임 헤더\n");
+            return 1;
+        }
+        payload.resize(header.payloadSize);
+        if (!readExact(payload.data(), payload.size())) {
+            break;
+        }
+
+        switch (header.type) {
+            case protocol::MessageType::AudioChunk:
+            case protocol::MessageType::AudioShm:
+                received[header.utteranceId] += payload.size();
+                break;
+            case protocol::MessageType::EndOfUtterance: {
+                const size_t bytes = received[header.utteranceId];
+                received.erase(header.utteranceId);
+                writer.write(protocol::MessageType::PartialResult, header.utteranceId, "echo");
+                writer.write(protocol::MessageType::FinalResult, header.utteranceId,
+                             "{\"bytes\": " + std::to_string(bytes) + "}");
+                break;
+            }
+            case protocol::MessageType::Transcript:
+                writer.write(protocol::MessageType::FinalResult, header.utteranceId,
+                             "{\"transcription\": \"" + std::string(payload.begin(), payload.end()) + "\"}");
+                break;
+            case protocol::MessageType::Intent:
+                writer.write(protocol::MessageType::FinalResult, header.utteranceId,
+                             std::string(payload.begin(), payload.end()));
+                break;
+            case protocol::MessageType::Command:
+                writer.write(protocol::MessageType::CommandResult, header.utteranceId,
+                             std::string(payload.begin(), payload.end()));
+                break;
+            case protocol::MessageType::Cancel:
+                received.erase(header.utteranceId);
+                break;
+            default:
+                break;
+        }
+    }
+    return 0;
+}
+
+} // namespace bench
+} // namespace sion
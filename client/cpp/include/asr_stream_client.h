@@ -0,0 +1,189 @@
+#pragma once
+
+#ifndef ASR_STREAM_CLIENT_H
+#define ASR_STREAM_CLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "python_bridge.h"
+#include "websocket_client.h"
+
+namespace sion {
+
+class AudioEncoder;
+class CancellationToken;
+
+/**
+ * @brief 스트리밍 ASR 연결 설정
+ */
+struct AsrStreamConfig {
+    std::string url;                                       // 예: "ws://localhost:8001/transcribe/stream"
+    std::chrono::milliseconds connectTimeout{3000};        // TCP 연결 + 업그레이드
+    std::chrono::milliseconds requestTimeout{15000};       // 스트림 시작 → 최종 텍스트
+    std::chrono::milliseconds reconnectInterval{5000};     // 연결 실패 후 재시도 간격
+};
+
+/**
+ * @brief ASR 서비스 /transcribe/stream 직접 연결 (WebSocket)
+ *
+ * Python 워커를 거치지 않고 C++에서 ASR 서비스로 오디오를 보내 인식 텍스트를 받습니다.
+ * 연결은 하나를 계속 유지하며 발화마다 새로 맺지 않고, 끊기면 다음 submit()에서
+ * reconnectInterval 간격으로 다시 연결합니다.
+ *
+ * 메시지 형식 (backend/asr/app/main.py와 동일):
+ *   C++ → ASR: {"type":"start","id":N,"codec":"flac","sample_rate":16000}
+ *              바이너리: id(LE 4바이트) + 오디오 조각 (코덱 바이트 그대로)
+ *              {"type":"end","id":N} / {"type":"cancel","id":N}
+ *   ASR → C++: {"type":"partial"|"final","id":N,"text":"..."} / {"type":"error","id":N,"message":"..."}
+ *
+ * 응답은 수신 스레드가 스트림 ID별로 분배하므로 여러 발화를 한 연결에 겹쳐 보낼 수 있습니다.
+ * 중간 결과는 수신 스레드에서 발화별 콜백으로 전달됩니다.
+ * 모든 메서드는 어느 스레드에서든 호출할 수 있으며, 여러 캡처 세션의 send 단계가
+ * 동시에 submit()할 수 있습니다 (각 조각은 한 WebSocket 메시지로 나가 섞이지 않음).
+ */
+class AsrStreamClient {
+public:
+    /**
+     * @brief 생성자
+     * @param config 연결 설정 (url이 비어 있으면 사용 안 함)
+     */
+    explicit AsrStreamClient(AsrStreamConfig config);
+
+    /**
+     * @brief 소멸자 - 연결 종료
+     */
+    ~AsrStreamClient();
+
+    // 복사 금지
+    AsrStreamClient(const AsrStreamClient&) = delete;
+    AsrStreamClient& operator=(const AsrStreamClient&) = delete;
+
+    /**
+     * @brief 첫 연결 (실패해도 이후 submit()에서 재시도)
+     * @return 연결 여부
+     */
+    bool start();
+
+    /**
+     * @brief 연결 종료 (대기 중인 스트림은 빈 결과로 완료)
+     */
+    void stop();
+
+    /**
+     * @brief 현재 연결되어 있는지 확인
+     */
+    bool isConnected() const { return m_connected.load(); }
+
+    /**
+     * @brief 연결되어 있지 않으면 재연결 시도 (재시도 간격 안이면 바로 false)
+     * @return 사용할 수 있는 연결이 있는지 여부
+     */
+    bool ensureConnected();
+
+    /**
+     * @brief 발화 전체 전송 (결과는 기다리지 않음)
+     *
+     * kStreamChunkSamples 단위로 인코딩하며 완성된 바이트가 생길 때마다 보내고,
+     * 반환 즉시 샘플 버퍼를 재사용할 수 있습니다.
+     * @param samples PCM s16le 모노 샘플
+     * @param sampleCount 샘플 수
+     * @param sampleRate 샘플링 레이트
+     * @param encoder 인코더 (nullptr이면 PCM, 호출 중 전용으로 사용)
+     * @param onPartial 중간 결과 콜백 (수신 스레드에서 호출, 선택)
+     * @param cancel 취소 토큰 (선택, 조각 사이에서 확인하여 end 대신 cancel 전송)
+     * @return 스트림 ID (0이면 연결 없음, 전송 실패 시에도 awaitTranscript()는 즉시 반환)
+     */
+    uint32_t submit(const int16_t* samples, size_t sampleCount, int sampleRate,
+                    AudioEncoder* encoder,
+                    const PartialResultCallback& onPartial = nullptr,
+                    CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 최종 인식 텍스트 대기 (스트림당 한 번만 호출)
+     * @param streamId submit()이 반환한 ID
+     * @param cancel 취소 토큰 (선택, 취소 시 cancel 전송 후 즉시 반환)
+     * @param failed 출력: 오류/시간 초과/연결 끊김 여부 (선택, 무음이면 false에 빈 텍스트)
+     * @return 인식 텍스트 (실패 시 빈 문자열)
+     */
+    std::string awaitTranscript(uint32_t streamId, CancellationToken* cancel = nullptr,
+                                bool* failed = nullptr);
+
+    /**
+     * @brief 스트림 취소 (cancel 전송, 대기자는 빈 결과로 깨어남)
+     */
+    void cancelStream(uint32_t streamId);
+
+    /**
+     * @brief 한 바이너리 메시지에 담는 샘플 수 (16 kHz 기준 100 ms)
+     */
+    static constexpr size_t kStreamChunkSamples = 1600;
+
+private:
+    /**
+     * @brief 응답 대기 항목
+     */
+    struct PendingStream {
+        PartialResultCallback onPartial;
+        std::promise<std::string> promise;
+        std::future<std::string> future;
+        std::chrono::steady_clock::time_point deadline;
+        bool completed = false;
+        bool failed = false;
+
+        // 지연 계측 (submit() 호출 스레드의 요청 ID와 시작 시각)
+        uint64_t traceRequest = 0;
+        int64_t sentAt = 0;
+        bool partialSeen = false;
+    };
+
+    using SocketPtr = std::shared_ptr<WebSocketClient>;
+
+    /**
+     * @brief 현재 연결 (끊겼거나 없으면 nullptr)
+     */
+    SocketPtr socket() const;
+
+    /**
+     * @brief 수신 스레드: 연결이 끊길 때까지 메시지 분배
+     */
+    void readLoop(SocketPtr socket);
+
+    void handleMessage(const std::string& message);
+    void completeStream(uint32_t streamId, const std::string& text, bool failed);
+    void failAllStreams();
+
+    /**
+     * @brief 이전 연결의 수신 스레드 정리 후 새로 연결 (m_connectMutex 보유)
+     */
+    bool connectLocked();
+
+    bool sendControl(const SocketPtr& socket, const char* type, uint32_t streamId);
+
+    AsrStreamConfig m_config;
+
+    std::mutex m_connectMutex;
+    std::chrono::steady_clock::time_point m_nextAttempt;   // m_connectMutex로 보호
+    std::thread m_reader;                                  // m_connectMutex로 보호
+    mutable std::mutex m_socketMutex;
+    SocketPtr m_socket;                                    // m_socketMutex로 보호
+    std::atomic<bool> m_connected;
+
+    std::atomic<uint32_t> m_nextStreamId;
+
+    mutable std::mutex m_pendingMutex;
+    std::unordered_map<uint32_t, PendingStream> m_pending;
+};
+
+} // namespace sion
+
+#endif // ASR_STREAM_CLIENT_H
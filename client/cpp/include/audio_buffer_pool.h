@@ -0,0 +1,102 @@
+#pragma once
+
+#ifndef AUDIO_BUFFER_POOL_H
+#define AUDIO_BUFFER_POOL_H
+
+#include <cstddef>
+#include <memory>
+
+#include "wav_buffer.h"
+
+namespace sion {
+
+/**
+ * @brief 미리 할당한 WAV 버퍼 풀
+ *
+ * 생성 시 bufferCount개의 WavBuffer를 최대 녹음 길이로 할당하고
+ * 페이지를 미리 확정해 두므로, 이후 acquire()/반환은 할당 없이
+ * 포인터 이동만 수행합니다. 풀이 비면 acquire()는 빈 핸들을 반환합니다.
+ *
+ * 핸들은 소멸(또는 reset()) 시 버퍼를 스스로 풀에 반환합니다.
+ * 풀 상태는 핸들과 공유하므로 핸들이 풀보다 오래 살아도 안전합니다.
+ */
+class AudioBufferPool {
+    struct State;
+
+public:
+    /**
+     * @brief 풀에서 빌린 버퍼의 소유 핸들 (이동만 가능)
+     */
+    class Handle {
+    public:
+        Handle() = default;
+        ~Handle();
+
+        Handle(Handle&& other) noexcept = default;
+        Handle& operator=(Handle&& other) noexcept;
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        /**
+         * @brief 버퍼를 풀에 반환 (빈 핸들이면 무시)
+         */
+        void reset();
+
+        WavBuffer* get() const { return m_buffer.get(); }
+        WavBuffer& operator*() const { return *m_buffer; }
+        WavBuffer* operator->() const { return m_buffer.get(); }
+        explicit operator bool() const { return m_buffer != nullptr; }
+
+    private:
+        friend class AudioBufferPool;
+
+        Handle(std::shared_ptr<State> state, std::unique_ptr<WavBuffer> buffer);
+
+        std::shared_ptr<State> m_state;
+        std::unique_ptr<WavBuffer> m_buffer;
+    };
+
+    /**
+     * @brief 생성자 (모든 버퍼를 즉시 할당)
+     * @param bufferCount 버퍼 수
+     * @param capacitySamples 버퍼당 샘플 용량
+     */
+    AudioBufferPool(size_t bufferCount, size_t capacitySamples);
+
+    ~AudioBufferPool();
+
+    // 복사 금지
+    AudioBufferPool(const AudioBufferPool&) = delete;
+    AudioBufferPool& operator=(const AudioBufferPool&) = delete;
+
+    /**
+     * @brief 버퍼 대여 (샘플 수 0으로 초기화됨)
+     * @return 핸들 (풀이 비었으면 빈 핸들)
+     */
+    Handle acquire();
+
+    /**
+     * @brief 대여 가능한 버퍼 수
+     */
+    size_t available() const;
+
+    /**
+     * @brief 전체 버퍼 수
+     */
+    size_t bufferCount() const { return m_bufferCount; }
+
+    /**
+     * @brief 버퍼당 샘플 용량
+     */
+    size_t capacitySamples() const { return m_capacitySamples; }
+
+private:
+    std::shared_ptr<State> m_state;
+    size_t m_bufferCount;
+    size_t m_capacitySamples;
+};
+
+} // namespace sion
+
+#endif // AUDIO_BUFFER_POOL_H
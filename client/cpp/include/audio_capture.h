@@ -8,9 +8,20 @@
 #include <string>
 #include <functional>
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#include "ring_buffer.h"
+#include "span.h"
+#include "wav_buffer.h"
 
 namespace sion {
 
+class CaptureBackend;
+class CancellationToken;
+class VoiceActivityDetector;
+
 /**
  * @brief 오디오 설정 구조체
  */
@@ -19,17 +30,31 @@ struct AudioConfig {
     int channels = 1;            // 채널 수 (모노)
     int bitsPerSample = 16;      // 비트 깊이
     float maxDuration = 10.0f;   // 최대 녹음 시간 (초)
+    int frameDurationMs = 10;    // 콜백 프레임 길이 (ms)
+    bool exclusiveMode = false;  // WASAPI 배타 모드 사용 여부
+    bool nativeFormat = true;    // 공유 모드에서 장치 믹스 포맷으로 열고 직접 변환 (AudioResampler)
+    int preRollMs = 0;           // 0보다 크면 스트림을 항상 실행하고 이만큼의 직전 오디오를 녹음 앞에 붙임
+    std::string device;          // 캡처 장치 (비우면 기본 장치, enumerateCaptureDevices()의 id, "null"이면 무음 더미, "file:<경로>"면 WAV/저널 레코드 재생)
 };
 
 /**
  * @brief 오디오 데이터 콜백 타입
+ *
+ * 프레임은 백엔드 내부 버퍼를 가리키는 뷰이며 콜백이 반환될 때까지만 유효합니다.
  */
-using AudioCallback = std::function<void(const std::vector<int16_t>&)>;
+using AudioCallback = std::function<void(Span<const int16_t>)>;
 
 /**
  * @brief 오디오 캡처 클래스
  * 
- * Windows WASAPI를 사용하여 마이크 입력을 캡처합니다.
+ * 플랫폼 캡처 백엔드(Windows WASAPI, Linux ALSA, macOS CoreAudio)로 마이크 입력을 캡처합니다.
+ * 장치는 initialize()에서 한 번 열어 두고, 캡처 중에는
+ * frameDurationMs 단위 프레임이 도착하는 즉시 프레임 콜백으로 전달합니다.
+ *
+ * AudioConfig::preRollMs를 지정하면 initialize()에서 스트림까지 시작해 두고
+ * (상시 캡처), 녹음 중이 아닐 때의 프레임은 작은 순환 버퍼(pre-roll)에만 기록합니다.
+ * 녹음을 시작하면 다음 프레임에서 pre-roll을 링 버퍼 앞에 붙이므로
+ * 스트림 시작 지연이 없고 핫키와 동시에 말한 첫 음절도 잘리지 않습니다.
  */
 class AudioCapture {
 public:
@@ -55,43 +80,172 @@ public:
     bool initialize();
 
     /**
-     * @brief 녹음 시작
+     * @brief 녹음 시작 (종료 시점이 정해지지 않은 캡처)
+     *
+     * 캡처 스레드는 미리 할당된 SPSC 링 버퍼(maxDuration 크기)에만 기록하며,
+     * 콜백 안에서는 할당이나 락을 사용하지 않습니다.
      * @return 성공 여부
      */
     bool startCapture();
 
     /**
      * @brief 녹음 중지
+     *
+     * 스트림을 즉시 멈추고(장치 버퍼 드레인 대기 없음)
+     * 링 버퍼에 쌓인 샘플을 반환합니다.
      * @return 캡처된 오디오 데이터
      */
     std::vector<int16_t> stopCapture();
 
     /**
      * @brief 고정 시간 녹음
+     *
+     * 상시 캡처 모드에서는 pre-roll도 녹음 시간에 포함됩니다.
      * @param durationSeconds 녹음 시간 (초)
-     * @return 캡처된 오디오 데이터
+     * @param cancel 취소 토큰 (선택, 취소 시 즉시 중단)
+     * @return 캡처된 오디오 데이터 (취소 시 빈 벡터)
+     */
+    std::vector<int16_t> captureForDuration(float durationSeconds, CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 고정 시간 녹음 결과를 WAV 버퍼에 직접 기록 (할당 없음)
+     *
+     * 프레임은 캡처 스레드에서 wav.samples()로 바로 복사되고 헤더는 제자리에 작성됩니다.
+     * @param durationSeconds 녹음 시간 (초, wav 용량을 넘는 부분은 버림)
+     * @param wav 출력 버퍼 (AudioBufferPool에서 빌린 버퍼 등)
+     * @param cancel 취소 토큰 (선택)
+     * @return 샘플이 기록되었는지 여부 (취소 시 false)
+     */
+    bool captureForDuration(float durationSeconds, WavBuffer& wav, CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 발화 단위 녹음 (VAD 엔드포인팅)
+     *
+     * 캡처 스레드에서 프레임마다 VAD를 실행하여 후행 무음이 감지되는 즉시
+     * 녹음을 끝내고, 앞뒤 무음(패딩 제외)을 잘라낸 구간만 반환합니다.
+     * 최대 길이는 AudioConfig::maxDuration입니다.
+     * @param vad 엔드포인터 (호출 시 reset됨)
+     * @param cancel 취소 토큰 (선택, 취소 시 스트림을 즉시 멈춤)
+     * @return 발화 구간 오디오 (발화가 없거나 취소되면 빈 벡터)
+     */
+    std::vector<int16_t> captureUtterance(VoiceActivityDetector& vad, CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 발화 단위 녹음 결과를 WAV 버퍼에 직접 기록
+     *
+     * 링 버퍼의 발화 구간을 wav.samples()로 한 번만 복사하고 헤더를 제자리에
+     * 작성하므로, 반환 후 wav.data()/wav.size()가 그대로 전송 가능한 WAV입니다.
+     * @param vad 엔드포인터 (호출 시 reset됨)
+     * @param wav 출력 버퍼 (maxDuration 용량으로 재사용)
+     * @param cancel 취소 토큰 (선택, 취소 시 스트림을 즉시 멈춤)
+     * @return 발화가 감지되었는지 여부 (취소 시 false)
+     */
+    bool captureUtterance(VoiceActivityDetector& vad, WavBuffer& wav, CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 발화 단위 녹음 결과를 호출자 버퍼에 직접 기록
+     *
+     * 공유 메모리 슬롯처럼 외부에서 관리하는 영역에 한 번만 복사합니다.
+     * @param vad 엔드포인터 (호출 시 reset됨)
+     * @param out 출력 버퍼
+     * @param capacity out에 기록 가능한 최대 샘플 수 (넘는 뒷부분은 버림)
+     * @param cancel 취소 토큰 (선택)
+     * @return 기록한 샘플 수 (발화가 없거나 취소되면 0)
+     */
+    size_t captureUtterance(VoiceActivityDetector& vad, int16_t* out, size_t capacity,
+                            CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 정지 신호까지 녹음 (푸시투토크)
+     *
+     * 키를 누를 때 호출하고, 키를 뗄 때 stop을 취소 상태로 만들면 그 시점까지의
+     * 오디오 전체를 반환합니다 (VAD 트리밍 없음, 상시 캡처 모드면 pre-roll 포함).
+     * @param stop 녹음 종료 신호 (키 뗌)
+     * @param out 출력 버퍼
+     * @param capacity out에 기록 가능한 최대 샘플 수 (도달 시 자동 종료)
+     * @param cancel 취소 토큰 (선택, 취소 시 결과 폐기)
+     * @return 기록한 샘플 수 (취소 시 0)
      */
-    std::vector<int16_t> captureForDuration(float durationSeconds);
+    size_t captureUntilStopped(CancellationToken& stop, int16_t* out, size_t capacity,
+                               CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 정지 신호까지 녹음한 결과를 WAV 버퍼에 직접 기록
+     * @param stop 녹음 종료 신호 (키 뗌)
+     * @param wav 출력 버퍼
+     * @param cancel 취소 토큰 (선택)
+     * @return 샘플이 기록되었는지 여부
+     */
+    bool captureUntilStopped(CancellationToken& stop, WavBuffer& wav, CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 프레임 콜백 설정
+     *
+     * 캡처 중 프레임이 도착할 때마다 캡처 스레드에서 호출됩니다.
+     * 상시 캡처 모드에서는 녹음 첫 프레임 직전에 pre-roll 구간이 (최대 두 조각으로) 먼저 전달됩니다.
+     * 녹음 중에는 변경하지 마세요.
+     * @param callback 프레임 콜백 (nullptr이면 해제)
+     */
+    void setFrameCallback(AudioCallback callback);
+
+    /**
+     * @brief 대기 중 프레임 콜백 설정 (웨이크워드 검출 등)
+     *
+     * 상시 캡처 모드에서 녹음 중이 아닐 때 도착하는 프레임마다 캡처 스레드에서 호출됩니다.
+     * 스트림은 initialize()에서 시작되므로 initialize() 전에 설정해야 합니다.
+     * @param callback 프레임 콜백 (nullptr이면 해제)
+     */
+    void setStandbyCallback(AudioCallback callback);
 
     /**
      * @brief 녹음 중인지 확인
      */
     bool isCapturing() const;
 
+    /**
+     * @brief 상시 캡처(pre-roll) 모드로 스트림이 실행 중인지 확인
+     */
+    bool isStandby() const { return m_standby.load(); }
+
+    /**
+     * @brief 마지막 녹음에서 링 버퍼가 가득 차 버려진 샘플 수
+     */
+    size_t getOverrunSamples() const { return m_overrunSamples.load(std::memory_order_relaxed); }
+
     /**
      * @brief 오디오 데이터를 WAV 파일로 저장
      * @param data 오디오 데이터
      * @param filepath 저장 경로
      * @return 성공 여부
      */
-    bool saveToWav(const std::vector<int16_t>& data, const std::string& filepath);
+    bool saveToWav(Span<const int16_t> data, const std::string& filepath);
 
     /**
      * @brief 오디오 데이터를 WAV 바이트로 변환
      * @param data 오디오 데이터
      * @return WAV 형식 바이트 배열
      */
-    std::vector<uint8_t> toWavBytes(const std::vector<int16_t>& data);
+    std::vector<uint8_t> toWavBytes(Span<const int16_t> data);
+
+    /**
+     * @brief WAV 헤더를 주어진 위치에 제자리 작성
+     * @param header 출력 위치 (WavBuffer::kHeaderSize 바이트)
+     * @param dataSize 샘플 데이터 크기 (바이트)
+     */
+    void writeWavHeader(uint8_t* header, uint32_t dataSize) const;
+
+    /**
+     * @brief 한 번의 녹음으로 얻을 수 있는 최대 샘플 수 (maxDuration × sampleRate × channels)
+     *
+     * captureUtterance()에 넘기는 WavBuffer가 이 용량 이상이면 재할당이 없습니다.
+     * 링 버퍼는 2의 거듭제곱으로 올림되어 더 크지만, 녹음은 항상 이 길이에서 끊습니다.
+     */
+    size_t maxCaptureSamples() const { return m_maxCaptureSamples; }
+
+    /**
+     * @brief 설정의 최대 녹음 샘플 수 (캡처 객체 없이 공유 메모리 슬롯 등 크기 계산용)
+     */
+    static size_t maxCaptureSamples(const AudioConfig& config);
 
     /**
      * @brief 설정 반환
@@ -100,16 +254,93 @@ public:
 
 private:
     /**
-     * @brief WAV 헤더 작성
+     * @brief 고정 시간 녹음 공통 구현 (out에 직접 기록)
+     * @return 기록한 샘플 수 (취소 시 0)
      */
-    void writeWavHeader(std::vector<uint8_t>& buffer, uint32_t dataSize);
+    size_t recordForDuration(float durationSeconds, int16_t* out, size_t capacity, CancellationToken* cancel);
 
     AudioConfig m_config;
     std::atomic<bool> m_capturing;
-    std::vector<int16_t> m_buffer;
-    
-    // 플랫폼 별 핸들 (구현에서 정의)
-    void* m_platformHandle;
+    size_t m_maxCaptureSamples;
+    SpscRingBuffer<int16_t> m_ring;
+    std::atomic<size_t> m_overrunSamples;
+    AudioCallback m_frameCallback;
+    AudioCallback m_standbyCallback;
+
+    /**
+     * @brief 녹음 시작 공통 구현
+     * @param limit 링 버퍼에 기록할 최대 샘플 수 (도달 시 엔드포인트 알림)
+     */
+    bool beginCapture(size_t limit);
+
+    /**
+     * @brief 캡처 스트림 중지 (링 버퍼 내용은 유지)
+     *
+     * 상시 캡처 모드에서는 스트림은 그대로 두고, 진행 중인 콜백이 끝날 때까지만
+     * 기다린 뒤 링 버퍼 기록을 멈춥니다.
+     */
+    void stopStream();
+
+    /**
+     * @brief 백엔드 프레임 처리 (캡처 스레드)
+     */
+    void handleFrame(Span<const int16_t> frame);
+
+    /**
+     * @brief 녹음 중인 샘플을 링 버퍼/프레임 콜백/VAD로 전달 (캡처 스레드)
+     */
+    void recordSamples(Span<const int16_t> samples);
+
+    /**
+     * @brief pre-roll 순환 버퍼에 프레임 추가 (캡처 스레드)
+     */
+    void pushPreRoll(Span<const int16_t> frame);
+
+    /**
+     * @brief 엔드포인트 도달 알림 (캡처 스레드, 발화당 1회, 락 없음)
+     * @param speechEnded 발화 종료(VAD, 키 뗌, 최대 길이)인지 여부 (취소는 false, EndOfSpeech 구간 기록)
+     */
+    void signalEndpoint(bool speechEnded = false);
+
+    /**
+     * @brief signalEndpoint()가 호출될 때까지 대기 (녹음을 시작한 스레드)
+     */
+    void waitForEndpoint();
+
+    /**
+     * @brief VAD 엔드포인트까지 녹음하고 발화 구간 계산 (샘플은 링 버퍼에 남김)
+     * @param begin 출력: 발화 시작 위치
+     * @param end 출력: 발화 종료 위치 (exclusive)
+     * @param cancel 취소 토큰 (nullptr 허용)
+     * @return 발화가 감지되었는지 여부 (취소 시 false)
+     */
+    bool recordUtterance(VoiceActivityDetector& vad, size_t& begin, size_t& end, CancellationToken* cancel);
+
+    // 엔드포인팅 상태 (captureUtterance 동안만 유효)
+    VoiceActivityDetector* m_vad;
+    std::atomic<bool> m_endpointReached;
+    std::mutex m_endpointMutex;
+    std::condition_variable m_endpointCv;
+
+    // 녹음 상태 (beginCapture()에서 설정, 이후 캡처 스레드 전용)
+    size_t m_captureLimit;
+    size_t m_recordedSamples;
+    uint64_t m_traceRequest;   // 지연 계측용 요청 ID
+    int64_t m_captureStartNs;  // 지연 계측용 녹음 시작 시각
+
+    // 상시 캡처 (pre-roll) 상태
+    std::atomic<bool> m_standby;         // 스트림이 녹음과 무관하게 실행 중
+    std::atomic<bool> m_preRollPending;  // 다음 프레임에서 pre-roll을 링 버퍼에 붙임
+    std::atomic<bool> m_inCallback;      // stopStream()이 진행 중인 콜백을 기다리는 데 사용
+    std::atomic<bool> m_callbackWaiter;  // stopStream()이 대기 중 (콜백은 이때만 알림)
+    std::mutex m_callbackMutex;
+    std::condition_variable m_callbackCv;
+    std::vector<int16_t> m_preRoll;      // 캡처 스레드 전용 순환 버퍼
+    size_t m_preRollPos;
+    size_t m_preRollFilled;
+
+    // 플랫폼 별 캡처 백엔드 (WASAPI 등)
+    std::unique_ptr<CaptureBackend> m_backend;
 };
 
 } // namespace sion
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef AUDIO_ENCODER_H
+#define AUDIO_ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bridge_protocol.h"
+
+namespace sion {
+
+/**
+ * @brief 스트리밍 오디오 인코더 인터페이스
+ *
+ * begin() 후 encode()에 임의 길이의 PCM 조각을 넣으면 완성된 블록/페이지만큼의
+ * 바이트가 out 뒤에 추가되고, finish()가 남은 샘플과 스트림 끝을 씁니다.
+ * 출력 바이트를 순서대로 이어 붙이면 그대로 재생 가능한 파일이 됩니다.
+ * 따라서 조각마다 바로 AUDIO_CHUNK로 보내 인코딩과 전송을 겹칠 수 있습니다.
+ */
+class AudioEncoder {
+public:
+    virtual ~AudioEncoder() = default;
+
+    /**
+     * @brief 새 스트림 시작 (스트림 헤더를 out에 추가)
+     * @param sampleRate 샘플링 레이트 (Hz)
+     * @param channels 채널 수 (인터리브)
+     * @param out 출력 버퍼
+     * @return 성공 여부
+     */
+    virtual bool begin(int sampleRate, int channels, std::vector<uint8_t>& out) = 0;
+
+    /**
+     * @brief PCM 조각 인코딩
+     * @param samples 인터리브 int16 샘플
+     * @param count 샘플 수 (채널 수의 배수)
+     * @param out 완성된 블록을 추가할 버퍼 (블록이 덜 찼으면 추가 없음)
+     */
+    virtual void encode(const int16_t* samples, size_t count, std::vector<uint8_t>& out) = 0;
+
+    /**
+     * @brief 남은 샘플을 마지막 블록으로 쓰고 스트림 종료
+     * @param out 출력 버퍼
+     */
+    virtual void finish(std::vector<uint8_t>& out) = 0;
+
+    /**
+     * @brief 코덱 종류 (AUDIO_CHUNK flags 값)
+     */
+    virtual protocol::AudioCodec codec() const = 0;
+};
+
+/**
+ * @brief 코덱 인코더 생성
+ *
+ * FLAC은 내장 구현(고정 예측 + Rice 부호화)이라 항상 사용할 수 있고,
+ * Opus는 libopus와 함께 빌드된 경우(SION_HAVE_OPUS)에만 Ogg Opus로 생성됩니다.
+ * @param codec 코덱
+ * @return 인코더 (PCM이거나 빌드에 없는 코덱이면 nullptr)
+ */
+std::unique_ptr<AudioEncoder> createAudioEncoder(protocol::AudioCodec codec);
+
+/**
+ * @brief 빌드에 포함된 코덱인지 확인
+ */
+bool isCodecAvailable(protocol::AudioCodec codec);
+
+} // namespace sion
+
+#endif // AUDIO_ENCODER_H
@@ -0,0 +1,90 @@
+#pragma once
+
+#ifndef AUDIO_KERNELS_H
+#define AUDIO_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sion {
+namespace kernels {
+
+/**
+ * @brief 프레임 단위 음향 특징
+ */
+struct FrameFeatures {
+    float rms = 0.0f;        // RMS 에너지 (int16 스케일)
+    float zcr = 0.0f;        // 영교차율 (0.0 ~ 1.0)
+};
+
+/**
+ * @brief 제곱합 계산 (정확한 64비트 누적)
+ * @param samples 샘플 포인터
+ * @param count 샘플 수
+ */
+uint64_t sumOfSquares(const int16_t* samples, size_t count);
+
+/**
+ * @brief 인접 샘플 간 부호가 바뀐 횟수
+ * @param samples 샘플 포인터
+ * @param count 샘플 수
+ */
+uint32_t zeroCrossings(const int16_t* samples, size_t count);
+
+/**
+ * @brief RMS 에너지와 영교차율 계산
+ * @param samples 샘플 포인터
+ * @param count 샘플 수
+ */
+FrameFeatures computeFrameFeatures(const int16_t* samples, size_t count);
+
+/**
+ * @brief float 내적 (FIR 필터 탭 적용)
+ * @param a 첫 번째 벡터
+ * @param b 두 번째 벡터
+ * @param count 원소 수
+ */
+float dotProduct(const float* a, const float* b, size_t count);
+
+/**
+ * @brief [-1, 1] float 샘플을 int16으로 변환 (범위 밖은 포화)
+ * @param in 입력 샘플
+ * @param out 출력 샘플
+ * @param count 샘플 수
+ */
+void floatToInt16(const float* in, int16_t* out, size_t count);
+
+/**
+ * @brief int16 샘플에 분석 창을 곱해 float로 변환 (out[i] = samples[i] * window[i])
+ * @param samples 입력 샘플
+ * @param window 창 계수 (정규화 계수 포함)
+ * @param out 출력 버퍼
+ * @param count 샘플 수
+ */
+void applyWindow(const int16_t* samples, const float* window, float* out, size_t count);
+
+/**
+ * @brief int8 내적 (양자화 신경망 연산, int32 누적)
+ * @param a 첫 번째 벡터
+ * @param b 두 번째 벡터
+ * @param count 원소 수 (2^17 미만이면 오버플로 없음)
+ */
+int32_t dotProductInt8(const int8_t* a, const int8_t* b, size_t count);
+
+/**
+ * @brief 실행 중인 CPU에 맞게 선택된 SIMD 구현 이름 ("avx2", "sse2", "neon", "scalar")
+ */
+const char* activeIsa();
+
+// 스칼라 기준 구현 (검증 및 꼬리 처리용)
+uint64_t sumOfSquaresScalar(const int16_t* samples, size_t count);
+uint32_t zeroCrossingsScalar(const int16_t* samples, size_t count);
+float dotProductScalar(const float* a, const float* b, size_t count);
+void floatToInt16Scalar(const float* in, int16_t* out, size_t count);
+void applyWindowScalar(const int16_t* samples, const float* window, float* out, size_t count);
+int32_t dotProductInt8Scalar(const int8_t* a, const int8_t* b, size_t count);
+
+} // namespace kernels
+} // namespace sion
+
+#endif // AUDIO_KERNELS_H
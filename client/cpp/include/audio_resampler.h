@@ -0,0 +1,101 @@
+#pragma once
+
+#ifndef AUDIO_RESAMPLER_H
+#define AUDIO_RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sion {
+
+/**
+ * @brief 장치 샘플 형식
+ */
+enum class SampleFormat {
+    Int16,      // 16비트 PCM
+    Int32,      // 32비트 PCM (24비트 컨테이너 포함)
+    Float32     // IEEE float [-1, 1] (WASAPI 공유 모드 믹스 포맷)
+};
+
+/**
+ * @brief 장치 입력 형식 (인터리브)
+ */
+struct InputFormat {
+    int sampleRate = 48000;
+    int channels = 2;
+    SampleFormat format = SampleFormat::Float32;
+};
+
+/**
+ * @brief 캡처 형식 변환 단계 (다운믹스 → 폴리페이즈 FIR 리샘플링 → int16)
+ *
+ * 장치를 네이티브 믹스 포맷(예: 48 kHz 스테레오 float)으로 연 뒤
+ * 캡처 스레드에서 직접 16 kHz 모노 int16으로 변환합니다.
+ *
+ * 리샘플링은 유리수 비율 L/M의 폴리페이즈 FIR(Kaiser 창 sinc)이며,
+ * 48k→16k(1/3)와 44.1k→16k(160/441)는 비율과 탭 수를 템플릿 인자로 고정한
+ * 구현을 사용해 위상 계산이 상수로 접히고, 탭 내적은 SIMD 커널로 계산합니다.
+ * 그 외 비율은 같은 알고리즘의 런타임 구현으로 처리합니다.
+ *
+ * 필터 상태(이전 입력)를 유지하므로 패킷 경계와 무관하게 연속된 출력을 냅니다.
+ */
+class AudioResampler {
+public:
+    AudioResampler();
+    ~AudioResampler();
+
+    // 복사 금지
+    AudioResampler(const AudioResampler&) = delete;
+    AudioResampler& operator=(const AudioResampler&) = delete;
+
+    /**
+     * @brief 변환 설정 (필터 계수 생성, 상태 초기화)
+     * @param input 장치 입력 형식
+     * @param outputRate 출력 샘플링 레이트 (Hz, 모노 int16)
+     * @return 성공 여부 (지원하지 않는 형식/비율이면 false)
+     */
+    bool configure(const InputFormat& input, int outputRate);
+
+    /**
+     * @brief 인터리브 입력 프레임 변환
+     * @param data 장치 버퍼 (nullptr이면 무음)
+     * @param frames 입력 프레임 수 (채널당 샘플 수)
+     * @param out 변환된 모노 int16 샘플을 뒤에 추가할 버퍼
+     */
+    void process(const void* data, size_t frames, std::vector<int16_t>& out);
+
+    /**
+     * @brief 필터 상태 초기화 (스트림 재시작 시)
+     */
+    void reset();
+
+    /**
+     * @brief 변환 없이 그대로 통과하는지 (이미 출력 형식과 같음)
+     */
+    bool isPassthrough() const { return m_passthrough; }
+
+    /**
+     * @brief 사용 중인 구현 이름 (로그용, 예: "polyphase 1/3 (fixed)")
+     */
+    const char* description() const;
+
+    /**
+     * @brief 리샘플링 커널 인터페이스 (구현은 audio_resampler.cpp)
+     */
+    class Kernel;
+
+private:
+    InputFormat m_input;
+    int m_outputRate;
+    bool m_passthrough;
+
+    std::unique_ptr<Kernel> m_kernel;   // 레이트가 같으면 nullptr
+    std::vector<float> m_mono;          // 다운믹스 결과 (재사용)
+    std::vector<float> m_resampled;     // 리샘플링 결과 (재사용)
+};
+
+} // namespace sion
+
+#endif // AUDIO_RESAMPLER_H
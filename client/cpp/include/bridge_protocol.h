@@ -0,0 +1,158 @@
+#pragma once
+
+#ifndef BRIDGE_PROTOCOL_H
+#define BRIDGE_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace sion {
+namespace protocol {
+
+/**
+ * @brief 브릿지 파이프 프로토콜 메시지 타입
+ *
+ * C++ → Python: AudioChunk, AudioShm, EndOfUtterance, Cancel, Command, Transcript, Intent, Speculate, Session
+ * Python → C++: PartialResult, FinalResult, CommandResult, Error, Ready
+ */
+enum class MessageType : uint8_t {
+    AudioChunk = 1,        // 오디오 조각 (flags = AudioCodec, 기본 PCM s16le 모노)
+    EndOfUtterance = 2,    // 발화 종료 (더 이상 AudioChunk 없음)
+    PartialResult = 3,     // 중간 인식 결과 (UTF-8)
+    FinalResult = 4,       // 최종 처리 결과 (UTF-8 JSON)
+    Cancel = 5,            // 발화 처리 취소
+    Command = 6,           // 텍스트 명령 (UTF-8)
+    CommandResult = 7,     // 텍스트 명령 응답 (UTF-8)
+    Error = 8,             // 처리 오류 (UTF-8 메시지)
+    Ready = 9,             // 워커 준비 완료 (utteranceId 0, 페이로드: 지원 코덱 목록 "pcm,flac,...")
+    AudioShm = 10,         // 공유 메모리 오디오 구간 알림 (ShmAudioRef)
+    Transcript = 11,       // ASR을 C++에서 직접 거친 인식 텍스트 (UTF-8, NLU/작업만 실행 → FinalResult)
+    Intent = 12,           // 캐시된 의도 (JSON {"transcription", "intent"}, 작업만 실행 → FinalResult)
+    Speculate = 13,        // 말하는 중인 발화의 안정된 중간 인식 텍스트 (UTF-8, utteranceId 0, 응답 없음)
+    Session = 14           // 발화의 캡처 세션 ID (u32 LE, 발화의 첫 프레임보다 먼저, 세션 0이면 생략)
+};
+
+constexpr uint8_t kMagic = 'S';
+constexpr uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = 16;
+
+// 한 프레임 페이로드 상한 (잘못된 스트림으로 인한 과대 할당 방지)
+constexpr uint32_t kMaxPayloadSize = 16 * 1024 * 1024;
+
+/**
+ * @brief AudioChunk 페이로드 코덱 (FrameHeader::flags)
+ *
+ * 한 발화의 모든 AudioChunk는 같은 코덱이어야 하며, PCM이 아니면
+ * 조각을 이어 붙인 바이트가 그대로 하나의 파일(FLAC/Ogg Opus 스트림)입니다.
+ */
+enum class AudioCodec : uint8_t {
+    Pcm = 0,
+    Flac = 1,
+    Opus = 2
+};
+
+/**
+ * @brief 프레임 헤더 (리틀 엔디언 16바이트)
+ *
+ * | magic(1) | version(1) | type(1) | flags(1) |
+ * | utteranceId(4) | sequence(4) | payloadSize(4) |
+ *
+ * sequence는 연결(한 워커 프로세스의 파이프) 방향마다 하나의 카운터로, 송신 측이
+ * 발화와 관계없이 보내는 프레임마다 0부터 1씩 늘립니다 (2^32에서 0으로 돌아감).
+ * 수신 측은 첫 프레임을 기준으로 이를 이용해 누락/순서 뒤바뀜을 검출합니다.
+ */
+struct FrameHeader {
+    MessageType type = MessageType::AudioChunk;
+    uint8_t flags = 0;
+    uint32_t utteranceId = 0;
+    uint32_t sequence = 0;
+    uint32_t payloadSize = 0;
+};
+
+/**
+ * @brief 공유 메모리 오디오 구간 (AudioShm 페이로드, 리틀 엔디언 12바이트)
+ *
+ * | slot(4) | sampleOffset(4) | sampleCount(4) |
+ *
+ * 샘플 자체는 SharedAudioRing의 slot 영역에 있으며 파이프로는 위치만 보냅니다.
+ */
+struct ShmAudioRef {
+    uint32_t slot = 0;
+    uint32_t sampleOffset = 0;
+    uint32_t sampleCount = 0;
+};
+
+constexpr size_t kShmAudioRefSize = 12;
+
+constexpr size_t kSessionPayloadSize = 4;
+
+/**
+ * @brief 요청 ID에 담긴 캡처 세션 ID (상위 32비트)
+ *
+ * 세션마다 요청 ID 공간을 나눠 trace와 결과 로그에서 겹치지 않게 하고,
+ * 브릿지는 이 값으로 SESSION 프레임을 붙입니다. 장치가 하나이면 세션 0입니다.
+ */
+constexpr uint32_t sessionOfRequest(uint64_t requestId) {
+    return static_cast<uint32_t>(requestId >> 32);
+}
+
+/**
+ * @brief 세션의 첫 요청 ID
+ */
+constexpr uint64_t firstRequestOfSession(uint32_t session) {
+    return (static_cast<uint64_t>(session) << 32) | 1;
+}
+
+/**
+ * @brief 코덱 이름 ("pcm", "flac", "opus")
+ */
+const char* audioCodecName(AudioCodec codec);
+
+/**
+ * @brief READY 페이로드의 코덱 목록을 비트마스크로 변환
+ * @param list 쉼표로 구분된 코덱 이름 (비어 있으면 PCM만)
+ * @return (1 << AudioCodec) 비트의 합 (PCM은 항상 포함)
+ */
+uint32_t parseCodecList(const std::string& list);
+
+/**
+ * @brief 헤더 직렬화
+ * @param header 헤더
+ * @param out 출력 버퍼 (kHeaderSize 바이트)
+ */
+void encodeHeader(const FrameHeader& header, uint8_t* out);
+
+/**
+ * @brief 헤더 역직렬화
+ * @param in 입력 버퍼 (kHeaderSize 바이트)
+ * @param header 출력: 헤더
+ * @return magic/version/크기가 유효한지 여부
+ */
+bool decodeHeader(const uint8_t* in, FrameHeader& header);
+
+/**
+ * @brief 공유 메모리 오디오 구간 직렬화
+ * @param ref 구간
+ * @param out 출력 버퍼 (kShmAudioRefSize 바이트)
+ */
+void encodeShmAudioRef(const ShmAudioRef& ref, uint8_t* out);
+
+/**
+ * @brief 공유 메모리 오디오 구간 역직렬화
+ * @param in 입력 버퍼
+ * @param size 입력 크기
+ * @param ref 출력: 구간
+ * @return 크기가 올바른지 여부
+ */
+bool decodeShmAudioRef(const uint8_t* in, size_t size, ShmAudioRef& ref);
+
+/**
+ * @brief 메시지 타입 이름 (로그용)
+ */
+const char* messageTypeName(MessageType type);
+
+} // namespace protocol
+} // namespace sion
+
+#endif // BRIDGE_PROTOCOL_H
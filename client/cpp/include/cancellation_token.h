@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace sion {
+
+/**
+ * @brief 협력적 취소 토큰
+ *
+ * 한 요청에 대해 하나를 만들어 캡처/브릿지/파이프라인에 전달합니다.
+ * 블로킹 대기 중인 쪽은 registerCallback()으로 깨우는 방법(조건 변수 notify,
+ * CANCEL 프레임 전송 등)을 등록해 두고, cancel()은 어느 스레드에서든
+ * 즉시 이를 실행합니다. 폴링 없이 취소가 전달되므로 지연은 콜백 실행 시간뿐입니다.
+ */
+class CancellationToken {
+public:
+    using Callback = std::function<void()>;
+
+    CancellationToken();
+
+    // 복사 금지 (콜백 목록을 공유해야 하므로 포인터/참조로 전달)
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    /**
+     * @brief 취소 요청 (여러 번 호출해도 콜백은 한 번만 실행)
+     */
+    void cancel();
+
+    /**
+     * @brief 취소되었는지 확인
+     */
+    bool isCancelled() const { return m_cancelled.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 취소 시 실행할 콜백 등록
+     *
+     * 이미 취소된 상태이면 호출 스레드에서 즉시 실행합니다.
+     * @param callback 콜백 (cancel()을 호출한 스레드에서 실행)
+     * @return 등록 ID (즉시 실행된 경우 0)
+     */
+    size_t registerCallback(Callback callback);
+
+    /**
+     * @brief 콜백 등록 해제
+     *
+     * 반환 후에는 콜백이 실행 중이지 않음이 보장되므로, 콜백이 참조하던
+     * 지역 변수를 안전하게 해제할 수 있습니다. 콜백 안에서 호출하지 마세요.
+     * @param id registerCallback()이 반환한 ID
+     */
+    void unregisterCallback(size_t id);
+
+private:
+    std::atomic<bool> m_cancelled;
+    std::mutex m_mutex;
+    std::mutex m_invokeMutex;   // 콜백 실행 구간 (unregister 대기용)
+    std::vector<std::pair<size_t, Callback>> m_callbacks;
+    size_t m_nextId;
+};
+
+/**
+ * @brief 범위 기반 취소 콜백 등록 (소멸 시 자동 해제)
+ */
+class ScopedCancelCallback {
+public:
+    /**
+     * @param token 취소 토큰 (nullptr이면 아무것도 하지 않음)
+     * @param callback 취소 시 실행할 콜백
+     */
+    ScopedCancelCallback(CancellationToken* token, CancellationToken::Callback callback)
+        : m_token(token)
+        , m_id(token ? token->registerCallback(std::move(callback)) : 0)
+    {
+    }
+
+    ~ScopedCancelCallback() {
+        if (m_token && m_id != 0) {
+            m_token->unregisterCallback(m_id);
+        }
+    }
+
+    ScopedCancelCallback(const ScopedCancelCallback&) = delete;
+    ScopedCancelCallback& operator=(const ScopedCancelCallback&) = delete;
+
+private:
+    CancellationToken* m_token;
+    size_t m_id;
+};
+
+} // namespace sion
+
+#endif // CANCELLATION_TOKEN_H
@@ -0,0 +1,187 @@
+#pragma once
+
+#ifndef CAPTURE_BACKEND_H
+#define CAPTURE_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "audio_capture.h"
+
+namespace sion {
+
+/**
+ * @brief 플랫폼 오디오 캡처 백엔드 인터페이스
+ *
+ * 장치를 열고, 스트림이 시작되면 고정 크기 프레임
+ * (AudioConfig::frameDurationMs) 단위로 콜백을 호출합니다.
+ * 콜백은 백엔드의 캡처 스레드에서 실행됩니다.
+ */
+class CaptureBackend {
+public:
+    virtual ~CaptureBackend() = default;
+
+    /**
+     * @brief 캡처 장치 열기
+     * @param config 오디오 설정
+     * @return 성공 여부
+     */
+    virtual bool open(const AudioConfig& config) = 0;
+
+    /**
+     * @brief 스트림 시작
+     * @param onFrame 프레임 도착 시 호출될 콜백 (캡처 스레드)
+     * @return 성공 여부
+     */
+    virtual bool start(AudioCallback onFrame) = 0;
+
+    /**
+     * @brief 스트림 중지 (캡처 스레드 종료까지 대기)
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @brief 장치 닫기
+     */
+    virtual void close() = 0;
+
+    /**
+     * @brief 장치가 열려 있는지 확인
+     */
+    virtual bool isOpen() const = 0;
+
+    /**
+     * @brief 백엔드 이름 (로그용)
+     */
+    virtual const char* name() const = 0;
+};
+
+/**
+ * @brief 장치 패킷을 고정 크기 프레임으로 재분할
+ *
+ * 장치 주기와 frameDurationMs가 달라도 콜백에는 항상 같은 크기의 프레임이
+ * 전달되도록 합니다. 프레임 경계가 맞는 패킷은 복사 없이 그대로 뷰로 넘깁니다.
+ * 캡처 스레드 전용이며, configure() 이후에는 할당하지 않습니다.
+ */
+class FrameAssembler {
+public:
+    /**
+     * @brief 프레임 크기 설정 (채워진 샘플 폐기)
+     * @param frameSamples 프레임당 샘플 수 (인터리브)
+     */
+    void configure(size_t frameSamples);
+
+    /**
+     * @brief 샘플 추가 (프레임이 찰 때마다 onFrame 호출)
+     * @param samples 샘플 포인터 (nullptr이면 무음)
+     * @param count 샘플 수
+     * @param onFrame 프레임 콜백
+     */
+    void append(const int16_t* samples, size_t count, const AudioCallback& onFrame);
+
+    /**
+     * @brief 프레임당 샘플 수
+     */
+    size_t frameSamples() const { return m_frameSamples; }
+
+private:
+    std::vector<int16_t> m_frame;
+    size_t m_frameSamples = 0;
+    size_t m_frameFill = 0;
+};
+
+/**
+ * @brief 캡처 장치 정보
+ */
+struct CaptureDeviceInfo {
+    std::string id;              // AudioConfig::device에 넣을 값 (WASAPI 엔드포인트 ID, ALSA PCM 이름, CoreAudio UID)
+    std::string name;            // 사용자에게 보여줄 이름
+    bool isDefault = false;      // 기본 캡처 장치 여부
+};
+
+/**
+ * @brief 빌드된 플랫폼 백엔드의 캡처 장치 목록
+ *
+ * 플랫폼 백엔드가 없는 빌드에서는 빈 목록을 반환합니다 ("null"과 "file:<경로>"는 항상 사용 가능).
+ */
+std::vector<CaptureDeviceInfo> enumerateCaptureDevices();
+
+/**
+ * @brief 설정과 빌드에 맞는 캡처 백엔드 생성
+ *
+ * 빌드 시 선택된 플랫폼 백엔드(Windows: WASAPI, Linux: ALSA, macOS: CoreAudio)를
+ * 반환하고, 플랫폼 백엔드가 없는 빌드이거나 AudioConfig::device가 "null"이면
+ * 무음 프레임을 실시간 속도로 생성하는 더미 백엔드를 반환합니다
+ * (장치가 없는 헤드리스 테스트 환경용). "file:<경로>"는 WAV 파일 재생 백엔드이며,
+ * "file:<세그먼트>.sionj#<번호>"는 발화 저널에 기록된 발화를 재생합니다.
+ * @param config 오디오 설정
+ */
+std::unique_ptr<CaptureBackend> createCaptureBackend(const AudioConfig& config);
+
+/**
+ * @brief 무음 프레임 더미 백엔드 생성
+ */
+std::unique_ptr<CaptureBackend> createNullBackend();
+
+/**
+ * @brief 파일 재생 백엔드 생성 (start()마다 처음부터 실시간 속도로 재생, 이후 무음)
+ * @param path 16비트 PCM WAV 경로 또는 저널 레코드 (loadReplayAudio(), 레이트/채널이 다르면 open()에서 변환)
+ */
+std::unique_ptr<CaptureBackend> createReplayBackend(const std::string& path);
+
+/**
+ * @brief 16비트 PCM WAV 파일을 모노 샘플로 읽기 (레이트/채널이 다르면 AudioResampler로 변환)
+ * @param path WAV 파일 경로
+ * @param outputRate 출력 샘플링 레이트 (Hz)
+ * @param out 출력: 샘플
+ * @return 성공 여부
+ */
+bool loadWavFile(const std::string& path, int outputRate, std::vector<int16_t>& out);
+
+/**
+ * @brief 재생 소스 읽기: WAV 파일 또는 발화 저널 레코드 ("<세그먼트>.sionj#<레코드 번호>")
+ * @param source WAV 경로 또는 저널 레코드
+ * @param outputRate 출력 샘플링 레이트 (Hz, 다르면 AudioResampler로 변환)
+ * @param out 출력: 샘플
+ * @return 성공 여부
+ */
+bool loadReplayAudio(const std::string& source, int outputRate, std::vector<int16_t>& out);
+
+#if defined(_WIN32)
+/**
+ * @brief WASAPI 이벤트 기반 백엔드 생성 (wasapi_capture.cpp)
+ */
+std::unique_ptr<CaptureBackend> createWasapiBackend();
+
+/**
+ * @brief 활성 WASAPI 캡처 엔드포인트 목록 (wasapi_capture.cpp)
+ */
+std::vector<CaptureDeviceInfo> enumerateWasapiDevices();
+#elif defined(SION_HAVE_ALSA)
+/**
+ * @brief ALSA PCM 백엔드 생성 (alsa_capture.cpp)
+ */
+std::unique_ptr<CaptureBackend> createAlsaBackend();
+
+/**
+ * @brief ALSA 캡처 PCM 이름 목록 (alsa_capture.cpp)
+ */
+std::vector<CaptureDeviceInfo> enumerateAlsaDevices();
+#elif defined(__APPLE__)
+/**
+ * @brief CoreAudio AudioQueue 백엔드 생성 (coreaudio_capture.cpp)
+ */
+std::unique_ptr<CaptureBackend> createCoreAudioBackend();
+
+/**
+ * @brief 입력 스트림이 있는 CoreAudio 장치 목록 (coreaudio_capture.cpp)
+ */
+std::vector<CaptureDeviceInfo> enumerateCoreAudioDevices();
+#endif
+
+} // namespace sion
+
+#endif // CAPTURE_BACKEND_H
@@ -3,11 +3,15 @@
 #ifndef HOTKEY_HANDLER_H
 #define HOTKEY_HANDLER_H
 
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
 #include <atomic>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -15,11 +19,43 @@
 
 namespace sion {
 
+class CancellationToken;
+
 /**
  * @brief 핫키 이벤트 콜백 타입
  */
 using HotkeyCallback = std::function<void()>;
 
+/**
+ * @brief 키 이벤트 종류
+ */
+enum class KeyEventType {
+    Pressed,
+    Released
+};
+
+/**
+ * @brief 누름/뗌 핫키 이벤트
+ */
+struct HotkeyEvent {
+    int hotkeyId;
+    KeyEventType type;
+    std::chrono::steady_clock::time_point timestamp;   // 훅에서 받은 시각 (QPC 기반)
+};
+
+/**
+ * @brief 누름/뗌 이벤트 콜백 타입
+ */
+using HotkeyEventCallback = std::function<void(const HotkeyEvent&)>;
+
+/**
+ * @brief 핫키 입력 방식
+ */
+enum class HotkeyBackend {
+    RegisterHotKey,   // Windows: WM_HOTKEY (누름만 전달)
+    LowLevelHook      // Windows: WH_KEYBOARD_LL (누름과 뗌 모두 전달)
+};
+
 /**
  * @brief 핫키 식별자
  */
@@ -34,13 +70,33 @@ struct HotkeyId {
  * 
  * Windows API를 사용하여 시스템 전역 핫키를 등록하고
  * 해당 핫키가 눌렸을 때 콜백을 실행합니다.
+ *
+ * HotkeyBackend::LowLevelHook을 선택하면 RegisterHotKey 대신 리스너 스레드에
+ * 저수준 키보드 훅을 설치하여 키를 뗄 때도 이벤트를 받으므로 푸시투토크
+ * (registerPushToTalk())를 쓸 수 있습니다. 훅 콜백은 시스템 제한 시간
+ * (LowLevelHooksTimeout) 안에 끝나야 하므로 등록한 콜백은 즉시 반환해야 합니다.
+ *
+ * 다른 플랫폼은 두 백엔드 모두 누름/뗌을 받는 같은 경로를 사용합니다.
+ * - Linux: X 디스플레이에 접속할 수 있으면 XGrabKey 패시브 그랩(키를 다른 앱에 전달하지 않음),
+ *   없으면(헤드리스, Wayland 전용 세션) /dev/input/event* evdev 장치를 직접 읽습니다.
+ *   evdev는 input 그룹 권한이 필요하고 키를 삼키지 않습니다.
+ * - macOS: CGEventTap (손쉬운 사용 권한 필요)
+ *
+ * 등록/해제/변경은 어느 스레드에서든, 리스너 실행 중에도 할 수 있습니다.
+ * 핫키 표는 copy-on-write로 관리하며, 변경할 때마다 새 표를 만들어 버전과 함께 게시합니다.
+ * 리스너는 버전이 바뀐 경우에만 새 표를 가져오므로 키 이벤트 처리에는 락이 없습니다.
+ * RegisterHotKey와 X11 그랩처럼 스레드/디스플레이에 묶이는 OS 등록은 리스너 스레드가
+ * 시작할 때와 변경 알림(Windows 스레드 메시지, Linux eventfd)을 받을 때 표에 맞춰 갱신합니다.
+ * 따라서 RegisterHotKey 실패(다른 프로그램이 사용 중)는 반환값이 아니라 로그로 알립니다.
+ * 눌린 상태에서 해제/변경된 푸시투토크 핫키에는 Released를 대신 전달합니다.
  */
 class HotkeyHandler {
 public:
     /**
      * @brief 생성자
+     * @param backend 핫키 입력 방식
      */
-    HotkeyHandler();
+    explicit HotkeyHandler(HotkeyBackend backend = HotkeyBackend::RegisterHotKey);
 
     /**
      * @brief 소멸자 - 등록된 모든 핫키 해제
@@ -59,6 +115,30 @@ public:
      */
     int registerHotkey(const std::string& hotkeyString, HotkeyCallback callback);
 
+    /**
+     * @brief 누름/뗌 핫키 등록 (LowLevelHook 백엔드 전용)
+     *
+     * 자동 반복 입력은 무시하므로 키를 누르고 있는 동안 Pressed 한 번,
+     * 메인 키를 뗄 때 Released 한 번이 전달됩니다.
+     * @param hotkeyString 핫키 문자열 (예: "ctrl+shift+space")
+     * @param callback 이벤트 콜백 (훅 스레드에서 호출)
+     * @return 성공 시 핫키 ID, 실패 시 -1
+     */
+    int registerPushToTalk(const std::string& hotkeyString, HotkeyEventCallback callback);
+
+    /**
+     * @brief 등록된 핫키의 키 조합 변경 (ID와 콜백 유지, 리스너 실행 중에도 가능)
+     * @param hotkeyId 등록 시 반환받은 핫키 ID
+     * @param hotkeyString 새 핫키 문자열
+     * @return 성공 여부 (파싱 실패, 없는 ID, 다른 핫키와 겹치면 false)
+     */
+    bool rebindHotkey(int hotkeyId, const std::string& hotkeyString);
+
+    /**
+     * @brief 핫키 입력 방식
+     */
+    HotkeyBackend backend() const { return m_backend; }
+
     /**
      * @brief 핫키 해제
      * @param hotkeyId 등록 시 반환받은 핫키 ID
@@ -73,8 +153,12 @@ public:
 
     /**
      * @brief 핫키 리스너 시작 (블로킹)
+     *
+     * stopListening() 또는 stop 취소 시 반환합니다. 시그널로는 돌아오지 않으므로
+     * 종료 시그널은 stop 토큰으로 전달하세요 (cancel()은 어느 스레드에서든 호출 가능).
+     * @param stop 종료 토큰 (nullptr이면 stopListening()으로만 중지)
      */
-    void startListening();
+    void startListening(CancellationToken* stop = nullptr);
 
     /**
      * @brief 핫키 리스너 시작 (논블로킹, 별도 스레드)
@@ -82,7 +166,7 @@ public:
     void startListeningAsync();
 
     /**
-     * @brief 핫키 리스너 중지
+     * @brief 핫키 리스너 중지 (비동기 리스너면 종료까지 대기)
      */
     void stopListening();
 
@@ -101,19 +185,131 @@ private:
      */
     bool parseHotkeyString(const std::string& hotkeyString, int& modifiers, int& keyCode);
 
+    /**
+     * @brief 디스패치 항목 (게시된 뒤에는 바뀌지 않음)
+     */
+    struct HotkeyEntry {
+        HotkeyId key;
+        HotkeyCallback callback;
+        HotkeyEventCallback eventCallback;
+    };
+    using HotkeyTable = std::vector<HotkeyEntry>;
+    using TablePtr = std::shared_ptr<const HotkeyTable>;
+
+    /**
+     * @brief 핫키 공통 등록 (표에 추가, OS 등록은 리스너 스레드가 수행)
+     */
+    int addHotkey(const std::string& hotkeyString, HotkeyCallback callback,
+                  HotkeyEventCallback eventCallback);
+
+    /**
+     * @brief 현재 표를 복사해 수정한 뒤 게시하고 리스너에 알림 (쓰기 쪽, 어느 스레드든)
+     * @param mutate 표 수정 함수 (false를 반환하면 게시하지 않음, m_tableMutex 안에서 호출)
+     * @return 게시 여부
+     */
+    bool updateTable(const std::function<bool(HotkeyTable&)>& mutate);
+
+    /**
+     * @brief 리스너 스레드의 표 스냅샷 (버전이 바뀐 경우에만 락을 잡고 새로 가져옴)
+     *
+     * 새 표에서 없어지거나 키가 바뀐 눌린 핫키에는 Released를 전달합니다.
+     */
+    TablePtr listenerTable();
+
+    /**
+     * @brief 리스너를 깨워 OS 등록을 표와 맞추게 함
+     */
+    void notifyListener();
+
     /**
      * @brief 메시지 루프 (Windows)
      */
     void messageLoop();
 
-    std::unordered_map<int, HotkeyCallback> m_callbacks;
-    std::unordered_map<int, HotkeyId> m_hotkeys;
+    /**
+     * @brief 키 이벤트를 등록된 핫키와 매칭해 콜백 호출 (리스너 스레드)
+     *
+     * 누름은 수정자가 정확히 일치할 때만, 뗌은 수정자와 무관하게 메인 키로 판정합니다.
+     * @param keyCode 플랫폼 키 코드 (parseHotkeyString()과 같은 체계)
+     * @param modifiers 현재 눌린 수정자 플래그
+     * @param down 누름 여부
+     * @return 이벤트를 삼켰는지 여부 (등록된 핫키의 메인 키)
+     */
+    bool handleKeyEvent(int keyCode, int modifiers, bool down);
+
+    /**
+     * @brief 실행 플래그를 내리고 리스너 대기 깨우기 (join 없음, 어느 스레드에서든 호출 가능)
+     */
+    void interruptListener();
+
+#if defined(_WIN32)
+    static LRESULT CALLBACK lowLevelKeyboardProc(int code, WPARAM wParam, LPARAM lParam);
+
+    /**
+     * @brief RegisterHotKey 등록을 현재 표와 맞춤 (리스너 스레드, 등록이 스레드 큐에 묶임)
+     */
+    void syncRegistrations();
+
+    /**
+     * @brief 리스너 스레드에서 등록한 RegisterHotKey 모두 해제
+     */
+    void releaseRegistrations();
+#elif defined(__linux__)
+    /**
+     * @brief X11 패시브 그랩 루프
+     * @return 디스플레이 접속 성공 여부 (실패 시 evdev로 대체)
+     */
+    bool runX11Loop();
+
+    /**
+     * @brief evdev 장치 읽기 루프
+     */
+    void runEvdevLoop();
+
+    /**
+     * @brief 쌓인 깨우기 신호(중지 요청, 표 변경 알림) 비우기
+     */
+    void drainWake();
+#endif
+
+#if !defined(_WIN32)
+    /**
+     * @brief 중지 요청이 올 때까지 대기 (입력을 받을 수 없을 때)
+     */
+    void waitForWake();
+#endif
+
+    HotkeyBackend m_backend;
     std::atomic<bool> m_running;
     std::thread m_listenerThread;
+
+    // 쓰기 쪽 (m_tableMutex로 직렬화)
+    std::mutex m_tableMutex;
+    TablePtr m_table;                        // 최신 표
+    std::atomic<uint64_t> m_tableVersion;    // 게시할 때마다 증가 (리스너는 이것만 확인)
     int m_nextId;
 
-#ifdef _WIN32
+    // 리스너 스레드 전용
+    TablePtr m_listenerTable;
+    uint64_t m_listenerVersion;
+    std::vector<int> m_pressed;              // 눌려 있는 핫키 ID (자동 반복 무시, 뗌 판정)
+
+#if defined(_WIN32)
     HWND m_hwnd;
+    HHOOK m_hook;
+    std::atomic<DWORD> m_listenerThreadId;   // 메시지 루프 스레드 (WM_QUIT/변경 알림 전달용)
+    std::vector<std::pair<HotkeyId, bool>> m_osHotkeys;   // 리스너 스레드: RegisterHotKey 시도 (second: 성공)
+#elif defined(__linux__)
+    bool m_useX11;                   // 생성 시 디스플레이 접속 가능 여부 (키 코드 체계 결정)
+    int m_wakeFd;                    // 리스너 poll 깨우기 (eventfd)
+#elif defined(__APPLE__)
+    void* m_eventTap;                // CFMachPortRef
+    void* m_runLoop;                 // 리스너 스레드의 CFRunLoopRef (m_wakeMutex로 보호)
+    void* m_wakeSource;              // 중지 요청용 CFRunLoopSourceRef (m_wakeMutex로 보호)
+#endif
+#if !defined(_WIN32) && !defined(__linux__)
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;    // waitForWake() 깨우기
 #endif
 };
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef JSON_UTIL_H
+#define JSON_UTIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace sion {
+namespace json {
+
+/**
+ * @brief JSON 문자열 리터럴로 이스케이프 (따옴표 포함)
+ */
+std::string quote(const std::string& text);
+
+/**
+ * @brief 최상위 객체에서 "key": 뒤의 값 시작 위치 찾기
+ *
+ * 중첩된 객체/배열과 문자열 안은 건너뛰므로 같은 이름의 하위 키와 혼동하지 않습니다.
+ * @return 값 첫 글자 위치 (없으면 npos)
+ */
+size_t findValue(const std::string& json, const char* key);
+
+/**
+ * @brief 최상위 문자열 값 (이스케이프와 \\u 서로게이트 쌍 해석)
+ * @return 키가 있고 값이 문자열인지 여부
+ */
+bool getString(const std::string& json, const char* key, std::string& out);
+
+/**
+ * @brief 최상위 부호 없는 정수 값
+ * @return 키가 있고 값이 숫자인지 여부
+ */
+bool getUint(const std::string& json, const char* key, uint64_t& out);
+
+/**
+ * @brief 최상위 값의 원문 (객체/배열/문자열/숫자/리터럴 그대로)
+ * @return 키가 있고 값이 끝까지 온전한지 여부
+ */
+bool getRaw(const std::string& json, const char* key, std::string& out);
+
+} // namespace json
+} // namespace sion
+
+#endif // JSON_UTIL_H
@@ -0,0 +1,131 @@
+#pragma once
+
+#ifndef KEYWORD_SPOTTER_H
+#define KEYWORD_SPOTTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "log_mel_frontend.h"
+
+namespace sion {
+
+/**
+ * @brief int8 양자화 키워드 인식 모델 (작은 CNN)
+ *
+ * 로그 멜 특징 창([numFrames][numMels], 채널 1)을 입력받아 키워드 확률을 계산합니다.
+ * 가중치와 활성값은 영점 0의 대칭 int8이며, 누적은 int32(kernels::dotProductInt8)로
+ * 하고 채널별 배율로 다시 양자화합니다. 작업 버퍼는 load()에서 모두 할당하므로
+ * infer()는 할당 없이 동작합니다.
+ *
+ * 모델 파일 형식 (리틀 엔디안, scripts/export_kws_model.py가 생성):
+ *   헤더: "SKWS", version(u32=1), sampleRate, frameLength, hopLength, fftSize (u32),
+ *         lowHz, highHz (f32), numFrames, numMels (u32), inputMean, inputScale (f32),
+ *         threshold (f32), smoothing (u32), keywordIndex (u32), layerCount (u32)
+ *   레이어: type(u32) 다음에
+ *     1 Conv2D (valid 패딩, HWC): outC, kh, kw, strideH, strideW, relu (u32), outScale (f32),
+ *              int8 weights[outC][kh][kw][inC], f32 scales[outC], i32 bias[outC]
+ *     2 Dense:  outC, relu (u32), outScale (f32), int8 weights[outC][in], f32 scales[outC], i32 bias[outC]
+ *     3 GlobalAvgPool: 추가 필드 없음
+ *   마지막 레이어는 Dense이며 출력(로짓)에 softmax를 적용합니다.
+ */
+class KeywordSpotter {
+public:
+    KeywordSpotter();
+
+    /**
+     * @brief 모델 파일 로드 및 작업 버퍼 할당
+     * @param path 모델 파일 경로
+     * @return 성공 여부
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief 모델이 로드되었는지 확인
+     */
+    bool isLoaded() const { return !m_layers.empty(); }
+
+    /**
+     * @brief 모델이 학습된 특징 추출 설정
+     */
+    const LogMelConfig& frontendConfig() const { return m_frontend; }
+
+    /**
+     * @brief 입력 창의 프레임 수
+     */
+    size_t numFrames() const { return m_numFrames; }
+
+    /**
+     * @brief 검출 임계값 (평활화된 확률 기준)
+     */
+    float threshold() const { return m_threshold; }
+
+    /**
+     * @brief 평활화에 사용할 연속 추론 횟수
+     */
+    size_t smoothing() const { return m_smoothing; }
+
+    /**
+     * @brief 로그 멜 프레임 하나를 모델 입력 스케일로 양자화
+     * @param mels numMels개의 로그 멜 값
+     * @param out numMels개의 int8 출력
+     */
+    void quantizeFrame(const float* mels, int8_t* out) const;
+
+    /**
+     * @brief 입력 버퍼 ([numFrames][numMels], 오래된 프레임부터 채움)
+     */
+    int8_t* input() { return m_activations[0].data(); }
+
+    /**
+     * @brief 입력 버퍼로 추론 (할당 없음)
+     * @return 키워드 확률 (0.0 ~ 1.0)
+     */
+    float infer();
+
+private:
+    enum class LayerType : uint32_t {
+        Conv2D = 1,
+        Dense = 2,
+        GlobalAvgPool = 3
+    };
+
+    /**
+     * @brief 레이어 하나 (Dense는 1x1 공간에 대한 Conv2D와 같은 배치)
+     */
+    struct Layer {
+        LayerType type;
+        size_t inH, inW, inC;
+        size_t outH, outW, outC;
+        size_t kernelH, kernelW;
+        size_t strideH, strideW;
+        bool relu;
+        std::vector<int8_t> weights;     // [outC][kernelH][kernelW][inC]
+        std::vector<int32_t> bias;       // 입력 스케일 * 가중치 스케일 단위
+        std::vector<float> multiplier;   // int32 누적 → 출력 int8 배율
+        std::vector<float> dequant;      // int32 누적 → 실수 배율 (마지막 레이어)
+    };
+
+    void runConv(const Layer& layer, const int8_t* in, int8_t* out);
+    void runDense(const Layer& layer, const int8_t* in, int8_t* out, bool last);
+    static void runGlobalAvgPool(const Layer& layer, const int8_t* in, int8_t* out);
+
+    LogMelConfig m_frontend;
+    size_t m_numFrames;
+    float m_inputMean;
+    float m_inputInvScale;
+    float m_threshold;
+    size_t m_smoothing;
+    size_t m_keywordIndex;
+
+    std::vector<Layer> m_layers;
+    std::vector<int8_t> m_activations[2];   // 레이어 입출력 교대 버퍼
+    std::vector<int8_t> m_patch;            // Conv2D 한 위치의 입력 패치 (im2col)
+    std::vector<float> m_logits;
+};
+
+} // namespace sion
+
+#endif // KEYWORD_SPOTTER_H
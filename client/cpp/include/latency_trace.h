@@ -0,0 +1,246 @@
+#pragma once
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sion {
+namespace trace {
+
+/**
+ * @brief 계측 구간 (음성 명령 한 건의 단계)
+ */
+enum class Stage : uint8_t {
+    HotkeyReceived,   // 핫키 이벤트 → 요청 제출 완료
+    DeviceOpen,       // 장치 열기 / 스트림 시작
+    FirstFrame,       // 녹음 시작 → 첫 프레임 기록
+    EndOfSpeech,      // 녹음 시작 → 발화 종료 (VAD 엔드포인트, 키 뗌, 최대 길이)
+    Encode,           // 코덱 인코딩 (발화 전체 합계)
+    BridgeSend,       // 전송 시작 → END_OF_UTTERANCE 기록
+    FirstPartial,     // 전송 시작 → 첫 중간 결과 수신
+    FinalResult,      // 전송 시작 → 최종 결과 수신
+    AsrTranscript,    // ASR 직접 연결: 스트림 시작 → 최종 인식 텍스트
+    LocalAsr,         // 로컬 ASR: 추론 요청 → 인식 텍스트 (대기 시간 포함)
+    EndToEnd,         // 요청 제출 → 결과 콜백
+    Count
+};
+
+constexpr size_t kStageCount = static_cast<size_t>(Stage::Count);
+
+/**
+ * @brief 구간 이름 (리포트/Chrome trace용, 예: "first-frame")
+ */
+const char* stageName(Stage stage);
+
+/**
+ * @brief 이벤트 카운터 (구간이 없는 계측: 캐시 적중/실패 등)
+ */
+enum class Counter : uint8_t {
+    TranscriptCacheHit,     // 인식 텍스트 → NLU 의도 캐시 적중 (NLU 생략)
+    TranscriptCacheMiss,
+    FingerprintCacheHit,    // 오디오 지문 → 인식 텍스트 캐시 적중 (ASR 생략)
+    FingerprintCacheMiss,
+    SpeculativeNluSent,     // 중간 인식 텍스트로 보낸 추측 NLU 요청 (SPECULATE)
+    LocalAsrRouted,         // 로컬 ASR 엔진으로 인식한 발화
+    LocalAsrFallback,       // 로컬 인식 실패로 원격 ASR에 다시 보낸 발화
+    JournalWritten,         // 발화 저널에 기록한 발화
+    JournalDropped,         // 대기 상한/디스크 오류로 저널에 기록하지 못한 발화
+    CaptureOverrunSamples,  // 녹음 링 버퍼가 가득 차 버린 샘플 수
+    WorkerRestart,          // 감시 스레드가 다시 띄운 Python 워커
+    Count
+};
+
+constexpr size_t kCounterCount = static_cast<size_t>(Counter::Count);
+
+/**
+ * @brief 카운터 이름 (리포트용, 예: "transcript-cache-hit")
+ */
+const char* counterName(Counter counter);
+
+/**
+ * @brief 단조 시각 (ns)
+ *
+ * steady_clock 기반이며 Windows에서는 QueryPerformanceCounter를 사용합니다.
+ */
+inline int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief steady_clock 시각을 now()와 같은 단위로 변환
+ */
+inline int64_t toNanoseconds(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+/**
+ * @brief 구간 기록
+ *
+ * 호출 스레드 전용 버퍼에 기록하므로 락과 할당이 없습니다 (스레드당 첫 호출 제외).
+ * 오디오 캡처 스레드에서도 호출할 수 있습니다. 버퍼가 차면 가장 오래된 구간을
+ * 덮어쓰지만 히스토그램에는 모든 구간이 누적됩니다.
+ * @param stage 구간
+ * @param requestId 요청 ID (0이면 요청과 무관)
+ * @param startNs 시작 시각 (now())
+ * @param endNs 종료 시각 (now())
+ */
+void record(Stage stage, uint64_t requestId, int64_t startNs, int64_t endNs);
+
+/**
+ * @brief 카운터 증가 (락 없음, 아무 스레드에서나 호출 가능)
+ * @param counter 카운터
+ * @param delta 증가량
+ */
+void increment(Counter counter, uint64_t delta = 1);
+
+/**
+ * @brief 카운터 현재 값 (프로세스 시작 이후 누적)
+ */
+uint64_t counterValue(Counter counter);
+
+/**
+ * @brief 계측 켜기/끄기 (기본 켜짐, 꺼져 있으면 record()/increment()는 즉시 반환)
+ */
+void setEnabled(bool enabled);
+
+/**
+ * @brief 계측이 켜져 있는지 확인
+ */
+bool isEnabled();
+
+/**
+ * @brief 현재 스레드가 처리 중인 요청 ID (RequestScope로 설정, 없으면 0)
+ *
+ * 요청 ID를 모르는 하위 모듈(AudioCapture, PythonProcessBridge)이 구간을
+ * 요청에 연결할 때 사용합니다.
+ */
+uint64_t currentRequest();
+
+/**
+ * @brief 요청 하나의 구간별 지연 (버퍼에 남은 구간만 대상, 같은 구간이 여럿이면 합계)
+ *
+ * 모든 스레드 버퍼를 훑으므로 기록 경로가 아닌 곳(발화 저널 스레드 등)에서 호출합니다.
+ * @param requestId 요청 ID
+ * @return 구간 순서대로 kStageCount개 (ns, 기록이 없으면 0)
+ */
+std::array<int64_t, kStageCount> requestDurations(uint64_t requestId);
+
+/**
+ * @brief 구간 통계 (ms)
+ */
+struct StageStats {
+    Stage stage;
+    uint64_t count = 0;
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+/**
+ * @brief 모든 스레드의 히스토그램을 합산한 구간별 통계
+ *
+ * 백분위는 로그 선형 히스토그램(2배 구간당 8칸, 상대 오차 약 12%)의 버킷 상한입니다.
+ * @return 구간 순서대로 kStageCount개
+ */
+std::vector<StageStats> summarize();
+
+/**
+ * @brief 구간 누적 분포 (Prometheus 히스토그램용)
+ */
+struct StageDistribution {
+    Stage stage;
+    uint64_t count = 0;
+    double sumMs = 0.0;
+    std::vector<uint64_t> cumulative;   // boundsMs마다 그 이하인 구간 수
+};
+
+/**
+ * @brief 모든 스레드의 히스토그램을 고정 상한으로 합산한 구간별 누적 분포
+ *
+ * 로그 선형 버킷의 상한이 경계 이하인 버킷만 세므로 경계 근처 값은 다음 칸으로 갈 수 있습니다
+ * (상대 오차 약 12%, summarize()의 백분위와 같은 정밀도).
+ * @param boundsMs 버킷 상한 (ms, 오름차순)
+ * @return 구간 순서대로 kStageCount개
+ */
+std::vector<StageDistribution> distributions(const std::vector<double>& boundsMs);
+
+/**
+ * @brief 구간별 p50/p95/p99와 카운터 리포트 출력 (기록이 없는 구간/카운터는 생략)
+ */
+void printReport(std::ostream& out);
+
+/**
+ * @brief 버퍼에 남은 구간을 Chrome trace-event JSON으로 저장
+ *
+ * chrome://tracing 또는 Perfetto에서 열 수 있으며 스레드별 트랙에 표시됩니다.
+ * @param path 출력 파일 경로
+ * @return 성공 여부
+ */
+bool writeChromeTrace(const std::string& path);
+
+/**
+ * @brief 범위 구간 (소멸 또는 end() 시 기록)
+ */
+class Span {
+public:
+    explicit Span(Stage stage, uint64_t requestId = currentRequest())
+        : m_stage(stage)
+        , m_requestId(requestId)
+        , m_start(now())
+    {
+    }
+
+    ~Span() {
+        end();
+    }
+
+    // 복사 금지
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    /**
+     * @brief 구간 종료 (두 번째 호출부터 무시)
+     */
+    void end() {
+        if (m_start != 0) {
+            record(m_stage, m_requestId, m_start, now());
+            m_start = 0;
+        }
+    }
+
+private:
+    Stage m_stage;
+    uint64_t m_requestId;
+    int64_t m_start;
+};
+
+/**
+ * @brief 현재 스레드의 요청 ID 설정 (소멸 시 이전 값 복원)
+ */
+class RequestScope {
+public:
+    explicit RequestScope(uint64_t requestId);
+    ~RequestScope();
+
+    // 복사 금지
+    RequestScope(const RequestScope&) = delete;
+    RequestScope& operator=(const RequestScope&) = delete;
+
+private:
+    uint64_t m_previous;
+};
+
+} // namespace trace
+} // namespace sion
+
+#endif // LATENCY_TRACE_H
@@ -0,0 +1,116 @@
+#pragma once
+
+#ifndef LOCAL_ASR_H
+#define LOCAL_ASR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cancellation_token.h"
+#include "thread_pool.h"
+
+namespace sion {
+
+/**
+ * @brief 로컬 ASR 설정
+ */
+struct LocalAsrConfig {
+    std::string modelPath;        // whisper.cpp ggml 모델 (예: ggml-tiny-q5_1.bin, 비어 있으면 사용 안 함)
+    std::string language = "ko";  // 인식 언어 ("auto"면 자동 감지)
+    size_t threads = 0;           // 추론 스레드 수 (0이면 물리 코어 수)
+    int maxLocalMs = 5000;        // 이보다 짧은 발화(짧은 명령)는 로컬 우선, 긴 받아쓰기는 원격
+    bool gpu = false;             // whisper.cpp가 GPU 백엔드로 빌드된 경우 사용
+};
+
+/**
+ * @brief 클라이언트 내장 로컬 ASR (whisper.cpp)
+ *
+ * 원격 ASR(backend/asr)이 멀거나 내려가 있을 때도 인식할 수 있도록 양자화된
+ * tiny/base 모델을 프로세스 안에서 실행합니다. 짧은 명령은 네트워크 왕복보다
+ * 로컬 추론이 빠르므로 route()가 발화 길이와 원격 연결 상태로 요청마다 경로를 고릅니다.
+ *
+ * 모델 파일은 메모리 매핑해 읽고(스트림 복사 없이 페이지 캐시에서 바로 적재),
+ * 컨텍스트와 추론 상태는 load()에서 한 번 만들어 발화마다 재사용합니다.
+ * 추론은 전용 스레드에서 한 번에 하나씩 실행하며, 발화 하나를 물리 코어 수만큼의
+ * 스레드로 나눠 계산합니다 (하이퍼스레드 형제 코어는 행렬 연산에서 이득이 없음).
+ * whisper.cpp 없이 빌드하면(SION_HAVE_WHISPER 미정의) load()는 항상 false입니다.
+ */
+class LocalAsrEngine {
+public:
+    /**
+     * @brief 생성자
+     * @param config 엔진 설정
+     */
+    explicit LocalAsrEngine(LocalAsrConfig config);
+
+    /**
+     * @brief 소멸자 - 진행 중인 추론을 마친 뒤 모델 해제
+     */
+    ~LocalAsrEngine();
+
+    // 복사 금지
+    LocalAsrEngine(const LocalAsrEngine&) = delete;
+    LocalAsrEngine& operator=(const LocalAsrEngine&) = delete;
+
+    /**
+     * @brief 빌드에 whisper.cpp가 포함되었는지 확인
+     */
+    static bool isAvailable();
+
+    /**
+     * @brief 모델 로드 후 무음으로 한 번 예열 (예열은 추론 스레드에서 비동기로)
+     * @return 성공 여부
+     */
+    bool load();
+
+    /**
+     * @brief 모델이 로드되었는지 확인
+     */
+    bool isLoaded() const { return m_context != nullptr; }
+
+    /**
+     * @brief 발화를 로컬에서 인식할지 결정
+     * @param sampleCount 샘플 수
+     * @param sampleRate 샘플링 레이트 (16 kHz가 아니면 원격)
+     * @param remoteReachable 원격 ASR에 연결되어 있는지 (아니면 길이와 관계없이 로컬)
+     * @return 로컬 인식 여부
+     */
+    bool route(size_t sampleCount, int sampleRate, bool remoteReachable) const;
+
+    /**
+     * @brief 인식 요청 (샘플은 호출 중에 복사하므로 반환 즉시 버퍼 재사용 가능)
+     * @param samples PCM s16le 모노 16 kHz 샘플
+     * @param sampleCount 샘플 수
+     * @param cancel 취소 토큰 (선택, 추론 중에도 확인하여 중단)
+     * @return 인식 텍스트 future (실패/취소/무음이면 빈 문자열)
+     */
+    std::future<std::string> transcribe(const int16_t* samples, size_t sampleCount,
+                                        std::shared_ptr<CancellationToken> cancel = nullptr);
+
+    /**
+     * @brief 추론 스레드 수
+     */
+    size_t threads() const { return m_threads; }
+
+    /**
+     * @brief 진행 중인 추론을 마치고 추론 스레드 종료
+     */
+    void stop();
+
+private:
+    std::string run(const std::vector<float>& samples, CancellationToken* cancel);
+
+    LocalAsrConfig m_config;
+    size_t m_threads;
+    void* m_context;              // whisper_context (헤더에 whisper.h를 노출하지 않음)
+    void* m_state;                // whisper_state (추론 스레드 전용)
+    ThreadPool m_inference;       // 추론 큐 (스레드 1개, whisper 상태가 하나이므로)
+};
+
+} // namespace sion
+
+#endif // LOCAL_ASR_H
@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef LOG_MEL_FRONTEND_H
+#define LOG_MEL_FRONTEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sion {
+
+/**
+ * @brief 로그 멜 특징 추출 설정
+ */
+struct LogMelConfig {
+    int sampleRate = 16000;      // 샘플링 레이트 (Hz)
+    int frameLength = 400;       // 분석 창 길이 (샘플, 25 ms)
+    int hopLength = 160;         // 프레임 간격 (샘플, 10 ms)
+    int fftSize = 512;           // FFT 크기 (2의 거듭제곱, frameLength 이상)
+    int numMels = 40;            // 멜 필터 수
+    float lowHz = 20.0f;         // 최저 필터 주파수
+    float highHz = 7600.0f;      // 최고 필터 주파수 (나이퀴스트 이하)
+};
+
+/**
+ * @brief 로그 멜 스펙트로그램 프레임 계산기
+ *
+ * configure()에서 창/트위들/멜 필터 테이블과 작업 버퍼를 모두 할당하고,
+ * compute()는 할당 없이 한 프레임을 처리합니다.
+ * 창 적용과 멜 필터 적용은 SIMD 커널(kernels::applyWindow/dotProduct)을 사용하고,
+ * FFT는 실수 입력을 절반 크기 복소 FFT(radix-2)로 계산합니다.
+ * 한 인스턴스는 한 스레드에서만 사용해야 합니다.
+ */
+class LogMelFrontend {
+public:
+    LogMelFrontend();
+
+    /**
+     * @brief 설정 적용 및 테이블 생성
+     * @param config 특징 추출 설정
+     * @return 설정이 유효한지 여부
+     */
+    bool configure(const LogMelConfig& config);
+
+    /**
+     * @brief 한 프레임의 로그 멜 에너지 계산 (할당 없음)
+     * @param frame frameLength개의 int16 샘플
+     * @param mels 출력: numMels개의 ln(멜 에너지 + 1e-6) 값 (입력은 [-1, 1]로 정규화)
+     */
+    void compute(const int16_t* frame, float* mels);
+
+    /**
+     * @brief 설정 반환
+     */
+    const LogMelConfig& getConfig() const { return m_config; }
+
+    /**
+     * @brief 설정이 적용되었는지 확인
+     */
+    bool isConfigured() const { return !m_window.empty(); }
+
+private:
+    /**
+     * @brief 멜 필터 하나 (0이 아닌 구간만 저장)
+     */
+    struct MelFilter {
+        size_t firstBin;
+        size_t weightOffset;     // m_melWeights 내 위치
+        size_t length;
+    };
+
+    void fft();
+
+    LogMelConfig m_config;
+    size_t m_halfSize;           // 복소 FFT 크기 (fftSize / 2)
+
+    std::vector<float> m_window;         // Hann 창 / 32768
+    std::vector<float> m_buffer;         // fftSize개 실수 = halfSize개 복소수 (인터리브)
+    std::vector<float> m_power;          // fftSize / 2 + 1개 파워 스펙트럼
+    std::vector<float> m_twiddleRe;      // 복소 FFT 트위들 (halfSize / 2개)
+    std::vector<float> m_twiddleIm;
+    std::vector<float> m_splitRe;        // 실수 FFT 분리 단계 트위들 (halfSize개)
+    std::vector<float> m_splitIm;
+    std::vector<uint32_t> m_bitReverse;  // halfSize개 비트 반전 인덱스
+    std::vector<MelFilter> m_filters;
+    std::vector<float> m_melWeights;
+};
+
+} // namespace sion
+
+#endif // LOG_MEL_FRONTEND_H
@@ -0,0 +1,160 @@
+#pragma once
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sion {
+namespace metrics {
+
+/**
+ * @brief 현재 값 지표 (수집 시점에 덮어씀)
+ */
+enum class Gauge : uint8_t {
+    PipelineInFlight,         // 처리 중인 요청 수 (모든 세션)
+    BridgePendingRequests,    // 워커 응답을 기다리는 요청 수 (브릿지 큐 깊이, 모든 워커)
+    WorkersReady,             // 예열이 끝난 Python 워커 수
+    AsrConnected,             // ASR 직접 연결 상태 (1: 연결됨, 0: 끊김/미사용)
+    Count
+};
+
+constexpr size_t kGaugeCount = static_cast<size_t>(Gauge::Count);
+
+/**
+ * @brief 지표 이름 (Prometheus 이름의 바탕, 예: "pipeline-in-flight")
+ */
+const char* gaugeName(Gauge gauge);
+
+/**
+ * @brief 값 설정 (락 없음, 아무 스레드에서나 호출 가능)
+ */
+void setGauge(Gauge gauge, int64_t value);
+
+/**
+ * @brief 현재 값
+ */
+int64_t gaugeValue(Gauge gauge);
+
+/**
+ * @brief 고정 버킷 분포 지표 (값은 ms)
+ */
+enum class Histogram : uint8_t {
+    VadUtteranceMs,           // VAD가 잘라낸 발화 길이 (앞뒤 무음 제외)
+    VadTrimmedMs,             // 발화 앞뒤에서 잘라낸 무음 길이
+    Count
+};
+
+constexpr size_t kHistogramCount = static_cast<size_t>(Histogram::Count);
+
+/**
+ * @brief 분포 이름 (예: "vad-utterance")
+ */
+const char* histogramName(Histogram histogram);
+
+/**
+ * @brief 값 기록 (원자 덧셈 두 번, 락과 할당 없음)
+ * @param histogram 분포
+ * @param valueMs 값 (ms)
+ */
+void observe(Histogram histogram, double valueMs);
+
+/**
+ * @brief 분포 버킷 상한 (ms, 오름차순, 모든 Histogram 공통)
+ */
+const std::vector<double>& histogramBoundsMs();
+
+/**
+ * @brief 모든 지표를 Prometheus 텍스트 형식(0.0.4)으로 출력
+ *
+ * trace 카운터는 sion_<이름>_total 카운터로, 구간 지연은 stage 레이블을 단
+ * sion_stage_duration_seconds 히스토그램으로, 게이지/분포는 sion_<이름>으로 내보냅니다.
+ * 캐시 적중률은 *_cache_hit_total / *_cache_miss_total의 비율로 계산합니다.
+ */
+void writePrometheus(std::ostream& out);
+
+/**
+ * @brief 메트릭 내보내기 서버 설정
+ */
+struct MetricsServerConfig {
+    uint16_t port = 0;                      // 스크레이프 포트 (0이면 사용 안 함)
+    std::string bindAddress = "127.0.0.1";  // 기본은 로컬에서만 (원격 수집은 로컬 에이전트가 중계)
+};
+
+/**
+ * @brief Prometheus 스크레이프 엔드포인트 (GET /metrics)
+ *
+ * 전용 스레드 하나가 연결을 받아 요청마다 수집기를 실행한 뒤 writePrometheus() 결과를
+ * 한 번에 응답합니다. 기록 쪽(카운터/분포/구간)은 원자값만 갱신하므로 오디오 스레드에는
+ * 비용이 거의 없고, 게이지처럼 여러 객체를 훑어야 하는 값은 스크레이프 때만 모읍니다.
+ * 연결은 요청 하나 뒤 닫으며, 스크레이프 주기(보통 15초)에 맞춘 단순한 구현입니다.
+ */
+class MetricsServer {
+public:
+    /**
+     * @brief 수집기 (스크레이프마다 서버 스레드에서 호출, 보통 setGauge())
+     */
+    using Collector = std::function<void()>;
+
+    /**
+     * @brief 생성자
+     * @param config 서버 설정
+     */
+    explicit MetricsServer(MetricsServerConfig config);
+
+    /**
+     * @brief 소멸자 - stop() 호출
+     */
+    ~MetricsServer();
+
+    // 복사 금지
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * @brief 수집기 추가 (start() 전에 호출, 참조하는 객체는 stop()까지 유지해야 함)
+     */
+    void addCollector(Collector collector);
+
+    /**
+     * @brief 포트를 열고 서버 스레드 시작
+     * @return 성공 여부
+     */
+    bool start();
+
+    /**
+     * @brief 서버 스레드 종료 (진행 중인 응답을 마친 뒤 반환)
+     */
+    void stop();
+
+    /**
+     * @brief 실행 중인지 확인
+     */
+    bool isRunning() const { return m_thread.joinable(); }
+
+private:
+    void run();
+    void serve(intptr_t client);
+
+    MetricsServerConfig m_config;
+    std::vector<Collector> m_collectors;
+
+    intptr_t m_listener;            // POSIX: fd, Windows: SOCKET (닫혀 있으면 -1)
+#ifndef _WIN32
+    int m_wakeFds[2];               // stop()이 서버 스레드의 poll()을 깨우는 파이프
+#endif
+    std::atomic<bool> m_stopping;
+    std::thread m_thread;
+};
+
+} // namespace metrics
+} // namespace sion
+
+#endif // METRICS_H
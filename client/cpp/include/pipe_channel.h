@@ -0,0 +1,160 @@
+#pragma once
+
+#ifndef PIPE_CHANNEL_H
+#define PIPE_CHANNEL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bridge_protocol.h"
+
+namespace sion {
+
+/**
+ * @brief 비동기 프레임 파이프 채널
+ *
+ * 송신/수신 핸들 한 쌍을 전용 I/O 스레드 하나가 다중화합니다.
+ * Windows는 overlapped 명명 파이프 + I/O 완료 포트(IOCP),
+ * Linux는 non-blocking fd + epoll(그 외 POSIX는 poll)을 사용합니다.
+ *
+ * send()는 프레임을 송신 큐에 넣고 바로 반환하며, 큐가 가득 차면
+ * 마감 시각까지만 기다립니다. 수신된 바이트는 부분 읽기를 누적해
+ * 완성된 프레임 단위로 I/O 스레드에서 onFrame 콜백으로 전달됩니다.
+ */
+class PipeChannel {
+public:
+#ifdef _WIN32
+    using NativeHandle = void*;               // HANDLE (FILE_FLAG_OVERLAPPED로 연 것)
+#else
+    using NativeHandle = int;                 // 파일 디스크립터
+#endif
+    using Clock = std::chrono::steady_clock;
+    using FrameHandler = std::function<void(const protocol::FrameHeader&, std::string&)>;
+    using CloseHandler = std::function<void()>;
+
+    // 송신 큐 상한 (초과 시 send()가 대기하여 상대가 멈췄을 때 메모리 증가를 막음)
+    static constexpr size_t kMaxQueuedBytes = 1024 * 1024;
+
+    // 재사용을 위해 보관하는 프레임 버퍼 수 (정상 상태에서 send()가 할당하지 않도록)
+    static constexpr size_t kMaxSpareBuffers = 32;
+
+    PipeChannel();
+
+    /**
+     * @brief 소멸자 - close() 호출
+     */
+    ~PipeChannel();
+
+    // 복사 금지
+    PipeChannel(const PipeChannel&) = delete;
+    PipeChannel& operator=(const PipeChannel&) = delete;
+
+    /**
+     * @brief 채널 열기 및 I/O 스레드 시작 (핸들 소유권 이전)
+     * @param writeHandle 상대 stdin으로 연결된 송신 핸들
+     * @param readHandle 상대 stdout으로 연결된 수신 핸들
+     * @param onFrame 프레임 수신 콜백 (I/O 스레드에서 호출)
+     * @param onClose 상대 종료/I/O 오류 콜백 (I/O 스레드에서 한 번 호출)
+     * @return 성공 여부
+     */
+    bool open(NativeHandle writeHandle, NativeHandle readHandle,
+              FrameHandler onFrame, CloseHandler onClose);
+
+    /**
+     * @brief I/O 스레드 종료 후 핸들 닫기 (송신 큐의 미전송 프레임은 버림)
+     */
+    void close();
+
+    /**
+     * @brief 프레임 송신 예약
+     * @param header 프레임 헤더 (payloadSize는 size로 덮어씀)
+     * @param payload 페이로드 (호출 중에 복사되므로 반환 후 재사용 가능)
+     * @param size 페이로드 크기
+     * @param deadline 송신 큐에 자리가 날 때까지 기다릴 마감 시각
+     * @return 큐에 넣었는지 여부 (채널 닫힘/시간 초과 시 false)
+     */
+    bool send(const protocol::FrameHeader& header, const void* payload, size_t size,
+              Clock::time_point deadline);
+
+    /**
+     * @brief 채널이 열려 있고 오류가 없는지 확인
+     */
+    bool isOpen() const { return m_open.load(); }
+
+    /**
+     * @brief 아직 기록되지 않은 송신 바이트 수
+     */
+    size_t queuedBytes() const;
+
+private:
+    /**
+     * @brief 송신 대기 프레임 (헤더 + 페이로드를 연속 버퍼로 보관)
+     */
+    struct OutgoingFrame {
+        std::vector<uint8_t> bytes;
+        size_t offset = 0;
+    };
+
+    void ioLoop();
+
+    /**
+     * @brief 수신 버퍼에서 완성된 프레임을 모두 꺼내 전달
+     * @return 스트림이 유효한지 여부 (잘못된 헤더면 false)
+     */
+    bool dispatchFrames();
+
+    /**
+     * @brief 송신 큐 앞에서 written 바이트 소비
+     */
+    void consumeWritten(size_t written);
+
+    /**
+     * @brief I/O 스레드 깨우기 (새 송신/종료)
+     */
+    void wake();
+
+    /**
+     * @brief I/O 스레드 종료 처리 (onClose 호출, 대기자 깨움)
+     */
+    void markClosed();
+
+    NativeHandle m_writeHandle;
+    NativeHandle m_readHandle;
+    FrameHandler m_onFrame;
+    CloseHandler m_onClose;
+
+    std::thread m_ioThread;
+    std::atomic<bool> m_open;
+    std::atomic<bool> m_stopping;
+
+    mutable std::mutex m_queueMutex;
+    std::condition_variable m_spaceCv;
+    std::deque<OutgoingFrame> m_queue;
+    size_t m_queuedBytes;              // m_queueMutex로 보호
+    std::vector<std::vector<uint8_t>> m_spareBuffers;   // 기록이 끝난 프레임 버퍼 (재사용)
+
+    // 수신 버퍼 (I/O 스레드 전용): 읽기 단위 → 프레임 누적
+    std::vector<uint8_t> m_readChunk;
+    std::vector<uint8_t> m_readBuffer;
+    size_t m_readOffset;
+
+#ifdef _WIN32
+    void* m_port;                      // I/O 완료 포트
+#else
+    int m_pollFd;                      // epoll 인스턴스 (Linux)
+    int m_wakeFds[2];                  // self-pipe (wake()용)
+#endif
+};
+
+} // namespace sion
+
+#endif // PIPE_CHANNEL_H
@@ -6,14 +6,39 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+#include "wav_buffer.h"
+#include "bridge_protocol.h"
+#include "pipe_channel.h"
+#include "thread_pool.h"
 
 namespace sion {
 
+class AudioEncoder;
+class CancellationToken;
+
 /**
- * @brief Python 인터프리터와의 통신을 담당하는 클래스
+ * @brief 임베디드 Python 인터프리터 브릿지
  * 
  * C++에서 캡처한 오디오 데이터를 Python 클라이언트로 전달하고,
  * Python 함수를 호출하여 결과를 받아옵니다.
+ *
+ * 인터프리터는 전용 스레드 하나가 소유하며(PyConfig로 초기화), 모든 호출은
+ * 요청 큐를 거쳐 그 스레드에서 실행됩니다. 스레드는 대기 중에 GIL을 놓고
+ * 작업 중에만 잡으므로, Python이 I/O·추론 중 GIL을 내려놓으면 Python 쪽
+ * 스레드도 진행되고 C++ 캡처/파이프라인 스레드는 GIL과 무관하게 동작합니다.
+ * process_audio와 callFunction()으로 부른 함수는 처음 한 번만 조회해 캐시합니다.
  */
 class PythonBridge {
 public:
@@ -27,20 +52,24 @@ public:
      */
     ~PythonBridge();
 
+    // 복사 금지
+    PythonBridge(const PythonBridge&) = delete;
+    PythonBridge& operator=(const PythonBridge&) = delete;
+
     /**
-     * @brief Python 인터프리터 초기화
+     * @brief 인터프리터 스레드 시작 및 Python 초기화
      * @param pythonHome Python 설치 경로 (선택)
      * @return 성공 여부
      */
     bool initialize(const std::string& pythonHome = "");
 
     /**
-     * @brief Python 인터프리터 종료
+     * @brief 대기 중인 호출을 마친 뒤 Python 종료 및 인터프리터 스레드 정리
      */
     void finalize();
 
     /**
-     * @brief Python 모듈 임포트
+     * @brief Python 모듈 임포트 (process_audio를 미리 조회해 캐시)
      * @param moduleName 모듈 이름
      * @return 성공 여부
      */
@@ -53,6 +82,23 @@ public:
      */
     std::string processAudio(const std::vector<uint8_t>& audioData);
 
+    /**
+     * @brief WAV 버퍼를 복사 없이 Python으로 전달하여 처리
+     *
+     * 버퍼 프로토콜 기반 읽기 전용 memoryview로 노출하며,
+     * 호출이 끝나면 memoryview를 release하여 버퍼 참조가 남지 않도록 합니다.
+     * @param wav 완성된 WAV 버퍼
+     * @return 처리 결과 문자열
+     */
+    std::string processAudio(const WavBuffer& wav);
+
+    /**
+     * @brief WAV 버퍼 처리 요청 (블로킹 없음)
+     * @param wav 완성된 WAV 버퍼 (future가 준비될 때까지 유지해야 함)
+     * @return 처리 결과 future (실패 시 빈 문자열, 종료 중이면 broken_promise)
+     */
+    std::future<std::string> submitAudio(const WavBuffer& wav);
+
     /**
      * @brief Python 함수 호출 (문자열 인자, 문자열 반환)
      * @param functionName 함수 이름
@@ -71,24 +117,79 @@ public:
     /**
      * @brief 초기화 상태 확인
      */
-    bool isInitialized() const { return m_initialized; }
+    bool isInitialized() const { return m_initialized.load(); }
 
     /**
      * @brief 마지막 오류 메시지 반환
      */
-    const std::string& getLastError() const { return m_lastError; }
+    std::string getLastError() const;
 
 private:
-    bool m_initialized;
+    /**
+     * @brief 인터프리터 스레드에서 fn 실행 후 결과 대기 (GIL을 잡은 상태로 실행)
+     */
+    template <typename F>
+    auto runOnInterpreter(F&& fn) -> std::invoke_result_t<F&>;
+
+    /**
+     * @brief 모듈 속성에서 호출 가능한 객체 조회 (캐시, 인터프리터 스레드 전용)
+     * @return PyObject* (빌린 참조, 없으면 nullptr)
+     */
+    void* resolveCallable(const std::string& name);
+
+    /**
+     * @brief 캐시된 호출 객체 해제 (인터프리터 스레드 전용)
+     */
+    void clearCallables();
+
+    /**
+     * @brief process_audio(arg) 호출 후 문자열 결과 반환 (인터프리터 스레드 전용)
+     * @param arg PyObject* 인자
+     */
+    std::string invokeProcessAudio(void* arg);
+
+    /**
+     * @brief WAV 버퍼를 memoryview로 감싸 process_audio 호출 (인터프리터 스레드 전용)
+     */
+    std::string processWav(const WavBuffer& wav);
+
+    void setLastError(const std::string& error);
+
+    std::atomic<bool> m_initialized;
+    mutable std::mutex m_errorMutex;
     std::string m_lastError;
-    void* m_module;  // PyObject* (Python.h 의존성 숨김)
+
+    // 아래는 인터프리터 스레드에서만 접근
+    void* m_module;          // PyObject* (Python.h 의존성 숨김)
+    void* m_threadState;     // 대기 중 GIL을 놓을 때 저장한 PyThreadState*
+    std::unordered_map<std::string, void*> m_callables;   // 이름 → PyObject*
+
+    std::thread::id m_interpreterThreadId;
+    std::unique_ptr<ThreadPool> m_interpreter;   // 스레드 1개짜리 요청 큐
 };
 
+/**
+ * @brief 중간 인식 결과 콜백 타입
+ */
+using PartialResultCallback = std::function<void(const std::string&)>;
+
 /**
  * @brief 프로세스 간 통신을 통한 Python 연동
  * 
  * Python 인터프리터를 임베딩하지 않고,
  * 별도 프로세스로 Python 스크립트를 실행하고 통신합니다.
+ *
+ * 파이프 위에서는 bridge_protocol.h의 프레임 프로토콜을 사용합니다.
+ * 발화는 beginUtterance() → sendAudioChunk()* → endUtterance() 순서로
+ * 캡처와 동시에 스트리밍할 수 있습니다. 송수신은 PipeChannel의 I/O 스레드
+ * 하나가 다중화하며(Windows IOCP, Linux epoll), 응답은 utteranceId별로
+ * 분배하므로 여러 발화가 동시에 처리 중이어도 됩니다.
+ * 중간 결과(PARTIAL_RESULT)는 I/O 스레드에서 발화별 콜백으로 전달되고,
+ * awaitResult()는 해당 발화의 최종 결과를 요청 마감 시각까지만 기다립니다.
+ *
+ * 자식 프로세스는 Windows에서 CreateProcess, POSIX에서 posix_spawn으로 시작하며,
+ * 예열이 끝나면 READY 프레임을 보냅니다 (waitUntilReady()).
+ * 여러 워커의 감시/재시작은 PythonWorkerPool이 담당합니다.
  */
 class PythonProcessBridge {
 public:
@@ -96,8 +197,10 @@ public:
      * @brief 생성자
      * @param pythonPath Python 실행 파일 경로
      * @param scriptPath 실행할 스크립트 경로
+     * @param extraArgs --pipe-mode 뒤에 붙일 추가 인자 (예: --shm 이름)
      */
-    PythonProcessBridge(const std::string& pythonPath, const std::string& scriptPath);
+    PythonProcessBridge(const std::string& pythonPath, const std::string& scriptPath,
+                        const std::vector<std::string>& extraArgs = {});
 
     /**
      * @brief 소멸자
@@ -115,6 +218,98 @@ public:
      */
     void stop();
 
+    /**
+     * @brief READY 프레임 수신(예열 완료)까지 대기
+     * @param timeout 최대 대기 시간
+     * @return 준비되었는지 여부 (시간 초과/프로세스 종료 시 false)
+     */
+    bool waitUntilReady(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief 예열이 끝나 요청을 바로 처리할 수 있는지 확인
+     */
+    bool isReady() const { return m_ready.load() && m_running.load(); }
+
+    /**
+     * @brief 상태 변화(READY 수신, 파이프 종료) 알림 콜백 타입
+     */
+    using StateCallback = std::function<void()>;
+
+    /**
+     * @brief 상태 변화 콜백 설정 (워커 풀 감시 스레드를 폴링 없이 깨움)
+     *
+     * I/O 스레드에서 호출되므로 짧게 끝나야 하며, 콜백 안에서 stop()을 호출하지 마세요.
+     * start() 전에 설정해야 시작 직후의 종료도 놓치지 않습니다.
+     */
+    void setStateCallback(StateCallback callback);
+
+    /**
+     * @brief 워커가 READY에서 알린 코덱을 디코딩할 수 있는지 확인
+     *
+     * READY 페이로드가 비어 있으면(구버전 워커) PCM만 지원하는 것으로 봅니다.
+     * @param codec 코덱
+     */
+    bool supportsCodec(protocol::AudioCodec codec) const {
+        return (m_codecs.load() >> static_cast<uint32_t>(codec)) & 1u;
+    }
+
+    /**
+     * @brief 응답을 기다리는 요청 수 (least-loaded 분배용)
+     */
+    size_t pendingRequests() const;
+
+    /**
+     * @brief 요청 마감 시간 설정 (beginUtterance()부터 최종 응답까지)
+     *
+     * Python 측이 멈추면 이 시간이 지난 뒤 해당 요청은 CANCEL 후 빈 결과로 끝납니다.
+     * @param timeout 마감 시간 (기본 30초)
+     */
+    void setRequestTimeout(std::chrono::milliseconds timeout) { m_requestTimeout = timeout; }
+
+    /**
+     * @brief 새 발화 스트림 시작 (응답 대기 항목 등록)
+     *
+     * 호출 스레드의 요청 ID(trace::RequestScope)에 세션이 있으면 SESSION 프레임을 먼저 보냅니다.
+     * @param onPartial 중간 결과 콜백 (I/O 스레드에서 호출, 선택)
+     * @return 발화 ID (프레임의 utteranceId)
+     */
+    uint32_t beginUtterance(PartialResultCallback onPartial = nullptr);
+
+    /**
+     * @brief 오디오 조각 전송 (AUDIO_CHUNK)
+     * @param utteranceId beginUtterance()가 반환한 ID
+     * @param samples PCM s16le 모노 샘플
+     * @param count 샘플 수
+     * @return 성공 여부
+     */
+    bool sendAudioChunk(uint32_t utteranceId, const int16_t* samples, size_t count);
+
+    /**
+     * @brief 발화 종료 알림 (END_OF_UTTERANCE)
+     * @param utteranceId 발화 ID
+     * @return 성공 여부
+     */
+    bool endUtterance(uint32_t utteranceId);
+
+    /**
+     * @brief 발화 처리 취소 (CANCEL)
+     * @param utteranceId 발화 ID
+     * @return 성공 여부
+     */
+    bool cancelUtterance(uint32_t utteranceId);
+
+    /**
+     * @brief 최종 결과 대기 (발화당 한 번만 호출)
+     *
+     * 대기 중 토큰이 취소되거나 요청 마감 시각이 지나면 CANCEL 프레임을 보내고
+     * 즉시 반환합니다. 응답은 I/O 스레드가 발화별로 분배하므로 파이프는 곧바로
+     * 다음 요청에 쓸 수 있습니다.
+     * @param utteranceId 발화 ID
+     * @param cancel 취소 토큰 (선택)
+     * @return 최종 결과 (오류/취소/시간 초과 시 빈 문자열)
+     */
+    std::string awaitResult(uint32_t utteranceId, CancellationToken* cancel = nullptr);
+
     /**
      * @brief 오디오 데이터 전송 및 결과 수신
      * @param audioData WAV 형식 오디오 바이트
@@ -123,7 +318,121 @@ public:
     std::string sendAudio(const std::vector<uint8_t>& audioData);
 
     /**
-     * @brief 텍스트 명령 전송
+     * @brief 연속 WAV 버퍼 전송 및 결과 수신 (중간 복사 없음)
+     * @param wav 완성된 WAV 버퍼
+     * @param onPartial 중간 결과 콜백 (선택)
+     * @return 처리 결과
+     */
+    std::string sendAudio(const WavBuffer& wav, const PartialResultCallback& onPartial = nullptr);
+
+    /**
+     * @brief PCM 샘플을 조각 단위로 전송하고 결과 수신
+     *
+     * 각 조각은 송신 큐에 들어가고, I/O 스레드가 큐에 쌓인 프레임을 모아
+     * 기록합니다 (POSIX: 여러 프레임을 한 번의 writev, Windows: overlapped WriteFile).
+     * @param samples PCM s16le 모노 샘플
+     * @param sampleCount 샘플 수
+     * @param onPartial 중간 결과 콜백 (선택)
+     * @return 처리 결과
+     */
+    std::string sendPcm(const int16_t* samples, size_t sampleCount,
+                        const PartialResultCallback& onPartial = nullptr);
+
+    /**
+     * @brief PCM 샘플을 전송만 하고 결과는 기다리지 않음
+     *
+     * 반환 즉시 샘플 버퍼를 재사용할 수 있으며, 결과는 awaitResult()로 받습니다.
+     * 파이프라인에서 다음 발화 전송과 이전 발화의 결과 대기를 겹칠 때 사용합니다.
+     * @param samples PCM s16le 모노 샘플
+     * @param sampleCount 샘플 수
+     * @param onPartial 중간 결과 콜백 (I/O 스레드에서 호출, 선택)
+     * @param cancel 취소 토큰 (선택, 조각 사이에서 확인하여 END 대신 CANCEL 전송)
+     * @return 발화 ID (전송 실패/취소 시에도 awaitResult()는 빈 문자열로 즉시 반환)
+     */
+    uint32_t submitPcm(const int16_t* samples, size_t sampleCount,
+                       const PartialResultCallback& onPartial = nullptr,
+                       CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief PCM 샘플을 인코딩하며 전송 (결과는 기다리지 않음)
+     *
+     * kBulkChunkSamples 단위로 인코딩해 완성된 바이트가 생길 때마다
+     * AUDIO_CHUNK(flags = 코덱)로 보내므로 인코딩과 전송이 겹칩니다.
+     * 워커가 코덱을 지원하는지는 호출자가 supportsCodec()으로 확인해야 합니다.
+     * @param samples PCM s16le 모노 샘플
+     * @param sampleCount 샘플 수
+     * @param sampleRate 샘플링 레이트 (스트림 헤더용)
+     * @param encoder 인코더 (호출 중 전용으로 사용)
+     * @param onPartial 중간 결과 콜백 (I/O 스레드에서 호출, 선택)
+     * @param cancel 취소 토큰 (선택, 조각 사이에서 확인)
+     * @return 발화 ID
+     */
+    uint32_t submitEncoded(const int16_t* samples, size_t sampleCount, int sampleRate,
+                           AudioEncoder& encoder,
+                           const PartialResultCallback& onPartial = nullptr,
+                           CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 공유 메모리 오디오 구간 알림 (AUDIO_SHM)
+     *
+     * 샘플은 SharedAudioRing 슬롯에 이미 기록되어 있어야 하며,
+     * 파이프로는 12바이트 위치 정보만 전송됩니다.
+     * @param utteranceId 발화 ID
+     * @param ref 슬롯/오프셋/샘플 수
+     * @return 성공 여부
+     */
+    bool sendSharedAudioChunk(uint32_t utteranceId, const protocol::ShmAudioRef& ref);
+
+    /**
+     * @brief 공유 메모리 슬롯의 발화 전체 전송 (결과는 기다리지 않음)
+     *
+     * 슬롯은 awaitResult()가 끝날 때까지 재사용하면 안 됩니다.
+     * @param slot 슬롯 번호
+     * @param sampleCount 슬롯에 기록된 샘플 수
+     * @param onPartial 중간 결과 콜백 (I/O 스레드에서 호출, 선택)
+     * @param cancel 취소 토큰 (선택)
+     * @return 발화 ID
+     */
+    uint32_t submitSharedAudio(uint32_t slot, size_t sampleCount,
+                               const PartialResultCallback& onPartial = nullptr,
+                               CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 인식 텍스트 전송 (TRANSCRIPT, 결과는 기다리지 않음)
+     *
+     * ASR을 C++에서 직접 거친 발화에 사용하며, 워커는 NLU와 작업 실행만 수행하고
+     * 오디오 발화와 같은 형식의 FINAL_RESULT로 응답합니다.
+     * @param transcript 인식 텍스트 (UTF-8)
+     * @param cancel 취소 토큰 (선택)
+     * @return 발화 ID (awaitResult()로 결과 수신)
+     */
+    uint32_t submitTranscript(const std::string& transcript, CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 캐시된 의도 전송 (INTENT, 결과는 기다리지 않음)
+     *
+     * 응답 캐시에 같은 인식 텍스트의 의도가 있을 때 사용하며, 워커는 NLU 없이
+     * 작업만 실행하고 submitTranscript()와 같은 형식의 FINAL_RESULT로 응답합니다.
+     * @param transcript 인식 텍스트 (UTF-8)
+     * @param intentJson NLU 의도 JSON 객체
+     * @param cancel 취소 토큰 (선택)
+     * @return 발화 ID (awaitResult()로 결과 수신)
+     */
+    uint32_t submitIntent(const std::string& transcript, const std::string& intentJson,
+                          CancellationToken* cancel = nullptr);
+
+    /**
+     * @brief 추측 NLU 요청 (SPECULATE, 응답 없음)
+     *
+     * 워커는 중간 인식 텍스트로 NLU를 미리 실행하고 의도가 확실하면 작업을 준비합니다.
+     * 이후 같은 텍스트의 TRANSCRIPT가 오면 추측한 NLU 결과를 재사용합니다.
+     * @param prefix 안정된 중간 인식 텍스트 (UTF-8)
+     * @return 전송 성공 여부
+     */
+    bool speculate(const std::string& prefix);
+
+    /**
+     * @brief 텍스트 명령 전송 (COMMAND → COMMAND_RESULT)
      * @param command 명령 문자열
      * @return 응답 문자열
      */
@@ -135,16 +444,82 @@ public:
     bool isRunning() const;
 
 private:
+    /**
+     * @brief 응답 대기 항목
+     */
+    struct PendingRequest {
+        PartialResultCallback onPartial;
+        std::promise<std::string> promise;
+        std::future<std::string> future;
+        std::chrono::steady_clock::time_point deadline;
+        bool completed = false;
+        
+        // 지연 계측 (beginUtterance()의 호출 스레드 요청 ID와 등록 시각)
+        uint64_t traceRequest = 0;
+        int64_t sentAt = 0;
+        bool partialSeen = false;
+    };
+
+    /**
+     * @brief 수신 프레임 처리: 발화별 대기 항목으로 분배 (I/O 스레드)
+     */
+    void handleFrame(const protocol::FrameHeader& header, std::string& payload);
+
+    /**
+     * @brief 채널 종료 처리 (I/O 스레드)
+     */
+    void handleChannelClosed();
+
+    /**
+     * @brief 대기 항목 완료 (중복 완료는 무시)
+     */
+    void completeRequest(uint32_t utteranceId, const std::string& result);
+
+    /**
+     * @brief 모든 대기 항목을 빈 결과로 완료 (파이프 종료 시)
+     */
+    void failAllRequests();
+
+    /**
+     * @brief 상태 변화 콜백 호출 (I/O 스레드)
+     */
+    void notifyStateChanged();
+
+    /**
+     * @brief 프레임 한 개 송신 예약 (헤더 + 페이로드, 송신 락 보유)
+     */
+    bool writeFrame(protocol::MessageType type, uint32_t utteranceId,
+                    const void* payload, size_t size, uint8_t flags = 0);
+
     std::string m_pythonPath;
     std::string m_scriptPath;
-    void* m_processHandle;
-    void* m_stdinPipe;
-    void* m_stdoutPipe;
-    bool m_running;
+    std::vector<std::string> m_extraArgs;
+    void* m_processHandle;              // Windows: HANDLE
+    int m_processId;                    // POSIX: pid_t (미실행 시 -1)
+    std::atomic<bool> m_running;
+    std::chrono::milliseconds m_requestTimeout;
+
+    std::atomic<bool> m_ready;
+    std::mutex m_readyMutex;
+    std::condition_variable m_readyCv;
+    std::atomic<uint32_t> m_codecs;     // READY로 받은 코덱 비트마스크
+
+    std::mutex m_stateCallbackMutex;
+    StateCallback m_stateCallback;
+
+    std::mutex m_writeMutex;
+    uint32_t m_sendSequence;            // m_writeMutex로 보호
+    uint32_t m_recvSequence;            // I/O 스레드 전용
+    bool m_recvStarted;
+    std::atomic<uint32_t> m_nextUtteranceId;
+
+    mutable std::mutex m_pendingMutex;
+    std::unordered_map<uint32_t, PendingRequest> m_pending;
+
+    // 마지막에 선언하여 가장 먼저 소멸 (I/O 스레드가 위 멤버를 참조)
+    PipeChannel m_channel;
 };
 
 } // namespace sion
 
 #endif // PYTHON_BRIDGE_H
-
-
@@ -0,0 +1,158 @@
+#pragma once
+
+#ifndef PYTHON_WORKER_POOL_H
+#define PYTHON_WORKER_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "python_bridge.h"
+
+namespace sion {
+
+/**
+ * @brief 워커 선택 정책
+ */
+enum class DispatchPolicy {
+    RoundRobin,     // 준비된 워커를 차례로
+    LeastLoaded     // 응답 대기 요청이 가장 적은 워커
+};
+
+/**
+ * @brief 워커 풀 설정 구조체
+ */
+struct WorkerPoolConfig {
+    std::string pythonPath = "python";
+    std::string scriptPath = "../python/main.py";
+    std::vector<std::string> extraArgs;                      // 워커 추가 인자 (예: --shm 이름)
+    size_t numWorkers = 2;                                   // 워커 프로세스 수
+    DispatchPolicy policy = DispatchPolicy::LeastLoaded;
+    std::chrono::milliseconds readyTimeout{15000};           // start()에서 예열 대기 상한
+    std::chrono::milliseconds requestTimeout{30000};         // 워커별 요청 마감 시간
+    std::chrono::milliseconds restartBackoff{500};           // 첫 재시작 지연 (연속 실패 시 2배씩)
+    std::chrono::milliseconds maxRestartBackoff{30000};      // 재시작 지연 상한
+};
+
+/**
+ * @brief 감시되는 사전 예열 Python 워커 풀
+ *
+ * start()에서 N개의 `python main.py --pipe-mode` 프로세스를 동시에 띄우고
+ * 각 워커가 임포트/예열을 마친 뒤 보내는 READY를 기다리므로, 첫 핫키 입력부터
+ * 인터프리터 콜드 스타트 비용이 없습니다.
+ *
+ * 감시 스레드가 죽은 워커를 백그라운드에서 지수 백오프로 재시작하며,
+ * acquire()는 예열이 끝난 워커만 골라 반환합니다. 요청 도중 워커가 죽으면
+ * 해당 요청만 빈 결과로 끝나고 다음 요청은 다른 워커로 갑니다.
+ */
+class PythonWorkerPool {
+public:
+    using WorkerPtr = std::shared_ptr<PythonProcessBridge>;
+
+    /**
+     * @brief 생성자
+     * @param config 풀 설정
+     */
+    explicit PythonWorkerPool(const WorkerPoolConfig& config = WorkerPoolConfig{});
+
+    /**
+     * @brief 소멸자 - stop() 호출
+     */
+    ~PythonWorkerPool();
+
+    // 복사 금지
+    PythonWorkerPool(const PythonWorkerPool&) = delete;
+    PythonWorkerPool& operator=(const PythonWorkerPool&) = delete;
+
+    /**
+     * @brief 모든 워커 시작, 예열 대기 후 감시 스레드 시작
+     * @return 하나 이상의 워커가 준비되었는지 여부
+     */
+    bool start();
+
+    /**
+     * @brief 감시 스레드와 모든 워커 종료
+     */
+    void stop();
+
+    /**
+     * @brief 요청을 보낼 워커 선택
+     *
+     * 준비된 워커가 없으면 실행 중인(예열 중인) 워커를 반환하며,
+     * 요청은 예열이 끝난 뒤 처리됩니다.
+     * @return 워커 (실행 중인 워커가 없으면 nullptr)
+     */
+    WorkerPtr acquire();
+
+    /**
+     * @brief 텍스트 명령 전송 (선택된 워커로)
+     * @param command 명령 문자열
+     * @return 응답 문자열 (실패 시 빈 문자열)
+     */
+    std::string sendCommand(const std::string& command);
+
+    /**
+     * @brief 예열이 끝난 워커 수
+     */
+    size_t readyWorkers() const;
+
+    /**
+     * @brief 모든 워커에서 응답을 기다리는 요청 수 (브릿지 큐 깊이)
+     */
+    size_t pendingRequests() const;
+
+    /**
+     * @brief 지금까지 재시작한 횟수
+     */
+    size_t restartCount() const { return m_restartCount.load(); }
+
+    /**
+     * @brief 설정 반환
+     */
+    const WorkerPoolConfig& getConfig() const { return m_config; }
+
+private:
+    /**
+     * @brief 워커 슬롯 (재시작 시 bridge만 교체)
+     */
+    struct Slot {
+        WorkerPtr bridge;
+        std::chrono::steady_clock::time_point nextRestart;
+        std::chrono::milliseconds backoff{0};
+    };
+
+    /**
+     * @brief 워커 프로세스 하나 시작 (READY는 기다리지 않음)
+     * @return 시작된 워커 (실패 시 nullptr)
+     */
+    WorkerPtr spawnWorker(size_t index);
+
+    /**
+     * @brief 감시 스레드: 죽은 워커 재시작
+     *
+     * 워커 상태 변화 알림과 다음 재시작 예정 시각에만 깨어나므로 유휴 시 주기적 깨어남이 없습니다.
+     */
+    void supervisorLoop();
+
+    WorkerPoolConfig m_config;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;          // 감시 스레드 깨우기 (종료, 워커 상태 변화)
+    std::vector<Slot> m_slots;
+    size_t m_nextIndex;                    // round-robin 위치
+    bool m_stopping;
+    bool m_stateChanged;                   // 워커가 READY 했거나 종료됨 (감시 스레드가 확인)
+
+    std::atomic<size_t> m_restartCount;
+    std::thread m_supervisor;
+};
+
+} // namespace sion
+
+#endif // PYTHON_WORKER_POOL_H
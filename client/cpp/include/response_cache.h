@@ -0,0 +1,181 @@
+#pragma once
+
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "log_mel_frontend.h"
+
+namespace sion {
+
+/**
+ * @brief 응답 캐시 설정
+ */
+struct ResponseCacheConfig {
+    std::string path;                                   // 저장 파일 (비어 있으면 메모리에만 유지)
+    std::chrono::seconds ttl{std::chrono::hours(24)};   // 인식 텍스트 → 의도 유효 시간
+    size_t maxEntries = 512;                            // 인식 텍스트 계층 항목 수 상한
+    size_t maxBytes = 1024 * 1024;                      // 인식 텍스트 계층 메모리 상한 (키 + 값)
+    bool fingerprint = false;                           // 오디오 지문 계층 사용
+    size_t maxFingerprints = 256;                       // 오디오 지문 계층 항목 수 상한
+    int maxHammingDistance = 20;                        // 같은 발화로 볼 지문 차이 (128비트 중, 무관한 발화는 약 64)
+    float maxDurationRatio = 1.25f;                     // 같은 발화로 볼 길이 비율
+};
+
+/**
+ * @brief 발화 오디오 지문 (128비트 스펙트럼 해시)
+ */
+struct AudioFingerprint {
+    uint64_t bits[2] = {0, 0};
+    uint32_t durationMs = 0;     // 유효 구간 길이 (0이면 지문 없음)
+
+    bool isValid() const { return durationMs > 0; }
+};
+
+/**
+ * @brief 반복 명령용 클라이언트 응답 캐시 (2계층 LRU)
+ *
+ *   인식 텍스트 계층: 정규화한 인식 텍스트 → NLU 의도 JSON (TTL 적용)
+ *                     인식 텍스트를 NLU 전에 아는 경우(ASR 직접 연결, 지문 적중)에
+ *                     워커에 INTENT로 의도를 넘겨 NLU 왕복을 생략합니다.
+ *   오디오 지문 계층: 발화 지문 → 인식 텍스트 (선택)
+ *                     해밍 거리가 가까운 발화면 ASR을 생략합니다.
+ *
+ * 작업 결과는 매번 달라질 수 있으므로 저장하지 않고, 작업 실행은 항상 워커가 합니다.
+ * 두 계층 모두 항목 수/바이트 상한을 넘으면 가장 오래 쓰지 않은 항목부터 버리며,
+ * save()/load()로 재시작 후에도 유지합니다. 적중/실패는 trace 카운터로 집계됩니다.
+ * 모든 메서드는 스레드에 안전합니다.
+ */
+class ResponseCache {
+public:
+    /**
+     * @brief 생성자
+     * @param config 캐시 설정
+     */
+    explicit ResponseCache(ResponseCacheConfig config);
+
+    // 복사 금지
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /**
+     * @brief 저장 파일에서 항목 읽기 (만료된 항목은 건너뜀)
+     * @return 성공 여부 (파일이 없으면 false, 캐시는 빈 상태로 사용 가능)
+     */
+    bool load();
+
+    /**
+     * @brief 저장 파일에 항목 쓰기 (임시 파일에 쓴 뒤 교체)
+     * @return 성공 여부 (path가 비어 있으면 false)
+     */
+    bool save() const;
+
+    /**
+     * @brief 오디오 지문 계층을 사용하는지 확인
+     */
+    bool fingerprintEnabled() const { return m_config.fingerprint; }
+
+    /**
+     * @brief 인식 텍스트로 의도 조회 (적중 시 최근 사용으로 갱신)
+     * @param transcript 인식 텍스트
+     * @param intent 출력: NLU 의도 JSON
+     * @return 적중 여부
+     */
+    bool lookupIntent(const std::string& transcript, std::string& intent);
+
+    /**
+     * @brief 의도 저장 (이미 유효한 항목이 있으면 만료 시각은 유지)
+     */
+    void storeIntent(const std::string& transcript, const std::string& intent);
+
+    /**
+     * @brief 발화 지문 계산 (에너지가 낮은 앞뒤 구간 제외)
+     * @param samples PCM s16le 모노 샘플
+     * @param sampleCount 샘플 수
+     * @param sampleRate 샘플링 레이트
+     * @param out 출력 지문
+     * @return 지문을 만들 만큼 유효 구간이 긴지 여부
+     */
+    bool computeFingerprint(const int16_t* samples, size_t sampleCount, int sampleRate,
+                            AudioFingerprint& out);
+
+    /**
+     * @brief 지문으로 인식 텍스트 조회 (가장 가까운 항목)
+     * @return 적중 여부
+     */
+    bool lookupTranscript(const AudioFingerprint& fingerprint, std::string& transcript);
+
+    /**
+     * @brief 지문 → 인식 텍스트 저장
+     */
+    void storeTranscript(const AudioFingerprint& fingerprint, const std::string& transcript);
+
+    /**
+     * @brief 워커 FINAL_RESULT JSON에서 인식 텍스트와 의도를 꺼내 두 계층에 저장
+     *
+     * 의도가 없거나 "unknown"이면 인식 텍스트 계층에는 저장하지 않습니다.
+     * @param result FINAL_RESULT 페이로드 ({"transcription", "intent", "result"})
+     * @param fingerprint 해당 발화 지문 (nullptr 또는 무효면 지문 계층 생략)
+     */
+    void storeResult(const std::string& result, const AudioFingerprint* fingerprint);
+
+    /**
+     * @brief 인식 텍스트 계층 항목 수
+     */
+    size_t intentCount() const;
+
+    /**
+     * @brief 오디오 지문 계층 항목 수
+     */
+    size_t fingerprintCount() const;
+
+    /**
+     * @brief 캐시 키로 쓰는 정규화 텍스트 (앞뒤 공백/문장부호 제거, 공백 축약, ASCII 소문자)
+     */
+    static std::string normalize(const std::string& transcript);
+
+private:
+    struct IntentEntry {
+        std::string key;
+        std::string intent;
+        int64_t expiresAt;       // system_clock 기준 초 (재시작 후에도 유효하도록 벽시계)
+    };
+
+    struct FingerprintEntry {
+        AudioFingerprint fingerprint;
+        std::string transcript;
+    };
+
+    using IntentList = std::list<IntentEntry>;
+
+    void insertIntentLocked(std::string key, std::string intent, int64_t expiresAt);
+    void eraseIntentLocked(IntentList::iterator it);
+    void insertFingerprintLocked(const AudioFingerprint& fingerprint, std::string transcript);
+    static size_t entryBytes(const IntentEntry& entry);
+
+    ResponseCacheConfig m_config;
+
+    mutable std::mutex m_mutex;
+    IntentList m_intents;                                        // 앞쪽이 최근 사용
+    std::unordered_map<std::string, IntentList::iterator> m_intentIndex;
+    size_t m_intentBytes;
+    std::list<FingerprintEntry> m_fingerprints;                  // 앞쪽이 최근 사용
+
+    // 지문 계산 전용 (호출 스레드가 여럿일 수 있어 별도 락)
+    std::mutex m_frontendMutex;
+    LogMelFrontend m_frontend;
+    std::vector<float> m_melFrames;
+    std::vector<float> m_frameEnergy;
+};
+
+} // namespace sion
+
+#endif // RESPONSE_CACHE_H
@@ -0,0 +1,157 @@
+#pragma once
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace sion {
+
+/**
+ * @brief 락프리 단일 생산자/단일 소비자 링 버퍼
+ *
+ * 생성 시 한 번만 할당하며, write()/read()는 할당이나 락 없이 동작합니다.
+ * 오디오 콜백(생산자)과 소비자 스레드가 각각 하나일 때만 안전합니다.
+ * 용량은 2의 거듭제곱으로 올림되어 인덱스 계산에 마스크를 사용합니다.
+ *
+ * @tparam T 원소 타입 (trivially copyable)
+ */
+template <typename T>
+class SpscRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SpscRingBuffer는 trivially copyable 타입만 지원합니다.");
+
+public:
+    /**
+     * @brief 생성자
+     * @param minCapacity 최소 용량 (원소 수)
+     */
+    explicit SpscRingBuffer(size_t minCapacity = 0) {
+        reserve(minCapacity);
+    }
+
+    // 복사 금지
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    /**
+     * @brief 버퍼 재할당 (생산자/소비자가 모두 정지한 상태에서만 호출)
+     * @param minCapacity 최소 용량 (원소 수)
+     */
+    void reserve(size_t minCapacity) {
+        size_t capacity = 1;
+        while (capacity < minCapacity) {
+            capacity <<= 1;
+        }
+        m_data.reset(new T[capacity]);
+        m_mask = capacity - 1;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 원소 쓰기 (생산자 전용)
+     * @param src 원본 데이터
+     * @param count 원소 수
+     * @return 실제로 쓴 원소 수 (공간 부족 시 count보다 작음)
+     */
+    size_t write(const T* src, size_t count) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        const size_t available = capacity() - (head - tail);
+        const size_t n = count < available ? count : available;
+
+        copyIn(head, src, n);
+        m_head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief 원소 읽기 (소비자 전용)
+     * @param dst 대상 버퍼
+     * @param count 최대 원소 수
+     * @return 실제로 읽은 원소 수
+     */
+    size_t read(T* dst, size_t count) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t stored = head - tail;
+        const size_t n = count < stored ? count : stored;
+
+        copyOut(tail, dst, n);
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief 원소를 복사하지 않고 건너뛰기 (소비자 전용)
+     * @param count 최대 원소 수
+     * @return 실제로 건너뛴 원소 수
+     */
+    size_t discard(size_t count) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t stored = head - tail;
+        const size_t n = count < stored ? count : stored;
+
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief 읽을 수 있는 원소 수 (소비자 기준)
+     */
+    size_t size() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 전체 용량
+     */
+    size_t capacity() const { return m_mask + 1; }
+
+    /**
+     * @brief 저장된 원소 폐기 (소비자 전용)
+     */
+    void clear() {
+        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    void copyIn(size_t position, const T* src, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        const size_t offset = position & m_mask;
+        const size_t first = n < capacity() - offset ? n : capacity() - offset;
+        std::memcpy(m_data.get() + offset, src, first * sizeof(T));
+        std::memcpy(m_data.get(), src + first, (n - first) * sizeof(T));
+    }
+
+    void copyOut(size_t position, T* dst, size_t n) const {
+        if (n == 0) {
+            return;
+        }
+        const size_t offset = position & m_mask;
+        const size_t first = n < capacity() - offset ? n : capacity() - offset;
+        std::memcpy(dst, m_data.get() + offset, first * sizeof(T));
+        std::memcpy(dst + first, m_data.get(), (n - first) * sizeof(T));
+    }
+
+    static constexpr size_t kCacheLine = 64;
+
+    std::unique_ptr<T[]> m_data;
+    size_t m_mask = 0;
+
+    // 생산자/소비자 인덱스를 서로 다른 캐시 라인에 배치 (false sharing 방지)
+    alignas(kCacheLine) std::atomic<size_t> m_head{0};
+    alignas(kCacheLine) std::atomic<size_t> m_tail{0};
+};
+
+} // namespace sion
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,163 @@
+#pragma once
+
+#ifndef SESSION_MANAGER_H
+#define SESSION_MANAGER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "audio_capture.h"
+#include "python_worker_pool.h"
+#include "shared_audio_ring.h"
+#include "thread_pool.h"
+#include "voice_activity_detector.h"
+#include "voice_pipeline.h"
+#include "wake_word_detector.h"
+
+namespace sion {
+
+/**
+ * @brief 캡처 세션 설정
+ */
+struct SessionManagerConfig {
+    std::vector<std::string> devices;   // 세션별 캡처 장치 (비우면 기본 장치 하나)
+    AudioConfig audio;                  // 공통 오디오 설정 (device는 세션마다 덮어씀)
+    VadConfig vad;
+    size_t maxInFlight = 2;             // 세션당 동시에 처리할 수 있는 최대 발화 수
+    size_t threads = 0;                 // 공유 풀 스레드 수 (최소 세션 수 × 3, 0이면 최소값)
+    WakeWordConfig wakeWord;            // modelPath 지정 시 세션마다 검출기
+};
+
+/**
+ * @brief 캡처 장치별 음성 파이프라인 묶음
+ *
+ * 장치마다 AudioCapture/VoicePipeline(VAD, 인코더 포함)/웨이크워드 검출기를 하나씩 두고,
+ * 파이프라인 단계는 모두 공유 ThreadPool 하나에서 실행하므로 세션 수만큼 단계 스레드가
+ * 늘지 않습니다. 웨이크워드 검출도 스레드 하나가 pollIntervalMs마다 모든 세션을 돕니다.
+ * Python 워커 풀, 공유 메모리 링, ASR 연결, 응답 캐시는 세션이 함께 씁니다.
+ *
+ * 장치가 둘 이상이면 세션 ID 1..N(장치 순서)을 요청 ID 상위 비트에 담아
+ * 결과와 trace를 세션별로 구분하고, 워커에는 SESSION 프레임으로 알립니다.
+ * 장치가 하나이면 세션 0으로 기존과 같은 요청 ID와 프로토콜을 씁니다.
+ */
+class SessionManager {
+public:
+    /**
+     * @brief 웨이크워드 검출 콜백 (검출 스레드에서 호출)
+     * @param session 세션 인덱스 (pipeline()의 인자)
+     * @param score 평활화된 키워드 확률
+     */
+    using WakeWordCallback = std::function<void(size_t session, float score)>;
+
+    /**
+     * @brief 생성자
+     * @param config 세션 설정
+     * @param workers Python 워커 풀 (이미 시작된 상태, 세션보다 오래 유지해야 함)
+     * @param sharedAudio 공유 메모리 오디오 링 (nullptr이면 파이프 전송, 슬롯은 세션이 나눠 씀)
+     */
+    SessionManager(SessionManagerConfig config, PythonWorkerPool& workers,
+                   SharedAudioRing* sharedAudio = nullptr);
+
+    /**
+     * @brief 소멸자 - 진행 중인 요청을 마친 뒤 종료
+     */
+    ~SessionManager();
+
+    // 복사 금지
+    SessionManager(const SessionManager&) = delete;
+    SessionManager& operator=(const SessionManager&) = delete;
+
+    /**
+     * @brief 장치를 열고 세션 생성
+     * @return 세션이 하나라도 열렸는지 여부 (열 수 없는 장치는 건너뜀)
+     */
+    bool start();
+
+    /**
+     * @brief 웨이크워드 검출 스레드 시작 (start()와 파이프라인 설정 이후에 호출)
+     * @param callback 검출 콜백
+     * @return 성공 여부 (검출 중인 세션이 없거나 이미 실행 중이면 false)
+     */
+    bool startWakeWord(WakeWordCallback callback);
+
+    /**
+     * @brief 열린 세션 수
+     */
+    size_t size() const { return m_sessions.size(); }
+
+    /**
+     * @brief 세션의 파이프라인
+     * @param index 세션 인덱스 (0 ~ size()-1)
+     */
+    VoicePipeline& pipeline(size_t index) { return *m_sessions[index]->pipeline; }
+
+    /**
+     * @brief 세션 ID (요청 ID 상위 32비트, 장치가 하나이면 0)
+     */
+    uint32_t sessionId(size_t index) const { return m_sessions[index]->id; }
+
+    /**
+     * @brief 세션의 캡처 장치 이름 (설정 값, 기본 장치는 빈 문자열)
+     */
+    const std::string& device(size_t index) const { return m_sessions[index]->device; }
+
+    /**
+     * @brief 웨이크워드 검출 중인 세션 수
+     */
+    size_t wakeWordSessions() const;
+
+    /**
+     * @brief 모든 파이프라인에 같은 설정 적용 (start() 이후, 요청 제출 전에 호출)
+     */
+    void forEachPipeline(const std::function<void(VoicePipeline&)>& fn);
+
+    /**
+     * @brief 모든 세션의 처리 중인 요청 취소 (블로킹 없음)
+     * @return 취소된 요청 수
+     */
+    size_t cancelAll();
+
+    /**
+     * @brief 웨이크워드 검출 중지, 파이프라인과 공유 풀 종료
+     */
+    void shutdown();
+
+private:
+    /**
+     * @brief 장치 하나의 처리 단위 (소멸 순서: 파이프라인 → 캡처 → 검출기)
+     */
+    struct Session {
+        uint32_t id = 0;
+        std::string device;
+        std::unique_ptr<WakeWordDetector> wakeWord;   // nullptr이면 핫키로만 동작
+        std::unique_ptr<AudioCapture> capture;
+        std::unique_ptr<VoicePipeline> pipeline;
+    };
+
+    void runWakeWord();
+
+    SessionManagerConfig m_config;
+    PythonWorkerPool& m_workers;
+    SharedAudioRing* m_sharedAudio;
+    WakeWordCallback m_wakeWordCallback;
+
+    std::unique_ptr<ThreadPool> m_executor;            // 세션보다 먼저 만들고 나중에 정리
+    std::vector<std::unique_ptr<Session>> m_sessions;
+
+    // 웨이크워드 검출 스레드 (모든 세션 공용)
+    std::thread m_wakeThread;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    bool m_stopping;                                   // m_wakeMutex로 보호
+};
+
+} // namespace sion
+
+#endif // SESSION_MANAGER_H
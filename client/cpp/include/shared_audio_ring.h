@@ -0,0 +1,123 @@
+#pragma once
+
+#ifndef SHARED_AUDIO_RING_H
+#define SHARED_AUDIO_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sion {
+
+/**
+ * @brief 프로세스 간 공유 메모리 오디오 슬롯 링
+ *
+ * Windows는 이름 있는 파일 매핑, POSIX는 shm_open + mmap으로 만든 영역을
+ * 고정 크기 발화 슬롯으로 나눕니다. AudioCapture가 슬롯에 샘플을 직접 기록하고,
+ * 파이프로는 AUDIO_SHM(슬롯/오프셋/샘플 수)만 보내므로 샘플이 커널 파이프
+ * 버퍼를 거치지 않습니다. Python 워커는 같은 이름으로 열어 numpy.frombuffer로
+ * 복사 없이 봅니다 (client/python/shared_audio.py).
+ *
+ * 영역 레이아웃 (리틀 엔디언):
+ *   [헤더 64B: magic | version | slotCount | slotSamples | sampleRate | dataOffset | slotStride]
+ *   [슬롯 0][슬롯 1]... (각 슬롯은 64바이트 정렬, slotSamples개의 int16)
+ *
+ * 슬롯 소유권은 생성한 프로세스만 관리합니다. 요청이 끝나면(최종 결과/취소/실패)
+ * releaseSlot()으로 반환하며, 워커는 AUDIO_SHM을 받는 즉시 구간을 읽습니다.
+ */
+class SharedAudioRing {
+public:
+    static constexpr uint32_t kMagic = 0x31524153;     // "SAR1"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 64;
+
+    SharedAudioRing();
+
+    /**
+     * @brief 소멸자 - close() 호출
+     */
+    ~SharedAudioRing();
+
+    // 복사 금지
+    SharedAudioRing(const SharedAudioRing&) = delete;
+    SharedAudioRing& operator=(const SharedAudioRing&) = delete;
+
+    /**
+     * @brief 공유 메모리 영역 생성
+     * @param name 영역 이름 (POSIX는 앞에 '/'를 붙여 shm_open)
+     * @param slotCount 슬롯 수
+     * @param slotSamples 슬롯당 최대 샘플 수
+     * @param sampleRate 샘플링 레이트 (워커에 전달용)
+     * @return 성공 여부
+     */
+    bool create(const std::string& name, size_t slotCount, size_t slotSamples, int sampleRate);
+
+    /**
+     * @brief 매핑 해제 및 영역 삭제
+     */
+    void close();
+
+    /**
+     * @brief 영역이 생성되어 있는지 확인
+     */
+    bool isOpen() const { return m_base != nullptr; }
+
+    /**
+     * @brief 영역 이름 (워커 --shm 인자)
+     */
+    const std::string& name() const { return m_name; }
+
+    /**
+     * @brief 빈 슬롯 확보
+     * @return 슬롯 번호 (빈 슬롯이 없으면 -1)
+     */
+    int acquireSlot();
+
+    /**
+     * @brief 슬롯 반환
+     * @param slot acquireSlot()이 반환한 번호
+     */
+    void releaseSlot(int slot);
+
+    /**
+     * @brief 슬롯 샘플 영역
+     * @param slot 슬롯 번호
+     * @return 샘플 시작 주소 (slotCapacity()개 기록 가능)
+     */
+    int16_t* slotData(int slot);
+
+    /**
+     * @brief 슬롯당 최대 샘플 수
+     */
+    size_t slotCapacity() const { return m_slotSamples; }
+
+    /**
+     * @brief 슬롯 수
+     */
+    size_t slotCount() const { return m_inUse.size(); }
+
+    /**
+     * @brief 빈 슬롯 수
+     */
+    size_t freeSlots() const;
+
+private:
+    std::string m_name;
+    uint8_t* m_base;
+    size_t m_mappedSize;
+    size_t m_slotSamples;
+    size_t m_slotStride;
+
+    mutable std::mutex m_mutex;
+    std::vector<bool> m_inUse;
+
+#ifdef _WIN32
+    void* m_mapping;    // HANDLE
+#endif
+};
+
+} // namespace sion
+
+#endif // SHARED_AUDIO_RING_H
@@ -0,0 +1,87 @@
+#pragma once
+
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace sion {
+
+/**
+ * @brief 연속 구간에 대한 비소유 뷰 (C++20 std::span의 C++17 대체)
+ *
+ * 포인터와 길이만 담으므로 값으로 전달해도 복사 비용이 없습니다.
+ * 가리키는 메모리의 수명은 호출자가 보장해야 합니다.
+ * std::vector에서 암시적으로 변환되어 기존 호출부를 그대로 쓸 수 있습니다.
+ *
+ * @tparam T 원소 타입 (읽기 전용 뷰는 const T)
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(T* data, size_t size) noexcept
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    Span(std::vector<U>& vector) noexcept
+        : m_data(vector.data())
+        , m_size(vector.size())
+    {
+    }
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<const U (*)[], T (*)[]>::value>>
+    Span(const std::vector<U>& vector) noexcept
+        : m_data(vector.data())
+        , m_size(vector.size())
+    {
+    }
+
+    // Span<T> → Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    constexpr Span(const Span<U>& other) noexcept
+        : m_data(other.data())
+        , m_size(other.size())
+    {
+    }
+
+    constexpr T* data() const noexcept { return m_data; }
+    constexpr size_t size() const noexcept { return m_size; }
+    constexpr size_t size_bytes() const noexcept { return m_size * sizeof(T); }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+
+    constexpr T& operator[](size_t index) const noexcept { return m_data[index]; }
+
+    constexpr iterator begin() const noexcept { return m_data; }
+    constexpr iterator end() const noexcept { return m_data + m_size; }
+
+    /**
+     * @brief 앞에서 count개
+     */
+    constexpr Span first(size_t count) const noexcept { return Span(m_data, count); }
+
+    /**
+     * @brief offset부터 count개 (count 생략 시 끝까지)
+     */
+    constexpr Span subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const noexcept {
+        return Span(m_data + offset, count == static_cast<size_t>(-1) ? m_size - offset : count);
+    }
+
+private:
+    T* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace sion
+
+#endif // SPAN_H
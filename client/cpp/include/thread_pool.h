@@ -0,0 +1,146 @@
+#pragma once
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sion {
+
+/**
+ * @brief 고정 크기 작업 스레드 풀
+ *
+ * FIFO 큐에 넣은 작업을 작업 스레드가 순서대로 꺼내 실행합니다.
+ * 스레드가 1개이면 제출 순서대로 실행되는 직렬 큐(파이프라인 단계)로 동작합니다.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief 생성자
+     * @param numThreads 작업 스레드 수 (최소 1)
+     * @param name 스레드 이름 (로그용)
+     */
+    explicit ThreadPool(size_t numThreads = 1, std::string name = "pool");
+
+    /**
+     * @brief 소멸자 - 남은 작업을 모두 실행한 뒤 종료
+     */
+    ~ThreadPool();
+
+    // 복사 금지
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief 작업 제출 (결과 없음)
+     * @param task 실행할 작업
+     * @return 큐에 들어갔는지 여부 (종료 중이면 false)
+     */
+    bool post(Task task);
+
+    /**
+     * @brief 작업 제출 (future로 결과 반환)
+     * @param fn 실행할 함수
+     * @return 결과 future (종료 중이면 broken_promise 예외를 담은 future)
+     */
+    template <typename F>
+    auto submit(F&& fn) -> std::future<typename std::invoke_result<std::decay_t<F>>::type> {
+        using Result = typename std::invoke_result<std::decay_t<F>>::type;
+
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+        std::future<Result> future = task->get_future();
+        post([task]() { (*task)(); });
+        return future;
+    }
+
+    /**
+     * @brief 새 작업 수신을 중단하고 남은 작업을 실행한 뒤 스레드 종료
+     */
+    void shutdown();
+
+    /**
+     * @brief 대기 중인 작업 수
+     */
+    size_t pendingTasks() const;
+
+    /**
+     * @brief 작업 스레드 수
+     */
+    size_t threadCount() const { return m_threads.size(); }
+
+private:
+    void workerLoop();
+
+    std::string m_name;
+    std::vector<std::thread> m_threads;
+    std::deque<Task> m_queue;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopping;
+};
+
+/**
+ * @brief 공유 ThreadPool 위의 직렬 큐 (strand)
+ *
+ * 제출 순서대로 한 번에 하나씩 실행하되 전용 스레드 없이 풀의 작업 스레드를 빌려 씁니다.
+ * 작업 하나를 마칠 때마다 남은 작업을 풀 큐 뒤로 다시 넣으므로, 같은 풀을 쓰는
+ * 여러 직렬 큐(캡처 세션별 파이프라인 단계)가 번갈아 실행됩니다.
+ */
+class SerialQueue {
+public:
+    using Task = ThreadPool::Task;
+
+    /**
+     * @brief 생성자
+     * @param pool 작업을 실행할 풀 (직렬 큐보다 오래 유지해야 함)
+     * @param name 큐 이름 (로그용)
+     */
+    SerialQueue(ThreadPool& pool, std::string name);
+
+    /**
+     * @brief 소멸자 - 남은 작업을 모두 실행할 때까지 대기
+     */
+    ~SerialQueue();
+
+    // 복사 금지
+    SerialQueue(const SerialQueue&) = delete;
+    SerialQueue& operator=(const SerialQueue&) = delete;
+
+    /**
+     * @brief 작업 제출
+     * @param task 실행할 작업
+     * @return 큐에 들어갔는지 여부 (종료 중이거나 풀이 종료되었으면 false)
+     */
+    bool post(Task task);
+
+    /**
+     * @brief 새 작업 수신을 중단하고 남은 작업이 끝날 때까지 대기 (큐의 작업 안에서 호출 금지)
+     */
+    void shutdown();
+
+private:
+    void runNext();
+
+    ThreadPool& m_pool;
+    std::string m_name;
+    std::deque<Task> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_idleCv;
+    bool m_scheduled;        // 풀에 실행이 예약되었거나 실행 중 (false이면 큐가 빔)
+    bool m_stopping;
+};
+
+} // namespace sion
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,181 @@
+#pragma once
+
+#ifndef UTTERANCE_JOURNAL_H
+#define UTTERANCE_JOURNAL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "latency_trace.h"
+#include "thread_pool.h"
+
+namespace sion {
+
+/**
+ * @brief 발화 저널 설정
+ */
+struct UtteranceJournalConfig {
+    std::string directory;                     // 세그먼트 디렉토리 (비어 있으면 사용 안 함)
+    size_t segmentBytes = 16u << 20;           // 세그먼트 파일 하나의 크기 (차면 다음 파일로)
+    size_t maxBytes = 256u << 20;              // 세그먼트 전체 상한 (넘으면 오래된 세그먼트부터 삭제)
+    size_t maxPendingBytes = 8u << 20;         // 기록 대기 중인 오디오 상한 (넘으면 그 발화는 기록 생략)
+};
+
+/**
+ * @brief 저널에 기록된 발화 하나
+ */
+struct JournalRecord {
+    uint64_t requestId = 0;
+    int64_t wallClockMs = 0;                   // 녹음 완료 시각 (Unix ms)
+    int64_t startedAtNs = 0;                   // 요청 제출 시각 (trace::now(), 같은 실행 안에서만 의미)
+    int sampleRate = 0;
+    std::vector<int16_t> samples;              // PCM s16le 모노 (앞뒤 무음 제거 후 전송한 그대로)
+    std::array<int64_t, trace::kStageCount> stageNs{};   // 구간별 지연 합계 (ns, 기록 없으면 0)
+    std::string transcript;                    // 인식 텍스트 (없으면 빈 문자열)
+    std::string intent;                        // NLU 의도 JSON (없으면 빈 문자열)
+    std::string result;                        // FINAL_RESULT 페이로드 전체 (실패 시 빈 문자열)
+};
+
+/**
+ * @brief 추가 전용 발화 저널 (디버깅/재생용)
+ *
+ * 발화마다 녹음 샘플과 메타데이터(시각, 구간별 지연, 인식 텍스트, 의도)를
+ * 세그먼트 파일(utterances-NNNNNN.sionj)에 이어 씁니다. 세그먼트는 segmentBytes로
+ * 미리 늘린 뒤 메모리 매핑하여 기록하므로 발화마다 파일 열기/쓰기 호출이 없고,
+ * 프로세스가 비정상 종료해도 페이지 캐시에 쓴 기록은 남습니다.
+ *
+ * begin()은 녹음 버퍼가 반환되기 전에 샘플만 복사하고, commit()은 결과와 함께
+ * 저널 스레드에 기록을 넘기므로 파이프라인 단계는 디스크를 기다리지 않습니다.
+ * 기록 대기 중인 오디오가 maxPendingBytes를 넘거나 저널 스레드가 밀리면 그 발화는
+ * 건너뜁니다 (기회적 기록, trace 카운터 journal-dropped).
+ *
+ * 레코드는 헤더를 마지막에 써서 완성된 것만 보이게 하므로 기록 중인 세그먼트도
+ * forEachRecord()로 읽을 수 있습니다. "file:<세그먼트>#<레코드 번호>" 캡처 장치와
+ * sion_bench 재생 벤치마크가 이 형식을 그대로 재생합니다.
+ */
+class UtteranceJournal {
+public:
+    /**
+     * @brief 생성자
+     * @param config 저널 설정
+     */
+    explicit UtteranceJournal(UtteranceJournalConfig config);
+
+    /**
+     * @brief 소멸자 - 대기 중인 기록을 마친 뒤 세그먼트 닫기
+     */
+    ~UtteranceJournal();
+
+    // 복사 금지
+    UtteranceJournal(const UtteranceJournal&) = delete;
+    UtteranceJournal& operator=(const UtteranceJournal&) = delete;
+
+    /**
+     * @brief 디렉토리를 만들고 새 세그먼트 열기 (기존 세그먼트는 이어서 번호를 매기고 상한에 맞게 정리)
+     * @return 성공 여부
+     */
+    bool open();
+
+    /**
+     * @brief 기록 중인지 확인
+     */
+    bool isOpen() const { return m_open; }
+
+    /**
+     * @brief 발화 녹음 등록 (샘플은 호출 중에 복사하므로 반환 즉시 버퍼 재사용 가능)
+     * @param requestId 요청 ID
+     * @param samples PCM s16le 모노 샘플
+     * @param sampleCount 샘플 수
+     * @param sampleRate 샘플링 레이트 (Hz)
+     * @param startedAtNs 요청 제출 시각 (trace::now())
+     * @return 등록 여부 (닫혀 있거나 대기 상한을 넘으면 false)
+     */
+    bool begin(uint64_t requestId, const int16_t* samples, size_t sampleCount, int sampleRate,
+               int64_t startedAtNs);
+
+    /**
+     * @brief 결과와 함께 기록 요청 (블로킹 없음, begin()하지 않은 요청이면 무시)
+     * @param requestId 요청 ID
+     * @param result FINAL_RESULT 페이로드 (실패 시 빈 문자열)
+     */
+    void commit(uint64_t requestId, const std::string& result);
+
+    /**
+     * @brief 기록하지 않고 등록 취소 (취소된 요청)
+     */
+    void discard(uint64_t requestId);
+
+    /**
+     * @brief 대기 중인 기록을 마치고 세그먼트를 파일 끝에 맞춰 닫기 (이후 begin()은 false)
+     */
+    void close();
+
+    /**
+     * @brief 세그먼트의 레코드 순회 (기록 중인 세그먼트도 완성된 레코드까지 읽음)
+     * @param path 세그먼트 파일 경로
+     * @param fn 레코드 콜백 (index: 세그먼트 안의 0부터 시작하는 번호, false를 반환하면 중단)
+     * @return 읽은 레코드 수 (세그먼트가 아니면 0)
+     */
+    static size_t forEachRecord(const std::string& path,
+                                const std::function<bool(size_t index, const JournalRecord& record)>& fn);
+
+    /**
+     * @brief 세그먼트의 레코드 하나 읽기
+     * @param path 세그먼트 파일 경로
+     * @param index 레코드 번호 (0부터)
+     * @param record 출력: 레코드
+     * @return 성공 여부
+     */
+    static bool readRecord(const std::string& path, size_t index, JournalRecord& record);
+
+    /**
+     * @brief 세그먼트 파일 확장자 (".sionj")
+     */
+    static constexpr const char* kExtension = ".sionj";
+
+private:
+    struct Segment {
+        std::string path;
+        size_t bytes = 0;
+    };
+
+    void write(const JournalRecord& record);
+    bool openSegment(size_t minBytes);
+    void closeSegment();
+
+    UtteranceJournalConfig m_config;
+    bool m_open;
+
+    // begin()~commit() 사이의 발화 (파이프라인 스레드가 쓰고 저널 스레드가 꺼냄)
+    std::mutex m_mutex;
+    std::unordered_map<uint64_t, JournalRecord> m_pending;
+    size_t m_pendingBytes;                     // 등록~기록 완료 전 오디오 바이트
+    std::vector<std::vector<int16_t>> m_spare; // 기록을 마친 샘플 버퍼 (재할당 방지)
+
+    // 저널 스레드 전용
+    std::deque<Segment> m_segments;            // 번호 순 (마지막이 기록 중인 세그먼트)
+    size_t m_totalBytes;                       // m_segments 크기 합
+    size_t m_nextIndex;
+    uint8_t* m_base;                           // 기록 중인 세그먼트 매핑 (nullptr이면 없음)
+    size_t m_capacity;
+    size_t m_used;
+#ifdef _WIN32
+    void* m_file;                              // HANDLE
+    void* m_mapping;                           // HANDLE
+#else
+    int m_fd;
+#endif
+
+    ThreadPool m_writer;                       // 기록 큐 (스레드 1개, 세그먼트 상태가 하나이므로)
+};
+
+} // namespace sion
+
+#endif // UTTERANCE_JOURNAL_H
@@ -0,0 +1,126 @@
+#pragma once
+
+#ifndef VOICE_ACTIVITY_DETECTOR_H
+#define VOICE_ACTIVITY_DETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sion {
+
+/**
+ * @brief VAD/엔드포인팅 설정
+ */
+struct VadConfig {
+    int sampleRate = 16000;          // 샘플링 레이트 (Hz)
+    int calibrationMs = 150;         // 잡음 레벨 추정 구간 (ms)
+    float minRms = 300.0f;           // 음성으로 인정할 최소 RMS (int16 스케일)
+    float noiseRatio = 3.0f;         // 잡음 대비 음성 에너지 배율
+    float maxZcr = 0.45f;            // 이보다 높은 영교차율은 마찰음/잡음으로 간주
+    int minSpeechMs = 60;            // 발화 시작으로 판정할 연속 음성 길이 (ms)
+    int trailingSilenceMs = 600;     // 발화 종료로 판정할 후행 무음 길이 (ms)
+    int leadingPaddingMs = 150;      // 발화 시작 전 보존할 길이 (ms)
+    int trailingPaddingMs = 200;     // 발화 종료 후 보존할 길이 (ms)
+    float noSpeechTimeout = 4.0f;    // 발화가 없을 때 포기하는 시간 (초)
+};
+
+/**
+ * @brief 엔드포인터 이벤트
+ */
+enum class VadEvent {
+    None,           // 상태 변화 없음
+    SpeechStart,    // 발화 시작 감지
+    SpeechEnd,      // 후행 무음 감지 - 녹음 종료
+    NoSpeech        // 제한 시간 내 발화 없음
+};
+
+/**
+ * @brief 에너지/영교차율 기반 음성 구간 검출 및 엔드포인팅
+ *
+ * 캡처 프레임을 순서대로 받아 잡음 레벨을 추정하고, 발화 시작/종료를
+ * 판정합니다. 샘플 위치는 reset() 이후 누적 샘플 인덱스로 보고되며,
+ * 앞뒤 무음을 잘라낼 구간([trimBegin, trimEnd))을 계산합니다.
+ * 할당이 없으므로 캡처 스레드에서 직접 호출해도 됩니다.
+ */
+class VoiceActivityDetector {
+public:
+    /**
+     * @brief 생성자
+     * @param config VAD 설정
+     */
+    explicit VoiceActivityDetector(const VadConfig& config = VadConfig{});
+
+    /**
+     * @brief 새 발화를 위해 상태 초기화
+     */
+    void reset();
+
+    /**
+     * @brief 프레임 처리
+     * @param samples 모노 int16 샘플
+     * @param count 샘플 수
+     * @return 이 프레임에서 발생한 이벤트
+     */
+    VadEvent process(const int16_t* samples, size_t count);
+
+    /**
+     * @brief 발화가 진행 중인지 확인
+     */
+    bool inSpeech() const { return m_state == State::Speech; }
+
+    /**
+     * @brief 엔드포인트(종료 또는 타임아웃)에 도달했는지 확인
+     */
+    bool isFinished() const { return m_state == State::Finished; }
+
+    /**
+     * @brief 패딩을 포함한 발화 시작 샘플 위치
+     */
+    size_t trimBegin() const;
+
+    /**
+     * @brief 패딩을 포함한 발화 종료 샘플 위치 (exclusive)
+     * @param totalSamples 실제로 캡처된 샘플 수
+     */
+    size_t trimEnd(size_t totalSamples) const;
+
+    /**
+     * @brief 발화가 한 번이라도 감지되었는지 확인
+     */
+    bool hasSpeech() const { return m_speechDetected; }
+
+    /**
+     * @brief 현재 추정 잡음 RMS
+     */
+    float noiseFloor() const { return m_noiseFloor; }
+
+    /**
+     * @brief 설정 반환
+     */
+    const VadConfig& getConfig() const { return m_config; }
+
+private:
+    enum class State { Waiting, Speech, Finished };
+
+    size_t msToSamples(int ms) const;
+    bool isSpeechFrame(float rms, float zcr) const;
+
+    VadConfig m_config;
+    State m_state;
+
+    size_t m_position;           // 누적 샘플 수
+    size_t m_calibrationSamples;
+    double m_noiseSum;
+    size_t m_noiseFrames;
+    float m_noiseFloor;
+
+    size_t m_speechRun;          // 연속 음성 샘플 수
+    size_t m_silenceRun;         // 연속 무음 샘플 수
+    size_t m_speechStart;        // 발화 시작 위치
+    size_t m_speechEnd;          // 마지막 음성 프레임 끝 위치
+    bool m_speechDetected;
+};
+
+} // namespace sion
+
+#endif // VOICE_ACTIVITY_DETECTOR_H
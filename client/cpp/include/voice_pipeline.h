@@ -0,0 +1,298 @@
+#pragma once
+
+#ifndef VOICE_PIPELINE_H
+#define VOICE_PIPELINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "asr_stream_client.h"
+#include "audio_buffer_pool.h"
+#include "audio_capture.h"
+#include "audio_encoder.h"
+#include "bridge_protocol.h"
+#include "cancellation_token.h"
+#include "local_asr.h"
+#include "python_worker_pool.h"
+#include "response_cache.h"
+#include "shared_audio_ring.h"
+#include "thread_pool.h"
+#include "utterance_journal.h"
+#include "voice_activity_detector.h"
+#include "wav_buffer.h"
+
+namespace sion {
+
+/**
+ * @brief 음성 명령 처리 파이프라인
+ *
+ * 핫키 스레드는 submit()으로 요청만 넣고 즉시 돌아갑니다.
+ * 처리는 세 단계(각각 SerialQueue)로 나뉘어 겹쳐 실행됩니다.
+ *
+ *   capture: 발화 종료까지 녹음 (WavBuffer에 직접 기록)
+ *   send:    워커 풀에서 워커를 골라 PCM을 스트리밍하고 버퍼 반환
+ *   result:  응답 대기 후 결과 콜백 호출 (제출 순서 유지)
+ *
+ * 따라서 발화 N의 ASR/NLU 응답을 기다리는 동안 발화 N+1을 녹음·전송할 수 있습니다.
+ * 단계는 executor 풀의 스레드를 빌려 쓰므로, 캡처 장치마다 파이프라인을 두는
+ * SessionManager는 풀 하나로 여러 세션을 돌립니다 (지정하지 않으면 3스레드 풀을 소유).
+ * WavBuffer는 미리 할당한 AudioBufferPool에서 재사용하며, 풀이 비면 새 요청을 거절합니다.
+ *
+ * SharedAudioRing을 넘기면 WavBuffer 대신 공유 메모리 슬롯에 직접 녹음하고
+ * 파이프로는 AUDIO_SHM 위치 정보만 보냅니다. 워커가 슬롯을 읽는 시점을
+ * 알 수 없으므로 슬롯은 최종 결과(또는 취소/실패)까지 요청이 소유합니다.
+ *
+ * setCodec()으로 코덱을 지정하면 send 단계가 조각 단위로 인코딩하면서 전송하고
+ * (워커가 READY에서 해당 코덱을 알린 경우만), 아니면 기존 PCM/AUDIO_SHM 경로를 씁니다.
+ * 인코딩한 발화는 전송이 끝나면 슬롯도 바로 반환합니다.
+ *
+ * setAsrClient()로 ASR 직접 연결을 지정하면 send 단계는 발화를 ASR 서비스로 바로
+ * 스트리밍하고, result 단계가 인식 텍스트를 받아 워커에 TRANSCRIPT로 넘깁니다
+ * (워커는 NLU/작업 실행만 수행). 연결할 수 없으면 발화별로 기존 워커 경로를 씁니다.
+ *
+ * setLocalAsr()로 로컬 ASR을 지정하면 짧은 명령(또는 원격 ASR 연결이 없을 때의 모든 발화)은
+ * send 단계가 내장 엔진에 넘기고 result 단계가 인식 텍스트를 워커에 TRANSCRIPT로 넘깁니다.
+ * 로컬 인식이 실패하면 원격 경로로 다시 보낼 수 있도록 녹음 버퍼는 인식이 끝날 때까지 유지합니다.
+ *
+ * setResponseCache()로 응답 캐시를 지정하면 send 단계는 발화 지문이 캐시와 가까울 때
+ * ASR을 생략하고, 인식 텍스트의 의도가 캐시에 있으면 워커에 INTENT로 넘겨 NLU를 생략합니다.
+ * 최종 결과의 인식 텍스트/의도는 다음 요청을 위해 캐시에 저장합니다.
+ *
+ * setSpeculativeNlu(true)이면 ASR 직접 연결의 중간 결과 중 연속한 두 결과가 일치하는
+ * 앞부분(단어 단위)을 워커에 SPECULATE로 미리 보내, 최종 인식 텍스트를 기다리는 동안
+ * NLU와 작업 준비가 진행되게 합니다. 최종 텍스트는 추측을 보낸 워커로 보내며,
+ * 워커가 텍스트가 같은지 보고 추측 결과를 확정하거나 버립니다.
+ * ASR 서비스는 PCM 스트림에만 중간 결과(발화 앞부분 인식)를 주므로, 이때 ASR 직접
+ * 연결로는 setCodec()의 코덱 대신 PCM으로 보냅니다.
+ *
+ * setJournal()로 발화 저널을 지정하면 녹음이 끝날 때 샘플을 저널에 복사해 두고,
+ * 결과 콜백 직전에 결과와 함께 기록을 넘깁니다 (기록은 저널 스레드에서, 취소된 요청은 버림).
+ *
+ * 요청마다 CancellationToken을 두어 cancel() 시 녹음 스트림 중지,
+ * 남은 조각 전송 생략, Python 작업 CANCEL을 단계와 관계없이 즉시 수행합니다.
+ * 취소된 요청은 결과 콜백을 호출하지 않습니다.
+ */
+class VoicePipeline {
+public:
+    /**
+     * @brief 최종 결과 콜백 (result 스레드에서 호출)
+     * @param requestId submit()이 반환한 요청 ID
+     * @param result 처리 결과 (실패/무음 시 빈 문자열)
+     */
+    using ResultCallback = std::function<void(uint64_t requestId, const std::string& result)>;
+
+    /**
+     * @brief 생성자
+     * @param capture 오디오 캡처 객체 (이미 초기화된 상태)
+     * @param vadConfig 발화 종료 검출 설정
+     * @param workers Python 워커 풀 (이미 시작된 상태)
+     * @param maxInFlight 동시에 처리할 수 있는 최대 발화 수 (버퍼 풀 크기)
+     * @param sharedAudio 공유 메모리 오디오 링 (nullptr이면 파이프로 PCM 전송,
+     *                    지정 시 동시 처리 수는 슬롯 수로 제한됨)
+     * @param executor 단계 작업을 실행할 공유 풀 (nullptr이면 전용 풀 생성,
+     *                 지정 시 파이프라인보다 오래 유지해야 함)
+     */
+    VoicePipeline(AudioCapture& capture, const VadConfig& vadConfig,
+                  PythonWorkerPool& workers, size_t maxInFlight = 2,
+                  SharedAudioRing* sharedAudio = nullptr, ThreadPool* executor = nullptr);
+
+    /**
+     * @brief 소멸자 - 진행 중인 요청을 마친 뒤 종료
+     */
+    ~VoicePipeline();
+
+    // 복사 금지
+    VoicePipeline(const VoicePipeline&) = delete;
+    VoicePipeline& operator=(const VoicePipeline&) = delete;
+
+    /**
+     * @brief 음성 명령 요청 제출 (블로킹 없음)
+     * @return 요청 ID (녹음 중이거나 버퍼가 모두 사용 중이면 0)
+     */
+    uint64_t submit();
+
+    /**
+     * @brief 푸시투토크 요청 시작 (키 누름, 블로킹 없음)
+     *
+     * VAD 엔드포인팅 대신 endHold()가 호출될 때까지 녹음합니다.
+     * @return 요청 ID (녹음 중이거나 버퍼가 모두 사용 중이면 0)
+     */
+    uint64_t beginHold();
+
+    /**
+     * @brief 푸시투토크 녹음 종료 (키 뗌, 블로킹 없음)
+     *
+     * 녹음은 capture 스레드에서 끝나고 이후 단계는 submit()과 같습니다.
+     * @return 진행 중인 푸시투토크 녹음이 있었는지 여부
+     */
+    bool endHold();
+
+    /**
+     * @brief 처리 중인 모든 요청 취소 (블로킹 없음, 핫키 스레드에서 호출 가능)
+     * @return 취소된 요청 수
+     */
+    size_t cancelAll();
+
+    /**
+     * @brief 특정 요청 취소
+     * @param requestId submit()이 반환한 요청 ID
+     * @return 처리 중인 요청이었는지 여부
+     */
+    bool cancel(uint64_t requestId);
+
+    /**
+     * @brief 전송 코덱 설정 (submit() 전에 호출)
+     * @param codec 코덱 (빌드에 없는 코덱이면 PCM 유지)
+     * @return 설정된 코덱
+     */
+    protocol::AudioCodec setCodec(protocol::AudioCodec codec);
+
+    /**
+     * @brief 캡처 세션 ID 설정 (submit() 전에 호출)
+     *
+     * 요청 ID 상위 32비트에 세션 ID를 담아 세션 사이에 요청 ID가 겹치지 않게 하고,
+     * 브릿지가 워커에 SESSION 프레임을 보내게 합니다 (0이면 보내지 않음).
+     */
+    void setSessionId(uint32_t session) { m_nextRequestId = protocol::firstRequestOfSession(session); }
+
+    /**
+     * @brief ASR 직접 연결 설정 (submit() 전에 호출, nullptr이면 워커가 ASR까지 수행)
+     * @param client 스트리밍 ASR 클라이언트 (파이프라인보다 오래 유지해야 함)
+     */
+    void setAsrClient(AsrStreamClient* client) { m_asr = client; }
+
+    /**
+     * @brief 로컬 ASR 설정 (submit() 전에 호출, nullptr이면 원격 ASR만 사용)
+     * @param engine 로드된 로컬 ASR 엔진 (파이프라인보다 오래 유지해야 함)
+     */
+    void setLocalAsr(LocalAsrEngine* engine) { m_localAsr = engine; }
+
+    /**
+     * @brief 응답 캐시 설정 (submit() 전에 호출, nullptr이면 캐시 사용 안 함)
+     * @param cache 응답 캐시 (파이프라인보다 오래 유지해야 함)
+     */
+    void setResponseCache(ResponseCache* cache) { m_cache = cache; }
+
+    /**
+     * @brief 발화 저널 설정 (submit() 전에 호출, nullptr이면 기록 안 함)
+     * @param journal 열린 발화 저널 (파이프라인보다 오래 유지해야 함)
+     */
+    void setJournal(UtteranceJournal* journal) { m_journal = journal; }
+
+    /**
+     * @brief 중간 인식 결과로 추측 NLU 사용 여부 (submit() 전에 호출, ASR 직접 연결에서만 동작, 켜면 PCM 전송)
+     */
+    void setSpeculativeNlu(bool enabled) { m_speculate = enabled; }
+
+    /**
+     * @brief 중간 결과 콜백 설정 (브릿지 수신 스레드에서 호출)
+     */
+    void setPartialCallback(PartialResultCallback callback);
+
+    /**
+     * @brief 최종 결과 콜백 설정
+     */
+    void setResultCallback(ResultCallback callback);
+
+    /**
+     * @brief 새 요청을 거절하고 진행 중인 요청을 마친 뒤 단계 종료
+     */
+    void shutdown();
+
+    /**
+     * @brief 현재 처리 중인 요청 수
+     */
+    size_t inFlight() const { return m_inFlight.load(); }
+
+private:
+    using TokenPtr = std::shared_ptr<CancellationToken>;
+
+    /**
+     * @brief 요청 하나의 녹음 버퍼 (WavBuffer 또는 공유 메모리 슬롯)
+     */
+    struct Utterance {
+        AudioBufferPool::Handle wav;  // 소멸 시 풀로 자동 반환
+        int slot = -1;
+        size_t sampleCount = 0;       // 슬롯 모드에서 기록된 샘플 수
+        TokenPtr stop;                // 푸시투토크 종료 신호 (nullptr이면 VAD 엔드포인팅)
+        int64_t startedAt = 0;        // 요청 제출 시각 (trace::now(), EndToEnd 구간)
+        AudioFingerprint fingerprint; // 응답 캐시 지문 계층용 (무효면 저장하지 않음)
+        bool remoteOnly = false;      // 로컬 인식 실패 후 원격으로 다시 보낼 때
+    };
+    // std::function은 복사 가능해야 하므로 단계 사이에는 shared_ptr로 전달
+    using UtterancePtr = std::shared_ptr<Utterance>;
+
+    /**
+     * @brief 요청 하나의 추측 NLU 상태 (ASR 수신 스레드와 result 단계가 공유)
+     */
+    struct Speculation {
+        std::mutex mutex;
+        std::string lastPartial;              // 직전 중간 결과
+        std::string sent;                     // 마지막으로 보낸 안정된 앞부분
+        size_t count = 0;                     // 보낸 횟수
+        PythonWorkerPool::WorkerPtr worker;   // 추측을 보낸 워커 (최종 텍스트도 이 워커로)
+    };
+    using SpeculationPtr = std::shared_ptr<Speculation>;
+
+    void runCapture(uint64_t requestId, TokenPtr token, UtterancePtr utterance);
+    void runSend(uint64_t requestId, TokenPtr token, UtterancePtr utterance);
+    void runResult(uint64_t requestId, TokenPtr token, PythonWorkerPool::WorkerPtr worker,
+                   uint32_t utteranceId, UtterancePtr utterance);
+    void runLocalResult(uint64_t requestId, TokenPtr token, std::shared_future<std::string> transcript,
+                        UtterancePtr utterance);
+    void runTranscriptResult(uint64_t requestId, TokenPtr token, uint32_t streamId,
+                             UtterancePtr utterance, SpeculationPtr speculation);
+    void respondToTranscript(uint64_t requestId, TokenPtr token, const std::string& transcript,
+                             UtterancePtr utterance, PythonWorkerPool::WorkerPtr worker);
+    void speculate(Speculation& speculation, const std::string& partial);
+    void finishRequest(uint64_t requestId, const CancellationToken& token, const Utterance& utterance,
+                       const std::string& result);
+
+    uint64_t startRequest(TokenPtr stop);
+
+    UtterancePtr acquireUtterance();
+    void releaseUtterance(Utterance& utterance);
+
+    AudioCapture& m_capture;
+    PythonWorkerPool& m_workers;
+    VoiceActivityDetector m_vad;         // capture 단계 전용
+    SharedAudioRing* m_sharedAudio;      // nullptr이면 파이프 전송
+    std::unique_ptr<AudioEncoder> m_encoder;   // send 단계 전용 (nullptr이면 PCM)
+    AsrStreamClient* m_asr = nullptr;          // nullptr이면 워커가 ASR 수행
+    LocalAsrEngine* m_localAsr = nullptr;      // nullptr이면 원격 ASR만
+    ResponseCache* m_cache = nullptr;          // nullptr이면 캐시 사용 안 함
+    UtteranceJournal* m_journal = nullptr;     // nullptr이면 기록 안 함
+    bool m_speculate = false;                  // ASR 중간 결과로 추측 NLU
+
+    AudioBufferPool m_buffers;           // 공유 메모리 모드에서는 비어 있음
+
+    std::mutex m_tokenMutex;
+    std::unordered_map<uint64_t, TokenPtr> m_tokens;   // 처리 중인 요청
+    TokenPtr m_holdStop;                               // 진행 중인 푸시투토크 녹음의 종료 신호
+
+    std::mutex m_callbackMutex;
+    PartialResultCallback m_partialCallback;
+    ResultCallback m_resultCallback;
+
+    std::atomic<bool> m_captureBusy;
+    std::atomic<size_t> m_inFlight;
+    std::atomic<uint64_t> m_nextRequestId;
+
+    std::unique_ptr<ThreadPool> m_ownedExecutor;   // executor를 받지 않은 경우에만
+
+    // 단계 큐 (shutdown()에서 capture → send → result 순으로 정리)
+    SerialQueue m_captureStage;
+    SerialQueue m_sendStage;
+    SerialQueue m_resultStage;
+};
+
+} // namespace sion
+
+#endif // VOICE_PIPELINE_H
@@ -0,0 +1,172 @@
+#pragma once
+
+#ifndef WAKE_WORD_DETECTOR_H
+#define WAKE_WORD_DETECTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "keyword_spotter.h"
+#include "log_mel_frontend.h"
+#include "ring_buffer.h"
+#include "span.h"
+
+namespace sion {
+
+/**
+ * @brief 웨이크워드 검출 설정
+ */
+struct WakeWordConfig {
+    std::string modelPath;           // KeywordSpotter 모델 파일 (비어 있으면 사용 안 함)
+    float threshold = 0.0f;          // 검출 임계값 (0이면 모델 기본값)
+    int inferenceIntervalMs = 40;    // 추론 간격 (오디오 시간 기준)
+    int refractoryMs = 1500;         // 검출 후 다시 검출하지 않는 구간 (오디오 시간 기준)
+    int pollIntervalMs = 50;         // 검출 스레드가 캡처 버퍼를 비우는 주기
+    int bufferMs = 1000;             // 캡처 스레드 → 검출 스레드 버퍼 길이
+};
+
+/**
+ * @brief 웨이크워드 검출 콜백 (검출 스레드에서 호출, 인자는 평활화된 키워드 확률)
+ */
+using WakeWordCallback = std::function<void(float)>;
+
+/**
+ * @brief 상시 캡처 스트림 기반 웨이크워드(키워드) 검출기
+ *
+ * feed()는 캡처 스레드에서 락프리 링 버퍼에 복사만 하고, 전용 스레드가 pollIntervalMs마다
+ * 모아서 로그 멜 특징 추출(hop마다)과 KeywordSpotter 추론(inferenceIntervalMs마다)을
+ * 수행합니다. 연속 smoothing회 추론의 평균 확률이 임계값을 넘으면 콜백을 호출하고
+ * 특징 창을 비운 뒤 refractoryMs 동안 추론을 쉽니다.
+ * 버퍼는 load()에서 모두 할당하므로 이후 처리 경로에는 할당이 없습니다.
+ */
+class WakeWordDetector {
+public:
+    /**
+     * @brief 생성자
+     * @param config 검출 설정
+     */
+    explicit WakeWordDetector(WakeWordConfig config);
+
+    /**
+     * @brief 소멸자 - 검출 스레드 종료
+     */
+    ~WakeWordDetector();
+
+    // 복사 금지
+    WakeWordDetector(const WakeWordDetector&) = delete;
+    WakeWordDetector& operator=(const WakeWordDetector&) = delete;
+
+    /**
+     * @brief 모델 로드 및 버퍼 할당
+     * @param sampleRate 캡처 샘플링 레이트 (모델과 같아야 함)
+     * @return 성공 여부
+     */
+    bool load(int sampleRate);
+
+    /**
+     * @brief 모델이 로드되었는지 확인
+     */
+    bool isLoaded() const { return m_spotter.isLoaded(); }
+
+    /**
+     * @brief 캡처 프레임 전달 (캡처 스레드 전용, 할당/락 없음)
+     *
+     * 검출 스레드가 밀려 버퍼가 가득 차면 나머지 샘플은 버리고 집계합니다.
+     */
+    void feed(Span<const int16_t> frame);
+
+    /**
+     * @brief 검출 스레드 시작
+     * @param callback 검출 콜백
+     * @return 성공 여부 (모델이 없거나 이미 실행 중이면 false)
+     */
+    bool start(WakeWordCallback callback);
+
+    /**
+     * @brief 검출 스레드 정지
+     */
+    void stop();
+
+    /**
+     * @brief feed()로 쌓인 샘플을 모두 처리 (start() 없이 한 스레드에서만 호출)
+     *
+     * 검출기 여러 개를 스레드 하나가 주기적으로 돌릴 때(SessionManager) 사용합니다.
+     * @return 이번 호출 중 검출이 있었는지 여부 (확률은 lastScore())
+     */
+    bool drain();
+
+    /**
+     * @brief 샘플을 직접 처리 (검출 스레드 또는 start() 없이 한 스레드에서만 호출)
+     * @param samples 모노 int16 샘플
+     * @param count 샘플 수
+     * @return 이번 호출 중 검출이 있었는지 여부
+     */
+    bool process(const int16_t* samples, size_t count);
+
+    /**
+     * @brief 마지막 추론의 평활화된 키워드 확률 (검출 직후에는 검출 시점 값)
+     */
+    float lastScore() const { return m_lastScore; }
+
+    /**
+     * @brief 버퍼가 가득 차 버린 샘플 수
+     */
+    uint64_t droppedSamples() const { return m_droppedSamples.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 특징 창과 평활화 상태 초기화
+     */
+    void reset();
+
+private:
+    void run();
+    void processFrame();
+
+    WakeWordConfig m_config;
+    KeywordSpotter m_spotter;
+    LogMelFrontend m_frontend;
+    float m_threshold;
+
+    size_t m_frameLength;
+    size_t m_hopLength;
+    size_t m_numMels;
+    size_t m_inferenceStride;        // 추론 간격 (프레임)
+    size_t m_refractoryFrames;
+
+    // 캡처 스레드 → 검출 스레드
+    SpscRingBuffer<int16_t> m_ring;
+    std::atomic<uint64_t> m_droppedSamples;
+
+    // 검출 스레드 전용 상태
+    std::vector<int16_t> m_chunk;    // 링 버퍼에서 꺼낸 샘플
+    std::vector<int16_t> m_frame;    // 분석 창 (마지막 hop 구간에 새 샘플을 채움)
+    size_t m_hopFill;
+    std::vector<float> m_mels;
+    std::vector<int8_t> m_features;  // [numFrames][numMels] 순환 버퍼 (양자화된 특징)
+    size_t m_featurePos;
+    size_t m_framesFilled;
+    size_t m_framesSinceInference;
+    size_t m_refractoryLeft;
+    std::vector<float> m_scores;     // 최근 smoothing회 추론 확률 (순환)
+    size_t m_scorePos;
+    size_t m_scoreCount;
+    float m_lastScore;
+    bool m_detected;
+
+    WakeWordCallback m_callback;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    bool m_running;                  // m_mutex로 보호
+};
+
+} // namespace sion
+
+#endif // WAKE_WORD_DETECTOR_H
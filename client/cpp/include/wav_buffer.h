@@ -0,0 +1,113 @@
+#pragma once
+
+#ifndef WAV_BUFFER_H
+#define WAV_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace sion {
+
+/**
+ * @brief 헤더 공간을 앞에 예약한 연속 WAV 버퍼
+ *
+ * [44바이트 WAV 헤더][int16 샘플...] 형태의 단일 메모리 블록입니다.
+ * 캡처 결과를 samples()에 직접 기록한 뒤 헤더만 제자리에 작성하면
+ * data()/size()가 곧 완성된 WAV 파일이 되므로 추가 복사가 없습니다.
+ * 용량은 줄어들지 않아 명령마다 재사용하면 재할당도 발생하지 않습니다.
+ *
+ * 저장 공간은 페이지 경계에 맞춰 할당하고 할당 직후 전체를 한 번 건드려
+ * (pre-fault) 녹음 중 첫 접근 페이지 폴트가 생기지 않게 합니다.
+ * 샘플 영역은 kSampleAlignment 경계에서 시작하여 SIMD 커널에 유리합니다.
+ */
+class WavBuffer {
+public:
+    static constexpr size_t kHeaderSize = 44;
+    static constexpr size_t kPageSize = 4096;
+    static constexpr size_t kSampleAlignment = 64;
+
+    WavBuffer() = default;
+
+    /**
+     * @brief 생성자
+     * @param capacitySamples 미리 확보할 샘플 수
+     */
+    explicit WavBuffer(size_t capacitySamples);
+
+    // 복사 금지 (이동만 허용)
+    WavBuffer(const WavBuffer&) = delete;
+    WavBuffer& operator=(const WavBuffer&) = delete;
+    WavBuffer(WavBuffer&&) = default;
+    WavBuffer& operator=(WavBuffer&&) = default;
+
+    /**
+     * @brief 샘플 수를 0으로 되돌리고 최소 용량 보장
+     * @param capacitySamples 최소 샘플 용량
+     */
+    void reset(size_t capacitySamples);
+
+    /**
+     * @brief 헤더 영역 (kHeaderSize 바이트)
+     */
+    uint8_t* header() { return m_storage.get() + kHeaderOffset; }
+
+    /**
+     * @brief 샘플 영역 시작 (헤더 바로 뒤)
+     */
+    int16_t* samples() { return reinterpret_cast<int16_t*>(m_storage.get() + kSampleAlignment); }
+    const int16_t* samples() const { return reinterpret_cast<const int16_t*>(m_storage.get() + kSampleAlignment); }
+
+    /**
+     * @brief 유효 샘플 수 설정 (samples()에 직접 기록한 뒤 호출)
+     * @param count 샘플 수 (capacitySamples() 이하)
+     */
+    void setSampleCount(size_t count);
+
+    /**
+     * @brief 유효 샘플 수
+     */
+    size_t sampleCount() const { return m_sampleCount; }
+
+    /**
+     * @brief 샘플 용량
+     */
+    size_t capacitySamples() const { return m_capacitySamples; }
+
+    /**
+     * @brief 샘플 데이터 크기 (바이트)
+     */
+    uint32_t dataSize() const { return static_cast<uint32_t>(m_sampleCount * sizeof(int16_t)); }
+
+    /**
+     * @brief 완성된 WAV 바이트 (헤더 포함 연속 구간)
+     */
+    const uint8_t* data() const { return m_storage.get() + kHeaderOffset; }
+
+    /**
+     * @brief 완성된 WAV 크기 (바이트)
+     */
+    size_t size() const { return kHeaderSize + dataSize(); }
+
+    /**
+     * @brief 샘플이 없는지 확인
+     */
+    bool empty() const { return m_sampleCount == 0; }
+
+private:
+    // 헤더를 샘플 영역 바로 앞에 붙여 data()부터 연속된 WAV가 되도록 함
+    static constexpr size_t kHeaderOffset = kSampleAlignment - kHeaderSize;
+    static_assert(kSampleAlignment >= kHeaderSize, "헤더가 정렬 여유 공간에 들어가야 합니다");
+
+    struct PageDeleter {
+        void operator()(uint8_t* storage) const;
+    };
+
+    std::unique_ptr<uint8_t, PageDeleter> m_storage;
+    size_t m_capacitySamples = 0;
+    size_t m_sampleCount = 0;
+};
+
+} // namespace sion
+
+#endif // WAV_BUFFER_H
@@ -0,0 +1,128 @@
+#pragma once
+
+#ifndef WEBSOCKET_CLIENT_H
+#define WEBSOCKET_CLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sion {
+
+/**
+ * @brief 최소 WebSocket 클라이언트 (RFC 6455)
+ *
+ * ws:// 는 일반 TCP, wss:// 는 OpenSSL이 있는 빌드(SION_HAVE_OPENSSL)에서만 지원합니다.
+ * 송신(sendText/sendBinary)과 수신(receive)은 서로 다른 스레드에서 동시에 호출할 수
+ * 있으며, 송신끼리는 내부 락으로 직렬화됩니다. 수신은 한 스레드만 호출해야 합니다.
+ *
+ * 클라이언트 프레임은 규격대로 마스킹하고, 조각난 수신 메시지는 합쳐서 돌려주며
+ * Ping에는 자동으로 Pong을 보냅니다. 확장(permessage-deflate)과 서브프로토콜은
+ * 협상하지 않습니다.
+ */
+class WebSocketClient {
+public:
+    /**
+     * @brief 프레임 opcode
+     */
+    enum class Opcode : uint8_t {
+        Continuation = 0x0,
+        Text = 0x1,
+        Binary = 0x2,
+        Close = 0x8,
+        Ping = 0x9,
+        Pong = 0xA
+    };
+
+    WebSocketClient();
+
+    /**
+     * @brief 소멸자 - 연결 종료
+     */
+    ~WebSocketClient();
+
+    // 복사 금지
+    WebSocketClient(const WebSocketClient&) = delete;
+    WebSocketClient& operator=(const WebSocketClient&) = delete;
+
+    /**
+     * @brief 서버 연결 및 업그레이드 핸드셰이크
+     * @param url "ws://host[:port]/path" 또는 "wss://..."
+     * @param timeout TCP 연결 + 핸드셰이크 제한 시간
+     * @return 성공 여부
+     */
+    bool connect(const std::string& url, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief 텍스트 메시지 전송 (UTF-8)
+     * @return 성공 여부 (실패 시 연결은 닫힌 것으로 표시)
+     */
+    bool sendText(const std::string& text);
+
+    /**
+     * @brief 바이너리 메시지 전송
+     * @return 성공 여부
+     */
+    bool sendBinary(const void* data, size_t size);
+
+    /**
+     * @brief 메시지 한 개 수신 (블로킹)
+     * @param opcode 출력: Text 또는 Binary
+     * @param payload 출력: 메시지 전체 (조각은 합쳐짐)
+     * @return 수신 여부 (서버가 Close를 보냈거나 오류/shutdown()이면 false)
+     */
+    bool receive(Opcode& opcode, std::string& payload);
+
+    /**
+     * @brief Close 프레임을 보내고 연결 중단 (다른 스레드에서 블로킹 중인 receive()를 깨움)
+     */
+    void shutdown();
+
+    /**
+     * @brief 소켓 해제 (receive()를 호출하는 스레드가 끝난 뒤 호출)
+     */
+    void close();
+
+    /**
+     * @brief 연결되어 있는지 확인
+     */
+    bool isOpen() const { return m_open.load(); }
+
+private:
+    bool sendFrame(Opcode opcode, const void* data, size_t size);
+    bool handshake(const std::string& host, const std::string& hostHeader, const std::string& path);
+
+    bool writeAll(const void* data, size_t size);
+    bool readExact(void* data, size_t size);
+
+    /**
+     * @brief 소켓(또는 TLS)에서 최대 size 바이트 읽기
+     * @return 읽은 바이트 수 (0이면 종료/오류)
+     */
+    size_t readSome(void* data, size_t size);
+
+    void releaseSocket();
+
+    intptr_t m_socket;           // POSIX: fd, Windows: SOCKET (미연결 시 -1)
+    void* m_tlsContext;          // SSL_CTX* (ws://이면 nullptr)
+    void* m_tls;                 // SSL*
+    std::mutex m_tlsMutex;       // SSL 객체는 송수신 동시 호출이 안전하지 않음
+    intptr_t m_wakeFds[2];       // TLS 수신 대기를 깨우는 채널 (POSIX: 파이프, Windows: UDP 소켓 하나)
+    std::atomic<bool> m_open;
+
+    std::mutex m_writeMutex;
+    std::vector<uint8_t> m_sendBuffer;   // 헤더 + 마스킹된 페이로드 (m_writeMutex로 보호)
+    uint32_t m_maskState;                // 마스킹 키 생성기 상태 (m_writeMutex로 보호)
+
+    // 수신 스레드 전용
+    std::vector<uint8_t> m_recvBuffer;   // 소켓에서 읽었지만 아직 소비하지 않은 바이트
+    size_t m_recvOffset;
+};
+
+} // namespace sion
+
+#endif // WEBSOCKET_CLIENT_H
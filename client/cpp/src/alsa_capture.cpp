@@ -0,0 +1,359 @@
+/**
+ * @file alsa_capture.cpp
+ * @brief ALSA PCM 캡처 백엔드 구현 (Linux 전용)
+ */
+
+#include "capture_backend.h"
+#include "audio_resampler.h"
+
+#include <alsa/asoundlib.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace sion {
+
+namespace {
+
+// 장치 버퍼 = 주기 × kPeriodsPerBuffer (캡처 스레드가 늦어질 때의 여유)
+constexpr snd_pcm_uframes_t kPeriodsPerBuffer = 8;
+
+/**
+ * @brief ALSA PCM 캡처
+ *
+ * PCM을 논블로킹으로 열고 poll()로 장치 주기(frameDurationMs)마다 깨어나
+ * 읽을 수 있는 만큼 snd_pcm_readi()로 비운 뒤 고정 크기 프레임으로 콜백합니다.
+ * 중지는 eventfd를 같은 poll 집합에 넣어 즉시 깨우므로 폴링 대기가 없습니다.
+ *
+ * 기본 장치 "default"는 데스크톱에서 PipeWire/PulseAudio ALSA 플러그인을 거치므로
+ * 별도 PipeWire 백엔드 없이 같은 경로로 동작합니다. 장치가 요청한 레이트/채널을
+ * 지원하지 않으면(hw:N 직접 지정 등) 장치 형식 그대로 열고 AudioResampler로 변환합니다.
+ * 오버런(-EPIPE)은 스트림을 복구한 뒤 계속 캡처합니다.
+ */
+class AlsaCaptureBackend : public CaptureBackend {
+public:
+    AlsaCaptureBackend() = default;
+
+    ~AlsaCaptureBackend() override {
+        stop();
+        close();
+    }
+
+    bool open(const AudioConfig& config) override {
+        if (m_pcm) {
+            return true;
+        }
+
+        m_config = config;
+        m_deviceName = config.device.empty() ? "default" : config.device;
+
+        int err = snd_pcm_open(&m_pcm, m_deviceName.c_str(), SND_PCM_STREAM_CAPTURE, SND_PCM_NONBLOCK);
+        if (err < 0) {
+            std::cerr << "[ALSA] 캡처 장치를 열 수 없습니다 (" << m_deviceName << "): "
+                      << snd_strerror(err) << std::endl;
+            m_pcm = nullptr;
+            return false;
+        }
+
+        if (!configureHardware() || !configureSoftware()) {
+            close();
+            return false;
+        }
+
+        m_stopFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (m_stopFd < 0) {
+            std::cerr << "[ALSA] eventfd 생성 실패: " << std::strerror(errno) << std::endl;
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool start(AudioCallback onFrame) override {
+        if (!m_pcm || m_thread.joinable()) {
+            return false;
+        }
+
+        m_onFrame = std::move(onFrame);
+        m_assembler.configure(static_cast<size_t>(m_config.sampleRate) * m_config.channels
+                              * m_config.frameDurationMs / 1000);
+        if (m_convert) {
+            m_resampler.reset();
+        }
+
+        // 이전 stop()의 깨우기 신호 소비
+        uint64_t pending = 0;
+        while (::read(m_stopFd, &pending, sizeof(pending)) > 0) {
+        }
+
+        int err = snd_pcm_prepare(m_pcm);
+        if (err >= 0) {
+            err = snd_pcm_start(m_pcm);
+        }
+        if (err < 0) {
+            std::cerr << "[ALSA] 스트림 시작 실패: " << snd_strerror(err) << std::endl;
+            return false;
+        }
+
+        m_thread = std::thread(&AlsaCaptureBackend::captureLoop, this);
+        return true;
+    }
+
+    void stop() override {
+        if (!m_thread.joinable()) {
+            return;
+        }
+
+        const uint64_t one = 1;
+        if (::write(m_stopFd, &one, sizeof(one)) < 0) {
+            std::cerr << "[ALSA] 중지 신호 실패: " << std::strerror(errno) << std::endl;
+        }
+        m_thread.join();
+
+        if (m_pcm) {
+            snd_pcm_drop(m_pcm);
+        }
+        m_onFrame = nullptr;
+    }
+
+    void close() override {
+        if (m_pcm) {
+            snd_pcm_close(m_pcm);
+            m_pcm = nullptr;
+        }
+        if (m_stopFd >= 0) {
+            ::close(m_stopFd);
+            m_stopFd = -1;
+        }
+    }
+
+    bool isOpen() const override {
+        return m_pcm != nullptr;
+    }
+
+    const char* name() const override {
+        return m_convert ? "ALSA (native format)" : "ALSA";
+    }
+
+private:
+    bool configureHardware() {
+        snd_pcm_hw_params_t* hw = nullptr;
+        snd_pcm_hw_params_alloca(&hw);
+        snd_pcm_hw_params_any(m_pcm, hw);
+
+        int err = snd_pcm_hw_params_set_access(m_pcm, hw, SND_PCM_ACCESS_RW_INTERLEAVED);
+        if (err < 0) {
+            std::cerr << "[ALSA] 인터리브 접근 미지원: " << snd_strerror(err) << std::endl;
+            return false;
+        }
+        err = snd_pcm_hw_params_set_format(m_pcm, hw, SND_PCM_FORMAT_S16_LE);
+        if (err < 0) {
+            std::cerr << "[ALSA] S16_LE 형식 미지원: " << snd_strerror(err) << std::endl;
+            return false;
+        }
+
+        // 장치가 요청과 다른 레이트/채널만 지원하면 가장 가까운 값으로 열고 직접 변환
+        unsigned int rate = static_cast<unsigned int>(m_config.sampleRate);
+        unsigned int channels = static_cast<unsigned int>(m_config.channels);
+        snd_pcm_hw_params_set_rate_resample(m_pcm, hw, m_config.nativeFormat ? 0 : 1);
+        snd_pcm_hw_params_set_channels_near(m_pcm, hw, &channels);
+        snd_pcm_hw_params_set_rate_near(m_pcm, hw, &rate, nullptr);
+
+        m_convert = rate != static_cast<unsigned int>(m_config.sampleRate)
+                 || channels != static_cast<unsigned int>(m_config.channels);
+        if (m_convert) {
+            InputFormat input;
+            input.sampleRate = static_cast<int>(rate);
+            input.channels = static_cast<int>(channels);
+            input.format = SampleFormat::Int16;
+            if (m_config.channels != 1 || !m_resampler.configure(input, m_config.sampleRate)) {
+                std::cerr << "[ALSA] 장치 형식 변환 미지원: " << rate << " Hz × " << channels << "ch" << std::endl;
+                return false;
+            }
+        }
+
+        m_deviceChannels = channels;
+
+        snd_pcm_uframes_t period = static_cast<snd_pcm_uframes_t>(rate) * m_config.frameDurationMs / 1000;
+        snd_pcm_hw_params_set_period_size_near(m_pcm, hw, &period, nullptr);
+        snd_pcm_uframes_t bufferFrames = period * kPeriodsPerBuffer;
+        snd_pcm_hw_params_set_buffer_size_near(m_pcm, hw, &bufferFrames);
+
+        err = snd_pcm_hw_params(m_pcm, hw);
+        if (err < 0) {
+            std::cerr << "[ALSA] 하드웨어 파라미터 설정 실패: " << snd_strerror(err) << std::endl;
+            return false;
+        }
+
+        snd_pcm_hw_params_get_period_size(hw, &m_periodFrames, nullptr);
+        m_period.assign(static_cast<size_t>(m_periodFrames) * m_deviceChannels, 0);
+        if (m_convert) {
+            // 캡처 스레드에서 재할당이 없도록 주기 한 개 분량을 미리 확보
+            m_converted.reserve(static_cast<size_t>(m_periodFrames) * m_config.sampleRate / rate + 64);
+            std::cout << "[ALSA] 장치 형식 " << rate << " Hz × " << channels << "ch → "
+                      << m_config.sampleRate << " Hz 모노 (" << m_resampler.description() << ")"
+                      << std::endl;
+        }
+        return true;
+    }
+
+    bool configureSoftware() {
+        snd_pcm_sw_params_t* sw = nullptr;
+        snd_pcm_sw_params_alloca(&sw);
+        snd_pcm_sw_params_current(m_pcm, sw);
+
+        // 주기 하나가 찰 때만 poll이 깨어나도록
+        snd_pcm_sw_params_set_avail_min(m_pcm, sw, m_periodFrames);
+
+        const int err = snd_pcm_sw_params(m_pcm, sw);
+        if (err < 0) {
+            std::cerr << "[ALSA] 소프트웨어 파라미터 설정 실패: " << snd_strerror(err) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void captureLoop() {
+        // 실시간 우선순위 시도 (권한이 없으면 일반 스케줄링으로 계속)
+        sched_param param{};
+        param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+
+        const int pcmFds = snd_pcm_poll_descriptors_count(m_pcm);
+        std::vector<pollfd> fds(static_cast<size_t>(pcmFds > 0 ? pcmFds : 0) + 1);
+        fds[0] = {m_stopFd, POLLIN, 0};
+        snd_pcm_poll_descriptors(m_pcm, fds.data() + 1, static_cast<unsigned int>(fds.size() - 1));
+
+        while (true) {
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "[ALSA] poll 실패: " << std::strerror(errno) << std::endl;
+                break;
+            }
+            if (fds[0].revents & POLLIN) {
+                break;  // 중지 요청
+            }
+
+            unsigned short revents = 0;
+            snd_pcm_poll_descriptors_revents(m_pcm, fds.data() + 1,
+                                             static_cast<unsigned int>(fds.size() - 1), &revents);
+            if ((revents & (POLLIN | POLLERR)) && !drainPeriods()) {
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief 읽을 수 있는 주기를 모두 읽어 프레임으로 전달
+     * @return 계속 캡처할 수 있는지 여부
+     */
+    bool drainPeriods() {
+        while (true) {
+            const snd_pcm_sframes_t frames = snd_pcm_readi(m_pcm, m_period.data(), m_periodFrames);
+            if (frames == -EAGAIN) {
+                return true;
+            }
+
+            if (frames < 0) {
+                // 오버런(-EPIPE)/일시 중단(-ESTRPIPE) 복구 후 캡처 재시작
+                int err = snd_pcm_recover(m_pcm, static_cast<int>(frames), 1);
+                if (err >= 0) {
+                    err = snd_pcm_start(m_pcm);
+                }
+                if (err < 0) {
+                    std::cerr << "[ALSA] 캡처 오류: " << snd_strerror(err) << std::endl;
+                    return false;
+                }
+                std::cerr << "[ALSA] 오버런 복구" << std::endl;
+                continue;
+            }
+
+            if (m_convert) {
+                m_converted.clear();
+                m_resampler.process(m_period.data(), static_cast<size_t>(frames), m_converted);
+                m_assembler.append(m_converted.data(), m_converted.size(), m_onFrame);
+            } else {
+                m_assembler.append(m_period.data(), static_cast<size_t>(frames) * m_deviceChannels, m_onFrame);
+            }
+        }
+    }
+
+    AudioConfig m_config;
+    std::string m_deviceName;
+    snd_pcm_t* m_pcm = nullptr;
+    int m_stopFd = -1;
+
+    unsigned int m_deviceChannels = 1;
+    snd_pcm_uframes_t m_periodFrames = 0;
+    std::vector<int16_t> m_period;
+
+    // 장치 형식 변환 (요청 레이트/채널 미지원 장치)
+    bool m_convert = false;
+    AudioResampler m_resampler;
+    std::vector<int16_t> m_converted;
+
+    std::thread m_thread;
+    AudioCallback m_onFrame;
+    FrameAssembler m_assembler;
+};
+
+} // namespace
+
+std::unique_ptr<CaptureBackend> createAlsaBackend() {
+    return std::make_unique<AlsaCaptureBackend>();
+}
+
+std::vector<CaptureDeviceInfo> enumerateAlsaDevices() {
+    std::vector<CaptureDeviceInfo> devices;
+
+    void** hints = nullptr;
+    const int err = snd_device_name_hint(-1, "pcm", &hints);
+    if (err < 0) {
+        std::cerr << "[ALSA] 장치 목록 조회 실패: " << snd_strerror(err) << std::endl;
+        return devices;
+    }
+
+    for (void** hint = hints; *hint; ++hint) {
+        char* name = snd_device_name_get_hint(*hint, "NAME");
+        char* description = snd_device_name_get_hint(*hint, "DESC");
+        char* direction = snd_device_name_get_hint(*hint, "IOID");   // NULL이면 입출력 모두
+
+        const bool capture = !direction || std::strcmp(direction, "Input") == 0;
+        if (name && capture && std::strcmp(name, "null") != 0) {
+            CaptureDeviceInfo info;
+            info.id = name;
+            info.name = description ? description : name;
+            // 설명은 "카드 이름\n용도" 두 줄
+            for (char& c : info.name) {
+                if (c == '\n') {
+                    c = ' ';
+                }
+            }
+            info.isDefault = info.id == "default";   // open()이 장치를 지정하지 않았을 때 여는 PCM
+            devices.push_back(std::move(info));
+        }
+
+        std::free(name);
+        std::free(description);
+        std::free(direction);
+    }
+    snd_device_name_free_hint(hints);
+    return devices;
+}
+
+} // namespace sion
@@ -0,0 +1,371 @@
+/**
+ * @file asr_stream_client.cpp
+ * @brief AsrStreamClient 클래스 구현
+ */
+
+#include "asr_stream_client.h"
+#include "audio_encoder.h"
+#include "cancellation_token.h"
+#include "json_util.h"
+#include "latency_trace.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace sion {
+
+namespace {
+
+void putU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+// 바이너리 메시지 앞의 스트림 ID 크기
+constexpr size_t kStreamIdSize = 4;
+
+} // namespace
+
+AsrStreamClient::AsrStreamClient(AsrStreamConfig config)
+    : m_config(std::move(config))
+    , m_connected(false)
+    , m_nextStreamId(1)
+{
+}
+
+AsrStreamClient::~AsrStreamClient() {
+    stop();
+}
+
+bool AsrStreamClient::start() {
+    if (m_config.url.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_connectMutex);
+    m_nextAttempt = {};
+    return connectLocked();
+}
+
+void AsrStreamClient::stop() {
+    std::lock_guard<std::mutex> lock(m_connectMutex);
+
+    SocketPtr socket;
+    {
+        std::lock_guard<std::mutex> socketLock(m_socketMutex);
+        socket = std::move(m_socket);
+    }
+    m_connected = false;
+
+    // Close 프레임 전송 + 소켓 중단으로 수신 스레드를 깨운 뒤 정리
+    if (socket) {
+        socket->shutdown();
+    }
+    if (m_reader.joinable()) {
+        m_reader.join();
+    }
+    if (socket) {
+        socket->close();
+    }
+    failAllStreams();
+}
+
+bool AsrStreamClient::ensureConnected() {
+    if (m_config.url.empty()) {
+        return false;
+    }
+    if (m_connected) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_connectMutex);
+    return connectLocked();
+}
+
+bool AsrStreamClient::connectLocked() {
+    if (m_connected) {
+        return true;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_nextAttempt) {
+        return false;   // 서버가 내려가 있을 때 발화마다 연결 제한 시간을 기다리지 않도록
+    }
+
+    // 끊긴 연결의 수신 스레드는 이미 끝나는 중이므로 바로 합류
+    if (m_reader.joinable()) {
+        m_reader.join();
+    }
+    SocketPtr previous;
+    {
+        std::lock_guard<std::mutex> socketLock(m_socketMutex);
+        previous = std::move(m_socket);
+    }
+    if (previous) {
+        previous->close();
+    }
+
+    auto socket = std::make_shared<WebSocketClient>();
+    if (!socket->connect(m_config.url, m_config.connectTimeout)) {
+        m_nextAttempt = now + m_config.reconnectInterval;
+        std::cerr << "[AsrStreamClient] ASR 서비스 연결 실패: " << m_config.url
+                  << " (" << m_config.reconnectInterval.count() << " ms 후 재시도)" << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> socketLock(m_socketMutex);
+        m_socket = socket;
+    }
+    m_connected = true;
+    m_reader = std::thread(&AsrStreamClient::readLoop, this, socket);
+
+    std::cout << "[AsrStreamClient] ASR 서비스 연결: " << m_config.url << std::endl;
+    return true;
+}
+
+AsrStreamClient::SocketPtr AsrStreamClient::socket() const {
+    std::lock_guard<std::mutex> lock(m_socketMutex);
+    return m_connected ? m_socket : nullptr;
+}
+
+uint32_t AsrStreamClient::submit(const int16_t* samples, size_t sampleCount, int sampleRate,
+                                 AudioEncoder* encoder,
+                                 const PartialResultCallback& onPartial,
+                                 CancellationToken* cancel) {
+    if (!ensureConnected()) {
+        return 0;
+    }
+    SocketPtr socket = this->socket();
+    if (!socket) {
+        return 0;
+    }
+
+    uint32_t streamId = m_nextStreamId.fetch_add(1);
+    if (streamId == 0) {
+        streamId = m_nextStreamId.fetch_add(1);   // 0은 "연결 없음"으로 예약
+    }
+
+    // 응답이 전송보다 먼저 도착해도 놓치지 않도록 송신 전에 등록
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        PendingStream& stream = m_pending[streamId];
+        stream.onPartial = onPartial;
+        stream.future = stream.promise.get_future();
+        stream.deadline = std::chrono::steady_clock::now() + m_config.requestTimeout;
+        stream.traceRequest = trace::currentRequest();
+        stream.sentAt = trace::now();
+    }
+    trace::Span sendSpan(trace::Stage::BridgeSend);
+
+    const auto codec = encoder ? encoder->codec() : protocol::AudioCodec::Pcm;
+    const std::string start = "{\"type\":\"start\",\"id\":" + std::to_string(streamId)
+                            + ",\"codec\":" + json::quote(protocol::audioCodecName(codec))
+                            + ",\"sample_rate\":" + std::to_string(sampleRate) + "}";
+
+    // 바이너리 메시지 = 스트림 ID + 코덱 바이트 (인코더는 버퍼 뒤에 이어 씀)
+    // 세션마다 send 단계가 동시에 호출하므로 송신 버퍼는 호출 스레드별로 재사용
+    thread_local std::vector<uint8_t> chunk;
+    chunk.resize(kStreamIdSize);
+    putU32(chunk.data(), streamId);
+    auto flush = [&]() {
+        if (chunk.size() == kStreamIdSize) {
+            return true;
+        }
+        const bool ok = socket->sendBinary(chunk.data(), chunk.size());
+        chunk.resize(kStreamIdSize);
+        return ok;
+    };
+
+    // 인코딩 시간은 조각별 호출을 합산해 발화당 한 구간으로 기록
+    const int64_t encodeStart = trace::now();
+    int64_t encodeNs = 0;
+
+    bool sent = socket->sendText(start);
+    if (sent && encoder) {
+        sent = encoder->begin(sampleRate, 1, chunk);
+        encodeNs += trace::now() - encodeStart;
+    }
+    for (size_t offset = 0; sent && offset < sampleCount; offset += kStreamChunkSamples) {
+        if (cancel && cancel->isCancelled()) {
+            cancelStream(streamId);
+            return streamId;
+        }
+        const size_t count = std::min(kStreamChunkSamples, sampleCount - offset);
+        if (encoder) {
+            const int64_t chunkStart = trace::now();
+            encoder->encode(samples + offset, count, chunk);
+            encodeNs += trace::now() - chunkStart;
+        } else {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(samples + offset);
+            chunk.insert(chunk.end(), bytes, bytes + count * sizeof(int16_t));
+        }
+        sent = flush();
+    }
+    if (sent && encoder) {
+        const int64_t finishStart = trace::now();
+        encoder->finish(chunk);
+        encodeNs += trace::now() - finishStart;
+        sent = flush();
+    }
+    if (encoder) {
+        trace::record(trace::Stage::Encode, trace::currentRequest(), encodeStart, encodeStart + encodeNs);
+    }
+
+    if (!sent || !sendControl(socket, "end", streamId)) {
+        std::cerr << "[AsrStreamClient] 스트림 " << streamId << " 전송 실패" << std::endl;
+        completeStream(streamId, "", true);   // 대기자가 즉시 깨어나도록 완료 처리
+    }
+    return streamId;
+}
+
+std::string AsrStreamClient::awaitTranscript(uint32_t streamId, CancellationToken* cancel, bool* failed) {
+    std::future<std::string> future;
+    std::chrono::steady_clock::time_point deadline;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        auto it = m_pending.find(streamId);
+        if (it == m_pending.end() || !it->second.future.valid()) {
+            if (failed) {
+                *failed = true;
+            }
+            return "";
+        }
+        future = std::move(it->second.future);
+        deadline = it->second.deadline;
+    }
+
+    {
+        // 취소 시 cancel 전송 + 빈 결과로 완료되어 future가 즉시 깨어남
+        ScopedCancelCallback onCancel(cancel, [this, streamId] { cancelStream(streamId); });
+        if (future.wait_until(deadline) == std::future_status::timeout) {
+            std::cerr << "[AsrStreamClient] 스트림 " << streamId << " 응답 시간 초과 ("
+                      << m_config.requestTimeout.count() << " ms)" << std::endl;
+            cancelStream(streamId);
+        }
+    }
+    std::string text = future.get();
+
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    auto it = m_pending.find(streamId);
+    if (failed) {
+        *failed = it != m_pending.end() && it->second.failed;
+    }
+    if (it != m_pending.end()) {
+        m_pending.erase(it);
+    }
+    return text;
+}
+
+void AsrStreamClient::cancelStream(uint32_t streamId) {
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        auto it = m_pending.find(streamId);
+        if (it == m_pending.end() || it->second.completed) {
+            return;  // 이미 끝난 스트림 (취소 토큰 콜백과 중복 호출 포함)
+        }
+    }
+
+    if (SocketPtr socket = this->socket()) {
+        sendControl(socket, "cancel", streamId);
+    }
+    completeStream(streamId, "", true);
+}
+
+bool AsrStreamClient::sendControl(const SocketPtr& socket, const char* type, uint32_t streamId) {
+    return socket->sendText(std::string("{\"type\":\"") + type + "\",\"id\":" + std::to_string(streamId) + "}");
+}
+
+void AsrStreamClient::readLoop(SocketPtr socket) {
+    WebSocketClient::Opcode opcode;
+    std::string message;
+    while (socket->receive(opcode, message)) {
+        if (opcode == WebSocketClient::Opcode::Text) {
+            handleMessage(message);
+        }
+    }
+
+    // 서버 종료/네트워크 오류: 대기 중인 스트림은 실패로 끝나고 다음 submit()에서 재연결
+    if (m_connected.exchange(false)) {
+        std::cerr << "[AsrStreamClient] ASR 서비스 연결이 끊겼습니다" << std::endl;
+    }
+    failAllStreams();
+}
+
+void AsrStreamClient::handleMessage(const std::string& message) {
+    std::string type;
+    uint64_t id = 0;
+    if (!json::getString(message, "type", type) || !json::getUint(message, "id", id)) {
+        std::cerr << "[AsrStreamClient] 잘못된 메시지: " << message << std::endl;
+        return;
+    }
+    const auto streamId = static_cast<uint32_t>(id);
+
+    if (type == "partial") {
+        std::string text;
+        json::getString(message, "text", text);
+
+        PartialResultCallback onPartial;
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            auto it = m_pending.find(streamId);
+            if (it != m_pending.end() && !it->second.completed) {
+                onPartial = it->second.onPartial;
+                if (!it->second.partialSeen) {
+                    it->second.partialSeen = true;
+                    trace::record(trace::Stage::FirstPartial, it->second.traceRequest,
+                                  it->second.sentAt, trace::now());
+                }
+            }
+        }
+        if (onPartial) {
+            onPartial(text);
+        }
+    } else if (type == "final") {
+        std::string text;
+        json::getString(message, "text", text);
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            auto it = m_pending.find(streamId);
+            if (it != m_pending.end() && !it->second.completed) {
+                trace::record(trace::Stage::AsrTranscript, it->second.traceRequest,
+                              it->second.sentAt, trace::now());
+            }
+        }
+        completeStream(streamId, text, false);
+    } else if (type == "error") {
+        std::string error;
+        json::getString(message, "message", error);
+        std::cerr << "[AsrStreamClient] ASR 오류 (스트림 " << streamId << "): " << error << std::endl;
+        completeStream(streamId, "", true);
+    } else {
+        std::cerr << "[AsrStreamClient] 예상치 못한 메시지: " << type << std::endl;
+    }
+}
+
+void AsrStreamClient::completeStream(uint32_t streamId, const std::string& text, bool failed) {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    auto it = m_pending.find(streamId);
+    if (it == m_pending.end() || it->second.completed) {
+        return;  // 이미 취소/완료된 스트림의 늦은 응답
+    }
+
+    it->second.completed = true;
+    it->second.failed = failed;
+    it->second.promise.set_value(text);
+}
+
+void AsrStreamClient::failAllStreams() {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    for (auto& [id, stream] : m_pending) {
+        if (!stream.completed) {
+            stream.completed = true;
+            stream.failed = true;
+            stream.promise.set_value("");
+        }
+    }
+}
+
+} // namespace sion
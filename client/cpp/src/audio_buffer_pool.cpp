@@ -0,0 +1,89 @@
+/**
+ * @file audio_buffer_pool.cpp
+ * @brief AudioBufferPool 클래스 구현
+ */
+
+#include "audio_buffer_pool.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace sion {
+
+struct AudioBufferPool::State {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<WavBuffer>> free;   // bufferCount만큼 예약 (반환 시 재할당 없음)
+};
+
+// ============================================================================
+// Handle
+// ============================================================================
+
+AudioBufferPool::Handle::Handle(std::shared_ptr<State> state, std::unique_ptr<WavBuffer> buffer)
+    : m_state(std::move(state))
+    , m_buffer(std::move(buffer))
+{
+}
+
+AudioBufferPool::Handle::~Handle() {
+    reset();
+}
+
+AudioBufferPool::Handle& AudioBufferPool::Handle::operator=(Handle&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_state = std::move(other.m_state);
+        m_buffer = std::move(other.m_buffer);
+    }
+    return *this;
+}
+
+void AudioBufferPool::Handle::reset() {
+    if (m_buffer && m_state) {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->free.push_back(std::move(m_buffer));
+    }
+    m_buffer.reset();
+    m_state.reset();
+}
+
+// ============================================================================
+// AudioBufferPool
+// ============================================================================
+
+AudioBufferPool::AudioBufferPool(size_t bufferCount, size_t capacitySamples)
+    : m_state(std::make_shared<State>())
+    , m_bufferCount(bufferCount)
+    , m_capacitySamples(capacitySamples)
+{
+    m_state->free.reserve(bufferCount);
+    for (size_t i = 0; i < bufferCount; ++i) {
+        m_state->free.push_back(std::make_unique<WavBuffer>(capacitySamples));
+    }
+}
+
+AudioBufferPool::~AudioBufferPool() = default;
+
+AudioBufferPool::Handle AudioBufferPool::acquire() {
+    std::unique_ptr<WavBuffer> buffer;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (m_state->free.empty()) {
+            return Handle();
+        }
+        buffer = std::move(m_state->free.back());
+        m_state->free.pop_back();
+    }
+
+    // 용량은 그대로이므로 재할당 없이 샘플 수만 초기화
+    buffer->reset(m_capacitySamples);
+    return Handle(m_state, std::move(buffer));
+}
+
+size_t AudioBufferPool::available() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->free.size();
+}
+
+} // namespace sion
@@ -4,20 +4,24 @@
  */
 
 #include "audio_capture.h"
+#include "capture_backend.h"
+#include "cancellation_token.h"
+#include "latency_trace.h"
+#include "metrics.h"
+#include "voice_activity_detector.h"
 #include <iostream>
 #include <fstream>
 #include <cstring>
-#include <thread>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
 #include <chrono>
 
-#ifdef _WIN32
-#include <windows.h>
-#include <mmsystem.h>
-#pragma comment(lib, "winmm.lib")
-#endif
-
 namespace sion {
 
+// 엔드포인트 알림은 락 없이 보내므로, 확인과 대기 사이에 놓친 알림을 다시 확인하는 주기
+constexpr auto kEndpointRecheckInterval = std::chrono::milliseconds(10);
+
 // WAV 파일 헤더 구조체
 #pragma pack(push, 1)
 struct WavHeader {
@@ -37,10 +41,27 @@ struct WavHeader {
 };
 #pragma pack(pop)
 
+static_assert(sizeof(WavHeader) == WavBuffer::kHeaderSize, "WAV 헤더 크기 불일치");
+
 AudioCapture::AudioCapture(const AudioConfig& config)
     : m_config(config)
     , m_capturing(false)
-    , m_platformHandle(nullptr)
+    , m_maxCaptureSamples(maxCaptureSamples(config))
+    , m_ring(m_maxCaptureSamples)
+    , m_overrunSamples(0)
+    , m_vad(nullptr)
+    , m_endpointReached(false)
+    , m_captureLimit(0)
+    , m_recordedSamples(0)
+    , m_traceRequest(0)
+    , m_captureStartNs(0)
+    , m_standby(false)
+    , m_preRollPending(false)
+    , m_inCallback(false)
+    , m_callbackWaiter(false)
+    , m_preRollPos(0)
+    , m_preRollFilled(0)
+    , m_backend(createCaptureBackend(config))
 {
 }
 
@@ -48,127 +69,420 @@ AudioCapture::~AudioCapture() {
     if (m_capturing) {
         stopCapture();
     }
+    if (m_backend) {
+        m_backend->stop();
+        m_backend->close();
+    }
 }
 
 bool AudioCapture::initialize() {
-#ifdef _WIN32
-    // Windows 오디오 장치 확인
-    UINT numDevices = waveInGetNumDevs();
-    if (numDevices == 0) {
-        std::cerr << "[AudioCapture] 오디오 입력 장치를 찾을 수 없습니다." << std::endl;
+    // 장치 열기 비용을 핫키 이후 경로에서 제거하기 위해 미리 열어 둠
+    trace::Span openSpan(trace::Stage::DeviceOpen, 0);
+    if (!m_backend->open(m_config)) {
+        std::cerr << "[AudioCapture] 오디오 입력 장치를 열 수 없습니다." << std::endl;
         return false;
     }
-    
-    // 기본 장치 정보 출력
-    WAVEINCAPS caps;
-    if (waveInGetDevCaps(0, &caps, sizeof(caps)) == MMSYSERR_NOERROR) {
-        std::wcout << L"[AudioCapture] 기본 오디오 장치: " << caps.szPname << std::endl;
+
+    std::cout << "[AudioCapture] 캡처 백엔드: " << m_backend->name()
+              << " (" << m_config.sampleRate << " Hz, "
+              << m_config.frameDurationMs << " ms 프레임)" << std::endl;
+
+    // 상시 캡처: 스트림 시작도 핫키 이후 경로에서 제거
+    if (m_config.preRollMs > 0 && !m_standby) {
+        const size_t preRollSamples = static_cast<size_t>(m_config.sampleRate) * m_config.channels
+                                      * m_config.preRollMs / 1000;
+        m_preRoll.assign(preRollSamples, 0);
+        m_preRollPos = 0;
+        m_preRollFilled = 0;
+
+        if (m_backend->start([this](Span<const int16_t> frame) { handleFrame(frame); })) {
+            m_standby = true;
+            std::cout << "[AudioCapture] 상시 캡처 (pre-roll " << m_config.preRollMs << " ms)" << std::endl;
+        } else {
+            std::cerr << "[AudioCapture] 상시 캡처 스트림 시작 실패, 녹음 시마다 스트림을 시작합니다." << std::endl;
+            m_preRoll.clear();
+        }
     }
-    
+    openSpan.end();
     return true;
-#else
-    // Linux/macOS 구현은 추후 추가
-    std::cout << "[AudioCapture] 플랫폼 미지원 (더미 모드)" << std::endl;
-    return true;
-#endif
+}
+
+size_t AudioCapture::maxCaptureSamples(const AudioConfig& config) {
+    return static_cast<size_t>(config.maxDuration * config.sampleRate) * config.channels;
 }
 
 bool AudioCapture::startCapture() {
-    if (m_capturing) {
+    return beginCapture(m_maxCaptureSamples);
+}
+
+bool AudioCapture::beginCapture(size_t limit) {
+    if (m_capturing || !m_backend->isOpen()) {
         return false;
     }
-    
-    m_buffer.clear();
+
+    // 이전 녹음의 잔여 샘플 폐기 (생산자는 녹음 중이 아니면 링 버퍼에 쓰지 않음)
+    m_ring.clear();
+    m_overrunSamples.store(0, std::memory_order_relaxed);
+    m_captureLimit = limit;
+    m_recordedSamples = 0;
+    m_traceRequest = trace::currentRequest();
+    m_captureStartNs = trace::now();
+
+    if (m_standby) {
+        // 스트림은 이미 실행 중: 다음 프레임부터 pre-roll과 함께 기록
+        m_preRollPending = true;
+        m_capturing = true;
+        return true;
+    }
+
     m_capturing = true;
-    
+
+    // 캡처 스레드: 링 버퍼에 복사만 수행 (할당/락 없음)
+    trace::Span startSpan(trace::Stage::DeviceOpen, m_traceRequest);
+    bool started = m_backend->start([this](Span<const int16_t> frame) { handleFrame(frame); });
+    startSpan.end();
+
+    if (!started) {
+        std::cerr << "[AudioCapture] 캡처 스트림 시작 실패" << std::endl;
+        m_capturing = false;
+        return false;
+    }
+
     return true;
 }
 
+void AudioCapture::handleFrame(Span<const int16_t> frame) {
+    m_inCallback = true;
+
+    if (m_capturing) {
+        if (m_preRollPending.exchange(false) && m_preRollFilled > 0) {
+            // 순환 버퍼의 가장 오래된 샘플부터 두 구간으로 전달
+            const size_t start = (m_preRollPos + m_preRoll.size() - m_preRollFilled) % m_preRoll.size();
+            const size_t first = std::min(m_preRollFilled, m_preRoll.size() - start);
+            recordSamples(Span<const int16_t>(m_preRoll.data() + start, first));
+            recordSamples(Span<const int16_t>(m_preRoll.data(), m_preRollFilled - first));
+        }
+        recordSamples(frame);
+    } else if (m_standbyCallback) {
+        m_standbyCallback(frame);
+    }
+
+    if (!m_preRoll.empty()) {
+        pushPreRoll(frame);
+    }
+
+    // 기다리는 stopStream()이 있을 때만 락을 잡고 깨움 (평소 콜백은 원자값 저장만)
+    m_inCallback = false;
+    if (m_callbackWaiter) {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        m_callbackCv.notify_all();
+    }
+}
+
+void AudioCapture::recordSamples(Span<const int16_t> samples) {
+    if (samples.empty()) {
+        return;
+    }
+
+    // 목표 길이를 넘는 샘플은 기록하지 않고, 링 버퍼가 가득 차 못 쓴 샘플은 오버런으로 집계
+    const size_t wanted = std::min(samples.size(), m_captureLimit - m_recordedSamples);
+    const size_t written = m_ring.write(samples.data(), wanted);
+    if (m_recordedSamples == 0 && written > 0) {
+        trace::record(trace::Stage::FirstFrame, m_traceRequest, m_captureStartNs, trace::now());
+    }
+    m_recordedSamples += written;
+    if (written < wanted) {
+        m_overrunSamples.fetch_add(wanted - written, std::memory_order_relaxed);
+    }
+
+    if (m_frameCallback) {
+        m_frameCallback(samples);
+    }
+
+    if (m_vad) {
+        m_vad->process(samples.data(), samples.size());
+    }
+    if ((m_vad && m_vad->isFinished()) || written < samples.size() || m_recordedSamples >= m_captureLimit) {
+        signalEndpoint(true);
+    }
+}
+
+void AudioCapture::pushPreRoll(Span<const int16_t> frame) {
+    // 프레임이 pre-roll보다 길면 뒷부분만 유지
+    const size_t capacity = m_preRoll.size();
+    if (frame.size() > capacity) {
+        frame = frame.subspan(frame.size() - capacity);
+    }
+
+    const size_t first = std::min(frame.size(), capacity - m_preRollPos);
+    std::memcpy(m_preRoll.data() + m_preRollPos, frame.data(), first * sizeof(int16_t));
+    std::memcpy(m_preRoll.data(), frame.data() + first, (frame.size() - first) * sizeof(int16_t));
+
+    m_preRollPos = (m_preRollPos + frame.size()) % capacity;
+    m_preRollFilled = std::min(m_preRollFilled + frame.size(), capacity);
+}
+
 std::vector<int16_t> AudioCapture::stopCapture() {
-    m_capturing = false;
-    return std::move(m_buffer);
-}
-
-std::vector<int16_t> AudioCapture::captureForDuration(float durationSeconds) {
-#ifdef _WIN32
-    // Wave 포맷 설정
-    WAVEFORMATEX wfx;
-    wfx.wFormatTag = WAVE_FORMAT_PCM;
-    wfx.nChannels = static_cast<WORD>(m_config.channels);
-    wfx.nSamplesPerSec = static_cast<DWORD>(m_config.sampleRate);
-    wfx.wBitsPerSample = static_cast<WORD>(m_config.bitsPerSample);
-    wfx.nBlockAlign = wfx.nChannels * wfx.wBitsPerSample / 8;
-    wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
-    wfx.cbSize = 0;
-    
-    // 버퍼 크기 계산
-    int numSamples = static_cast<int>(durationSeconds * m_config.sampleRate);
-    int bufferSize = numSamples * wfx.nBlockAlign;
-    
-    std::vector<int16_t> audioData(numSamples);
-    
-    // Wave 입력 장치 열기
-    HWAVEIN hWaveIn;
-    MMRESULT result = waveInOpen(&hWaveIn, WAVE_MAPPER, &wfx, 0, 0, CALLBACK_NULL);
-    if (result != MMSYSERR_NOERROR) {
-        std::cerr << "[AudioCapture] waveInOpen 실패: " << result << std::endl;
+    if (!m_capturing) {
         return {};
     }
-    
-    // 버퍼 준비
-    WAVEHDR waveHdr;
-    std::memset(&waveHdr, 0, sizeof(waveHdr));
-    waveHdr.lpData = reinterpret_cast<LPSTR>(audioData.data());
-    waveHdr.dwBufferLength = bufferSize;
-    
-    result = waveInPrepareHeader(hWaveIn, &waveHdr, sizeof(waveHdr));
-    if (result != MMSYSERR_NOERROR) {
-        waveInClose(hWaveIn);
+
+    stopStream();
+
+    std::vector<int16_t> audioData(m_ring.size());
+    m_ring.read(audioData.data(), audioData.size());
+
+    return audioData;
+}
+
+std::vector<int16_t> AudioCapture::captureUtterance(VoiceActivityDetector& vad, CancellationToken* cancel) {
+    size_t begin = 0;
+    size_t end = 0;
+    if (!recordUtterance(vad, begin, end, cancel)) {
         return {};
     }
-    
-    result = waveInAddBuffer(hWaveIn, &waveHdr, sizeof(waveHdr));
-    if (result != MMSYSERR_NOERROR) {
-        waveInUnprepareHeader(hWaveIn, &waveHdr, sizeof(waveHdr));
-        waveInClose(hWaveIn);
-        return {};
+
+    std::vector<int16_t> audioData(end - begin);
+    m_ring.read(audioData.data(), audioData.size());
+    m_ring.clear();
+
+    return audioData;
+}
+
+bool AudioCapture::captureUtterance(VoiceActivityDetector& vad, WavBuffer& wav, CancellationToken* cancel) {
+    wav.reset(maxCaptureSamples());
+
+    // 링 버퍼 → WAV 샘플 영역으로 단 한 번 복사, 헤더는 제자리 작성
+    wav.setSampleCount(captureUtterance(vad, wav.samples(), wav.capacitySamples(), cancel));
+    if (wav.sampleCount() == 0) {
+        return false;
     }
-    
-    // 녹음 시작
-    result = waveInStart(hWaveIn);
-    if (result != MMSYSERR_NOERROR) {
-        waveInUnprepareHeader(hWaveIn, &waveHdr, sizeof(waveHdr));
-        waveInClose(hWaveIn);
-        return {};
+    writeWavHeader(wav.header(), wav.dataSize());
+
+    return true;
+}
+
+size_t AudioCapture::captureUtterance(VoiceActivityDetector& vad, int16_t* out, size_t capacity,
+                                      CancellationToken* cancel) {
+    size_t begin = 0;
+    size_t end = 0;
+    if (!recordUtterance(vad, begin, end, cancel)) {
+        return 0;
     }
-    
-    // 녹음 완료 대기
-    while (!(waveHdr.dwFlags & WHDR_DONE)) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const size_t count = m_ring.read(out, std::min(end - begin, capacity));
+    m_ring.clear();
+
+    return count;
+}
+
+bool AudioCapture::recordUtterance(VoiceActivityDetector& vad, size_t& begin, size_t& end,
+                                   CancellationToken* cancel) {
+    if (m_capturing || (cancel && cancel->isCancelled())) {
+        return false;
     }
-    
-    // 정리
-    waveInStop(hWaveIn);
-    waveInUnprepareHeader(hWaveIn, &waveHdr, sizeof(waveHdr));
-    waveInClose(hWaveIn);
-    
+
+    vad.reset();
+    m_vad = &vad;
+    m_endpointReached = false;
+
+    if (!startCapture()) {
+        m_vad = nullptr;
+        return false;
+    }
+
+    // 후행 무음/타임아웃/버퍼 가득 참/취소 중 하나가 발생하면 즉시 깨어남
+    {
+        ScopedCancelCallback onCancel(cancel, [this] { signalEndpoint(); });
+        waitForEndpoint();
+    }
+
+    stopStream();
+    m_vad = nullptr;
+
+    if (cancel && cancel->isCancelled()) {
+        m_ring.clear();
+        return false;
+    }
+
+    const size_t total = m_ring.size();
+    begin = vad.trimBegin();
+    end = vad.trimEnd(total);
+
+    if (!vad.hasSpeech() || end <= begin) {
+        m_ring.clear();
+        return false;
+    }
+
+    const double msPerSample = 1000.0 / (static_cast<double>(m_config.sampleRate) * m_config.channels);
+    metrics::observe(metrics::Histogram::VadUtteranceMs, (end - begin) * msPerSample);
+    metrics::observe(metrics::Histogram::VadTrimmedMs, (total - (end - begin)) * msPerSample);
+
+    // 앞쪽 무음은 복사 없이 건너뜀
+    m_ring.discard(begin);
+    return true;
+}
+
+void AudioCapture::stopStream() {
+    if (m_standby) {
+        // 녹음 플래그를 내린 뒤 진행 중인 콜백이 끝나면 더 이상 링 버퍼에 쓰지 않음
+        m_capturing = false;
+        if (m_inCallback) {
+            // waiter 저장 → inCallback 확인 / inCallback 해제 → waiter 확인이 모두 seq_cst라
+            // 콜백이 알림을 건너뛰면 여기서는 반드시 해제된 값을 보게 되어 깨어남을 놓치지 않음
+            m_callbackWaiter = true;
+            std::unique_lock<std::mutex> lock(m_callbackMutex);
+            m_callbackCv.wait(lock, [this] { return !m_inCallback; });
+            m_callbackWaiter = false;
+        }
+    } else {
+        m_backend->stop();
+        m_capturing = false;
+    }
+
+    // 오디오 스레드는 원자값만 더하고 카운터 집계는 녹음이 끝난 뒤 한 번에
+    const size_t overrun = m_overrunSamples.load(std::memory_order_relaxed);
+    if (overrun > 0) {
+        trace::increment(trace::Counter::CaptureOverrunSamples, overrun);
+        std::cerr << "[AudioCapture] 최대 녹음 시간 초과로 " << overrun << " 샘플이 버려졌습니다." << std::endl;
+    }
+}
+
+void AudioCapture::signalEndpoint(bool speechEnded) {
+    if (m_endpointReached.exchange(true)) {
+        return;
+    }
+    if (speechEnded) {
+        trace::record(trace::Stage::EndOfSpeech, m_traceRequest, m_captureStartNs, trace::now());
+    }
+    // 오디오 콜백에서도 불리므로 대기 스레드와 락을 다투지 않음
+    m_endpointCv.notify_one();
+}
+
+void AudioCapture::waitForEndpoint() {
+    std::unique_lock<std::mutex> lock(m_endpointMutex);
+    while (!m_endpointReached.load()) {
+        m_endpointCv.wait_for(lock, kEndpointRecheckInterval);
+    }
+}
+
+std::vector<int16_t> AudioCapture::captureForDuration(float durationSeconds, CancellationToken* cancel) {
+    const size_t numSamples = static_cast<size_t>(durationSeconds * m_config.sampleRate)
+                              * m_config.channels;
+
+    // 편의용 API (호출마다 할당), 반복 호출 경로는 WavBuffer 오버로드 사용
+    std::vector<int16_t> audioData(numSamples);
+    audioData.resize(recordForDuration(durationSeconds, audioData.data(), audioData.size(), cancel));
     return audioData;
-#else
-    // 더미 구현
-    int numSamples = static_cast<int>(durationSeconds * m_config.sampleRate);
-    std::vector<int16_t> dummyData(numSamples, 0);
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(static_cast<int>(durationSeconds * 1000)));
-    return dummyData;
-#endif
+}
+
+bool AudioCapture::captureForDuration(float durationSeconds, WavBuffer& wav, CancellationToken* cancel) {
+    const size_t numSamples = static_cast<size_t>(durationSeconds * m_config.sampleRate)
+                              * m_config.channels;
+    wav.reset(std::min(numSamples, wav.capacitySamples()));
+
+    wav.setSampleCount(recordForDuration(durationSeconds, wav.samples(), wav.capacitySamples(), cancel));
+    if (wav.empty()) {
+        return false;
+    }
+    writeWavHeader(wav.header(), wav.dataSize());
+    return true;
+}
+
+size_t AudioCapture::recordForDuration(float durationSeconds, int16_t* out, size_t capacity,
+                                       CancellationToken* cancel) {
+    if (m_capturing || !m_backend->isOpen() || (cancel && cancel->isCancelled())) {
+        return 0;
+    }
+
+    const size_t numSamples = std::min({static_cast<size_t>(durationSeconds * m_config.sampleRate)
+                                        * m_config.channels, capacity, m_maxCaptureSamples});
+    if (numSamples == 0) {
+        return 0;
+    }
+
+    // 목표 샘플 수에 도달하면 캡처 스레드가 엔드포인트를 알림
+    m_endpointReached = false;
+    if (!beginCapture(numSamples)) {
+        return 0;
+    }
+
+    // 마지막 프레임 도착 또는 취소 즉시 깨어남 (폴링 없음)
+    {
+        ScopedCancelCallback onCancel(cancel, [this] { signalEndpoint(); });
+        waitForEndpoint();
+    }
+
+    stopStream();
+
+    if (cancel && cancel->isCancelled()) {
+        m_ring.clear();
+        return 0;
+    }
+
+    const size_t count = m_ring.read(out, numSamples);
+    m_ring.clear();
+    return count;
+}
+
+size_t AudioCapture::captureUntilStopped(CancellationToken& stop, int16_t* out, size_t capacity,
+                                         CancellationToken* cancel) {
+    if (m_capturing || !m_backend->isOpen() || (cancel && cancel->isCancelled())) {
+        return 0;
+    }
+
+    const size_t limit = std::min(capacity, m_maxCaptureSamples);
+    m_endpointReached = false;
+    if (limit == 0 || !beginCapture(limit)) {
+        return 0;
+    }
+
+    // 키 뗌, 버퍼 가득 참, 취소 중 먼저 오는 쪽에서 깨어남
+    {
+        ScopedCancelCallback onStop(&stop, [this] { signalEndpoint(true); });
+        ScopedCancelCallback onCancel(cancel, [this] { signalEndpoint(); });
+        waitForEndpoint();
+    }
+
+    stopStream();
+
+    if (cancel && cancel->isCancelled()) {
+        m_ring.clear();
+        return 0;
+    }
+
+    const size_t count = m_ring.read(out, limit);
+    m_ring.clear();
+    return count;
+}
+
+bool AudioCapture::captureUntilStopped(CancellationToken& stop, WavBuffer& wav, CancellationToken* cancel) {
+    wav.reset(maxCaptureSamples());
+
+    wav.setSampleCount(captureUntilStopped(stop, wav.samples(), wav.capacitySamples(), cancel));
+    if (wav.empty()) {
+        return false;
+    }
+    writeWavHeader(wav.header(), wav.dataSize());
+    return true;
+}
+
+void AudioCapture::setFrameCallback(AudioCallback callback) {
+    m_frameCallback = std::move(callback);
+}
+
+void AudioCapture::setStandbyCallback(AudioCallback callback) {
+    m_standbyCallback = std::move(callback);
 }
 
 bool AudioCapture::isCapturing() const {
     return m_capturing;
 }
 
-bool AudioCapture::saveToWav(const std::vector<int16_t>& data, const std::string& filepath) {
-    auto wavBytes = toWavBytes(data);
+bool AudioCapture::saveToWav(Span<const int16_t> data, const std::string& filepath) {
+    const uint32_t dataSize = static_cast<uint32_t>(data.size_bytes());
+    uint8_t header[WavBuffer::kHeaderSize];
+    writeWavHeader(header, dataSize);
     
     std::ofstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
@@ -176,28 +490,21 @@ bool AudioCapture::saveToWav(const std::vector<int16_t>& data, const std::string
         return false;
     }
     
-    file.write(reinterpret_cast<const char*>(wavBytes.data()), wavBytes.size());
+    // 헤더와 샘플을 각각 기록 (중간 버퍼 없음)
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data.data()), dataSize);
     file.close();
     
     return true;
 }
 
-std::vector<uint8_t> AudioCapture::toWavBytes(const std::vector<int16_t>& data) {
-    uint32_t dataSize = static_cast<uint32_t>(data.size() * sizeof(int16_t));
-    
-    WavHeader header;
-    header.fileSize = dataSize + sizeof(WavHeader) - 8;
-    header.numChannels = static_cast<uint16_t>(m_config.channels);
-    header.sampleRate = static_cast<uint32_t>(m_config.sampleRate);
-    header.bitsPerSample = static_cast<uint16_t>(m_config.bitsPerSample);
-    header.blockAlign = header.numChannels * header.bitsPerSample / 8;
-    header.byteRate = header.sampleRate * header.blockAlign;
-    header.dataSize = dataSize;
+std::vector<uint8_t> AudioCapture::toWavBytes(Span<const int16_t> data) {
+    uint32_t dataSize = static_cast<uint32_t>(data.size_bytes());
     
     std::vector<uint8_t> result(sizeof(WavHeader) + dataSize);
     
-    // 헤더 복사
-    std::memcpy(result.data(), &header, sizeof(WavHeader));
+    // 헤더 작성
+    writeWavHeader(result.data(), dataSize);
     
     // 데이터 복사
     std::memcpy(result.data() + sizeof(WavHeader), data.data(), dataSize);
@@ -205,9 +512,17 @@ std::vector<uint8_t> AudioCapture::toWavBytes(const std::vector<int16_t>& data)
     return result;
 }
 
-void AudioCapture::writeWavHeader(std::vector<uint8_t>& buffer, uint32_t dataSize) {
-    // toWavBytes에서 처리
+void AudioCapture::writeWavHeader(uint8_t* header, uint32_t dataSize) const {
+    WavHeader wav;
+    wav.fileSize = dataSize + sizeof(WavHeader) - 8;
+    wav.numChannels = static_cast<uint16_t>(m_config.channels);
+    wav.sampleRate = static_cast<uint32_t>(m_config.sampleRate);
+    wav.bitsPerSample = static_cast<uint16_t>(m_config.bitsPerSample);
+    wav.blockAlign = wav.numChannels * wav.bitsPerSample / 8;
+    wav.byteRate = wav.sampleRate * wav.blockAlign;
+    wav.dataSize = dataSize;
+    
+    std::memcpy(header, &wav, sizeof(WavHeader));
 }
 
 } // namespace sion
-
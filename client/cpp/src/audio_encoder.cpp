@@ -0,0 +1,635 @@
+/**
+ * @file audio_encoder.cpp
+ * @brief 스트리밍 FLAC / Ogg Opus 인코더 구현
+ */
+
+#include "audio_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#ifdef SION_HAVE_OPUS
+#include <opus/opus.h>
+#endif
+
+namespace sion {
+
+namespace {
+
+// ============================================================================
+// 비트 출력
+// ============================================================================
+
+/**
+ * @brief MSB 우선 비트 출력기 (FLAC 비트스트림용)
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out)
+        : m_out(out)
+    {
+    }
+
+    /**
+     * @brief 하위 bits개 비트 기록 (bits <= 32)
+     */
+    void write(uint32_t value, int bits) {
+        if (bits == 0) {
+            return;
+        }
+        const uint64_t mask = (uint64_t{1} << bits) - 1;
+        m_acc = (m_acc << bits) | (value & mask);
+        m_count += bits;
+        while (m_count >= 8) {
+            m_count -= 8;
+            m_out.push_back(static_cast<uint8_t>(m_acc >> m_count));
+        }
+        m_acc &= (uint64_t{1} << m_count) - 1;
+    }
+
+    void writeSigned(int32_t value, int bits) {
+        write(static_cast<uint32_t>(value), bits);
+    }
+
+    /**
+     * @brief q개의 0 뒤에 1 (Rice 몫)
+     */
+    void writeUnary(uint32_t q) {
+        while (q >= 32) {
+            write(0, 32);
+            q -= 32;
+        }
+        write(1, static_cast<int>(q) + 1);
+    }
+
+    void alignToByte() {
+        if (m_count > 0) {
+            write(0, 8 - m_count);
+        }
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_acc = 0;
+    int m_count = 0;
+};
+
+uint8_t crc8(const uint8_t* data, size_t size) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = static_cast<uint8_t>((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint16_t crc16(const uint8_t* data, size_t size) {
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1);
+        }
+    }
+    return crc;
+}
+
+// ============================================================================
+// FLAC
+// ============================================================================
+
+// 블록 길이 (16 kHz 기준 128 ms, 헤더 코드 0b1011)
+constexpr size_t kFlacBlockSize = 2048;
+constexpr int kFlacMaxFixedOrder = 4;
+constexpr int kFlacMaxPartitionOrder = 8;
+constexpr uint32_t kFlacMaxRiceParameter = 14;   // 15는 escape
+
+inline uint32_t zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+/**
+ * @brief 고정 예측자(order 0~4) 잔차 계산
+ */
+void fixedResidual(const int32_t* x, size_t n, int order, int32_t* residual) {
+    for (size_t i = static_cast<size_t>(order); i < n; ++i) {
+        switch (order) {
+            case 0: residual[i] = x[i]; break;
+            case 1: residual[i] = x[i] - x[i - 1]; break;
+            case 2: residual[i] = x[i] - 2 * x[i - 1] + x[i - 2]; break;
+            case 3: residual[i] = x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3]; break;
+            default: residual[i] = x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4]; break;
+        }
+    }
+}
+
+/**
+ * @brief 합과 개수로 Rice 파라미터를 고르고 예상 비트 수 반환
+ */
+uint64_t bestRiceParameter(uint64_t sum, size_t count, uint32_t& parameter) {
+    uint64_t bestBits = std::numeric_limits<uint64_t>::max();
+    parameter = 0;
+    for (uint32_t k = 0; k <= kFlacMaxRiceParameter; ++k) {
+        const uint64_t bits = static_cast<uint64_t>(count) * (k + 1) + (sum >> k);
+        if (bits < bestBits) {
+            bestBits = bits;
+            parameter = k;
+        }
+    }
+    return bestBits;
+}
+
+/**
+ * @brief 잔차 분할 차수와 분할별 Rice 파라미터 선택
+ * @return 예상 비트 수 (방법/차수 필드 포함)
+ */
+uint64_t planResidual(const int32_t* residual, size_t n, int order,
+                      int& partitionOrder, std::vector<uint32_t>& parameters)
+{
+    uint64_t bestBits = std::numeric_limits<uint64_t>::max();
+    std::vector<uint32_t> candidate;
+
+    for (int p = 0; p <= kFlacMaxPartitionOrder; ++p) {
+        const size_t partitions = size_t{1} << p;
+        if (n % partitions != 0 || n / partitions <= static_cast<size_t>(order)) {
+            break;
+        }
+        const size_t partitionSize = n / partitions;
+
+        candidate.assign(partitions, 0);
+        uint64_t bits = 2 + 4;
+        for (size_t part = 0; part < partitions; ++part) {
+            const size_t begin = part == 0 ? static_cast<size_t>(order) : part * partitionSize;
+            const size_t end = (part + 1) * partitionSize;
+            uint64_t sum = 0;
+            for (size_t i = begin; i < end; ++i) {
+                sum += zigzag(residual[i]);
+            }
+            bits += 4 + bestRiceParameter(sum, end - begin, candidate[part]);
+        }
+
+        if (bits < bestBits) {
+            bestBits = bits;
+            partitionOrder = p;
+            parameters = candidate;
+        }
+    }
+    return bestBits;
+}
+
+/**
+ * @brief 스트리밍 FLAC 인코더 (16비트, 고정 예측 + 분할 Rice)
+ *
+ * STREAMINFO의 총 샘플 수와 MD5는 스트리밍이므로 0(알 수 없음)으로 둡니다.
+ */
+class FlacEncoder : public AudioEncoder {
+public:
+    bool begin(int sampleRate, int channels, std::vector<uint8_t>& out) override {
+        if (sampleRate <= 0 || sampleRate >= (1 << 20) || channels < 1 || channels > 8) {
+            return false;
+        }
+
+        m_sampleRate = sampleRate;
+        m_channels = channels;
+        m_frameNumber = 0;
+        m_pending.clear();
+        m_pending.reserve(kFlacBlockSize * static_cast<size_t>(channels));
+
+        static const uint8_t kMarker[4] = {'f', 'L', 'a', 'C'};
+        out.insert(out.end(), kMarker, kMarker + 4);
+
+        BitWriter bits(out);
+        bits.write(1, 1);                   // 마지막 메타데이터 블록
+        bits.write(0, 7);                   // STREAMINFO
+        bits.write(34, 24);
+        bits.write(kFlacBlockSize, 16);     // 최소 블록 (마지막 블록 제외)
+        bits.write(kFlacBlockSize, 16);     // 최대 블록
+        bits.write(0, 24);                  // 최소 프레임 크기 (알 수 없음)
+        bits.write(0, 24);                  // 최대 프레임 크기
+        bits.write(static_cast<uint32_t>(sampleRate), 20);
+        bits.write(static_cast<uint32_t>(channels - 1), 3);
+        bits.write(15, 5);                  // 16비트
+        bits.write(0, 4);                   // 총 샘플 수 (36비트, 0 = 알 수 없음)
+        bits.write(0, 32);
+        for (int i = 0; i < 4; ++i) {
+            bits.write(0, 32);              // MD5 (미계산)
+        }
+        return true;
+    }
+
+    void encode(const int16_t* samples, size_t count, std::vector<uint8_t>& out) override {
+        const size_t blockSamples = kFlacBlockSize * static_cast<size_t>(m_channels);
+        while (count > 0) {
+            const size_t n = std::min(count, blockSamples - m_pending.size());
+            m_pending.insert(m_pending.end(), samples, samples + n);
+            samples += n;
+            count -= n;
+
+            if (m_pending.size() == blockSamples) {
+                writeFrame(m_pending.data(), kFlacBlockSize, out);
+                m_pending.clear();
+            }
+        }
+    }
+
+    void finish(std::vector<uint8_t>& out) override {
+        const size_t frames = m_pending.size() / static_cast<size_t>(m_channels);
+        if (frames > 0) {
+            writeFrame(m_pending.data(), frames, out);
+        }
+        m_pending.clear();
+    }
+
+    protocol::AudioCodec codec() const override { return protocol::AudioCodec::Flac; }
+
+private:
+    static uint32_t sampleRateCode(int rate) {
+        switch (rate) {
+            case 8000:  return 4;
+            case 16000: return 5;
+            case 22050: return 6;
+            case 24000: return 7;
+            case 32000: return 8;
+            case 44100: return 9;
+            case 48000: return 10;
+            default:    return 0;   // STREAMINFO 참조
+        }
+    }
+
+    void writeFrame(const int16_t* interleaved, size_t frames, std::vector<uint8_t>& out) {
+        m_frame.clear();
+        BitWriter bits(m_frame);
+
+        // 프레임 헤더
+        bits.write(0x3FFE, 14);             // 동기 코드
+        bits.write(0, 1);
+        bits.write(0, 1);                   // 고정 블록 크기
+        if (frames == kFlacBlockSize) {
+            bits.write(11, 4);              // 256 * 2^(11-8) = 2048
+        } else if (frames <= 256) {
+            bits.write(6, 4);               // 헤더 끝 8비트 (blocksize-1)
+        } else {
+            bits.write(7, 4);               // 헤더 끝 16비트 (blocksize-1)
+        }
+        bits.write(sampleRateCode(m_sampleRate), 4);
+        bits.write(static_cast<uint32_t>(m_channels - 1), 4);   // 독립 채널
+        bits.write(4, 3);                   // 16비트
+        bits.write(0, 1);
+        writeUtf8Number(bits, m_frameNumber++);
+        if (frames != kFlacBlockSize) {
+            bits.write(static_cast<uint32_t>(frames - 1), frames <= 256 ? 8 : 16);
+        }
+        bits.write(crc8(m_frame.data(), m_frame.size()), 8);
+
+        // 채널별 서브프레임
+        m_channel.resize(frames);
+        m_residual.resize(frames);
+        for (int c = 0; c < m_channels; ++c) {
+            for (size_t i = 0; i < frames; ++i) {
+                m_channel[i] = interleaved[i * static_cast<size_t>(m_channels) + static_cast<size_t>(c)];
+            }
+            writeSubframe(bits, frames);
+        }
+
+        bits.alignToByte();
+        const uint16_t crc = crc16(m_frame.data(), m_frame.size());
+        bits.write(crc, 16);
+
+        out.insert(out.end(), m_frame.begin(), m_frame.end());
+    }
+
+    static void writeUtf8Number(BitWriter& bits, uint32_t value) {
+        if (value < 0x80) {
+            bits.write(value, 8);
+            return;
+        }
+        // 선두 바이트: (extra+1)개의 1 + 0 + 상위 비트, 이어지는 바이트: 10xxxxxx
+        const int extra = value < 0x800 ? 1 : value < 0x10000 ? 2 : value < 0x200000 ? 3
+                        : value < 0x4000000 ? 4 : 5;
+        const uint32_t prefix = (0xFFu << (7 - extra)) & 0xFFu;
+        bits.write(prefix | (value >> (6 * extra)), 8);
+        for (int i = extra - 1; i >= 0; --i) {
+            bits.write(0x80 | ((value >> (6 * i)) & 0x3F), 8);
+        }
+    }
+
+    void writeSubframe(BitWriter& bits, size_t n) {
+        const int32_t* x = m_channel.data();
+
+        if (std::all_of(x, x + n, [x](int32_t v) { return v == x[0]; })) {
+            bits.write(0, 1);
+            bits.write(0, 6);               // CONSTANT
+            bits.write(0, 1);
+            bits.writeSigned(x[0], 16);
+            return;
+        }
+
+        // 잔차 절댓값 합이 가장 작은 고정 예측 차수 선택
+        int bestOrder = 0;
+        uint64_t bestSum = std::numeric_limits<uint64_t>::max();
+        const int maxOrder = static_cast<int>(std::min<size_t>(kFlacMaxFixedOrder, n - 1));
+        for (int order = 0; order <= maxOrder; ++order) {
+            fixedResidual(x, n, order, m_residual.data());
+            uint64_t sum = 0;
+            for (size_t i = static_cast<size_t>(order); i < n; ++i) {
+                sum += static_cast<uint64_t>(std::abs(m_residual[i]));
+            }
+            if (sum < bestSum) {
+                bestSum = sum;
+                bestOrder = order;
+            }
+        }
+
+        fixedResidual(x, n, bestOrder, m_residual.data());
+        int partitionOrder = 0;
+        const uint64_t residualBits = planResidual(m_residual.data(), n, bestOrder,
+                                                   partitionOrder, m_parameters);
+
+        if (residualBits + 16 * static_cast<uint64_t>(bestOrder) >= 16 * static_cast<uint64_t>(n)) {
+            bits.write(0, 1);
+            bits.write(1, 6);               // VERBATIM
+            bits.write(0, 1);
+            for (size_t i = 0; i < n; ++i) {
+                bits.writeSigned(x[i], 16);
+            }
+            return;
+        }
+
+        bits.write(0, 1);
+        bits.write(8 + static_cast<uint32_t>(bestOrder), 6);   // FIXED
+        bits.write(0, 1);
+        for (int i = 0; i < bestOrder; ++i) {
+            bits.writeSigned(x[i], 16);     // 워밍업 샘플
+        }
+
+        bits.write(0, 2);                   // 4비트 Rice 파라미터
+        bits.write(static_cast<uint32_t>(partitionOrder), 4);
+        const size_t partitionSize = n >> partitionOrder;
+        for (size_t part = 0; part < m_parameters.size(); ++part) {
+            const uint32_t k = m_parameters[part];
+            bits.write(k, 4);
+            const size_t begin = part == 0 ? static_cast<size_t>(bestOrder) : part * partitionSize;
+            const size_t end = (part + 1) * partitionSize;
+            for (size_t i = begin; i < end; ++i) {
+                const uint32_t u = zigzag(m_residual[i]);
+                bits.writeUnary(u >> k);
+                bits.write(u, static_cast<int>(k));
+            }
+        }
+    }
+
+    int m_sampleRate = 16000;
+    int m_channels = 1;
+    uint32_t m_frameNumber = 0;
+    std::vector<int16_t> m_pending;      // 블록이 찰 때까지 모으는 인터리브 샘플
+    std::vector<uint8_t> m_frame;        // CRC 계산용 프레임 버퍼 (재사용)
+    std::vector<int32_t> m_channel;
+    std::vector<int32_t> m_residual;
+    std::vector<uint32_t> m_parameters;
+};
+
+// ============================================================================
+// Ogg Opus
+// ============================================================================
+
+#ifdef SION_HAVE_OPUS
+
+// 패킷 길이 (20 ms)
+constexpr int kOpusFrameMs = 20;
+constexpr int kOpusBitrate = 24000;
+constexpr int kOpusMaxPacket = 1500;
+constexpr int kOpusGranuleRate = 48000;   // Ogg Opus granule 단위
+
+// Ogg 페이지 CRC 테이블 (다항식 0x04C11DB7, 컴파일 시 생성이라 여러 세션이 동시에 인코딩해도 안전)
+constexpr std::array<uint32_t, 256> makeOggCrcTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t r = i << 24;
+        for (int bit = 0; bit < 8; ++bit) {
+            r = (r & 0x80000000u) ? (r << 1) ^ 0x04C11DB7u : r << 1;
+        }
+        table[i] = r;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> kOggCrcTable = makeOggCrcTable();
+
+uint32_t oggCrc(const uint8_t* data, size_t size) {
+    uint32_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc = (crc << 8) ^ kOggCrcTable[((crc >> 24) ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+void putLe16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void putLe32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+}
+
+/**
+ * @brief libopus 기반 Ogg Opus 인코더 (페이지당 패킷 1개)
+ *
+ * 마지막 페이지에 EOS 플래그를 달기 위해 직전 패킷 하나를 보류했다가
+ * 다음 패킷이 나오거나 finish()가 호출될 때 씁니다.
+ */
+class OggOpusEncoder : public AudioEncoder {
+public:
+    ~OggOpusEncoder() override {
+        if (m_encoder) {
+            opus_encoder_destroy(m_encoder);
+        }
+    }
+
+    bool begin(int sampleRate, int channels, std::vector<uint8_t>& out) override {
+        if (m_encoder) {
+            opus_encoder_destroy(m_encoder);
+            m_encoder = nullptr;
+        }
+
+        int error = OPUS_OK;
+        m_encoder = opus_encoder_create(sampleRate, channels, OPUS_APPLICATION_VOIP, &error);
+        if (error != OPUS_OK || !m_encoder) {
+            std::cerr << "[AudioEncoder] Opus 인코더 생성 실패: " << opus_strerror(error) << std::endl;
+            m_encoder = nullptr;
+            return false;
+        }
+        opus_encoder_ctl(m_encoder, OPUS_SET_BITRATE(kOpusBitrate));
+        opus_encoder_ctl(m_encoder, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE));
+
+        opus_int32 lookahead = 0;
+        opus_encoder_ctl(m_encoder, OPUS_GET_LOOKAHEAD(&lookahead));
+
+        m_sampleRate = sampleRate;
+        m_channels = channels;
+        m_granuleScale = kOpusGranuleRate / sampleRate;
+        m_frameSamples = static_cast<size_t>(sampleRate / (1000 / kOpusFrameMs));
+        m_preSkip = static_cast<uint16_t>(lookahead * m_granuleScale);
+        m_serial = static_cast<uint32_t>(std::rand());
+        m_pageSequence = 0;
+        m_encodedFrames = 0;
+        m_inputFrames = 0;
+        m_hasPendingPacket = false;
+        m_pending.clear();
+        m_pending.reserve(m_frameSamples * static_cast<size_t>(channels));
+
+        std::vector<uint8_t> head = {'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 1,
+                                     static_cast<uint8_t>(channels)};
+        putLe16(head, m_preSkip);
+        putLe32(head, static_cast<uint32_t>(sampleRate));
+        putLe16(head, 0);                   // 출력 이득
+        head.push_back(0);                  // 채널 매핑 0 (모노/스테레오)
+        writePage(head, 0, 0x02, out);      // BOS
+
+        std::vector<uint8_t> tags = {'O', 'p', 'u', 's', 'T', 'a', 'g', 's'};
+        static const char kVendor[] = "sion";
+        putLe32(tags, sizeof(kVendor) - 1);
+        tags.insert(tags.end(), kVendor, kVendor + sizeof(kVendor) - 1);
+        putLe32(tags, 0);                   // 사용자 주석 없음
+        writePage(tags, 0, 0x00, out);
+        return true;
+    }
+
+    void encode(const int16_t* samples, size_t count, std::vector<uint8_t>& out) override {
+        const size_t packetSamples = m_frameSamples * static_cast<size_t>(m_channels);
+        m_inputFrames += count / static_cast<size_t>(m_channels);
+        while (count > 0) {
+            const size_t n = std::min(count, packetSamples - m_pending.size());
+            m_pending.insert(m_pending.end(), samples, samples + n);
+            samples += n;
+            count -= n;
+
+            if (m_pending.size() == packetSamples) {
+                encodePacket(out);
+            }
+        }
+    }
+
+    void finish(std::vector<uint8_t>& out) override {
+        if (!m_encoder) {
+            return;
+        }
+        if (!m_pending.empty() || !m_hasPendingPacket) {
+            // 마지막 패킷은 무음으로 채우고 granule로 실제 길이를 알림
+            m_pending.resize(m_frameSamples * static_cast<size_t>(m_channels), 0);
+            encodePacket(out);
+        }
+
+        const uint64_t decoded = m_encodedFrames * m_frameSamples * m_granuleScale;
+        const uint64_t actual = m_preSkip + m_inputFrames * m_granuleScale;
+        writePage(m_packet, std::min(decoded, actual), 0x04, out);   // EOS
+        m_hasPendingPacket = false;
+    }
+
+    protocol::AudioCodec codec() const override { return protocol::AudioCodec::Opus; }
+
+private:
+    void encodePacket(std::vector<uint8_t>& out) {
+        if (m_hasPendingPacket) {
+            writePage(m_packet, m_encodedFrames * m_frameSamples * m_granuleScale, 0x00, out);
+        }
+
+        m_packet.resize(kOpusMaxPacket);
+        const opus_int32 size = opus_encode(m_encoder, m_pending.data(), static_cast<int>(m_frameSamples),
+                                            m_packet.data(), kOpusMaxPacket);
+        m_pending.clear();
+        if (size < 0) {
+            std::cerr << "[AudioEncoder] Opus 인코딩 실패: " << opus_strerror(size) << std::endl;
+            m_packet.clear();
+        } else {
+            m_packet.resize(static_cast<size_t>(size));
+        }
+        ++m_encodedFrames;
+        m_hasPendingPacket = true;
+    }
+
+    void writePage(const std::vector<uint8_t>& packet, uint64_t granule, uint8_t headerType,
+                   std::vector<uint8_t>& out)
+    {
+        const size_t start = out.size();
+        static const uint8_t kCapture[4] = {'O', 'g', 'g', 'S'};
+        out.insert(out.end(), kCapture, kCapture + 4);
+        out.push_back(0);                   // 버전
+        out.push_back(headerType);
+        putLe32(out, static_cast<uint32_t>(granule));
+        putLe32(out, static_cast<uint32_t>(granule >> 32));
+        putLe32(out, m_serial);
+        putLe32(out, m_pageSequence++);
+        putLe32(out, 0);                    // CRC 자리
+
+        // 레이싱: 255 단위 분할, 마지막 값은 255 미만
+        const size_t segments = packet.size() / 255 + 1;
+        out.push_back(static_cast<uint8_t>(segments));
+        for (size_t i = 0; i + 1 < segments; ++i) {
+            out.push_back(255);
+        }
+        out.push_back(static_cast<uint8_t>(packet.size() % 255));
+        out.insert(out.end(), packet.begin(), packet.end());
+
+        const uint32_t crc = oggCrc(out.data() + start, out.size() - start);
+        for (int i = 0; i < 4; ++i) {
+            out[start + 22 + static_cast<size_t>(i)] = static_cast<uint8_t>(crc >> (8 * i));
+        }
+    }
+
+    OpusEncoder* m_encoder = nullptr;
+    int m_sampleRate = 16000;
+    int m_channels = 1;
+    uint64_t m_granuleScale = 3;
+    size_t m_frameSamples = 320;
+    uint16_t m_preSkip = 0;
+    uint32_t m_serial = 0;
+    uint32_t m_pageSequence = 0;
+    uint64_t m_encodedFrames = 0;        // 인코딩한 패킷 수
+    uint64_t m_inputFrames = 0;          // 실제 입력 프레임 수 (패딩 제외)
+    std::vector<int16_t> m_pending;
+    std::vector<uint8_t> m_packet;       // 아직 페이지로 쓰지 않은 마지막 패킷
+    bool m_hasPendingPacket = false;
+};
+
+#endif // SION_HAVE_OPUS
+
+} // namespace
+
+std::unique_ptr<AudioEncoder> createAudioEncoder(protocol::AudioCodec codec) {
+    switch (codec) {
+        case protocol::AudioCodec::Flac:
+            return std::make_unique<FlacEncoder>();
+#ifdef SION_HAVE_OPUS
+        case protocol::AudioCodec::Opus:
+            return std::make_unique<OggOpusEncoder>();
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+bool isCodecAvailable(protocol::AudioCodec codec) {
+    switch (codec) {
+        case protocol::AudioCodec::Pcm:
+        case protocol::AudioCodec::Flac:
+            return true;
+        case protocol::AudioCodec::Opus:
+#ifdef SION_HAVE_OPUS
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+} // namespace sion
@@ -0,0 +1,440 @@
+/**
+ * @file audio_kernels.cpp
+ * @brief 프레임 에너지/영교차율, 리샘플링 및 키워드 인식 SIMD 커널 구현
+ *
+ * 기본 구현은 빌드 대상 ISA(x86: SSE2, ARM: NEON, 그 외: 스칼라)로 컴파일되고,
+ * x86 빌드에는 AVX2 커널(audio_kernels_avx2.cpp)이 함께 들어가 처음 호출할 때
+ * CPU 기능을 확인해 함수 테이블을 고릅니다. 하나의 바이너리가 구형 CPU에서도
+ * 동작하면서 최신 CPU에서는 AVX2를 사용합니다.
+ * 환경 변수 SION_KERNELS_ISA(scalar, sse2, neon, avx2)로 지원 범위 안에서 강제할 수 있습니다
+ * (벤치마크 비교용).
+ */
+
+#include "audio_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SION_KERNELS_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SION_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(SION_KERNELS_AVX2_DISPATCH) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace sion {
+namespace kernels {
+
+// ============================================================================
+// 스칼라 구현
+// ============================================================================
+
+uint64_t sumOfSquaresScalar(const int16_t* samples, size_t count) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const int32_t s = samples[i];
+        sum += static_cast<uint64_t>(s * s);
+    }
+    return sum;
+}
+
+uint32_t zeroCrossingsScalar(const int16_t* samples, size_t count) {
+    uint32_t crossings = 0;
+    for (size_t i = 1; i < count; ++i) {
+        crossings += static_cast<uint32_t>((samples[i] ^ samples[i - 1]) < 0);
+    }
+    return crossings;
+}
+
+float dotProductScalar(const float* a, const float* b, size_t count) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void floatToInt16Scalar(const float* in, int16_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float scaled = std::min(std::max(in[i] * 32768.0f, -32768.0f), 32767.0f);
+        out[i] = static_cast<int16_t>(std::lrintf(scaled));
+    }
+}
+
+void applyWindowScalar(const int16_t* samples, const float* window, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<float>(samples[i]) * window[i];
+    }
+}
+
+int32_t dotProductInt8Scalar(const int8_t* a, const int8_t* b, size_t count) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    }
+    return sum;
+}
+
+// ============================================================================
+// SIMD 구현
+// ============================================================================
+
+#if defined(SION_KERNELS_AVX2_DISPATCH)
+namespace avx2 {
+// audio_kernels_avx2.cpp
+uint64_t sumOfSquares(const int16_t* samples, size_t count);
+uint32_t zeroCrossings(const int16_t* samples, size_t count);
+float dotProduct(const float* a, const float* b, size_t count);
+void floatToInt16(const float* in, int16_t* out, size_t count);
+void applyWindow(const int16_t* samples, const float* window, float* out, size_t count);
+int32_t dotProductInt8(const int8_t* a, const int8_t* b, size_t count);
+} // namespace avx2
+#endif
+
+namespace {
+
+#if defined(SION_KERNELS_SSE2)
+namespace sse2 {
+
+uint64_t sumOfSquares(const int16_t* samples, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        // 쌍별 곱의 합은 최대 2^31이므로 부호 없는 32비트로 해석해 64비트로 확장
+        const __m128i sq = _mm_madd_epi16(x, x);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(sq, zero));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(sq, zero));
+    }
+
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + sumOfSquaresScalar(samples + i, count - i);
+}
+
+uint32_t zeroCrossings(const int16_t* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 1;
+
+    for (; i + 8 <= count; i += 8) {
+        const __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        const __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i - 1));
+        const __m128i flip = _mm_srli_epi16(_mm_xor_si128(cur, prev), 15);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(flip, ones));
+    }
+
+    alignas(16) uint32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3]
+         + zeroCrossingsScalar(samples + i - 1, count - i + 1);
+}
+
+float dotProduct(const float* a, const float* b, size_t count) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i = 0;
+
+    // 누산기 두 개로 곱-덧셈 의존 사슬을 나눔
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+
+    __m128 sum = _mm_add_ps(acc0, acc1);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum) + dotProductScalar(a + i, b + i, count - i);
+}
+
+void floatToInt16(const float* in, int16_t* out, size_t count) {
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    const __m128 upper = _mm_set1_ps(32767.0f);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        // cvtps는 범위 밖을 INT_MIN으로 만들지만 packs가 int16 범위로 포화시킴
+        const __m128i lo = _mm_cvtps_epi32(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(in + i), scale), upper));
+        const __m128i hi = _mm_cvtps_epi32(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale), upper));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));
+    }
+    floatToInt16Scalar(in + i, out + i, count - i);
+}
+
+void applyWindow(const int16_t* samples, const float* window, float* out, size_t count) {
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        // 상위 16비트에 넣은 뒤 산술 시프트로 부호 확장
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), _mm_loadu_ps(window + i)));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), _mm_loadu_ps(window + i + 4)));
+    }
+    applyWindowScalar(samples + i, window + i, out + i, count - i);
+}
+
+int32_t dotProductInt8(const int8_t* a, const int8_t* b, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        // SSE2에는 부호 있는 8비트 확장이 없으므로 부호 마스크와 섞어 16비트로 확장
+        const __m128i xs = _mm_cmpgt_epi8(zero, x);
+        const __m128i ys = _mm_cmpgt_epi8(zero, y);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(x, xs), _mm_unpacklo_epi8(y, ys)));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(x, xs), _mm_unpackhi_epi8(y, ys)));
+    }
+
+    alignas(16) int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dotProductInt8Scalar(a + i, b + i, count - i);
+}
+
+} // namespace sse2
+#elif defined(SION_KERNELS_NEON)
+namespace neon {
+
+uint64_t sumOfSquares(const int16_t* samples, size_t count) {
+    uint64x2_t acc = vdupq_n_u64(0);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t x = vld1q_s16(samples + i);
+        const int32x4_t lo = vmull_s16(vget_low_s16(x), vget_low_s16(x));
+        const int32x4_t hi = vmull_s16(vget_high_s16(x), vget_high_s16(x));
+        acc = vpadalq_u32(acc, vreinterpretq_u32_s32(lo));
+        acc = vpadalq_u32(acc, vreinterpretq_u32_s32(hi));
+    }
+
+    return vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1)
+         + sumOfSquaresScalar(samples + i, count - i);
+}
+
+uint32_t zeroCrossings(const int16_t* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t i = 1;
+
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t cur = vld1q_s16(samples + i);
+        const int16x8_t prev = vld1q_s16(samples + i - 1);
+        const uint16x8_t flip = vshrq_n_u16(vreinterpretq_u16_s16(veorq_s16(cur, prev)), 15);
+        acc = vpadalq_u16(acc, flip);
+    }
+
+    return vgetq_lane_u32(acc, 0) + vgetq_lane_u32(acc, 1)
+         + vgetq_lane_u32(acc, 2) + vgetq_lane_u32(acc, 3)
+         + zeroCrossingsScalar(samples + i - 1, count - i + 1);
+}
+
+float dotProduct(const float* a, const float* b, size_t count) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    for (; i + 4 <= count; i += 4) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+
+    const float32x4_t acc = vaddq_f32(acc0, acc1);
+    const float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    return vget_lane_f32(vpadd_f32(pair, pair), 0) + dotProductScalar(a + i, b + i, count - i);
+}
+
+void floatToInt16(const float* in, int16_t* out, size_t count) {
+    const float32x4_t scale = vdupq_n_f32(32768.0f);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        // vcvtnq는 포화 변환이고 vqmovn이 int16 범위로 한 번 더 포화
+        const int32x4_t lo = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + i), scale));
+        const int32x4_t hi = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + i + 4), scale));
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+    floatToInt16Scalar(in + i, out + i, count - i);
+}
+
+void applyWindow(const int16_t* samples, const float* window, float* out, size_t count) {
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t x = vld1q_s16(samples + i);
+        const float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x)));
+        const float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x)));
+        vst1q_f32(out + i, vmulq_f32(lo, vld1q_f32(window + i)));
+        vst1q_f32(out + i + 4, vmulq_f32(hi, vld1q_f32(window + i + 4)));
+    }
+    applyWindowScalar(samples + i, window + i, out + i, count - i);
+}
+
+int32_t dotProductInt8(const int8_t* a, const int8_t* b, size_t count) {
+    int32x4_t acc = vdupq_n_s32(0);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        const int8x16_t x = vld1q_s8(a + i);
+        const int8x16_t y = vld1q_s8(b + i);
+        // 곱은 int16에 들어가고(최대 2^14) 인접 쌍을 int32로 누적
+        acc = vpadalq_s16(acc, vmull_s8(vget_low_s8(x), vget_low_s8(y)));
+        acc = vpadalq_s16(acc, vmull_s8(vget_high_s8(x), vget_high_s8(y)));
+    }
+
+    return vgetq_lane_s32(acc, 0) + vgetq_lane_s32(acc, 1)
+         + vgetq_lane_s32(acc, 2) + vgetq_lane_s32(acc, 3)
+         + dotProductInt8Scalar(a + i, b + i, count - i);
+}
+
+} // namespace neon
+#endif
+
+// ============================================================================
+// 런타임 디스패치
+// ============================================================================
+
+struct KernelTable {
+    const char* isa;
+    uint64_t (*sumOfSquares)(const int16_t*, size_t);
+    uint32_t (*zeroCrossings)(const int16_t*, size_t);
+    float (*dotProduct)(const float*, const float*, size_t);
+    void (*floatToInt16)(const float*, int16_t*, size_t);
+    void (*applyWindow)(const int16_t*, const float*, float*, size_t);
+    int32_t (*dotProductInt8)(const int8_t*, const int8_t*, size_t);
+};
+
+#if defined(SION_KERNELS_AVX2_DISPATCH)
+bool cpuSupportsAvx2() {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // OS가 YMM 레지스터 상태를 저장하는지(OSXSAVE + XCR0) 함께 확인
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+KernelTable selectKernels() {
+    const KernelTable scalar = {"scalar", sumOfSquaresScalar, zeroCrossingsScalar,
+                                dotProductScalar, floatToInt16Scalar,
+                                applyWindowScalar, dotProductInt8Scalar};
+    std::vector<KernelTable> supported = {scalar};
+#if defined(SION_KERNELS_SSE2)
+    supported.push_back({"sse2", sse2::sumOfSquares, sse2::zeroCrossings,
+                         sse2::dotProduct, sse2::floatToInt16,
+                         sse2::applyWindow, sse2::dotProductInt8});
+#elif defined(SION_KERNELS_NEON)
+    supported.push_back({"neon", neon::sumOfSquares, neon::zeroCrossings,
+                         neon::dotProduct, neon::floatToInt16,
+                         neon::applyWindow, neon::dotProductInt8});
+#endif
+#if defined(SION_KERNELS_AVX2_DISPATCH)
+    if (cpuSupportsAvx2()) {
+        supported.push_back({"avx2", avx2::sumOfSquares, avx2::zeroCrossings,
+                             avx2::dotProduct, avx2::floatToInt16,
+                             avx2::applyWindow, avx2::dotProductInt8});
+    }
+#endif
+
+    // 강제 지정 (지원하지 않는 이름이면 무시하고 가장 빠른 구현)
+    if (const char* forced = std::getenv("SION_KERNELS_ISA")) {
+        for (const KernelTable& table : supported) {
+            if (std::strcmp(table.isa, forced) == 0) {
+                return table;
+            }
+        }
+    }
+    return supported.back();
+}
+
+const KernelTable& kernelTable() {
+    static const KernelTable table = selectKernels();
+    return table;
+}
+
+} // namespace
+
+uint64_t sumOfSquares(const int16_t* samples, size_t count) {
+    return kernelTable().sumOfSquares(samples, count);
+}
+
+uint32_t zeroCrossings(const int16_t* samples, size_t count) {
+    return kernelTable().zeroCrossings(samples, count);
+}
+
+float dotProduct(const float* a, const float* b, size_t count) {
+    return kernelTable().dotProduct(a, b, count);
+}
+
+void floatToInt16(const float* in, int16_t* out, size_t count) {
+    kernelTable().floatToInt16(in, out, count);
+}
+
+void applyWindow(const int16_t* samples, const float* window, float* out, size_t count) {
+    kernelTable().applyWindow(samples, window, out, count);
+}
+
+int32_t dotProductInt8(const int8_t* a, const int8_t* b, size_t count) {
+    return kernelTable().dotProductInt8(a, b, count);
+}
+
+const char* activeIsa() {
+    return kernelTable().isa;
+}
+
+FrameFeatures computeFrameFeatures(const int16_t* samples, size_t count) {
+    FrameFeatures features;
+    if (count == 0) {
+        return features;
+    }
+
+    const double meanSquare = static_cast<double>(sumOfSquares(samples, count)) / count;
+    features.rms = static_cast<float>(std::sqrt(meanSquare));
+    features.zcr = count > 1
+        ? static_cast<float>(zeroCrossings(samples, count)) / static_cast<float>(count - 1)
+        : 0.0f;
+    return features;
+}
+
+} // namespace kernels
+} // namespace sion
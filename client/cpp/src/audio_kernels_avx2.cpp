@@ -0,0 +1,141 @@
+/**
+ * @file audio_kernels_avx2.cpp
+ * @brief AVX2 커널 (이 파일만 -mavx2 / /arch:AVX2로 컴파일)
+ *
+ * audio_kernels.cpp가 CPU가 AVX2를 지원할 때만 호출합니다.
+ * 다른 번역 단위와 공유되는 인라인 함수(std::min 등)를 쓰면 링커가 AVX2로
+ * 컴파일된 사본을 골라 구형 CPU에서 잘못된 명령어 예외가 날 수 있으므로,
+ * 여기서는 intrinsic과 audio_kernels.cpp의 스칼라 함수만 사용합니다.
+ */
+
+#include "audio_kernels.h"
+
+#include <immintrin.h>
+
+namespace sion {
+namespace kernels {
+namespace avx2 {
+
+uint64_t sumOfSquares(const int16_t* samples, size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + i));
+        // 쌍별 곱의 합은 최대 2^31이므로 부호 없는 32비트로 해석해 64비트로 확장
+        const __m256i sq = _mm256_madd_epi16(x, x);
+        acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(sq, zero));
+        acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(sq, zero));
+    }
+
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3]
+         + sumOfSquaresScalar(samples + i, count - i);
+}
+
+uint32_t zeroCrossings(const int16_t* samples, size_t count) {
+    if (count < 2) {
+        return 0;
+    }
+
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 1;
+
+    for (; i + 16 <= count; i += 16) {
+        const __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + i));
+        const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + i - 1));
+        const __m256i flip = _mm256_srli_epi16(_mm256_xor_si256(cur, prev), 15);
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(flip, ones));
+    }
+
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    uint32_t crossings = 0;
+    for (uint32_t lane : lanes) {
+        crossings += lane;
+    }
+    return crossings + zeroCrossingsScalar(samples + i - 1, count - i + 1);
+}
+
+float dotProduct(const float* a, const float* b, size_t count) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+
+    // 누산기 두 개로 곱-덧셈 의존 사슬을 나눔
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+
+    const __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum) + dotProductScalar(a + i, b + i, count - i);
+}
+
+void floatToInt16(const float* in, int16_t* out, size_t count) {
+    const __m256 scale = _mm256_set1_ps(32768.0f);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        // cvtps는 범위 밖을 INT_MIN으로 만들지만 packs가 int16 범위로 포화시킴
+        const __m256i lo = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale),
+                                                            _mm256_set1_ps(32767.0f)));
+        const __m256i hi = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8), scale),
+                                                            _mm256_set1_ps(32767.0f)));
+        // packs는 128비트 레인 단위이므로 순서를 되돌림
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+    }
+    floatToInt16Scalar(in + i, out + i, count - i);
+}
+
+void applyWindow(const int16_t* samples, const float* window, float* out, size_t count) {
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i + 8));
+        const __m256 flo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(lo));
+        const __m256 fhi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(hi));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(flo, _mm256_loadu_ps(window + i)));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(fhi, _mm256_loadu_ps(window + i + 8)));
+    }
+    applyWindowScalar(samples + i, window + i, out + i, count - i);
+}
+
+int32_t dotProductInt8(const int8_t* a, const int8_t* b, size_t count) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        const __m256i x0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        const __m256i y0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        const __m256i x1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 16)));
+        const __m256i y1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 16)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(x0, y0));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(x1, y1));
+    }
+    for (; i + 16 <= count; i += 16) {
+        const __m256i x = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        const __m256i y = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(x, y));
+    }
+
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum) + dotProductInt8Scalar(a + i, b + i, count - i);
+}
+
+} // namespace avx2
+} // namespace kernels
+} // namespace sion
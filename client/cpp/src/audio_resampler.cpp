@@ -0,0 +1,364 @@
+/**
+ * @file audio_resampler.cpp
+ * @brief AudioResampler 클래스 구현 (폴리페이즈 FIR)
+ */
+
+#include "audio_resampler.h"
+#include "audio_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace sion {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Kaiser 창 β (저지대역 감쇠 약 80 dB)
+constexpr double kKaiserBeta = 8.0;
+
+// 통과대역 비율 (나이퀴스트 대비, 나머지는 천이 대역)
+constexpr double kPassbandRatio = 0.92;
+
+// 위상당 탭 수 (입력 샘플 기준 필터 길이)
+constexpr int kTapsPerPhase = 48;
+
+/**
+ * @brief 0차 수정 베셀 함수 (Kaiser 창용 급수 전개)
+ */
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfSq = x * x / 4.0;
+    for (int k = 1; k < 50; ++k) {
+        term *= halfSq / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief 폴리페이즈 계수 생성
+ *
+ * 길이 L*taps의 저역 통과 원형 필터 h를 설계한 뒤 위상 p마다
+ * h[p + k*L]을 역순으로 모아 [phase][tap] 배열로 저장합니다.
+ * 역순 저장 덕분에 출력 하나가 연속 입력 구간과의 내적 한 번이 됩니다.
+ * @param out L*taps개 float
+ */
+void designPolyphase(int upFactor, int downFactor, int taps, float* out) {
+    const int length = upFactor * taps;
+    const double center = (length - 1) / 2.0;
+    const double cutoff = 0.5 / std::max(upFactor, downFactor) * kPassbandRatio;   // 업샘플 도메인 기준
+    const double windowNorm = besselI0(kKaiserBeta);
+
+    std::vector<double> prototype(static_cast<size_t>(length));
+    double sum = 0.0;
+    for (int n = 0; n < length; ++n) {
+        const double t = n - center;
+        const double x = 2.0 * cutoff * t;
+        const double sinc = std::abs(x) < 1e-12 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+        const double r = length > 1 ? 2.0 * t / (length - 1) : 0.0;
+        const double window = besselI0(kKaiserBeta * std::sqrt(std::max(0.0, 1.0 - r * r))) / windowNorm;
+        prototype[n] = 2.0 * cutoff * sinc * window;
+        sum += prototype[n];
+    }
+
+    // 업샘플링으로 줄어든 에너지 보상: 위상마다 DC 이득 ≈ 1
+    const double gain = upFactor / sum;
+    for (int phase = 0; phase < upFactor; ++phase) {
+        for (int j = 0; j < taps; ++j) {
+            const int k = taps - 1 - j;
+            out[phase * taps + j] = static_cast<float>(prototype[phase + k * upFactor] * gain);
+        }
+    }
+}
+
+/**
+ * @brief 폴리페이즈 리샘플링 루프 (고정/런타임 구현 공용)
+ *
+ * history는 taps-1개의 이전 입력 뒤에 새 입력이 이어진 버퍼이고,
+ * pos는 다음 출력의 기준 입력 위치, phase는 그 출력의 필터 위상입니다.
+ */
+template <typename Ratio>
+void runPolyphase(const Ratio& ratio, const float* coefficients,
+                  std::vector<float>& history, size_t& pos, int& phase,
+                  const float* in, size_t count, std::vector<float>& out)
+{
+    const int up = ratio.up();
+    const int down = ratio.down();
+    const int taps = ratio.taps();
+
+    history.insert(history.end(), in, in + count);
+
+    const size_t available = history.size();
+    size_t p = pos;
+    int ph = phase;
+    while (p < available) {
+        const float* window = history.data() + p - static_cast<size_t>(taps - 1);
+        out.push_back(kernels::dotProduct(coefficients + static_cast<size_t>(ph) * taps, window,
+                                          static_cast<size_t>(taps)));
+        ph += down;
+        p += static_cast<size_t>(ph / up);
+        ph %= up;
+    }
+
+    // 다음 출력에 필요한 taps-1개 이전 입력만 남김
+    const size_t keepFrom = std::min(p - static_cast<size_t>(taps - 1), available);
+    history.erase(history.begin(), history.begin() + static_cast<std::ptrdiff_t>(keepFrom));
+    pos = p - keepFrom;
+    phase = ph;
+}
+
+} // namespace
+
+// ============================================================================
+// 리샘플링 커널
+// ============================================================================
+
+class AudioResampler::Kernel {
+public:
+    virtual ~Kernel() = default;
+    virtual void process(const float* in, size_t count, std::vector<float>& out) = 0;
+    virtual void reset() = 0;
+    virtual const char* description() const = 0;
+};
+
+namespace {
+
+/**
+ * @brief 컴파일 타임에 비율과 탭 수가 고정된 폴리페이즈 커널
+ *
+ * 위상 증가/나머지 연산이 상수로 접히고 계수 테이블 크기가 고정됩니다.
+ */
+template <int Up, int Down, int Taps>
+class FixedPolyphaseKernel : public AudioResampler::Kernel {
+public:
+    struct Ratio {
+        constexpr int up() const { return Up; }
+        constexpr int down() const { return Down; }
+        constexpr int taps() const { return Taps; }
+    };
+
+    explicit FixedPolyphaseKernel(const char* description)
+        : m_coefficients(static_cast<size_t>(Up) * Taps)
+        , m_description(description)
+    {
+        designPolyphase(Up, Down, Taps, m_coefficients.data());
+        reset();
+    }
+
+    void process(const float* in, size_t count, std::vector<float>& out) override {
+        runPolyphase(Ratio{}, m_coefficients.data(), m_history, m_pos, m_phase, in, count, out);
+    }
+
+    void reset() override {
+        m_history.assign(Taps - 1, 0.0f);
+        m_pos = Taps - 1;
+        m_phase = 0;
+    }
+
+    const char* description() const override { return m_description; }
+
+private:
+    std::vector<float> m_coefficients;
+    std::vector<float> m_history;
+    size_t m_pos = 0;
+    int m_phase = 0;
+    const char* m_description;
+};
+
+/**
+ * @brief 임의 유리수 비율 폴리페이즈 커널
+ */
+class RuntimePolyphaseKernel : public AudioResampler::Kernel {
+public:
+    struct Ratio {
+        int upFactor;
+        int downFactor;
+        int tapCount;
+        int up() const { return upFactor; }
+        int down() const { return downFactor; }
+        int taps() const { return tapCount; }
+    };
+
+    RuntimePolyphaseKernel(int up, int down, int taps)
+        : m_ratio{up, down, taps}
+        , m_coefficients(static_cast<size_t>(up) * taps)
+    {
+        designPolyphase(up, down, taps, m_coefficients.data());
+        reset();
+    }
+
+    void process(const float* in, size_t count, std::vector<float>& out) override {
+        runPolyphase(m_ratio, m_coefficients.data(), m_history, m_pos, m_phase, in, count, out);
+    }
+
+    void reset() override {
+        m_history.assign(static_cast<size_t>(m_ratio.tapCount - 1), 0.0f);
+        m_pos = static_cast<size_t>(m_ratio.tapCount - 1);
+        m_phase = 0;
+    }
+
+    const char* description() const override { return "polyphase (runtime ratio)"; }
+
+private:
+    Ratio m_ratio;
+    std::vector<float> m_coefficients;
+    std::vector<float> m_history;
+    size_t m_pos = 0;
+    int m_phase = 0;
+};
+
+// 계수 테이블이 과도하게 커지는 비율(서로소 L이 큰 경우)은 거부
+constexpr int kMaxUpFactor = 1024;
+
+/**
+ * @brief 인터리브 입력을 모노 float으로 다운믹스
+ */
+void downmix(const void* data, size_t frames, const InputFormat& input, float* out) {
+    const size_t channels = static_cast<size_t>(input.channels);
+
+    switch (input.format) {
+    case SampleFormat::Float32: {
+        const float* src = static_cast<const float*>(data);
+        if (channels == 1) {
+            std::memcpy(out, src, frames * sizeof(float));
+        } else if (channels == 2) {
+            for (size_t i = 0; i < frames; ++i) {
+                out[i] = 0.5f * (src[2 * i] + src[2 * i + 1]);
+            }
+        } else {
+            const float scale = 1.0f / static_cast<float>(channels);
+            for (size_t i = 0; i < frames; ++i) {
+                float sum = 0.0f;
+                for (size_t c = 0; c < channels; ++c) {
+                    sum += src[i * channels + c];
+                }
+                out[i] = sum * scale;
+            }
+        }
+        break;
+    }
+    case SampleFormat::Int16: {
+        const int16_t* src = static_cast<const int16_t*>(data);
+        const float scale = 1.0f / (32768.0f * static_cast<float>(channels));
+        for (size_t i = 0; i < frames; ++i) {
+            int32_t sum = 0;
+            for (size_t c = 0; c < channels; ++c) {
+                sum += src[i * channels + c];
+            }
+            out[i] = static_cast<float>(sum) * scale;
+        }
+        break;
+    }
+    case SampleFormat::Int32: {
+        const int32_t* src = static_cast<const int32_t*>(data);
+        const float scale = 1.0f / (2147483648.0f * static_cast<float>(channels));
+        for (size_t i = 0; i < frames; ++i) {
+            int64_t sum = 0;
+            for (size_t c = 0; c < channels; ++c) {
+                sum += src[i * channels + c];
+            }
+            out[i] = static_cast<float>(sum) * scale;
+        }
+        break;
+    }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// AudioResampler 구현
+// ============================================================================
+
+AudioResampler::AudioResampler()
+    : m_outputRate(0)
+    , m_passthrough(false)
+{
+}
+
+AudioResampler::~AudioResampler() = default;
+
+bool AudioResampler::configure(const InputFormat& input, int outputRate) {
+    if (input.sampleRate <= 0 || input.channels <= 0 || outputRate <= 0) {
+        return false;
+    }
+
+    m_input = input;
+    m_outputRate = outputRate;
+    m_kernel.reset();
+    m_passthrough = input.sampleRate == outputRate && input.channels == 1
+                 && input.format == SampleFormat::Int16;
+
+    if (input.sampleRate == outputRate) {
+        return true;
+    }
+
+    const int divisor = std::gcd(input.sampleRate, outputRate);
+    const int up = outputRate / divisor;
+    const int down = input.sampleRate / divisor;
+
+    // 흔한 장치 레이트는 컴파일 타임 특수화 구현 사용
+    if (up == 1 && down == 3) {
+        m_kernel = std::make_unique<FixedPolyphaseKernel<1, 3, kTapsPerPhase>>("polyphase 48k→16k (fixed)");
+    } else if (up == 160 && down == 441) {
+        m_kernel = std::make_unique<FixedPolyphaseKernel<160, 441, kTapsPerPhase>>("polyphase 44.1k→16k (fixed)");
+    } else if (up <= kMaxUpFactor) {
+        m_kernel = std::make_unique<RuntimePolyphaseKernel>(up, down, kTapsPerPhase);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void AudioResampler::process(const void* data, size_t frames, std::vector<int16_t>& out) {
+    if (frames == 0) {
+        return;
+    }
+
+    if (m_passthrough && data) {
+        const int16_t* src = static_cast<const int16_t*>(data);
+        out.insert(out.end(), src, src + frames);
+        return;
+    }
+
+    m_mono.resize(frames);
+    if (data) {
+        downmix(data, frames, m_input, m_mono.data());
+    } else {
+        std::fill(m_mono.begin(), m_mono.end(), 0.0f);
+    }
+
+    const std::vector<float>* converted = &m_mono;
+    if (m_kernel) {
+        m_resampled.clear();
+        m_kernel->process(m_mono.data(), frames, m_resampled);
+        converted = &m_resampled;
+    }
+
+    const size_t offset = out.size();
+    out.resize(offset + converted->size());
+    kernels::floatToInt16(converted->data(), out.data() + offset, converted->size());
+}
+
+void AudioResampler::reset() {
+    if (m_kernel) {
+        m_kernel->reset();
+    }
+}
+
+const char* AudioResampler::description() const {
+    if (m_passthrough) {
+        return "passthrough";
+    }
+    return m_kernel ? m_kernel->description() : "downmix only";
+}
+
+} // namespace sion
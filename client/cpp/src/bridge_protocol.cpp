@@ -0,0 +1,120 @@
+/**
+ * @file bridge_protocol.cpp
+ * @brief 브릿지 파이프 프로토콜 직렬화 구현
+ */
+
+#include "bridge_protocol.h"
+
+namespace sion {
+namespace protocol {
+
+namespace {
+
+void putU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t getU32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0])
+         | static_cast<uint32_t>(in[1]) << 8
+         | static_cast<uint32_t>(in[2]) << 16
+         | static_cast<uint32_t>(in[3]) << 24;
+}
+
+} // namespace
+
+void encodeHeader(const FrameHeader& header, uint8_t* out) {
+    out[0] = kMagic;
+    out[1] = kVersion;
+    out[2] = static_cast<uint8_t>(header.type);
+    out[3] = header.flags;
+    putU32(out + 4, header.utteranceId);
+    putU32(out + 8, header.sequence);
+    putU32(out + 12, header.payloadSize);
+}
+
+bool decodeHeader(const uint8_t* in, FrameHeader& header) {
+    if (in[0] != kMagic || in[1] != kVersion) {
+        return false;
+    }
+
+    header.type = static_cast<MessageType>(in[2]);
+    header.flags = in[3];
+    header.utteranceId = getU32(in + 4);
+    header.sequence = getU32(in + 8);
+    header.payloadSize = getU32(in + 12);
+
+    return header.payloadSize <= kMaxPayloadSize;
+}
+
+void encodeShmAudioRef(const ShmAudioRef& ref, uint8_t* out) {
+    putU32(out, ref.slot);
+    putU32(out + 4, ref.sampleOffset);
+    putU32(out + 8, ref.sampleCount);
+}
+
+bool decodeShmAudioRef(const uint8_t* in, size_t size, ShmAudioRef& ref) {
+    if (size != kShmAudioRefSize) {
+        return false;
+    }
+
+    ref.slot = getU32(in);
+    ref.sampleOffset = getU32(in + 4);
+    ref.sampleCount = getU32(in + 8);
+    return true;
+}
+
+const char* messageTypeName(MessageType type) {
+    switch (type) {
+        case MessageType::AudioChunk:     return "AUDIO_CHUNK";
+        case MessageType::EndOfUtterance: return "END_OF_UTTERANCE";
+        case MessageType::PartialResult:  return "PARTIAL_RESULT";
+        case MessageType::FinalResult:    return "FINAL_RESULT";
+        case MessageType::Cancel:         return "CANCEL";
+        case MessageType::Command:        return "COMMAND";
+        case MessageType::CommandResult:  return "COMMAND_RESULT";
+        case MessageType::Error:          return "ERROR";
+        case MessageType::Ready:          return "READY";
+        case MessageType::AudioShm:       return "AUDIO_SHM";
+        case MessageType::Transcript:     return "TRANSCRIPT";
+        case MessageType::Intent:         return "INTENT";
+        case MessageType::Speculate:      return "SPECULATE";
+        case MessageType::Session:        return "SESSION";
+    }
+    return "UNKNOWN";
+}
+
+const char* audioCodecName(AudioCodec codec) {
+    switch (codec) {
+        case AudioCodec::Pcm:  return "pcm";
+        case AudioCodec::Flac: return "flac";
+        case AudioCodec::Opus: return "opus";
+    }
+    return "unknown";
+}
+
+uint32_t parseCodecList(const std::string& list) {
+    uint32_t mask = 1u << static_cast<uint32_t>(AudioCodec::Pcm);
+
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        const std::string name = list.substr(start, end - start);
+        for (AudioCodec codec : {AudioCodec::Flac, AudioCodec::Opus}) {
+            if (name == audioCodecName(codec)) {
+                mask |= 1u << static_cast<uint32_t>(codec);
+            }
+        }
+        start = end + 1;
+    }
+    return mask;
+}
+
+} // namespace protocol
+} // namespace sion
@@ -0,0 +1,63 @@
+/**
+ * @file cancellation_token.cpp
+ * @brief CancellationToken 클래스 구현
+ */
+
+#include "cancellation_token.h"
+
+#include <algorithm>
+
+namespace sion {
+
+CancellationToken::CancellationToken()
+    : m_cancelled(false)
+    , m_nextId(1)
+{
+}
+
+void CancellationToken::cancel() {
+    std::vector<std::pair<size_t, Callback>> callbacks;
+    std::lock_guard<std::mutex> invokeLock(m_invokeMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_cancelled.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        callbacks.swap(m_callbacks);
+    }
+
+    for (auto& entry : callbacks) {
+        entry.second();
+    }
+}
+
+size_t CancellationToken::registerCallback(Callback callback) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_cancelled.load(std::memory_order_acquire)) {
+            const size_t id = m_nextId++;
+            m_callbacks.emplace_back(id, std::move(callback));
+            return id;
+        }
+    }
+
+    callback();
+    return 0;
+}
+
+void CancellationToken::unregisterCallback(size_t id) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_callbacks.begin(), m_callbacks.end(),
+                               [id](const auto& entry) { return entry.first == id; });
+        if (it != m_callbacks.end()) {
+            m_callbacks.erase(it);
+            return;
+        }
+    }
+
+    // 목록에 없으면 cancel()이 이미 꺼내 실행 중일 수 있으므로 끝날 때까지 대기
+    std::lock_guard<std::mutex> invokeLock(m_invokeMutex);
+}
+
+} // namespace sion
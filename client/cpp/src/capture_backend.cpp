@@ -0,0 +1,319 @@
+/**
+ * @file capture_backend.cpp
+ * @brief 캡처 백엔드 팩토리, 프레임 재분할 및 더미 백엔드 구현
+ */
+
+#include "capture_backend.h"
+#include "audio_resampler.h"
+#include "utterance_journal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sion {
+
+namespace {
+
+constexpr const char* kReplayPrefix = "file:";
+constexpr char kRecordSeparator = '#';   // "<저널 세그먼트>#<레코드 번호>"
+
+uint32_t readLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+         | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint16_t readLe16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+/**
+ * @brief 무음(또는 WAV 파일) 프레임을 실시간 속도로 생성하는 더미 백엔드
+ *
+ * 실제 장치가 없는 플랫폼에서도 프레임 콜백 모델이 동일하게 동작하도록
+ * frameDurationMs 간격(절대 시각 기준)으로 프레임을 전달합니다.
+ * 재생 파일이 있으면 start()마다 파일을 처음부터 재생한 뒤 무음을 이어 보냅니다
+ * (벤치마크/재현 테스트에서 녹음 경로 전체를 실제 오디오로 구동).
+ */
+class NullCaptureBackend : public CaptureBackend {
+public:
+    explicit NullCaptureBackend(std::string replayPath = {})
+        : m_replayPath(std::move(replayPath))
+    {
+    }
+
+    ~NullCaptureBackend() override {
+        stop();
+    }
+
+    bool open(const AudioConfig& config) override {
+        m_config = config;
+        if (!m_replayPath.empty() && !loadReplayAudio(m_replayPath, config.sampleRate, m_replay)) {
+            return false;
+        }
+        m_open = true;
+        return true;
+    }
+
+    bool start(AudioCallback onFrame) override {
+        if (!m_open || m_thread.joinable()) {
+            return false;
+        }
+
+        m_onFrame = std::move(onFrame);
+        m_replayPos = 0;
+        m_stopRequested = false;
+        m_thread = std::thread(&NullCaptureBackend::captureLoop, this);
+        return true;
+    }
+
+    void stop() override {
+        if (!m_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+        m_onFrame = nullptr;
+    }
+
+    void close() override {
+        m_open = false;
+    }
+
+    bool isOpen() const override {
+        return m_open;
+    }
+
+    const char* name() const override {
+        return m_replayPath.empty() ? "Null (silence)" : "Replay (file)";
+    }
+
+private:
+    void captureLoop() {
+        const size_t frameSamples = static_cast<size_t>(m_config.sampleRate) * m_config.channels
+                                    * m_config.frameDurationMs / 1000;
+        std::vector<int16_t> frame(frameSamples, 0);
+
+        const auto period = std::chrono::milliseconds(m_config.frameDurationMs);
+        auto deadline = std::chrono::steady_clock::now() + period;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_cv.wait_until(lock, deadline, [this] { return m_stopRequested; })) {
+            lock.unlock();
+            if (!m_replay.empty()) {
+                // 파일이 끝난 뒤의 칸은 무음
+                const size_t n = std::min(frameSamples, m_replay.size() - m_replayPos);
+                std::memcpy(frame.data(), m_replay.data() + m_replayPos, n * sizeof(int16_t));
+                std::fill(frame.begin() + static_cast<std::ptrdiff_t>(n), frame.end(), int16_t(0));
+                m_replayPos += n;
+            }
+            if (m_onFrame) {
+                m_onFrame(Span<const int16_t>(frame));
+            }
+            lock.lock();
+            deadline += period;
+        }
+    }
+
+    AudioConfig m_config;
+    bool m_open = false;
+
+    std::string m_replayPath;
+    std::vector<int16_t> m_replay;   // 재생할 샘플 (비어 있으면 무음)
+    size_t m_replayPos = 0;          // 캡처 스레드 전용
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopRequested = false;
+    AudioCallback m_onFrame;
+};
+
+/**
+ * @brief s16 인터리브 샘플을 outputRate 모노로 변환 (이미 같으면 그대로 이동)
+ */
+bool convertToMono(std::vector<int16_t> samples, int channels, int sampleRate, int outputRate,
+                   std::vector<int16_t>& out) {
+    if (channels == 1 && sampleRate == outputRate) {
+        out = std::move(samples);
+        return true;
+    }
+
+    InputFormat input;
+    input.sampleRate = sampleRate;
+    input.channels = channels;
+    input.format = SampleFormat::Int16;
+    AudioResampler resampler;
+    if (!resampler.configure(input, outputRate)) {
+        std::cerr << "[Replay] 형식 변환 미지원: " << sampleRate << " Hz × " << channels << "ch" << std::endl;
+        return false;
+    }
+    out.clear();
+    resampler.process(samples.data(), samples.size() / static_cast<size_t>(channels), out);
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// WAV 파일 / 발화 저널 읽기
+// ============================================================================
+
+bool loadWavFile(const std::string& path, int outputRate, std::vector<int16_t>& out) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0
+        || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        std::cerr << "[Replay] WAV 파일이 아닙니다: " << path << std::endl;
+        return false;
+    }
+
+    // 청크 순회: fmt와 data만 사용하고 나머지(LIST 등)는 건너뜀
+    int channels = 0;
+    int sampleRate = 0;
+    const uint8_t* data = nullptr;
+    size_t dataSize = 0;
+    size_t offset = 12;
+    while (offset + 8 <= bytes.size()) {
+        const uint8_t* chunk = bytes.data() + offset;
+        const size_t size = std::min<size_t>(readLe32(chunk + 4), bytes.size() - offset - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            if (readLe16(chunk + 8) != 1 || readLe16(chunk + 22) != 16) {
+                std::cerr << "[Replay] 16비트 PCM WAV만 지원합니다: " << path << std::endl;
+                return false;
+            }
+            channels = readLe16(chunk + 10);
+            sampleRate = static_cast<int>(readLe32(chunk + 12));
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            data = chunk + 8;
+            dataSize = size;
+        }
+        offset += 8 + size + (size & 1);
+    }
+    if (channels <= 0 || sampleRate <= 0 || !data) {
+        std::cerr << "[Replay] fmt/data 청크가 없습니다: " << path << std::endl;
+        return false;
+    }
+
+    const size_t frames = dataSize / (sizeof(int16_t) * static_cast<size_t>(channels));
+    std::vector<int16_t> samples(frames * static_cast<size_t>(channels));
+    std::memcpy(samples.data(), data, samples.size() * sizeof(int16_t));
+
+    return convertToMono(std::move(samples), channels, sampleRate, outputRate, out);
+}
+
+bool loadReplayAudio(const std::string& source, int outputRate, std::vector<int16_t>& out) {
+    const size_t separator = source.rfind(kRecordSeparator);
+    if (separator == std::string::npos
+        || source.compare(separator - std::min(separator, std::strlen(UtteranceJournal::kExtension)),
+                          std::strlen(UtteranceJournal::kExtension), UtteranceJournal::kExtension) != 0) {
+        return loadWavFile(source, outputRate, out);
+    }
+
+    const std::string path = source.substr(0, separator);
+    const size_t index = static_cast<size_t>(std::strtoull(source.c_str() + separator + 1, nullptr, 10));
+    JournalRecord record;
+    if (!UtteranceJournal::readRecord(path, index, record) || record.sampleRate <= 0) {
+        std::cerr << "[Replay] 저널 레코드를 읽을 수 없습니다: " << source << std::endl;
+        return false;
+    }
+    return convertToMono(std::move(record.samples), 1, record.sampleRate, outputRate, out);
+}
+
+// ============================================================================
+// FrameAssembler
+// ============================================================================
+
+void FrameAssembler::configure(size_t frameSamples) {
+    m_frameSamples = frameSamples;
+    m_frame.assign(frameSamples, 0);
+    m_frameFill = 0;
+}
+
+void FrameAssembler::append(const int16_t* samples, size_t count, const AudioCallback& onFrame) {
+    while (count > 0) {
+        // 프레임 경계가 맞으면 원본 패킷을 그대로 뷰로 전달 (복사 없음)
+        if (samples && m_frameFill == 0 && count >= m_frameSamples) {
+            if (onFrame) {
+                onFrame(Span<const int16_t>(samples, m_frameSamples));
+            }
+            samples += m_frameSamples;
+            count -= m_frameSamples;
+            continue;
+        }
+
+        const size_t n = std::min(count, m_frameSamples - m_frameFill);
+        if (samples) {
+            std::memcpy(m_frame.data() + m_frameFill, samples, n * sizeof(int16_t));
+            samples += n;
+        } else {
+            std::memset(m_frame.data() + m_frameFill, 0, n * sizeof(int16_t));
+        }
+        m_frameFill += n;
+        count -= n;
+
+        if (m_frameFill == m_frameSamples) {
+            if (onFrame) {
+                onFrame(Span<const int16_t>(m_frame));
+            }
+            m_frameFill = 0;
+        }
+    }
+}
+
+// ============================================================================
+// 팩토리
+// ============================================================================
+
+std::unique_ptr<CaptureBackend> createNullBackend() {
+    return std::make_unique<NullCaptureBackend>();
+}
+
+std::unique_ptr<CaptureBackend> createReplayBackend(const std::string& path) {
+    return std::make_unique<NullCaptureBackend>(path);
+}
+
+std::vector<CaptureDeviceInfo> enumerateCaptureDevices() {
+#if defined(_WIN32)
+    return enumerateWasapiDevices();
+#elif defined(SION_HAVE_ALSA)
+    return enumerateAlsaDevices();
+#elif defined(__APPLE__)
+    return enumerateCoreAudioDevices();
+#else
+    return {};
+#endif
+}
+
+std::unique_ptr<CaptureBackend> createCaptureBackend(const AudioConfig& config) {
+    if (config.device == "null") {
+        return createNullBackend();
+    }
+    if (config.device.compare(0, std::strlen(kReplayPrefix), kReplayPrefix) == 0) {
+        return createReplayBackend(config.device.substr(std::strlen(kReplayPrefix)));
+    }
+
+#if defined(_WIN32)
+    return createWasapiBackend();
+#elif defined(SION_HAVE_ALSA)
+    return createAlsaBackend();
+#elif defined(__APPLE__)
+    return createCoreAudioBackend();
+#else
+    return createNullBackend();
+#endif
+}
+
+} // namespace sion
@@ -0,0 +1,262 @@
+/**
+ * @file coreaudio_capture.cpp
+ * @brief CoreAudio AudioQueue 캡처 백엔드 구현 (macOS 전용)
+ */
+
+#include "capture_backend.h"
+
+#include <AudioToolbox/AudioToolbox.h>
+#include <CoreAudio/CoreAudio.h>
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace sion {
+
+namespace {
+
+// 장치 주기가 늦어져도 끊기지 않도록 순환시키는 큐 버퍼 수
+constexpr int kQueueBufferCount = 4;
+
+// kAudioObjectPropertyElementMain (macOS 12 이전 SDK에서는 ElementMaster, 값은 같음)
+constexpr AudioObjectPropertyElement kElementMain = 0;
+
+/**
+ * @brief CFString → UTF-8
+ */
+std::string toUtf8(CFStringRef text) {
+    if (!text) {
+        return std::string();
+    }
+    const CFIndex capacity = CFStringGetMaximumSizeForEncoding(CFStringGetLength(text), kCFStringEncodingUTF8) + 1;
+    std::string out(static_cast<size_t>(capacity), '\0');
+    if (!CFStringGetCString(text, &out[0], capacity, kCFStringEncodingUTF8)) {
+        return std::string();
+    }
+    out.resize(std::strlen(out.c_str()));
+    return out;
+}
+
+/**
+ * @brief 장치의 문자열 속성 (UID, 이름)
+ */
+std::string deviceString(AudioObjectID device, AudioObjectPropertySelector selector) {
+    const AudioObjectPropertyAddress address = {selector, kAudioObjectPropertyScopeGlobal, kElementMain};
+    CFStringRef value = nullptr;
+    UInt32 size = sizeof(value);
+    if (AudioObjectGetPropertyData(device, &address, 0, nullptr, &size, &value) != noErr || !value) {
+        return std::string();
+    }
+    std::string out = toUtf8(value);
+    CFRelease(value);
+    return out;
+}
+
+/**
+ * @brief CoreAudio AudioQueue 입력 캡처
+ *
+ * AudioQueue를 설정된 레이트/채널의 int16 PCM으로 열면 장치 형식(보통 48 kHz float)
+ * 변환은 AudioQueue가 수행합니다. 큐 버퍼는 frameDurationMs 크기로 할당하고,
+ * run loop 없이(nullptr) 생성하므로 입력 콜백은 AudioQueue 내부 스레드에서 호출됩니다.
+ * 콜백이 큐 버퍼를 바로 다시 넣어 스트림이 끊기지 않게 합니다.
+ *
+ * 처음 열 때 macOS가 마이크 접근 권한을 요청하며, 거부되면 무음 버퍼가 전달됩니다.
+ */
+class CoreAudioCaptureBackend : public CaptureBackend {
+public:
+    CoreAudioCaptureBackend() = default;
+
+    ~CoreAudioCaptureBackend() override {
+        stop();
+        close();
+    }
+
+    bool open(const AudioConfig& config) override {
+        if (m_queue) {
+            return true;
+        }
+
+        m_config = config;
+
+        AudioStreamBasicDescription format{};
+        format.mSampleRate = config.sampleRate;
+        format.mFormatID = kAudioFormatLinearPCM;
+        format.mFormatFlags = kLinearPCMFormatFlagIsSignedInteger | kLinearPCMFormatFlagIsPacked;
+        format.mBitsPerChannel = 16;
+        format.mChannelsPerFrame = static_cast<UInt32>(config.channels);
+        format.mBytesPerFrame = format.mChannelsPerFrame * sizeof(int16_t);
+        format.mFramesPerPacket = 1;
+        format.mBytesPerPacket = format.mBytesPerFrame;
+
+        OSStatus status = AudioQueueNewInput(&format, &CoreAudioCaptureBackend::inputCallback, this,
+                                             nullptr, kCFRunLoopCommonModes, 0, &m_queue);
+        if (status != noErr) {
+            std::cerr << "[CoreAudio] AudioQueueNewInput 실패: " << status << std::endl;
+            m_queue = nullptr;
+            return false;
+        }
+
+        // 장치 UID (enumerateCaptureDevices()가 돌려준 값, 비우면 시스템 기본 입력)
+        if (!config.device.empty()) {
+            CFStringRef uid = CFStringCreateWithCString(kCFAllocatorDefault, config.device.c_str(),
+                                                        kCFStringEncodingUTF8);
+            status = uid ? AudioQueueSetProperty(m_queue, kAudioQueueProperty_CurrentDevice, &uid, sizeof(uid))
+                         : static_cast<OSStatus>(kAudio_ParamError);
+            if (uid) {
+                CFRelease(uid);
+            }
+            if (status != noErr) {
+                std::cerr << "[CoreAudio] 캡처 장치를 선택할 수 없습니다 (" << config.device << "): "
+                          << status << std::endl;
+                close();
+                return false;
+            }
+        }
+
+        const UInt32 frameBytes = static_cast<UInt32>(config.sampleRate) * format.mBytesPerFrame
+                                  * config.frameDurationMs / 1000;
+        for (AudioQueueBufferRef& buffer : m_buffers) {
+            status = AudioQueueAllocateBuffer(m_queue, frameBytes, &buffer);
+            if (status != noErr) {
+                std::cerr << "[CoreAudio] AudioQueueAllocateBuffer 실패: " << status << std::endl;
+                close();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool start(AudioCallback onFrame) override {
+        if (!m_queue || m_running) {
+            return false;
+        }
+
+        m_onFrame = std::move(onFrame);
+        m_assembler.configure(static_cast<size_t>(m_config.sampleRate) * m_config.channels
+                              * m_config.frameDurationMs / 1000);
+        m_running = true;
+
+        for (AudioQueueBufferRef buffer : m_buffers) {
+            AudioQueueEnqueueBuffer(m_queue, buffer, 0, nullptr);
+        }
+
+        const OSStatus status = AudioQueueStart(m_queue, nullptr);
+        if (status != noErr) {
+            std::cerr << "[CoreAudio] AudioQueueStart 실패: " << status << std::endl;
+            m_running = false;
+            AudioQueueReset(m_queue);
+            return false;
+        }
+        return true;
+    }
+
+    void stop() override {
+        if (!m_running) {
+            return;
+        }
+
+        // 즉시 중지는 동기식: 반환 후에는 입력 콜백이 더 호출되지 않음
+        m_running = false;
+        AudioQueueStop(m_queue, true);
+        m_onFrame = nullptr;
+    }
+
+    void close() override {
+        if (m_queue) {
+            // 큐를 해제하면 할당한 버퍼도 함께 해제됨
+            AudioQueueDispose(m_queue, true);
+            m_queue = nullptr;
+        }
+        for (AudioQueueBufferRef& buffer : m_buffers) {
+            buffer = nullptr;
+        }
+    }
+
+    bool isOpen() const override {
+        return m_queue != nullptr;
+    }
+
+    const char* name() const override {
+        return "CoreAudio (AudioQueue)";
+    }
+
+private:
+    static void inputCallback(void* userData, AudioQueueRef queue, AudioQueueBufferRef buffer,
+                              const AudioTimeStamp* /*startTime*/, UInt32 packetCount,
+                              const AudioStreamPacketDescription* /*packetDescs*/) {
+        auto* self = static_cast<CoreAudioCaptureBackend*>(userData);
+
+        if (packetCount > 0) {
+            self->m_assembler.append(static_cast<const int16_t*>(buffer->mAudioData),
+                                     buffer->mAudioDataByteSize / sizeof(int16_t), self->m_onFrame);
+        }
+
+        if (self->m_running) {
+            AudioQueueEnqueueBuffer(queue, buffer, 0, nullptr);
+        }
+    }
+
+    AudioConfig m_config;
+    AudioQueueRef m_queue = nullptr;
+    AudioQueueBufferRef m_buffers[kQueueBufferCount] = {};
+    std::atomic<bool> m_running{false};
+
+    AudioCallback m_onFrame;
+    FrameAssembler m_assembler;
+};
+
+} // namespace
+
+std::unique_ptr<CaptureBackend> createCoreAudioBackend() {
+    return std::make_unique<CoreAudioCaptureBackend>();
+}
+
+std::vector<CaptureDeviceInfo> enumerateCoreAudioDevices() {
+    std::vector<CaptureDeviceInfo> devices;
+
+    AudioObjectPropertyAddress address = {kAudioHardwarePropertyDevices, kAudioObjectPropertyScopeGlobal, kElementMain};
+    UInt32 size = 0;
+    OSStatus status = AudioObjectGetPropertyDataSize(kAudioObjectSystemObject, &address, 0, nullptr, &size);
+    std::vector<AudioObjectID> ids(size / sizeof(AudioObjectID));
+    if (status == noErr && !ids.empty()) {
+        status = AudioObjectGetPropertyData(kAudioObjectSystemObject, &address, 0, nullptr, &size, ids.data());
+    }
+    if (status != noErr) {
+        std::cerr << "[CoreAudio] 장치 목록 조회 실패: " << status << std::endl;
+        return devices;
+    }
+    ids.resize(size / sizeof(AudioObjectID));
+
+    AudioObjectID defaultInput = kAudioObjectUnknown;
+    address.mSelector = kAudioHardwarePropertyDefaultInputDevice;
+    size = sizeof(defaultInput);
+    AudioObjectGetPropertyData(kAudioObjectSystemObject, &address, 0, nullptr, &size, &defaultInput);
+
+    for (const AudioObjectID id : ids) {
+        // 입력 스트림이 없는 장치(스피커 등)는 제외
+        const AudioObjectPropertyAddress streams = {kAudioDevicePropertyStreams, kAudioObjectPropertyScopeInput, kElementMain};
+        UInt32 streamBytes = 0;
+        if (AudioObjectGetPropertyDataSize(id, &streams, 0, nullptr, &streamBytes) != noErr || streamBytes == 0) {
+            continue;
+        }
+
+        CaptureDeviceInfo info;
+        info.id = deviceString(id, kAudioDevicePropertyDeviceUID);
+        if (info.id.empty()) {
+            continue;
+        }
+        info.name = deviceString(id, kAudioObjectPropertyName);
+        if (info.name.empty()) {
+            info.name = info.id;
+        }
+        info.isDefault = id == defaultInput;
+        devices.push_back(std::move(info));
+    }
+    return devices;
+}
+
+} // namespace sion
@@ -4,82 +4,453 @@
  */
 
 #include "hotkey_handler.h"
+#include "cancellation_token.h"
 #include <algorithm>
+#include <chrono>
 #include <cctype>
 #include <iostream>
 #include <sstream>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#ifdef SION_HAVE_X11
+#include <X11/XKBlib.h>
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+#endif
+#elif defined(__APPLE__)
+#include <Carbon/Carbon.h>
+#endif
 
 namespace sion {
 
-HotkeyHandler::HotkeyHandler()
-    : m_running(false)
-    , m_nextId(1)
+namespace {
+
 #ifdef _WIN32
+// WH_KEYBOARD_LL 콜백에는 사용자 데이터가 없으므로 훅을 설치한 인스턴스를 보관
+HotkeyHandler* g_hookOwner = nullptr;
+
+// 핫키 표가 바뀌었음을 리스너 스레드에 알리는 스레드 메시지
+constexpr UINT kTableChangedMessage = WM_APP + 1;
+
+constexpr int kModAlt = MOD_ALT;
+constexpr int kModControl = MOD_CONTROL;
+constexpr int kModShift = MOD_SHIFT;
+constexpr int kModSuper = MOD_WIN;
+#else
+// 다른 플랫폼도 Windows MOD_* 값과 같은 비트를 사용
+constexpr int kModAlt = 0x0001;
+constexpr int kModControl = 0x0002;
+constexpr int kModShift = 0x0004;
+constexpr int kModSuper = 0x0008;
+#endif
+
+/**
+ * @brief 이름 있는 특수 키
+ */
+struct NamedKey {
+    const char* name;
+    int code;
+};
+
+/**
+ * @brief 플랫폼 키 코드 표 (핫키 문자열의 메인 키 → 키 코드)
+ */
+struct KeyTable {
+    int letters[26];          // a-z
+    int digits[10];           // 0-9
+    int functionKeys[12];     // F1-F12
+    NamedKey named[21];
+};
+
+#if defined(_WIN32)
+// 가상 키 코드 (VK_*)
+constexpr KeyTable kWindowsKeys = {
+    {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+     'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z'},
+    {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'},
+    {VK_F1, VK_F2, VK_F3, VK_F4, VK_F5, VK_F6, VK_F7, VK_F8, VK_F9, VK_F10, VK_F11, VK_F12},
+    {{"space", VK_SPACE}, {"enter", VK_RETURN}, {"return", VK_RETURN},
+     {"escape", VK_ESCAPE}, {"esc", VK_ESCAPE}, {"tab", VK_TAB}, {"backspace", VK_BACK},
+     {"delete", VK_DELETE}, {"del", VK_DELETE}, {"insert", VK_INSERT}, {"ins", VK_INSERT},
+     {"home", VK_HOME}, {"end", VK_END}, {"pageup", VK_PRIOR}, {"pgup", VK_PRIOR},
+     {"pagedown", VK_NEXT}, {"pgdn", VK_NEXT}, {"up", VK_UP}, {"down", VK_DOWN},
+     {"left", VK_LEFT}, {"right", VK_RIGHT}},
+};
+#elif defined(__linux__)
+// evdev 키 코드 (KEY_*, 자판 배열과 무관한 물리 키 위치)
+constexpr KeyTable kEvdevKeys = {
+    {KEY_A, KEY_B, KEY_C, KEY_D, KEY_E, KEY_F, KEY_G, KEY_H, KEY_I, KEY_J, KEY_K, KEY_L, KEY_M,
+     KEY_N, KEY_O, KEY_P, KEY_Q, KEY_R, KEY_S, KEY_T, KEY_U, KEY_V, KEY_W, KEY_X, KEY_Y, KEY_Z},
+    {KEY_0, KEY_1, KEY_2, KEY_3, KEY_4, KEY_5, KEY_6, KEY_7, KEY_8, KEY_9},
+    {KEY_F1, KEY_F2, KEY_F3, KEY_F4, KEY_F5, KEY_F6, KEY_F7, KEY_F8, KEY_F9, KEY_F10, KEY_F11, KEY_F12},
+    {{"space", KEY_SPACE}, {"enter", KEY_ENTER}, {"return", KEY_ENTER},
+     {"escape", KEY_ESC}, {"esc", KEY_ESC}, {"tab", KEY_TAB}, {"backspace", KEY_BACKSPACE},
+     {"delete", KEY_DELETE}, {"del", KEY_DELETE}, {"insert", KEY_INSERT}, {"ins", KEY_INSERT},
+     {"home", KEY_HOME}, {"end", KEY_END}, {"pageup", KEY_PAGEUP}, {"pgup", KEY_PAGEUP},
+     {"pagedown", KEY_PAGEDOWN}, {"pgdn", KEY_PAGEDOWN}, {"up", KEY_UP}, {"down", KEY_DOWN},
+     {"left", KEY_LEFT}, {"right", KEY_RIGHT}},
+};
+
+#ifdef SION_HAVE_X11
+// X11 keysym (레벨 0 = 소문자)
+constexpr KeyTable kX11Keys = {
+    {XK_a, XK_b, XK_c, XK_d, XK_e, XK_f, XK_g, XK_h, XK_i, XK_j, XK_k, XK_l, XK_m,
+     XK_n, XK_o, XK_p, XK_q, XK_r, XK_s, XK_t, XK_u, XK_v, XK_w, XK_x, XK_y, XK_z},
+    {XK_0, XK_1, XK_2, XK_3, XK_4, XK_5, XK_6, XK_7, XK_8, XK_9},
+    {XK_F1, XK_F2, XK_F3, XK_F4, XK_F5, XK_F6, XK_F7, XK_F8, XK_F9, XK_F10, XK_F11, XK_F12},
+    {{"space", XK_space}, {"enter", XK_Return}, {"return", XK_Return},
+     {"escape", XK_Escape}, {"esc", XK_Escape}, {"tab", XK_Tab}, {"backspace", XK_BackSpace},
+     {"delete", XK_Delete}, {"del", XK_Delete}, {"insert", XK_Insert}, {"ins", XK_Insert},
+     {"home", XK_Home}, {"end", XK_End}, {"pageup", XK_Prior}, {"pgup", XK_Prior},
+     {"pagedown", XK_Next}, {"pgdn", XK_Next}, {"up", XK_Up}, {"down", XK_Down},
+     {"left", XK_Left}, {"right", XK_Right}},
+};
+
+// 그랩 시 함께 등록하는 잠금 수정자 조합 (CapsLock/NumLock 상태와 무관하게 동작)
+constexpr unsigned int kX11LockMasks[] = {0, LockMask, Mod2Mask, LockMask | Mod2Mask};
+
+unsigned int toX11Modifiers(int modifiers) {
+    unsigned int state = 0;
+    if (modifiers & kModControl) state |= ControlMask;
+    if (modifiers & kModAlt) state |= Mod1Mask;
+    if (modifiers & kModShift) state |= ShiftMask;
+    if (modifiers & kModSuper) state |= Mod4Mask;
+    return state;
+}
+
+int fromX11Modifiers(unsigned int state) {
+    int modifiers = 0;
+    if (state & ControlMask) modifiers |= kModControl;
+    if (state & Mod1Mask) modifiers |= kModAlt;
+    if (state & ShiftMask) modifiers |= kModShift;
+    if (state & Mod4Mask) modifiers |= kModSuper;
+    return modifiers;
+}
+
+int x11ErrorHandler(Display* /*display*/, XErrorEvent* error) {
+    if (error->error_code == BadAccess) {
+        std::cerr << "[HotkeyHandler] 다른 프로그램이 이미 그랩한 핫키입니다" << std::endl;
+    } else {
+        std::cerr << "[HotkeyHandler] X11 오류: " << static_cast<int>(error->error_code) << std::endl;
+    }
+    return 0;
+}
+#endif // SION_HAVE_X11
+
+/**
+ * @brief evdev 장치가 키보드인지 확인 (문자 키와 스페이스 보유)
+ */
+bool isKeyboardDevice(int fd) {
+    unsigned long keyBits[KEY_MAX / (8 * sizeof(unsigned long)) + 1] = {};
+    if (::ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0) {
+        return false;
+    }
+    auto hasKey = [&](int key) {
+        return (keyBits[key / (8 * sizeof(unsigned long))] >> (key % (8 * sizeof(unsigned long)))) & 1UL;
+    };
+    return hasKey(KEY_A) && hasKey(KEY_SPACE);
+}
+
+// evdevModifierIndex() 순서의 수정자 플래그
+constexpr int kEvdevModifierFlags[] = {kModControl, kModAlt, kModShift, kModSuper};
+
+/**
+ * @brief evdev 수정자 키의 kEvdevModifierFlags 인덱스 (수정자가 아니면 -1)
+ */
+int evdevModifierIndex(int code) {
+    switch (code) {
+    case KEY_LEFTCTRL: case KEY_RIGHTCTRL: return 0;
+    case KEY_LEFTALT: case KEY_RIGHTALT: return 1;
+    case KEY_LEFTSHIFT: case KEY_RIGHTSHIFT: return 2;
+    case KEY_LEFTMETA: case KEY_RIGHTMETA: return 3;
+    default: return -1;
+    }
+}
+#elif defined(__APPLE__)
+// macOS 가상 키 코드 (kVK_*, 물리 키 위치)
+constexpr KeyTable kMacKeys = {
+    {kVK_ANSI_A, kVK_ANSI_B, kVK_ANSI_C, kVK_ANSI_D, kVK_ANSI_E, kVK_ANSI_F, kVK_ANSI_G,
+     kVK_ANSI_H, kVK_ANSI_I, kVK_ANSI_J, kVK_ANSI_K, kVK_ANSI_L, kVK_ANSI_M, kVK_ANSI_N,
+     kVK_ANSI_O, kVK_ANSI_P, kVK_ANSI_Q, kVK_ANSI_R, kVK_ANSI_S, kVK_ANSI_T, kVK_ANSI_U,
+     kVK_ANSI_V, kVK_ANSI_W, kVK_ANSI_X, kVK_ANSI_Y, kVK_ANSI_Z},
+    {kVK_ANSI_0, kVK_ANSI_1, kVK_ANSI_2, kVK_ANSI_3, kVK_ANSI_4,
+     kVK_ANSI_5, kVK_ANSI_6, kVK_ANSI_7, kVK_ANSI_8, kVK_ANSI_9},
+    {kVK_F1, kVK_F2, kVK_F3, kVK_F4, kVK_F5, kVK_F6, kVK_F7, kVK_F8, kVK_F9, kVK_F10, kVK_F11, kVK_F12},
+    {{"space", kVK_Space}, {"enter", kVK_Return}, {"return", kVK_Return},
+     {"escape", kVK_Escape}, {"esc", kVK_Escape}, {"tab", kVK_Tab}, {"backspace", kVK_Delete},
+     {"delete", kVK_ForwardDelete}, {"del", kVK_ForwardDelete}, {"insert", kVK_Help}, {"ins", kVK_Help},
+     {"home", kVK_Home}, {"end", kVK_End}, {"pageup", kVK_PageUp}, {"pgup", kVK_PageUp},
+     {"pagedown", kVK_PageDown}, {"pgdn", kVK_PageDown}, {"up", kVK_UpArrow}, {"down", kVK_DownArrow},
+     {"left", kVK_LeftArrow}, {"right", kVK_RightArrow}},
+};
+
+int fromMacModifiers(CGEventFlags flags) {
+    int modifiers = 0;
+    if (flags & kCGEventFlagMaskControl) modifiers |= kModControl;
+    if (flags & kCGEventFlagMaskAlternate) modifiers |= kModAlt;
+    if (flags & kCGEventFlagMaskShift) modifiers |= kModShift;
+    if (flags & kCGEventFlagMaskCommand) modifiers |= kModSuper;
+    return modifiers;
+}
+#endif
+
+/**
+ * @brief 메인 키 이름을 키 코드로 변환
+ * @return 키 코드 (모르는 키면 -1, macOS kVK_ANSI_A처럼 0도 유효한 코드)
+ */
+int lookupKeyCode(const KeyTable& table, const std::string& key) {
+    // 알파벳/숫자 키
+    if (key.length() == 1 && std::isalpha(static_cast<unsigned char>(key[0]))) {
+        return table.letters[key[0] - 'a'];
+    }
+    if (key.length() == 1 && std::isdigit(static_cast<unsigned char>(key[0]))) {
+        return table.digits[key[0] - '0'];
+    }
+
+    // Function 키 (F1-F12)
+    if (key.length() >= 2 && key.length() <= 3 && key[0] == 'f' &&
+        std::all_of(key.begin() + 1, key.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+        const int fNum = std::stoi(key.substr(1));
+        return (fNum >= 1 && fNum <= 12) ? table.functionKeys[fNum - 1] : -1;
+    }
+
+    // 특수 키
+    for (const NamedKey& named : table.named) {
+        if (key == named.name) {
+            return named.code;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+HotkeyHandler::HotkeyHandler(HotkeyBackend backend)
+    : m_backend(backend)
+    , m_running(false)
+    , m_table(std::make_shared<const HotkeyTable>())
+    , m_tableVersion(0)
+    , m_nextId(1)
+    , m_listenerTable(m_table)
+    , m_listenerVersion(0)
+#if defined(_WIN32)
     , m_hwnd(nullptr)
+    , m_hook(nullptr)
+    , m_listenerThreadId(0)
+#elif defined(__linux__)
+    , m_useX11(false)
+    , m_wakeFd(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+#elif defined(__APPLE__)
+    , m_eventTap(nullptr)
+    , m_runLoop(nullptr)
+    , m_wakeSource(nullptr)
 #endif
 {
+#if defined(__linux__) && defined(SION_HAVE_X11)
+    // 디스플레이에 접속할 수 있으면 X11 그랩, 아니면 evdev (키 코드 체계가 달라 등록 전에 결정)
+    if (Display* display = XOpenDisplay(nullptr)) {
+        m_useX11 = true;
+        XCloseDisplay(display);
+    }
+#endif
 }
 
 HotkeyHandler::~HotkeyHandler() {
     stopListening();
     unregisterAllHotkeys();
+#if defined(__linux__)
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+    }
+#endif
 }
 
 int HotkeyHandler::registerHotkey(const std::string& hotkeyString, HotkeyCallback callback) {
+    return addHotkey(hotkeyString, std::move(callback), nullptr);
+}
+
+int HotkeyHandler::registerPushToTalk(const std::string& hotkeyString, HotkeyEventCallback callback) {
+    if (m_backend != HotkeyBackend::LowLevelHook) {
+        std::cerr << "[HotkeyHandler] 푸시투토크는 LowLevelHook 백엔드에서만 지원됩니다: "
+                  << hotkeyString << std::endl;
+        return -1;
+    }
+
+    return addHotkey(hotkeyString, nullptr, std::move(callback));
+}
+
+int HotkeyHandler::addHotkey(const std::string& hotkeyString, HotkeyCallback callback,
+                             HotkeyEventCallback eventCallback) {
     int modifiers = 0;
     int keyCode = 0;
-    
+
     if (!parseHotkeyString(hotkeyString, modifiers, keyCode)) {
         std::cerr << "[HotkeyHandler] 핫키 파싱 실패: " << hotkeyString << std::endl;
         return -1;
     }
-    
-#ifdef _WIN32
-    // Windows에서 핫키 등록
-    if (!RegisterHotKey(nullptr, m_nextId, modifiers, keyCode)) {
-        std::cerr << "[HotkeyHandler] RegisterHotKey 실패: " << GetLastError() << std::endl;
+
+    int id = -1;
+    const bool added = updateTable([&](HotkeyTable& table) {
+        for (const HotkeyEntry& entry : table) {
+            if (entry.key.modifiers == modifiers && entry.key.keyCode == keyCode) {
+                std::cerr << "[HotkeyHandler] 이미 등록된 핫키입니다: " << hotkeyString
+                          << " (ID: " << entry.key.id << ")" << std::endl;
+                return false;
+            }
+        }
+        id = m_nextId++;
+        table.push_back({{id, modifiers, keyCode}, std::move(callback), std::move(eventCallback)});
+        return true;
+    });
+    if (!added) {
         return -1;
     }
-#endif
-    
-    int id = m_nextId++;
-    m_callbacks[id] = callback;
-    m_hotkeys[id] = {id, modifiers, keyCode};
-    
-    std::cout << "[HotkeyHandler] 핫키 등록됨: " << hotkeyString 
+
+    std::cout << "[HotkeyHandler] 핫키 등록됨: " << hotkeyString
               << " (ID: " << id << ")" << std::endl;
-    
+
     return id;
 }
 
-bool HotkeyHandler::unregisterHotkey(int hotkeyId) {
-    auto it = m_hotkeys.find(hotkeyId);
-    if (it == m_hotkeys.end()) {
+bool HotkeyHandler::rebindHotkey(int hotkeyId, const std::string& hotkeyString) {
+    int modifiers = 0;
+    int keyCode = 0;
+
+    if (!parseHotkeyString(hotkeyString, modifiers, keyCode)) {
+        std::cerr << "[HotkeyHandler] 핫키 파싱 실패: " << hotkeyString << std::endl;
         return false;
     }
-    
-#ifdef _WIN32
-    UnregisterHotKey(nullptr, hotkeyId);
-#endif
-    
-    m_callbacks.erase(hotkeyId);
-    m_hotkeys.erase(it);
-    
-    return true;
+
+    const bool rebound = updateTable([&](HotkeyTable& table) {
+        HotkeyEntry* target = nullptr;
+        for (HotkeyEntry& entry : table) {
+            if (entry.key.id == hotkeyId) {
+                target = &entry;
+            } else if (entry.key.modifiers == modifiers && entry.key.keyCode == keyCode) {
+                std::cerr << "[HotkeyHandler] 이미 등록된 핫키입니다: " << hotkeyString
+                          << " (ID: " << entry.key.id << ")" << std::endl;
+                return false;
+            }
+        }
+        if (!target) {
+            return false;
+        }
+        target->key.modifiers = modifiers;
+        target->key.keyCode = keyCode;
+        return true;
+    });
+
+    if (rebound) {
+        std::cout << "[HotkeyHandler] 핫키 변경됨: " << hotkeyString
+                  << " (ID: " << hotkeyId << ")" << std::endl;
+    }
+    return rebound;
+}
+
+bool HotkeyHandler::unregisterHotkey(int hotkeyId) {
+    return updateTable([hotkeyId](HotkeyTable& table) {
+        const auto it = std::find_if(table.begin(), table.end(),
+                                     [hotkeyId](const HotkeyEntry& entry) { return entry.key.id == hotkeyId; });
+        if (it == table.end()) {
+            return false;
+        }
+        table.erase(it);
+        return true;
+    });
 }
 
 void HotkeyHandler::unregisterAllHotkeys() {
-    for (auto& [id, hotkey] : m_hotkeys) {
-#ifdef _WIN32
-        UnregisterHotKey(nullptr, id);
-#endif
+    updateTable([](HotkeyTable& table) {
+        if (table.empty()) {
+            return false;
+        }
+        table.clear();
+        return true;
+    });
+}
+
+bool HotkeyHandler::updateTable(const std::function<bool(HotkeyTable&)>& mutate) {
+    {
+        std::lock_guard<std::mutex> lock(m_tableMutex);
+        auto table = std::make_shared<HotkeyTable>(*m_table);
+        if (!mutate(*table)) {
+            return false;
+        }
+        m_table = std::move(table);
+        ++m_tableVersion;
+    }
+    notifyListener();
+    return true;
+}
+
+HotkeyHandler::TablePtr HotkeyHandler::listenerTable() {
+    const uint64_t version = m_tableVersion.load();
+    if (version == m_listenerVersion) {
+        return m_listenerTable;
+    }
+
+    TablePtr previous = std::move(m_listenerTable);
+    {
+        std::lock_guard<std::mutex> lock(m_tableMutex);
+        m_listenerTable = m_table;
+        m_listenerVersion = m_tableVersion.load();
     }
-    m_callbacks.clear();
-    m_hotkeys.clear();
+
+    // 누른 채로 해제/변경된 핫키는 뗌이 매칭되지 않으므로 여기서 끝냄 (푸시투토크가 멈추지 않도록)
+    auto find = [](const HotkeyTable& table, int id) -> const HotkeyEntry* {
+        for (const HotkeyEntry& entry : table) {
+            if (entry.key.id == id) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    };
+    for (size_t i = 0; i < m_pressed.size();) {
+        const HotkeyEntry* before = find(*previous, m_pressed[i]);
+        const HotkeyEntry* after = find(*m_listenerTable, m_pressed[i]);
+        if (before && after && before->key.keyCode == after->key.keyCode
+            && before->key.modifiers == after->key.modifiers) {
+            ++i;
+            continue;
+        }
+        if (before && before->eventCallback) {
+            before->eventCallback({m_pressed[i], KeyEventType::Released, std::chrono::steady_clock::now()});
+        }
+        m_pressed.erase(m_pressed.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    return m_listenerTable;
+}
+
+void HotkeyHandler::notifyListener() {
+#if defined(_WIN32)
+    // 리스너가 아직 없으면 시작할 때 표를 읽으므로 알릴 필요 없음
+    if (const DWORD threadId = m_listenerThreadId.load()) {
+        PostThreadMessage(threadId, kTableChangedMessage, 0, 0);
+    }
+#elif defined(__linux__)
+    // 리스너가 실행 중이 아니면 다음 시작 시 비워짐
+    const uint64_t one = 1;
+    if (m_wakeFd >= 0 && ::write(m_wakeFd, &one, sizeof(one)) < 0) {
+        std::cerr << "[HotkeyHandler] 리스너 깨우기 실패: " << std::strerror(errno) << std::endl;
+    }
+#endif
+    // macOS와 기타 플랫폼은 OS 등록 없이 표를 직접 매칭하므로 알릴 것이 없음
 }
 
-void HotkeyHandler::startListening() {
+void HotkeyHandler::startListening(CancellationToken* stop) {
     m_running = true;
+    // 취소 콜백은 cancel()을 호출한 스레드에서 실행되므로 join 없이 깨우기만 함
+    ScopedCancelCallback onStop(stop, [this] { interruptListener(); });
     messageLoop();
 }
 
@@ -89,145 +460,556 @@ void HotkeyHandler::startListeningAsync() {
 }
 
 void HotkeyHandler::stopListening() {
-    m_running = false;
-    
-#ifdef _WIN32
-    // 메시지 루프 종료를 위한 메시지 전송
-    PostThreadMessage(GetCurrentThreadId(), WM_QUIT, 0, 0);
-#endif
-    
+    interruptListener();
+
     if (m_listenerThread.joinable()) {
         m_listenerThread.join();
     }
 }
 
+void HotkeyHandler::interruptListener() {
+    m_running = false;
+
+#if defined(_WIN32)
+    // 리스너가 아직 스레드 ID를 게시하지 않았으면 루프에 들어가기 전에 실행 플래그를 봄
+    if (const DWORD threadId = m_listenerThreadId.load()) {
+        PostThreadMessage(threadId, WM_QUIT, 0, 0);
+    }
+#elif defined(__linux__)
+    // 리스너의 poll 깨우기
+    const uint64_t one = 1;
+    if (m_wakeFd >= 0 && ::write(m_wakeFd, &one, sizeof(one)) < 0) {
+        std::cerr << "[HotkeyHandler] 리스너 깨우기 실패: " << std::strerror(errno) << std::endl;
+    }
+#else
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+#if defined(__APPLE__)
+        // 신호된 소스는 run loop에 들어가기 전이어도 유지되므로 CFRunLoopStop()처럼 사라지지 않음
+        if (m_wakeSource) {
+            CFRunLoopSourceSignal(static_cast<CFRunLoopSourceRef>(m_wakeSource));
+            CFRunLoopWakeUp(static_cast<CFRunLoopRef>(m_runLoop));
+        }
+#endif
+    }
+    m_wakeCv.notify_all();
+#endif
+}
+
 bool HotkeyHandler::isListening() const {
     return m_running;
 }
 
 bool HotkeyHandler::parseHotkeyString(const std::string& hotkeyString, int& modifiers, int& keyCode) {
     modifiers = 0;
-    keyCode = 0;
-    
+    keyCode = -1;
+
     // 소문자로 변환
     std::string str = hotkeyString;
     std::transform(str.begin(), str.end(), str.begin(), ::tolower);
-    
+
     // '+' 기준으로 분리
     std::stringstream ss(str);
     std::string token;
     std::vector<std::string> parts;
-    
+
     while (std::getline(ss, token, '+')) {
         // 앞뒤 공백 제거
         token.erase(0, token.find_first_not_of(" \t"));
         token.erase(token.find_last_not_of(" \t") + 1);
-        
+
         if (!token.empty()) {
             parts.push_back(token);
         }
     }
-    
+
     if (parts.empty()) {
         return false;
     }
-    
-#ifdef _WIN32
+
     // 수정자 키 파싱
     for (size_t i = 0; i < parts.size() - 1; ++i) {
         const auto& part = parts[i];
-        
+
         if (part == "ctrl" || part == "control") {
-            modifiers |= MOD_CONTROL;
-        } else if (part == "alt") {
-            modifiers |= MOD_ALT;
+            modifiers |= kModControl;
+        } else if (part == "alt" || part == "option") {
+            modifiers |= kModAlt;
         } else if (part == "shift") {
-            modifiers |= MOD_SHIFT;
-        } else if (part == "win" || part == "windows") {
-            modifiers |= MOD_WIN;
+            modifiers |= kModShift;
+        } else if (part == "win" || part == "windows" || part == "super" || part == "cmd") {
+            modifiers |= kModSuper;
         }
     }
-    
-    // 메인 키 파싱
+
+    // 메인 키 파싱 (플랫폼 키 코드)
     const auto& mainKey = parts.back();
-    
-    // 알파벳 키
-    if (mainKey.length() == 1 && std::isalpha(mainKey[0])) {
-        keyCode = std::toupper(mainKey[0]);
-    }
-    // 숫자 키
-    else if (mainKey.length() == 1 && std::isdigit(mainKey[0])) {
-        keyCode = mainKey[0];
-    }
-    // 특수 키
-    else if (mainKey == "space") {
-        keyCode = VK_SPACE;
-    } else if (mainKey == "enter" || mainKey == "return") {
-        keyCode = VK_RETURN;
-    } else if (mainKey == "escape" || mainKey == "esc") {
-        keyCode = VK_ESCAPE;
-    } else if (mainKey == "tab") {
-        keyCode = VK_TAB;
-    } else if (mainKey == "backspace") {
-        keyCode = VK_BACK;
-    } else if (mainKey == "delete" || mainKey == "del") {
-        keyCode = VK_DELETE;
-    } else if (mainKey == "insert" || mainKey == "ins") {
-        keyCode = VK_INSERT;
-    } else if (mainKey == "home") {
-        keyCode = VK_HOME;
-    } else if (mainKey == "end") {
-        keyCode = VK_END;
-    } else if (mainKey == "pageup" || mainKey == "pgup") {
-        keyCode = VK_PRIOR;
-    } else if (mainKey == "pagedown" || mainKey == "pgdn") {
-        keyCode = VK_NEXT;
-    } else if (mainKey == "up") {
-        keyCode = VK_UP;
-    } else if (mainKey == "down") {
-        keyCode = VK_DOWN;
-    } else if (mainKey == "left") {
-        keyCode = VK_LEFT;
-    } else if (mainKey == "right") {
-        keyCode = VK_RIGHT;
-    }
-    // Function 키 (F1-F12)
-    else if (mainKey.length() >= 2 && mainKey[0] == 'f') {
-        int fNum = std::stoi(mainKey.substr(1));
-        if (fNum >= 1 && fNum <= 12) {
-            keyCode = VK_F1 + (fNum - 1);
+
+#if defined(_WIN32)
+    keyCode = lookupKeyCode(kWindowsKeys, mainKey);
+#elif defined(__linux__)
+#ifdef SION_HAVE_X11
+    if (m_useX11) {
+        keyCode = lookupKeyCode(kX11Keys, mainKey);
+    } else
+#endif
+    keyCode = lookupKeyCode(kEvdevKeys, mainKey);
+#elif defined(__APPLE__)
+    keyCode = lookupKeyCode(kMacKeys, mainKey);
+#else
+    keyCode = -1;
+#endif
+
+    return keyCode >= 0;
+}
+
+bool HotkeyHandler::handleKeyEvent(int keyCode, int modifiers, bool down) {
+    const auto timestamp = std::chrono::steady_clock::now();
+    // 스냅샷을 쥐고 있으므로 콜백 안에서 등록/해제해도 순회 중인 표는 그대로 유지
+    const TablePtr table = listenerTable();
+
+    bool swallowed = false;
+    for (const HotkeyEntry& entry : *table) {
+        const HotkeyId& hotkey = entry.key;
+        if (hotkey.keyCode != keyCode) {
+            continue;
+        }
+        const auto pressed = std::find(m_pressed.begin(), m_pressed.end(), hotkey.id);
+
+        if (down) {
+            if (pressed != m_pressed.end()) {
+                swallowed = true;  // 자동 반복
+                continue;
+            }
+            if (modifiers != hotkey.modifiers) {
+                continue;
+            }
+            m_pressed.push_back(hotkey.id);
+            swallowed = true;
+
+            if (entry.callback) {
+                entry.callback();
+            }
+            if (entry.eventCallback) {
+                entry.eventCallback({hotkey.id, KeyEventType::Pressed, timestamp});
+            }
+        } else if (pressed != m_pressed.end()) {
+            // 수정자를 먼저 떼더라도 메인 키를 뗄 때 종료
+            m_pressed.erase(pressed);
+            swallowed = true;
+
+            if (entry.eventCallback) {
+                entry.eventCallback({hotkey.id, KeyEventType::Released, timestamp});
+            }
         }
     }
-#endif
-    
-    return keyCode != 0;
+    return swallowed;
 }
 
+#if defined(_WIN32)
 void HotkeyHandler::messageLoop() {
-#ifdef _WIN32
     MSG msg;
-    
+
+    // 스레드 메시지 큐를 먼저 만들어 두어야 다른 스레드의 변경 알림이 사라지지 않음
+    PeekMessage(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+    m_listenerThreadId = GetCurrentThreadId();
+
+    // 저수준 훅은 설치한 스레드의 메시지 루프에서 호출됨
+    if (m_backend == HotkeyBackend::LowLevelHook && !m_hook) {
+        g_hookOwner = this;
+        m_hook = SetWindowsHookExW(WH_KEYBOARD_LL, &HotkeyHandler::lowLevelKeyboardProc,
+                                   GetModuleHandleW(nullptr), 0);
+        if (!m_hook) {
+            std::cerr << "[HotkeyHandler] 저수준 키보드 훅 설치 실패: " << GetLastError() << std::endl;
+            g_hookOwner = nullptr;
+        }
+    }
+
+    // RegisterHotKey는 호출한 스레드의 큐에 묶이므로 리스너 스레드에서 등록
+    syncRegistrations();
+
     while (m_running && GetMessage(&msg, nullptr, 0, 0)) {
+        if (msg.message == kTableChangedMessage) {
+            syncRegistrations();
+            continue;
+        }
         if (msg.message == WM_HOTKEY) {
-            int hotkeyId = static_cast<int>(msg.wParam);
-            
-            auto it = m_callbacks.find(hotkeyId);
-            if (it != m_callbacks.end() && it->second) {
-                it->second();
+            const int hotkeyId = static_cast<int>(msg.wParam);
+            const TablePtr table = listenerTable();
+            for (const HotkeyEntry& entry : *table) {
+                if (entry.key.id == hotkeyId && entry.callback) {
+                    entry.callback();
+                }
             }
         }
-        
+
         TranslateMessage(&msg);
         DispatchMessage(&msg);
     }
-#else
-    // Linux/macOS 구현은 추후 추가
+
+    releaseRegistrations();
+    if (m_hook) {
+        UnhookWindowsHookEx(m_hook);
+        m_hook = nullptr;
+        g_hookOwner = nullptr;
+    }
+    m_listenerThreadId = 0;
+}
+
+void HotkeyHandler::syncRegistrations() {
+    if (m_backend != HotkeyBackend::RegisterHotKey) {
+        return;  // 저수준 훅은 표를 직접 매칭
+    }
+    const TablePtr table = listenerTable();
+
+    // 없어졌거나 키가 바뀐 등록 해제
+    for (auto it = m_osHotkeys.begin(); it != m_osHotkeys.end();) {
+        const auto entry = std::find_if(table->begin(), table->end(), [&](const HotkeyEntry& e) {
+            return e.key.id == it->first.id && e.key.modifiers == it->first.modifiers
+                && e.key.keyCode == it->first.keyCode;
+        });
+        if (entry != table->end()) {
+            ++it;
+            continue;
+        }
+        if (it->second) {
+            UnregisterHotKey(nullptr, it->first.id);
+        }
+        it = m_osHotkeys.erase(it);
+    }
+
+    // 새 항목 등록 (실패한 항목도 기록해 변경 알림마다 다시 시도하지 않음)
+    for (const HotkeyEntry& entry : *table) {
+        const auto known = std::find_if(m_osHotkeys.begin(), m_osHotkeys.end(),
+                                        [&](const std::pair<HotkeyId, bool>& os) { return os.first.id == entry.key.id; });
+        if (known != m_osHotkeys.end()) {
+            continue;
+        }
+        const bool registered = RegisterHotKey(nullptr, entry.key.id, entry.key.modifiers, entry.key.keyCode) != 0;
+        if (!registered) {
+            std::cerr << "[HotkeyHandler] RegisterHotKey 실패 (ID: " << entry.key.id << "): "
+                      << GetLastError() << std::endl;
+        }
+        m_osHotkeys.emplace_back(entry.key, registered);
+    }
+}
+
+void HotkeyHandler::releaseRegistrations() {
+    for (const auto& [hotkey, registered] : m_osHotkeys) {
+        if (registered) {
+            UnregisterHotKey(nullptr, hotkey.id);
+        }
+    }
+    m_osHotkeys.clear();
+}
+
+LRESULT CALLBACK HotkeyHandler::lowLevelKeyboardProc(int code, WPARAM wParam, LPARAM lParam) {
+    if (code == HC_ACTION && g_hookOwner) {
+        const auto* info = reinterpret_cast<const KBDLLHOOKSTRUCT*>(lParam);
+        const bool down = wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN;
+        const bool up = wParam == WM_KEYUP || wParam == WM_SYSKEYUP;
+        if (down || up) {
+            // 메인 키보다 먼저 눌린 수정자 키는 비동기 상태에 이미 반영되어 있음
+            auto isDown = [](int vk) { return (GetAsyncKeyState(vk) & 0x8000) != 0; };
+            int modifiers = 0;
+            if (isDown(VK_CONTROL)) modifiers |= MOD_CONTROL;
+            if (isDown(VK_MENU)) modifiers |= MOD_ALT;
+            if (isDown(VK_SHIFT)) modifiers |= MOD_SHIFT;
+            if (isDown(VK_LWIN) || isDown(VK_RWIN)) modifiers |= MOD_WIN;
+
+            if (g_hookOwner->handleKeyEvent(static_cast<int>(info->vkCode), modifiers, down)) {
+                return 1;  // 등록된 핫키는 다른 앱으로 전달하지 않음 (RegisterHotKey와 동일)
+            }
+        }
+    }
+    return CallNextHookEx(nullptr, code, wParam, lParam);
+}
+#elif defined(__linux__)
+void HotkeyHandler::messageLoop() {
+    // 이전 stopListening()과 리스너 시작 전 변경 알림 소비 (표는 그랩할 때 읽음)
+    drainWake();
+
+    if (m_useX11 && runX11Loop()) {
+        return;
+    }
+    if (m_useX11) {
+        // 키 코드가 keysym 체계라 evdev로 대체할 수 없음
+        std::cerr << "[HotkeyHandler] X 디스플레이 접속 실패" << std::endl;
+        waitForWake();
+        return;
+    }
+    runEvdevLoop();
+}
+
+bool HotkeyHandler::runX11Loop() {
+#ifdef SION_HAVE_X11
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        return false;
+    }
+
+    XSetErrorHandler(&x11ErrorHandler);
+    const Window root = DefaultRootWindow(display);
+
+    // 자동 반복 시 KeyRelease/KeyPress 쌍 대신 KeyPress만 반복되도록
+    Bool detectable = False;
+    XkbSetDetectableAutoRepeat(display, True, &detectable);
+
+    // 그랩은 이 연결에 묶이므로 표가 바뀌면 리스너 스레드에서 전부 다시 그랩
+    auto grabHotkeys = [&] {
+        XUngrabKey(display, AnyKey, AnyModifier, root);
+        const TablePtr table = listenerTable();
+        for (const HotkeyEntry& entry : *table) {
+            const KeyCode code = XKeysymToKeycode(display, static_cast<KeySym>(entry.key.keyCode));
+            if (code == 0) {
+                std::cerr << "[HotkeyHandler] 키보드에 없는 키입니다 (ID: " << entry.key.id << ")" << std::endl;
+                continue;
+            }
+            for (unsigned int lockMask : kX11LockMasks) {
+                XGrabKey(display, code, toX11Modifiers(entry.key.modifiers) | lockMask, root,
+                         True, GrabModeAsync, GrabModeAsync);
+            }
+        }
+        XSync(display, False);
+    };
+    XSelectInput(display, root, KeyPressMask | KeyReleaseMask);
+    grabHotkeys();
+
+    std::cout << "[HotkeyHandler] X11 키 그랩 모드" << std::endl;
+
+    pollfd fds[2] = {
+        {ConnectionNumber(display), POLLIN, 0},
+        {m_wakeFd, POLLIN, 0},
+    };
+
     while (m_running) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        while (XPending(display) > 0) {
+            XEvent event;
+            XNextEvent(display, &event);
+            if (event.type == KeyPress || event.type == KeyRelease) {
+                const KeySym sym = XkbKeycodeToKeysym(display, static_cast<KeyCode>(event.xkey.keycode), 0, 0);
+                handleKeyEvent(static_cast<int>(sym), fromX11Modifiers(event.xkey.state),
+                               event.type == KeyPress);
+            }
+        }
+
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;  // 시그널 (종료는 깨우기 신호로 옴)
+            }
+            std::cerr << "[HotkeyHandler] poll 실패: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            drainWake();
+            if (!m_running) {
+                break;  // 중지 요청
+            }
+            grabHotkeys();  // 표 변경
+        }
     }
+
+    XUngrabKey(display, AnyKey, AnyModifier, root);
+    XCloseDisplay(display);
+    return true;
+#else
+    return false;
 #endif
 }
 
-} // namespace sion
+void HotkeyHandler::runEvdevLoop() {
+    std::vector<pollfd> fds;
+    fds.push_back({m_wakeFd, POLLIN, 0});
+
+    if (DIR* dir = ::opendir("/dev/input")) {
+        while (const dirent* entry = ::readdir(dir)) {
+            if (std::strncmp(entry->d_name, "event", 5) != 0) {
+                continue;
+            }
+            const std::string path = std::string("/dev/input/") + entry->d_name;
+            const int fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+            if (fd < 0) {
+                continue;
+            }
+            if (isKeyboardDevice(fd)) {
+                fds.push_back({fd, POLLIN, 0});
+            } else {
+                ::close(fd);
+            }
+        }
+        ::closedir(dir);
+    }
+
+    if (fds.size() == 1) {
+        std::cerr << "[HotkeyHandler] 읽을 수 있는 키보드 장치가 없습니다 "
+                     "(X 디스플레이가 없고 /dev/input 권한이 없음)" << std::endl;
+        waitForWake();
+        return;
+    }
+
+    std::cout << "[HotkeyHandler] evdev 모드 (키보드 " << fds.size() - 1 << "개)" << std::endl;
+
+    // 장치별이 아닌 합산 상태 (좌/우 또는 두 키보드에 나눠 눌러도 인식)
+    int heldModifiers[4] = {};
+    auto currentModifiers = [&] {
+        int modifiers = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (heldModifiers[i] > 0) {
+                modifiers |= kEvdevModifierFlags[i];
+            }
+        }
+        return modifiers;
+    };
+
+    input_event events[64];
+    while (m_running) {
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;  // 시그널 (종료는 깨우기 신호로 옴)
+            }
+            std::cerr << "[HotkeyHandler] poll 실패: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            // 표 변경이면 다음 이벤트부터 새 표로 매칭 (evdev는 OS 등록 없음)
+            drainWake();
+            if (!m_running) {
+                break;  // 중지 요청
+            }
+        }
+
+        for (size_t i = 1; i < fds.size(); ++i) {
+            if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                // 장치 분리: 음수 fd는 poll이 무시
+                ::close(fds[i].fd);
+                fds[i].fd = -1;
+                continue;
+            }
+            if (!(fds[i].revents & POLLIN)) {
+                continue;
+            }
+
+            ssize_t bytes = 0;
+            while ((bytes = ::read(fds[i].fd, events, sizeof(events))) > 0) {
+                const size_t count = static_cast<size_t>(bytes) / sizeof(input_event);
+                for (size_t e = 0; e < count; ++e) {
+                    const input_event& event = events[e];
+                    if (event.type != EV_KEY || event.value == 2) {
+                        continue;  // 키 이벤트만, 자동 반복(2)은 무시
+                    }
+
+                    const bool down = event.value == 1;
+                    const int modifier = evdevModifierIndex(event.code);
+                    if (modifier >= 0) {
+                        heldModifiers[modifier] = std::max(0, heldModifiers[modifier] + (down ? 1 : -1));
+                        continue;
+                    }
+                    handleKeyEvent(event.code, currentModifiers(), down);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 1; i < fds.size(); ++i) {
+        if (fds[i].fd >= 0) {
+            ::close(fds[i].fd);
+        }
+    }
+}
+
+void HotkeyHandler::waitForWake() {
+    // 깨우기 신호를 비운 뒤 확인하므로 그 전에 온 중지 요청도 놓치지 않음 (표 변경 알림은 무시)
+    pollfd fd = {m_wakeFd, POLLIN, 0};
+    while (m_running) {
+        if (::poll(&fd, 1, -1) < 0 && errno != EINTR) {
+            std::cerr << "[HotkeyHandler] poll 실패: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        drainWake();
+    }
+}
+
+void HotkeyHandler::drainWake() {
+    uint64_t pending = 0;
+    while (m_wakeFd >= 0 && ::read(m_wakeFd, &pending, sizeof(pending)) > 0) {
+    }
+}
+#elif defined(__APPLE__)
+void HotkeyHandler::messageLoop() {
+    // 리스너 스레드의 run loop에서 키 이벤트를 받아 등록된 핫키와 매칭
+    auto tapCallback = [](CGEventTapProxy /*proxy*/, CGEventType type, CGEventRef event,
+                          void* userInfo) -> CGEventRef {
+        auto* self = static_cast<HotkeyHandler*>(userInfo);
+        if (type == kCGEventTapDisabledByTimeout || type == kCGEventTapDisabledByUserInput) {
+            // 콜백이 늦으면 시스템이 탭을 끄므로 다시 켬
+            CGEventTapEnable(static_cast<CFMachPortRef>(self->m_eventTap), true);
+            return event;
+        }
+
+        const int keyCode = static_cast<int>(CGEventGetIntegerValueField(event, kCGKeyboardEventKeycode));
+        const int modifiers = fromMacModifiers(CGEventGetFlags(event));
+        if (self->handleKeyEvent(keyCode, modifiers, type == kCGEventKeyDown)) {
+            return nullptr;  // 등록된 핫키는 다른 앱으로 전달하지 않음
+        }
+        return event;
+    };
 
+    const CGEventMask mask = CGEventMaskBit(kCGEventKeyDown) | CGEventMaskBit(kCGEventKeyUp);
+    CFMachPortRef tap = CGEventTapCreate(kCGSessionEventTap, kCGHeadInsertEventTap, kCGEventTapOptionDefault,
+                                         mask, tapCallback, this);
+    if (!tap) {
+        std::cerr << "[HotkeyHandler] CGEventTap 생성 실패 (손쉬운 사용 권한을 허용하세요)" << std::endl;
+        waitForWake();
+        return;
+    }
+
+    m_eventTap = tap;
+    CFRunLoopSourceRef source = CFMachPortCreateRunLoopSource(kCFAllocatorDefault, tap, 0);
+    CFRunLoopRef runLoop = CFRunLoopGetCurrent();
+    CFRunLoopAddSource(runLoop, source, kCFRunLoopCommonModes);
+    CGEventTapEnable(tap, true);
+
+    // 중지 요청용 소스: 신호되면 run loop를 멈춤 (타임아웃 폴링 없음)
+    CFRunLoopSourceContext wakeContext = {};
+    wakeContext.perform = [](void*) { CFRunLoopStop(CFRunLoopGetCurrent()); };
+    CFRunLoopSourceRef wakeSource = CFRunLoopSourceCreate(kCFAllocatorDefault, 0, &wakeContext);
+    CFRunLoopAddSource(runLoop, wakeSource, kCFRunLoopCommonModes);
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_runLoop = runLoop;
+        m_wakeSource = wakeSource;
+    }
+
+    // 소스를 게시한 뒤 확인하므로 그 전에 온 중지 요청도 놓치지 않음
+    while (m_running) {
+        CFRunLoopRunInMode(kCFRunLoopDefaultMode, 1.0e10, false);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_runLoop = nullptr;
+        m_wakeSource = nullptr;
+    }
+    CFRunLoopRemoveSource(runLoop, wakeSource, kCFRunLoopCommonModes);
+    CFRelease(wakeSource);
+    CGEventTapEnable(tap, false);
+    CFRunLoopRemoveSource(runLoop, source, kCFRunLoopCommonModes);
+    CFRelease(source);
+    CFRelease(tap);
+    m_eventTap = nullptr;
+}
+#else
+void HotkeyHandler::messageLoop() {
+    // 지원하지 않는 플랫폼: 중지될 때까지 대기
+    waitForWake();
+}
+#endif
 
+#if !defined(_WIN32) && !defined(__linux__)
+void HotkeyHandler::waitForWake() {
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_wakeCv.wait(lock, [this] { return !m_running; });
+}
+#endif
+
+} // namespace sion
@@ -0,0 +1,229 @@
+/**
+ * @file json_util.cpp
+ * @brief 최소 JSON 헬퍼 구현 (ASR 메시지, 워커 결과 파싱)
+ */
+
+#include "json_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace sion {
+namespace json {
+
+namespace {
+
+constexpr const char* kWhitespace = " \t\r\n";
+
+void appendUtf8(std::string& out, uint32_t codepoint) {
+    if (codepoint < 0x80) {
+        out.push_back(static_cast<char>(codepoint));
+    } else if (codepoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else if (codepoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    }
+}
+
+/**
+ * @brief 문자열 리터럴 끝 다음 위치 (pos는 여는 따옴표, 닫히지 않으면 npos)
+ */
+size_t skipString(const std::string& json, size_t pos) {
+    for (++pos; pos < json.size(); ++pos) {
+        if (json[pos] == '\\') {
+            ++pos;
+        } else if (json[pos] == '"') {
+            return pos + 1;
+        }
+    }
+    return std::string::npos;
+}
+
+/**
+ * @brief 값 하나의 끝 다음 위치 (닫히지 않은 객체/배열/문자열이면 npos)
+ */
+size_t skipValue(const std::string& json, size_t pos) {
+    if (pos >= json.size()) {
+        return std::string::npos;
+    }
+    if (json[pos] == '"') {
+        return skipString(json, pos);
+    }
+    if (json[pos] != '{' && json[pos] != '[') {
+        const size_t end = json.find_first_of(",}] \t\r\n", pos);
+        return end == std::string::npos ? json.size() : end;
+    }
+
+    size_t depth = 0;
+    while (pos < json.size()) {
+        const char c = json[pos];
+        if (c == '"') {
+            pos = skipString(json, pos);
+            if (pos == std::string::npos) {
+                return pos;
+            }
+            continue;
+        }
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if ((c == '}' || c == ']') && --depth == 0) {
+            return pos + 1;
+        }
+        ++pos;
+    }
+    return std::string::npos;
+}
+
+} // namespace
+
+std::string quote(const std::string& text) {
+    std::string out;
+    out.reserve(text.size() + 2);
+    out.push_back('"');
+    for (const char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out.push_back(c);
+                }
+                break;
+        }
+    }
+    out.push_back('"');
+    return out;
+}
+
+size_t findValue(const std::string& json, const char* key) {
+    size_t pos = json.find_first_not_of(kWhitespace);
+    if (pos == std::string::npos || json[pos] != '{') {
+        return std::string::npos;
+    }
+    const size_t keyLength = std::strlen(key);
+
+    ++pos;
+    while (true) {
+        pos = json.find_first_not_of(kWhitespace, pos);
+        if (pos == std::string::npos || json[pos] != '"') {
+            return std::string::npos;   // 빈 객체 또는 잘못된 형식
+        }
+        const size_t keyEnd = skipString(json, pos);
+        if (keyEnd == std::string::npos) {
+            return std::string::npos;
+        }
+        // 키는 이스케이프 없이 비교 (프로토콜 키는 모두 ASCII)
+        const bool match = keyEnd - pos - 2 == keyLength && json.compare(pos + 1, keyLength, key) == 0;
+
+        pos = json.find_first_not_of(kWhitespace, keyEnd);
+        if (pos == std::string::npos || json[pos] != ':') {
+            return std::string::npos;
+        }
+        pos = json.find_first_not_of(kWhitespace, pos + 1);
+        if (pos == std::string::npos) {
+            return pos;
+        }
+        if (match) {
+            return pos;
+        }
+
+        pos = skipValue(json, pos);
+        if (pos == std::string::npos) {
+            return pos;
+        }
+        pos = json.find_first_not_of(kWhitespace, pos);
+        if (pos == std::string::npos || json[pos] != ',') {
+            return std::string::npos;
+        }
+        ++pos;
+    }
+}
+
+bool getString(const std::string& json, const char* key, std::string& out) {
+    size_t pos = findValue(json, key);
+    if (pos == std::string::npos || json[pos] != '"') {
+        return false;
+    }
+
+    out.clear();
+    for (++pos; pos < json.size(); ++pos) {
+        const char c = json[pos];
+        if (c == '"') {
+            return true;
+        }
+        if (c != '\\') {
+            out.push_back(c);
+            continue;
+        }
+        if (++pos >= json.size()) {
+            return false;
+        }
+        switch (json[pos]) {
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'u': {
+                if (pos + 4 >= json.size()) {
+                    return false;
+                }
+                uint32_t codepoint = static_cast<uint32_t>(std::strtoul(json.substr(pos + 1, 4).c_str(), nullptr, 16));
+                pos += 4;
+                // 서로게이트 쌍 (U+10000 이상은 \\u 두 개로 옴)
+                if (codepoint >= 0xD800 && codepoint < 0xDC00 && pos + 6 < json.size()
+                    && json[pos + 1] == '\\' && json[pos + 2] == 'u') {
+                    const uint32_t low = static_cast<uint32_t>(std::strtoul(json.substr(pos + 3, 4).c_str(), nullptr, 16));
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                        pos += 6;
+                    }
+                }
+                appendUtf8(out, codepoint);
+                break;
+            }
+            default:
+                out.push_back(json[pos]);   // \" \\ \/
+                break;
+        }
+    }
+    return false;
+}
+
+bool getUint(const std::string& json, const char* key, uint64_t& out) {
+    const size_t pos = findValue(json, key);
+    if (pos == std::string::npos || json[pos] < '0' || json[pos] > '9') {
+        return false;
+    }
+    out = std::strtoull(json.c_str() + pos, nullptr, 10);
+    return true;
+}
+
+bool getRaw(const std::string& json, const char* key, std::string& out) {
+    const size_t pos = findValue(json, key);
+    const size_t end = pos == std::string::npos ? pos : skipValue(json, pos);
+    if (end == std::string::npos) {
+        return false;
+    }
+    out.assign(json, pos, end - pos);
+    return true;
+}
+
+} // namespace json
+} // namespace sion
@@ -0,0 +1,328 @@
+/**
+ * @file keyword_spotter.cpp
+ * @brief KeywordSpotter 클래스 구현
+ */
+
+#include "keyword_spotter.h"
+#include "audio_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace sion {
+
+namespace {
+
+constexpr uint32_t kModelVersion = 1;
+
+// 손상된 파일이 큰 할당을 일으키지 않도록 제한
+constexpr size_t kMaxDimension = 4096;
+constexpr size_t kMaxTensorSize = size_t{1} << 22;
+constexpr size_t kMaxLayers = 64;
+constexpr size_t kMaxPatch = size_t{1} << 16;   // dotProductInt8의 int32 누적 한계 안쪽
+
+/**
+ * @brief 모델 파일 바이트를 순서대로 읽는 커서 (범위를 벗어나면 이후 읽기 모두 실패)
+ */
+class ModelReader {
+public:
+    explicit ModelReader(const std::vector<uint8_t>& data) : m_data(data), m_offset(0), m_ok(true) {}
+
+    bool read(void* dst, size_t size) {
+        if (!m_ok || size > m_data.size() - m_offset) {
+            m_ok = false;
+            return false;
+        }
+        std::memcpy(dst, m_data.data() + m_offset, size);
+        m_offset += size;
+        return true;
+    }
+
+    uint32_t u32() {
+        uint8_t bytes[4] = {};
+        read(bytes, sizeof(bytes));
+        return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+             | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+
+    float f32() {
+        const uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_offset == m_data.size(); }
+
+private:
+    const std::vector<uint8_t>& m_data;
+    size_t m_offset;
+    bool m_ok;
+};
+
+bool validScale(float scale) {
+    return std::isfinite(scale) && scale > 0.0f;
+}
+
+int8_t saturate(float value, bool relu) {
+    const long rounded = std::lrintf(value);
+    return static_cast<int8_t>(std::min(std::max(rounded, relu ? 0L : -128L), 127L));
+}
+
+} // namespace
+
+KeywordSpotter::KeywordSpotter()
+    : m_numFrames(0)
+    , m_inputMean(0.0f)
+    , m_inputInvScale(1.0f)
+    , m_threshold(0.0f)
+    , m_smoothing(1)
+    , m_keywordIndex(0)
+{
+}
+
+bool KeywordSpotter::load(const std::string& path) {
+    m_layers.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "[KeywordSpotter] 모델 파일을 열 수 없습니다: " << path << std::endl;
+        return false;
+    }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ModelReader reader(data);
+    char magic[4] = {};
+    reader.read(magic, sizeof(magic));
+    if (!reader.ok() || std::memcmp(magic, "SKWS", 4) != 0 || reader.u32() != kModelVersion) {
+        std::cerr << "[KeywordSpotter] 지원하지 않는 모델 형식: " << path << std::endl;
+        return false;
+    }
+
+    LogMelConfig frontend;
+    frontend.sampleRate = static_cast<int>(reader.u32());
+    frontend.frameLength = static_cast<int>(reader.u32());
+    frontend.hopLength = static_cast<int>(reader.u32());
+    frontend.fftSize = static_cast<int>(reader.u32());
+    frontend.lowHz = reader.f32();
+    frontend.highHz = reader.f32();
+    const size_t numFrames = reader.u32();
+    frontend.numMels = static_cast<int>(reader.u32());
+    const float inputMean = reader.f32();
+    const float inputScale = reader.f32();
+    const float threshold = reader.f32();
+    const size_t smoothing = reader.u32();
+    const size_t keywordIndex = reader.u32();
+    const size_t layerCount = reader.u32();
+
+    const size_t numMels = static_cast<size_t>(frontend.numMels);
+    if (!reader.ok() || numFrames == 0 || numFrames > kMaxDimension
+        || numMels == 0 || numMels > kMaxDimension || !validScale(inputScale)
+        || !(threshold > 0.0f && threshold <= 1.0f) || smoothing == 0 || smoothing > kMaxDimension
+        || layerCount == 0 || layerCount > kMaxLayers) {
+        std::cerr << "[KeywordSpotter] 잘못된 모델 헤더: " << path << std::endl;
+        return false;
+    }
+
+    // 레이어 파싱: 입력 형태를 따라가며 출력 형태와 배율 계산
+    std::vector<Layer> layers;
+    size_t h = numFrames, w = numMels, c = 1;
+    float scale = inputScale;
+    size_t maxActivation = h * w * c;
+    size_t maxPatch = 0;
+
+    for (size_t index = 0; index < layerCount; ++index) {
+        Layer layer{};
+        layer.type = static_cast<LayerType>(reader.u32());
+        layer.inH = h;
+        layer.inW = w;
+        layer.inC = c;
+        float outScale = scale;
+
+        if (layer.type == LayerType::Conv2D || layer.type == LayerType::Dense) {
+            layer.outC = reader.u32();
+            if (layer.type == LayerType::Conv2D) {
+                layer.kernelH = reader.u32();
+                layer.kernelW = reader.u32();
+                layer.strideH = reader.u32();
+                layer.strideW = reader.u32();
+            } else {
+                // Dense는 입력 전체를 덮는 커널 하나로 처리
+                layer.kernelH = 1;
+                layer.kernelW = 1;
+                layer.strideH = 1;
+                layer.strideW = 1;
+                layer.inH = layer.inW = 1;
+                layer.inC = h * w * c;
+            }
+            layer.relu = reader.u32() != 0;
+            outScale = reader.f32();
+
+            if (!reader.ok() || layer.outC == 0 || layer.outC > kMaxDimension
+                || layer.kernelH == 0 || layer.kernelH > layer.inH
+                || layer.kernelW == 0 || layer.kernelW > layer.inW
+                || layer.strideH == 0 || layer.strideW == 0 || !validScale(outScale)) {
+                std::cerr << "[KeywordSpotter] 잘못된 레이어 " << index << ": " << path << std::endl;
+                return false;
+            }
+            layer.outH = (layer.inH - layer.kernelH) / layer.strideH + 1;
+            layer.outW = (layer.inW - layer.kernelW) / layer.strideW + 1;
+
+            const size_t patch = layer.kernelH * layer.kernelW * layer.inC;
+            if (patch > kMaxPatch || patch * layer.outC > kMaxTensorSize
+                || layer.outH * layer.outW * layer.outC > kMaxTensorSize) {
+                std::cerr << "[KeywordSpotter] 레이어 " << index << "가 너무 큽니다: " << path << std::endl;
+                return false;
+            }
+            layer.weights.resize(patch * layer.outC);
+            reader.read(layer.weights.data(), layer.weights.size());
+
+            layer.multiplier.resize(layer.outC);
+            layer.dequant.resize(layer.outC);
+            bool scalesValid = true;
+            for (size_t oc = 0; oc < layer.outC; ++oc) {
+                const float weightScale = reader.f32();
+                scalesValid = scalesValid && validScale(weightScale);
+                layer.dequant[oc] = scale * weightScale;
+                layer.multiplier[oc] = scale * weightScale / outScale;
+            }
+            layer.bias.resize(layer.outC);
+            for (size_t oc = 0; oc < layer.outC; ++oc) {
+                layer.bias[oc] = static_cast<int32_t>(reader.u32());
+            }
+            if (!scalesValid) {
+                std::cerr << "[KeywordSpotter] 레이어 " << index << "의 가중치 배율이 잘못되었습니다: " << path << std::endl;
+                return false;
+            }
+            maxPatch = std::max(maxPatch, patch);
+        } else if (layer.type == LayerType::GlobalAvgPool) {
+            layer.outH = layer.outW = 1;
+            layer.outC = c;
+        } else {
+            std::cerr << "[KeywordSpotter] 알 수 없는 레이어 종류 " << static_cast<uint32_t>(layer.type)
+                      << ": " << path << std::endl;
+            return false;
+        }
+
+        if (!reader.ok()) {
+            std::cerr << "[KeywordSpotter] 모델 파일이 잘렸습니다: " << path << std::endl;
+            return false;
+        }
+
+        h = layer.outH;
+        w = layer.outW;
+        c = layer.outC;
+        scale = outScale;
+        maxActivation = std::max(maxActivation, h * w * c);
+        layers.push_back(std::move(layer));
+    }
+
+    if (!reader.atEnd() || layers.back().type != LayerType::Dense || keywordIndex >= c) {
+        std::cerr << "[KeywordSpotter] 모델 출력이 올바르지 않습니다: " << path << std::endl;
+        return false;
+    }
+
+    m_frontend = frontend;
+    m_numFrames = numFrames;
+    m_inputMean = inputMean;
+    m_inputInvScale = 1.0f / inputScale;
+    m_threshold = threshold;
+    m_smoothing = smoothing;
+    m_keywordIndex = keywordIndex;
+    m_layers = std::move(layers);
+    m_activations[0].assign(maxActivation, 0);
+    m_activations[1].assign(maxActivation, 0);
+    m_patch.assign(maxPatch, 0);
+    m_logits.assign(c, 0.0f);
+
+    std::cout << "[KeywordSpotter] 모델 로드: " << path << " (" << m_layers.size() << "개 레이어, 입력 "
+              << numFrames << "x" << numMels << ", " << kernels::activeIsa() << ")" << std::endl;
+    return true;
+}
+
+void KeywordSpotter::quantizeFrame(const float* mels, int8_t* out) const {
+    const size_t numMels = static_cast<size_t>(m_frontend.numMels);
+    for (size_t i = 0; i < numMels; ++i) {
+        out[i] = saturate((mels[i] - m_inputMean) * m_inputInvScale, false);
+    }
+}
+
+float KeywordSpotter::infer() {
+    for (size_t index = 0; index < m_layers.size(); ++index) {
+        const Layer& layer = m_layers[index];
+        const int8_t* in = m_activations[index % 2].data();
+        int8_t* out = m_activations[(index + 1) % 2].data();
+
+        switch (layer.type) {
+        case LayerType::Conv2D:
+            runConv(layer, in, out);
+            break;
+        case LayerType::Dense:
+            runDense(layer, in, out, index + 1 == m_layers.size());
+            break;
+        case LayerType::GlobalAvgPool:
+            runGlobalAvgPool(layer, in, out);
+            break;
+        }
+    }
+
+    // 로짓 softmax 중 키워드 클래스 확률
+    const float maxLogit = *std::max_element(m_logits.begin(), m_logits.end());
+    float sum = 0.0f;
+    for (float logit : m_logits) {
+        sum += std::exp(logit - maxLogit);
+    }
+    return std::exp(m_logits[m_keywordIndex] - maxLogit) / sum;
+}
+
+void KeywordSpotter::runConv(const Layer& layer, const int8_t* in, int8_t* out) {
+    const size_t rowBytes = layer.kernelW * layer.inC;
+    const size_t patchSize = layer.kernelH * rowBytes;
+
+    for (size_t oy = 0; oy < layer.outH; ++oy) {
+        for (size_t ox = 0; ox < layer.outW; ++ox) {
+            // HWC 배치에서 커널 한 행(kernelW * inC)은 연속이므로 행 단위로 패치 구성
+            const int8_t* origin = in + ((oy * layer.strideH) * layer.inW + ox * layer.strideW) * layer.inC;
+            for (size_t ky = 0; ky < layer.kernelH; ++ky) {
+                std::memcpy(m_patch.data() + ky * rowBytes, origin + ky * layer.inW * layer.inC, rowBytes);
+            }
+
+            int8_t* dst = out + (oy * layer.outW + ox) * layer.outC;
+            const int8_t* weights = layer.weights.data();
+            for (size_t oc = 0; oc < layer.outC; ++oc, weights += patchSize) {
+                const int32_t acc = kernels::dotProductInt8(m_patch.data(), weights, patchSize) + layer.bias[oc];
+                dst[oc] = saturate(static_cast<float>(acc) * layer.multiplier[oc], layer.relu);
+            }
+        }
+    }
+}
+
+void KeywordSpotter::runDense(const Layer& layer, const int8_t* in, int8_t* out, bool last) {
+    const int8_t* weights = layer.weights.data();
+    for (size_t oc = 0; oc < layer.outC; ++oc, weights += layer.inC) {
+        const int32_t acc = kernels::dotProductInt8(in, weights, layer.inC) + layer.bias[oc];
+        if (last) {
+            m_logits[oc] = static_cast<float>(acc) * layer.dequant[oc];
+        } else {
+            out[oc] = saturate(static_cast<float>(acc) * layer.multiplier[oc], layer.relu);
+        }
+    }
+}
+
+void KeywordSpotter::runGlobalAvgPool(const Layer& layer, const int8_t* in, int8_t* out) {
+    const size_t positions = layer.inH * layer.inW;
+    for (size_t ch = 0; ch < layer.inC; ++ch) {
+        int32_t sum = 0;
+        for (size_t p = 0; p < positions; ++p) {
+            sum += in[p * layer.inC + ch];
+        }
+        out[ch] = saturate(static_cast<float>(sum) / static_cast<float>(positions), false);
+    }
+}
+
+} // namespace sion
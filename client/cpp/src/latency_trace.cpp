@@ -0,0 +1,504 @@
+/**
+ * @file latency_trace.cpp
+ * @brief 구간 계측 (스레드별 무잠금 버퍼, 히스토그램, Chrome trace 출력) 구현
+ */
+
+#include "latency_trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+namespace sion {
+namespace trace {
+
+namespace {
+
+// 스레드당 보관하는 최근 구간 수 (Chrome trace용, 넘치면 오래된 것부터 덮어씀)
+constexpr size_t kEventCapacity = 2048;
+
+// 로그 선형 히스토그램 (µs): 16 미만은 1 µs 단위, 이후 2배 구간마다 8칸
+constexpr int kLinearBuckets = 16;
+constexpr int kSubBuckets = 8;
+constexpr int kMaxExponent = 36;     // 2^36 µs ≈ 19시간
+constexpr int kBucketCount = kLinearBuckets + (kMaxExponent - 4 + 1) * kSubBuckets;
+
+constexpr const char* kStageNames[kStageCount] = {
+    "hotkey-received",
+    "device-open",
+    "first-frame",
+    "end-of-speech",
+    "encode",
+    "bridge-send",
+    "first-partial",
+    "final-result",
+    "asr-transcript",
+    "local-asr",
+    "end-to-end",
+};
+
+constexpr const char* kCounterNames[kCounterCount] = {
+    "transcript-cache-hit",
+    "transcript-cache-miss",
+    "fingerprint-cache-hit",
+    "fingerprint-cache-miss",
+    "speculative-nlu-sent",
+    "local-asr-routed",
+    "local-asr-fallback",
+    "journal-written",
+    "journal-dropped",
+    "capture-overrun-samples",
+    "worker-restart",
+};
+
+// 카운터는 드물게 증가하므로 스레드별 버퍼 없이 전역 원자값 하나씩 사용
+std::atomic<uint64_t> g_counters[kCounterCount] = {};
+
+int bucketIndex(uint64_t micros) {
+    if (micros < static_cast<uint64_t>(kLinearBuckets)) {
+        return static_cast<int>(micros);
+    }
+    int exponent = 4;
+    while (exponent < kMaxExponent && (micros >> (exponent + 1)) != 0) {
+        ++exponent;
+    }
+    if ((micros >> (exponent + 1)) != 0) {
+        return kBucketCount - 1;   // 범위 초과
+    }
+    const int mantissa = static_cast<int>((micros >> (exponent - 3)) & (kSubBuckets - 1));
+    return kLinearBuckets + (exponent - 4) * kSubBuckets + mantissa;
+}
+
+uint64_t bucketUpperBound(int index) {
+    if (index < kLinearBuckets) {
+        return static_cast<uint64_t>(index) + 1;
+    }
+    const int exponent = 4 + (index - kLinearBuckets) / kSubBuckets;
+    const uint64_t mantissa = static_cast<uint64_t>((index - kLinearBuckets) % kSubBuckets);
+    return (kSubBuckets + mantissa + 1) << (exponent - 3);
+}
+
+/**
+ * @brief 기록된 구간 하나 (읽기와 쓰기가 겹칠 수 있어 필드마다 원자적)
+ */
+struct Event {
+    std::atomic<int64_t> startNs{0};
+    std::atomic<int64_t> endNs{0};
+    std::atomic<uint64_t> requestId{0};
+    std::atomic<uint32_t> stage{0};
+};
+
+/**
+ * @brief 스레드 전용 버퍼 (쓰기는 소유 스레드만, 읽기는 아무 스레드)
+ *
+ * 스레드가 끝나면 inUse를 내려 다음에 생성되는 스레드가 재사용합니다
+ * (워커 재시작마다 버퍼가 늘지 않도록). 누적 통계는 그대로 유지됩니다.
+ */
+struct ThreadBuffer {
+    uint32_t trackId = 0;
+    std::atomic<bool> inUse{false};
+    std::atomic<uint64_t> head{0};
+    Event events[kEventCapacity];
+
+    std::atomic<uint32_t> histogram[kStageCount][kBucketCount] = {};
+    std::atomic<uint64_t> totalMicros[kStageCount] = {};
+    std::atomic<uint64_t> maxMicros[kStageCount] = {};
+};
+
+/**
+ * @brief 버퍼 목록 (종료 시 늦게 기록하는 스레드가 있어도 안전하도록 해제하지 않음)
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+std::atomic<bool> g_enabled{true};
+thread_local uint64_t t_currentRequest = 0;
+
+/**
+ * @brief 스레드 종료 시 버퍼 반납
+ */
+struct BufferLease {
+    ThreadBuffer* buffer = nullptr;
+
+    ~BufferLease() {
+        if (buffer) {
+            buffer->inUse.store(false, std::memory_order_release);
+        }
+    }
+};
+
+ThreadBuffer& localBuffer() {
+    thread_local BufferLease lease;
+    if (lease.buffer) {
+        return *lease.buffer;
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        bool expected = false;
+        if (buffer->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            lease.buffer = buffer.get();
+            return *lease.buffer;
+        }
+    }
+
+    reg.buffers.push_back(std::make_unique<ThreadBuffer>());
+    lease.buffer = reg.buffers.back().get();
+    lease.buffer->trackId = static_cast<uint32_t>(reg.buffers.size());
+    lease.buffer->inUse.store(true, std::memory_order_relaxed);
+    return *lease.buffer;
+}
+
+/**
+ * @brief 읽기용 구간 사본
+ */
+struct EventCopy {
+    int64_t startNs;
+    int64_t endNs;
+    uint64_t requestId;
+    uint32_t stage;
+    uint32_t trackId;
+};
+
+/**
+ * @brief 버퍼에 남은 구간 복사 (읽는 동안 덮어쓴 항목은 제외)
+ */
+void collectEvents(const ThreadBuffer& buffer, std::vector<EventCopy>& out) {
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    const uint64_t first = head > kEventCapacity ? head - kEventCapacity : 0;
+
+    const size_t begin = out.size();
+    for (uint64_t i = first; i < head; ++i) {
+        const Event& event = buffer.events[i % kEventCapacity];
+        out.push_back({event.startNs.load(std::memory_order_relaxed),
+                       event.endNs.load(std::memory_order_relaxed),
+                       event.requestId.load(std::memory_order_relaxed),
+                       event.stage.load(std::memory_order_relaxed),
+                       buffer.trackId});
+    }
+
+    // 복사 중 쓰기 스레드가 앞질러 덮어쓴 구간 폐기 (쓰는 중인 한 칸 포함)
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = buffer.head.load(std::memory_order_relaxed) + 1;
+    const uint64_t valid = after > kEventCapacity ? after - kEventCapacity : 0;
+    if (valid > first) {
+        const size_t overwritten = static_cast<size_t>(std::min(valid, head) - first);
+        out.erase(out.begin() + static_cast<std::ptrdiff_t>(begin),
+                  out.begin() + static_cast<std::ptrdiff_t>(begin + overwritten));
+    }
+}
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            out << '\\';
+        }
+        out << *p;
+    }
+    out << '"';
+}
+
+} // namespace
+
+const char* stageName(Stage stage) {
+    const size_t index = static_cast<size_t>(stage);
+    return index < kStageCount ? kStageNames[index] : "unknown";
+}
+
+const char* counterName(Counter counter) {
+    const size_t index = static_cast<size_t>(counter);
+    return index < kCounterCount ? kCounterNames[index] : "unknown";
+}
+
+void increment(Counter counter, uint64_t delta) {
+    if (!g_enabled.load(std::memory_order_relaxed) || counter >= Counter::Count) {
+        return;
+    }
+    g_counters[static_cast<size_t>(counter)].fetch_add(delta, std::memory_order_relaxed);
+}
+
+uint64_t counterValue(Counter counter) {
+    if (counter >= Counter::Count) {
+        return 0;
+    }
+    return g_counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+void record(Stage stage, uint64_t requestId, int64_t startNs, int64_t endNs) {
+    if (!g_enabled.load(std::memory_order_relaxed) || stage >= Stage::Count) {
+        return;
+    }
+
+    ThreadBuffer& buffer = localBuffer();
+    const size_t stageIndex = static_cast<size_t>(stage);
+
+    // 히스토그램 (읽기 스레드와만 경쟁하므로 relaxed로 충분)
+    const uint64_t micros = endNs > startNs ? static_cast<uint64_t>(endNs - startNs) / 1000 : 0;
+    buffer.histogram[stageIndex][bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    buffer.totalMicros[stageIndex].fetch_add(micros, std::memory_order_relaxed);
+    if (micros > buffer.maxMicros[stageIndex].load(std::memory_order_relaxed)) {
+        buffer.maxMicros[stageIndex].store(micros, std::memory_order_relaxed);
+    }
+
+    // 최근 구간 (단일 생산자 링: 항목을 쓴 뒤 head를 release로 공개).
+    // 펜스는 덮어쓴 값을 본 읽기 스레드가 이전 head도 보도록 보장 (seqlock과 같은 방식)
+    const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Event& event = buffer.events[head % kEventCapacity];
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.endNs.store(endNs, std::memory_order_relaxed);
+    event.requestId.store(requestId, std::memory_order_relaxed);
+    event.stage.store(static_cast<uint32_t>(stageIndex), std::memory_order_relaxed);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void setEnabled(bool enabled) {
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool isEnabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t currentRequest() {
+    return t_currentRequest;
+}
+
+RequestScope::RequestScope(uint64_t requestId)
+    : m_previous(t_currentRequest)
+{
+    t_currentRequest = requestId;
+}
+
+RequestScope::~RequestScope() {
+    t_currentRequest = m_previous;
+}
+
+std::array<int64_t, kStageCount> requestDurations(uint64_t requestId) {
+    std::array<int64_t, kStageCount> durations{};
+    if (requestId == 0) {
+        return durations;
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        // collectEvents()와 같은 방식이지만 일치하는 구간만 모아 복사량을 줄임
+        struct Match {
+            uint64_t position;
+            uint32_t stage;
+            int64_t durationNs;
+        };
+        Match matches[kStageCount * 4];
+        size_t matchCount = 0;
+
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const uint64_t first = head > kEventCapacity ? head - kEventCapacity : 0;
+        for (uint64_t i = first; i < head && matchCount < sizeof(matches) / sizeof(matches[0]); ++i) {
+            const Event& event = buffer->events[i % kEventCapacity];
+            if (event.requestId.load(std::memory_order_relaxed) != requestId) {
+                continue;
+            }
+            const uint32_t stage = event.stage.load(std::memory_order_relaxed);
+            const int64_t duration = event.endNs.load(std::memory_order_relaxed)
+                                   - event.startNs.load(std::memory_order_relaxed);
+            if (stage < kStageCount) {
+                matches[matchCount++] = {i, stage, std::max<int64_t>(0, duration)};
+            }
+        }
+
+        // 읽는 동안 덮어쓴 칸은 다른 요청의 구간일 수 있으므로 제외
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = buffer->head.load(std::memory_order_relaxed) + 1;
+        const uint64_t valid = after > kEventCapacity ? after - kEventCapacity : 0;
+        for (size_t m = 0; m < matchCount; ++m) {
+            if (matches[m].position >= valid) {
+                durations[matches[m].stage] += matches[m].durationNs;
+            }
+        }
+    }
+    return durations;
+}
+
+std::vector<StageStats> summarize() {
+    std::vector<uint64_t> counts(kStageCount * kBucketCount, 0);
+    std::vector<uint64_t> totals(kStageCount, 0);
+    std::vector<uint64_t> maxima(kStageCount, 0);
+
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& buffer : reg.buffers) {
+            for (size_t s = 0; s < kStageCount; ++s) {
+                for (int b = 0; b < kBucketCount; ++b) {
+                    counts[s * kBucketCount + b] += buffer->histogram[s][b].load(std::memory_order_relaxed);
+                }
+                totals[s] += buffer->totalMicros[s].load(std::memory_order_relaxed);
+                maxima[s] = std::max(maxima[s], buffer->maxMicros[s].load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    std::vector<StageStats> stats(kStageCount);
+    for (size_t s = 0; s < kStageCount; ++s) {
+        StageStats& stage = stats[s];
+        stage.stage = static_cast<Stage>(s);
+
+        const uint64_t* bucket = &counts[s * kBucketCount];
+        for (int b = 0; b < kBucketCount; ++b) {
+            stage.count += bucket[b];
+        }
+        if (stage.count == 0) {
+            continue;
+        }
+
+        // 순위가 처음 도달하는 버킷의 상한 (최댓값을 넘지 않도록)
+        auto percentile = [&](double q) {
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * stage.count + 0.5));
+            uint64_t seen = 0;
+            for (int b = 0; b < kBucketCount; ++b) {
+                seen += bucket[b];
+                if (seen >= rank) {
+                    return std::min(bucketUpperBound(b), maxima[s]) / 1000.0;
+                }
+            }
+            return maxima[s] / 1000.0;
+        };
+
+        stage.meanMs = static_cast<double>(totals[s]) / stage.count / 1000.0;
+        stage.p50Ms = percentile(0.50);
+        stage.p95Ms = percentile(0.95);
+        stage.p99Ms = percentile(0.99);
+        stage.maxMs = maxima[s] / 1000.0;
+    }
+    return stats;
+}
+
+std::vector<StageDistribution> distributions(const std::vector<double>& boundsMs) {
+    std::vector<StageDistribution> result(kStageCount);
+    for (size_t s = 0; s < kStageCount; ++s) {
+        result[s].stage = static_cast<Stage>(s);
+        result[s].cumulative.assign(boundsMs.size(), 0);
+    }
+
+    // 버킷마다 처음으로 상한을 담는 경계 (경계 이후 칸은 누적 합으로 채움)
+    std::vector<size_t> firstBound(kBucketCount);
+    for (int b = 0; b < kBucketCount; ++b) {
+        const double upperMs = bucketUpperBound(b) / 1000.0;
+        firstBound[b] = static_cast<size_t>(std::lower_bound(boundsMs.begin(), boundsMs.end(), upperMs)
+                                            - boundsMs.begin());
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        for (size_t s = 0; s < kStageCount; ++s) {
+            StageDistribution& stage = result[s];
+            for (int b = 0; b < kBucketCount; ++b) {
+                const uint64_t count = buffer->histogram[s][b].load(std::memory_order_relaxed);
+                if (count == 0) {
+                    continue;
+                }
+                stage.count += count;
+                if (firstBound[b] < boundsMs.size()) {
+                    stage.cumulative[firstBound[b]] += count;
+                }
+            }
+            stage.sumMs += buffer->totalMicros[s].load(std::memory_order_relaxed) / 1000.0;
+        }
+    }
+    for (StageDistribution& stage : result) {
+        for (size_t k = 1; k < stage.cumulative.size(); ++k) {
+            stage.cumulative[k] += stage.cumulative[k - 1];
+        }
+    }
+    return result;
+}
+
+void printReport(std::ostream& out) {
+    const std::vector<StageStats> stats = summarize();
+
+    out << "[Trace] 구간별 지연 (ms)" << std::endl;
+    out << "  " << std::left << std::setw(16) << "stage" << std::right
+        << std::setw(8) << "count" << std::setw(10) << "mean" << std::setw(10) << "p50"
+        << std::setw(10) << "p95" << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(2);
+    for (const StageStats& stage : stats) {
+        if (stage.count == 0) {
+            continue;
+        }
+        out << "  " << std::left << std::setw(16) << stageName(stage.stage) << std::right
+            << std::setw(8) << stage.count << std::setw(10) << stage.meanMs
+            << std::setw(10) << stage.p50Ms << std::setw(10) << stage.p95Ms
+            << std::setw(10) << stage.p99Ms << std::setw(10) << stage.maxMs << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+
+    bool header = false;
+    for (size_t c = 0; c < kCounterCount; ++c) {
+        const uint64_t value = counterValue(static_cast<Counter>(c));
+        if (value == 0) {
+            continue;
+        }
+        if (!header) {
+            out << "[Trace] 카운터" << std::endl;
+            header = true;
+        }
+        out << "  " << std::left << std::setw(24) << kCounterNames[c] << std::right
+            << std::setw(8) << value << std::endl;
+    }
+    out.flags(flags);
+}
+
+bool writeChromeTrace(const std::string& path) {
+    std::vector<EventCopy> events;
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& buffer : reg.buffers) {
+            collectEvents(*buffer, events);
+        }
+    }
+    std::sort(events.begin(), events.end(),
+              [](const EventCopy& a, const EventCopy& b) { return a.startNs < b.startNs; });
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    // 완료 이벤트("X"), 시각은 µs (첫 구간 기준 상대값)
+    const int64_t origin = events.empty() ? 0 : events.front().startNs;
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    file << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < events.size(); ++i) {
+        const EventCopy& event = events[i];
+        file << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        writeJsonString(file, stageName(static_cast<Stage>(event.stage)));
+        file << ",\"cat\":\"sion\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.trackId
+             << ",\"ts\":" << (event.startNs - origin) / 1000.0
+             << ",\"dur\":" << std::max<int64_t>(0, event.endNs - event.startNs) / 1000.0
+             << ",\"args\":{\"request\":" << event.requestId << "}}";
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
+
+} // namespace trace
+} // namespace sion
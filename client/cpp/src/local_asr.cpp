@@ -0,0 +1,316 @@
+/**
+ * @file local_asr.cpp
+ * @brief LocalAsrEngine 클래스 구현 (whisper.cpp)
+ */
+
+#include "local_asr.h"
+#include "latency_trace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+#ifdef SION_HAVE_WHISPER
+#include <whisper.h>
+#endif
+
+namespace sion {
+
+namespace {
+
+// whisper 모델 입력 레이트 (WHISPER_SAMPLE_RATE)
+constexpr int kModelSampleRate = 16000;
+// whisper_full()은 1초 미만 입력을 건너뛰므로 짧은 명령은 무음으로 채움 (여유 100 ms)
+constexpr size_t kMinInputSamples = kModelSampleRate * 11 / 10;
+
+/**
+ * @brief 물리 코어 수 (알 수 없으면 논리 코어의 절반)
+ */
+size_t physicalCoreCount() {
+    size_t cores = 0;
+#if defined(_WIN32)
+    DWORD bytes = 0;
+    GetLogicalProcessorInformation(nullptr, &bytes);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(bytes / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!info.empty() && GetLogicalProcessorInformation(info.data(), &bytes)) {
+        cores = static_cast<size_t>(std::count_if(info.begin(), info.end(), [](const auto& entry) {
+            return entry.Relationship == RelationProcessorCore;
+        }));
+    }
+#elif defined(__APPLE__)
+    int value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname("hw.physicalcpu", &value, &size, nullptr, 0) == 0 && value > 0) {
+        cores = static_cast<size_t>(value);
+    }
+#else
+    // (physical id, core id) 쌍이 물리 코어 하나 (ARM 등 core id가 없으면 0개)
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::set<std::pair<int, int>> unique;
+    std::string line;
+    int physicalId = 0;
+    while (std::getline(cpuinfo, line)) {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        if (line.compare(0, 11, "physical id") == 0) {
+            physicalId = std::atoi(line.c_str() + colon + 1);
+        } else if (line.compare(0, 7, "core id") == 0) {
+            unique.emplace(physicalId, std::atoi(line.c_str() + colon + 1));
+        }
+    }
+    cores = unique.size();
+#endif
+    if (cores == 0) {
+        cores = std::max(1u, std::thread::hardware_concurrency() / 2);
+    }
+    return cores;
+}
+
+/**
+ * @brief 읽기 전용 파일 매핑 (모델 적재 동안만 유지)
+ */
+class MappedFile {
+public:
+    ~MappedFile() {
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+#else
+        if (m_data) {
+            munmap(m_data, m_size);
+        }
+#endif
+    }
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        LARGE_INTEGER size{};
+        if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            return false;
+        }
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info {};
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            m_size = static_cast<size_t>(info.st_size);
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                m_data = data;
+                // 적재가 처음부터 끝까지 한 번 읽으므로 미리 읽기 요청
+                madvise(m_data, m_size, MADV_SEQUENTIAL);
+                madvise(m_data, m_size, MADV_WILLNEED);
+            }
+        }
+        ::close(fd);   // 매핑은 파일 디스크립터와 무관하게 유지됨
+#endif
+        return m_data != nullptr;
+    }
+
+    void* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    void* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+};
+
+} // namespace
+
+LocalAsrEngine::LocalAsrEngine(LocalAsrConfig config)
+    : m_config(std::move(config))
+    , m_threads(m_config.threads > 0 ? m_config.threads : physicalCoreCount())
+    , m_context(nullptr)
+    , m_state(nullptr)
+    , m_inference(1, "local-asr")
+{
+}
+
+LocalAsrEngine::~LocalAsrEngine() {
+    stop();
+#ifdef SION_HAVE_WHISPER
+    if (m_state) {
+        whisper_free_state(static_cast<whisper_state*>(m_state));
+    }
+    if (m_context) {
+        whisper_free(static_cast<whisper_context*>(m_context));
+    }
+#endif
+}
+
+bool LocalAsrEngine::isAvailable() {
+#ifdef SION_HAVE_WHISPER
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool LocalAsrEngine::load() {
+    if (m_context) {
+        return true;
+    }
+    if (m_config.modelPath.empty()) {
+        return false;
+    }
+#ifdef SION_HAVE_WHISPER
+    MappedFile model;
+    if (!model.open(m_config.modelPath)) {
+        std::cerr << "[LocalAsr] 모델 파일을 열 수 없습니다: " << m_config.modelPath << std::endl;
+        return false;
+    }
+
+    // 가중치는 적재 중에 ggml 버퍼로 복사되므로 매핑은 이 함수 안에서만 유지
+    whisper_context_params params = whisper_context_default_params();
+    params.use_gpu = m_config.gpu;
+    // 상태 없이 적재하고 추론 상태는 아래에서 한 번만 만듦 (기본 상태까지 만들면 KV 캐시/연산 버퍼가 두 벌)
+    whisper_context* context = whisper_init_from_buffer_with_params_no_state(model.data(), model.size(), params);
+    if (!context) {
+        std::cerr << "[LocalAsr] 모델 적재 실패: " << m_config.modelPath << std::endl;
+        return false;
+    }
+    whisper_state* state = whisper_init_state(context);
+    if (!state) {
+        std::cerr << "[LocalAsr] 추론 상태 생성 실패" << std::endl;
+        whisper_free(context);
+        return false;
+    }
+    m_context = context;
+    m_state = state;
+
+    // 첫 명령이 커널/버퍼 초기화 비용을 치르지 않도록 무음으로 한 번 실행
+    m_inference.post([this]() { run(std::vector<float>(kMinInputSamples, 0.0f), nullptr); });
+
+    std::cout << "[LocalAsr] 로컬 ASR 준비 (" << m_config.modelPath << ", 스레드 " << m_threads
+              << ", " << m_config.maxLocalMs << " ms 이하 로컬 우선)" << std::endl;
+    return true;
+#else
+    std::cerr << "[LocalAsr] whisper.cpp 없이 빌드되어 로컬 ASR을 사용할 수 없습니다" << std::endl;
+    return false;
+#endif
+}
+
+bool LocalAsrEngine::route(size_t sampleCount, int sampleRate, bool remoteReachable) const {
+    if (!isLoaded() || sampleRate != kModelSampleRate) {
+        return false;
+    }
+    if (!remoteReachable) {
+        return true;   // 오프라인: 길이와 관계없이 로컬
+    }
+    const size_t durationMs = sampleCount * 1000 / static_cast<size_t>(sampleRate);
+    return durationMs <= static_cast<size_t>(std::max(0, m_config.maxLocalMs));
+}
+
+std::future<std::string> LocalAsrEngine::transcribe(const int16_t* samples, size_t sampleCount,
+                                                    std::shared_ptr<CancellationToken> cancel) {
+    // whisper 입력은 [-1, 1] float
+    std::vector<float> input(std::max(sampleCount, kMinInputSamples), 0.0f);
+    for (size_t i = 0; i < sampleCount; ++i) {
+        input[i] = static_cast<float>(samples[i]) * (1.0f / 32768.0f);
+    }
+
+    const uint64_t requestId = trace::currentRequest();
+    const int64_t queuedAt = trace::now();
+    return m_inference.submit([this, input = std::move(input), cancel, requestId, queuedAt]() {
+        if (cancel && cancel->isCancelled()) {
+            return std::string();
+        }
+        std::string text = run(input, cancel.get());
+        trace::record(trace::Stage::LocalAsr, requestId, queuedAt, trace::now());
+        return text;
+    });
+}
+
+void LocalAsrEngine::stop() {
+    m_inference.shutdown();
+}
+
+std::string LocalAsrEngine::run(const std::vector<float>& samples, CancellationToken* cancel) {
+#ifdef SION_HAVE_WHISPER
+    whisper_full_params params = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
+    params.n_threads = static_cast<int>(m_threads);
+    params.language = m_config.language.c_str();
+    // 짧은 명령: 이전 발화 문맥 없이 한 구간으로, 타임스탬프 토큰 생략
+    params.no_context = true;
+    params.single_segment = true;
+    params.no_timestamps = true;
+    params.print_progress = false;
+    params.print_realtime = false;
+    params.print_special = false;
+    params.print_timestamps = false;
+    if (cancel) {
+        params.abort_callback = [](void* data) { return static_cast<CancellationToken*>(data)->isCancelled(); };
+        params.abort_callback_user_data = cancel;
+    }
+
+    auto* context = static_cast<whisper_context*>(m_context);
+    auto* state = static_cast<whisper_state*>(m_state);
+    if (whisper_full_with_state(context, state, params, samples.data(), static_cast<int>(samples.size())) != 0) {
+        if (!cancel || !cancel->isCancelled()) {
+            std::cerr << "[LocalAsr] 추론 실패" << std::endl;
+        }
+        return std::string();
+    }
+
+    std::string text;
+    const int segments = whisper_full_n_segments_from_state(state);
+    for (int i = 0; i < segments; ++i) {
+        text += whisper_full_get_segment_text_from_state(state, i);
+    }
+
+    // 앞뒤 공백 제거, 무음 표시 토큰("[BLANK_AUDIO]" 등)은 인식 실패로 처리
+    const size_t begin = text.find_first_not_of(' ');
+    const size_t end = text.find_last_not_of(' ');
+    text = begin == std::string::npos ? std::string() : text.substr(begin, end - begin + 1);
+    if (!text.empty() && text.front() == '[' && text.back() == ']') {
+        text.clear();
+    }
+    return text;
+#else
+    (void)samples;
+    (void)cancel;
+    return std::string();
+#endif
+}
+
+} // namespace sion
@@ -0,0 +1,206 @@
+/**
+ * @file log_mel_frontend.cpp
+ * @brief LogMelFrontend 클래스 구현
+ */
+
+#include "log_mel_frontend.h"
+#include "audio_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace sion {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// log(0) 방지용 하한 (정규화된 파워 기준 약 -60 dB)
+constexpr float kLogFloor = 1e-6f;
+
+double hzToMel(double hz) {
+    return 2595.0 * std::log10(1.0 + hz / 700.0);
+}
+
+double melToHz(double mel) {
+    return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0);
+}
+
+} // namespace
+
+LogMelFrontend::LogMelFrontend()
+    : m_halfSize(0)
+{
+}
+
+bool LogMelFrontend::configure(const LogMelConfig& config) {
+    const bool powerOfTwo = config.fftSize >= 4 && (config.fftSize & (config.fftSize - 1)) == 0;
+    if (!powerOfTwo || config.frameLength <= 0 || config.frameLength > config.fftSize
+        || config.hopLength <= 0 || config.hopLength > config.frameLength
+        || config.numMels <= 0 || config.sampleRate <= 0
+        || config.lowHz < 0.0f || config.highHz <= config.lowHz
+        || config.highHz > config.sampleRate / 2.0f) {
+        std::cerr << "[LogMelFrontend] 잘못된 설정 (fft " << config.fftSize
+                  << ", frame " << config.frameLength << ", hop " << config.hopLength
+                  << ", mels " << config.numMels << ")" << std::endl;
+        return false;
+    }
+
+    m_config = config;
+    const size_t fftSize = static_cast<size_t>(config.fftSize);
+    const size_t frameLength = static_cast<size_t>(config.frameLength);
+    m_halfSize = fftSize / 2;
+
+    // 주기형 Hann 창, int16 → [-1, 1] 정규화를 창에 합침
+    m_window.resize(frameLength);
+    for (size_t n = 0; n < frameLength; ++n) {
+        const double hann = 0.5 - 0.5 * std::cos(2.0 * kPi * n / frameLength);
+        m_window[n] = static_cast<float>(hann / 32768.0);
+    }
+
+    m_buffer.assign(fftSize, 0.0f);
+    m_power.assign(m_halfSize + 1, 0.0f);
+
+    m_twiddleRe.resize(m_halfSize / 2);
+    m_twiddleIm.resize(m_halfSize / 2);
+    for (size_t j = 0; j < m_halfSize / 2; ++j) {
+        const double angle = -2.0 * kPi * j / m_halfSize;
+        m_twiddleRe[j] = static_cast<float>(std::cos(angle));
+        m_twiddleIm[j] = static_cast<float>(std::sin(angle));
+    }
+
+    m_splitRe.resize(m_halfSize);
+    m_splitIm.resize(m_halfSize);
+    for (size_t k = 0; k < m_halfSize; ++k) {
+        const double angle = -2.0 * kPi * k / fftSize;
+        m_splitRe[k] = static_cast<float>(std::cos(angle));
+        m_splitIm[k] = static_cast<float>(std::sin(angle));
+    }
+
+    size_t bits = 0;
+    while ((size_t{1} << bits) < m_halfSize) {
+        ++bits;
+    }
+    m_bitReverse.resize(m_halfSize);
+    for (size_t i = 0; i < m_halfSize; ++i) {
+        uint32_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            reversed |= static_cast<uint32_t>((i >> b) & 1) << (bits - 1 - b);
+        }
+        m_bitReverse[i] = reversed;
+    }
+
+    // 멜 척도에서 등간격인 삼각 필터 (HTK 공식), 0이 아닌 빈만 연속으로 저장
+    const size_t numMels = static_cast<size_t>(config.numMels);
+    const double lowMel = hzToMel(config.lowHz);
+    const double highMel = hzToMel(config.highHz);
+    const double binHz = static_cast<double>(config.sampleRate) / fftSize;
+
+    m_filters.clear();
+    m_melWeights.clear();
+    m_filters.reserve(numMels);
+    for (size_t m = 0; m < numMels; ++m) {
+        const double lower = melToHz(lowMel + (highMel - lowMel) * m / (numMels + 1));
+        const double center = melToHz(lowMel + (highMel - lowMel) * (m + 1) / (numMels + 1));
+        const double upper = melToHz(lowMel + (highMel - lowMel) * (m + 2) / (numMels + 1));
+
+        MelFilter filter{0, m_melWeights.size(), 0};
+        for (size_t bin = 0; bin <= m_halfSize; ++bin) {
+            const double hz = bin * binHz;
+            double weight = 0.0;
+            if (hz > lower && hz < center) {
+                weight = (hz - lower) / (center - lower);
+            } else if (hz >= center && hz < upper) {
+                weight = (upper - hz) / (upper - center);
+            }
+            if (weight <= 0.0) {
+                continue;
+            }
+            if (filter.length == 0) {
+                filter.firstBin = bin;
+            }
+            // 구간 안에서 0이 되는 빈은 없으므로 연속 구간으로 저장
+            m_melWeights.push_back(static_cast<float>(weight));
+            ++filter.length;
+        }
+        m_filters.push_back(filter);
+    }
+    return true;
+}
+
+void LogMelFrontend::compute(const int16_t* frame, float* mels) {
+    const size_t frameLength = m_window.size();
+    kernels::applyWindow(frame, m_window.data(), m_buffer.data(), frameLength);
+    // FFT가 버퍼 전체를 덮어쓰므로 영 패딩은 매번 다시 채움
+    std::fill(m_buffer.begin() + frameLength, m_buffer.end(), 0.0f);
+
+    // 실수 fftSize개를 복소 halfSize개(짝수 = 실수부, 홀수 = 허수부)로 보고 변환
+    fft();
+
+    // 분리 단계: Z[k]와 conj(Z[M-k])로 실수 FFT의 짝수/홀수 성분을 복원
+    const float* z = m_buffer.data();
+    const size_t half = m_halfSize;
+    m_power[0] = (z[0] + z[1]) * (z[0] + z[1]);
+    m_power[half] = (z[0] - z[1]) * (z[0] - z[1]);
+    for (size_t k = 1; k < half; ++k) {
+        const float ar = z[2 * k];
+        const float ai = z[2 * k + 1];
+        const float br = z[2 * (half - k)];
+        const float bi = z[2 * (half - k) + 1];
+
+        const float evenRe = 0.5f * (ar + br);
+        const float evenIm = 0.5f * (ai - bi);
+        const float oddRe = 0.5f * (ai + bi);
+        const float oddIm = -0.5f * (ar - br);
+
+        const float wr = m_splitRe[k];
+        const float wi = m_splitIm[k];
+        const float re = evenRe + wr * oddRe - wi * oddIm;
+        const float im = evenIm + wr * oddIm + wi * oddRe;
+        m_power[k] = re * re + im * im;
+    }
+
+    for (size_t m = 0; m < m_filters.size(); ++m) {
+        const MelFilter& filter = m_filters[m];
+        const float energy = kernels::dotProduct(m_power.data() + filter.firstBin,
+                                                 m_melWeights.data() + filter.weightOffset,
+                                                 filter.length);
+        mels[m] = std::log(energy + kLogFloor);
+    }
+}
+
+void LogMelFrontend::fft() {
+    float* x = m_buffer.data();
+    const size_t n = m_halfSize;
+
+    for (size_t i = 0; i < n; ++i) {
+        const size_t j = m_bitReverse[i];
+        if (i < j) {
+            std::swap(x[2 * i], x[2 * j]);
+            std::swap(x[2 * i + 1], x[2 * j + 1]);
+        }
+    }
+
+    // 반복형 radix-2 decimation-in-time
+    for (size_t size = 2; size <= n; size <<= 1) {
+        const size_t halfBlock = size / 2;
+        const size_t step = n / size;
+        for (size_t start = 0; start < n; start += size) {
+            for (size_t j = 0; j < halfBlock; ++j) {
+                const float wr = m_twiddleRe[j * step];
+                const float wi = m_twiddleIm[j * step];
+                float* a = x + 2 * (start + j);
+                float* b = x + 2 * (start + j + halfBlock);
+                const float tr = wr * b[0] - wi * b[1];
+                const float ti = wr * b[1] + wi * b[0];
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+} // namespace sion
@@ -10,54 +10,86 @@
 #include <string>
 #include <memory>
 #include <csignal>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <process.h>
+#define SION_GETPID _getpid
+#else
+#include <pthread.h>
+#include <unistd.h>
+#define SION_GETPID getpid
+#endif
 
 #include "hotkey_handler.h"
+#include "cancellation_token.h"
 #include "audio_capture.h"
-#include "python_bridge.h"
+#include "capture_backend.h"
+#include "voice_activity_detector.h"
+#include "python_worker_pool.h"
+#include "voice_pipeline.h"
+#include "session_manager.h"
+#include "shared_audio_ring.h"
+#include "audio_encoder.h"
+#include "latency_trace.h"
+#include "metrics.h"
+#include "asr_stream_client.h"
+#include "local_asr.h"
+#include "response_cache.h"
+#include "utterance_journal.h"
 
-// 전역 실행 플래그
-std::atomic<bool> g_running{true};
+// 종료 요청 (취소 시 핫키 리스너가 바로 깨어나 반환)
+sion::CancellationToken g_shutdown;
+
+#ifdef _WIN32
+// 콘솔 제어 핸들러 (Ctrl+C, 창 닫기 등: 시스템이 만든 별도 스레드에서 호출)
+BOOL WINAPI consoleCtrlHandler(DWORD event) {
+    std::cout << "\n[SION] 종료 신호 수신 (event: " << event << ")" << std::endl;
+    g_shutdown.cancel();
+    return TRUE;
+}
+#else
+// 종료 시그널 대기 스레드 시작 (시그널 핸들러가 아니므로 토큰 콜백을 그대로 실행 가능)
+void startSignalThread() {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    // 이후 만드는 스레드가 마스크를 상속하므로 다른 스레드로는 전달되지 않음
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
 
-// 시그널 핸들러
-void signalHandler(int signal) {
-    std::cout << "\n[SION] 종료 신호 수신 (signal: " << signal << ")" << std::endl;
-    g_running = false;
+    // 종료 시그널 없이 끝나면 sigwait 중인 채로 프로세스와 함께 정리됨
+    std::thread([signals] {
+        int signal = 0;
+        if (sigwait(&signals, &signal) == 0) {
+            std::cout << "\n[SION] 종료 신호 수신 (signal: " << signal << ")" << std::endl;
+        }
+        g_shutdown.cancel();
+    }).detach();
 }
+#endif
 
 /**
- * @brief 음성 명령 처리 함수
- * @param audioCapture 오디오 캡처 객체
- * @param pythonBridge Python 브릿지 객체
+ * @brief 세미콜론으로 구분한 장치 목록 (ALSA/CoreAudio 장치 이름에 쉼표가 들어가므로, 빈 항목은 기본 장치)
  */
-void handleVoiceCommand(
-    sion::AudioCapture& audioCapture,
-    sion::PythonProcessBridge& pythonBridge
-) {
-    std::cout << "[SION] 🎤 음성 녹음 시작..." << std::endl;
-    
-    // 5초간 녹음
-    auto audioData = audioCapture.captureForDuration(5.0f);
-    
-    if (audioData.empty()) {
-        std::cerr << "[SION] ❌ 오디오 캡처 실패" << std::endl;
-        return;
-    }
-    
-    std::cout << "[SION] ✅ 녹음 완료 (" 
-              << audioData.size() << " samples)" << std::endl;
-    
-    // WAV 바이트로 변환
-    auto wavBytes = audioCapture.toWavBytes(audioData);
-    
-    // Python으로 전송
-    std::cout << "[SION] 🔄 Python 처리 중..." << std::endl;
-    auto result = pythonBridge.sendAudio(wavBytes);
-    
-    if (!result.empty()) {
-        std::cout << "[SION] 📝 결과: " << result << std::endl;
-    } else {
-        std::cerr << "[SION] ❌ Python 처리 실패" << std::endl;
+std::vector<std::string> splitDevices(const std::string& list) {
+    std::vector<std::string> devices;
+    std::stringstream stream(list);
+    std::string device;
+    while (std::getline(stream, device, ';')) {
+        devices.push_back(device);
     }
+    return devices;
 }
 
 /**
@@ -69,49 +101,189 @@ int main(int argc, char* argv[]) {
     std::cout << "   C++ Hotkey Module" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    // 시그널 핸들러 등록
-    std::signal(SIGINT, signalHandler);
-    std::signal(SIGTERM, signalHandler);
+    // 캡처 장치 목록 (SION_LIST_DEVICES=1: SION_AUDIO_DEVICES에 넣을 id 출력 후 종료)
+    if (const char* list = std::getenv("SION_LIST_DEVICES")) {
+        if (std::string(list) == "1") {
+            for (const sion::CaptureDeviceInfo& device : sion::enumerateCaptureDevices()) {
+                std::cout << (device.isDefault ? "* " : "  ") << device.id << "  " << device.name << std::endl;
+            }
+            std::cout << "  null  무음 더미 / file:<경로>  WAV 재생 / file:<세그먼트>.sionj#<번호>  저널 발화 재생" << std::endl;
+            return 0;
+        }
+    }
+    
+    // 종료 신호 처리 (다른 스레드를 만들기 전에 등록)
+#ifdef _WIN32
+    SetConsoleCtrlHandler(consoleCtrlHandler, TRUE);
+#else
+    startSignalThread();
+#endif
     
-    // Python 경로 설정 (기본값 또는 인자로 전달)
-    std::string pythonPath = "python";
-    std::string scriptPath = "../python/main.py";
+    // Python 워커 설정 (기본값 또는 인자로 전달)
+    sion::WorkerPoolConfig workerConfig;
     
     if (argc > 1) {
-        pythonPath = argv[1];
+        workerConfig.pythonPath = argv[1];
     }
     if (argc > 2) {
-        scriptPath = argv[2];
+        workerConfig.scriptPath = argv[2];
+    }
+    if (argc > 3) {
+        workerConfig.numWorkers = static_cast<size_t>(std::max(1, std::atoi(argv[3])));
     }
     
-    // 오디오 캡처 초기화
-    sion::AudioConfig audioConfig;
+    // 캡처 세션 설정 (장치마다 녹음 → 전송 → 결과 파이프라인 하나)
+    sion::SessionManagerConfig sessionConfig;
+    sion::AudioConfig& audioConfig = sessionConfig.audio;
     audioConfig.sampleRate = 16000;
     audioConfig.channels = 1;
     audioConfig.bitsPerSample = 16;
+    audioConfig.preRollMs = 300;  // 상시 캡처: 핫키 직전 300 ms를 녹음 앞에 붙임 (0이면 비활성)
+    if (const char* devices = std::getenv("SION_AUDIO_DEVICES")) {
+        sessionConfig.devices = splitDevices(devices);  // 예: "hw:1,0;hw:2,0" (장치마다 세션, SION_LIST_DEVICES=1로 확인)
+    } else if (const char* device = std::getenv("SION_AUDIO_DEVICE")) {
+        audioConfig.device = device;  // 예: "hw:1,0", 헤드리스 테스트는 "null"
+    }
     
-    sion::AudioCapture audioCapture(audioConfig);
-    if (!audioCapture.initialize()) {
-        std::cerr << "[SION] ❌ 오디오 장치 초기화 실패" << std::endl;
+    // 웨이크워드 (SION_WAKEWORD_MODEL 지정 시 세션마다 상시 캡처 스트림에서 키워드 검출)
+    if (const char* model = std::getenv("SION_WAKEWORD_MODEL")) {
+        sessionConfig.wakeWord.modelPath = model;  // scripts/export_kws_model.py로 만든 .kws 파일
+    }
+    
+    // VAD 엔드포인터 설정
+    sessionConfig.vad.sampleRate = audioConfig.sampleRate;
+    
+    // 공유 메모리 오디오 링 (실패 시 파이프로 PCM 전송, 슬롯은 세션이 나눠 씀)
+    constexpr size_t kMaxInFlight = 4;  // 세션당 (파이프 전송 시 세션마다 최대 녹음 길이 버퍼 수)
+    sessionConfig.maxInFlight = kMaxInFlight;
+    const size_t sharedAudioSlots = std::max(kMaxInFlight, 2 * std::max<size_t>(1, sessionConfig.devices.size()));
+    sion::SharedAudioRing sharedAudio;
+    const size_t slotSamples = sion::AudioCapture::maxCaptureSamples(audioConfig);
+    const std::string sharedAudioName = "sion-audio-" + std::to_string(SION_GETPID());
+    if (sharedAudio.create(sharedAudioName, sharedAudioSlots, slotSamples, audioConfig.sampleRate)) {
+        workerConfig.extraArgs = {"--shm", sharedAudio.name()};
+        std::cout << "[SION] ✅ 공유 메모리 오디오 링 생성: " << sharedAudio.name() << std::endl;
+    } else {
+        std::cerr << "[SION] ⚠️ 공유 메모리 생성 실패, 파이프로 오디오 전송" << std::endl;
+    }
+    
+    // Python 워커 풀 초기화 (첫 핫키 전에 인터프리터/임포트 예열)
+    sion::PythonWorkerPool pythonWorkers(workerConfig);
+    if (!pythonWorkers.start()) {
+        std::cerr << "[SION] ❌ Python 워커 시작 실패" << std::endl;
         return 1;
     }
-    std::cout << "[SION] ✅ 오디오 장치 초기화 완료" << std::endl;
+    std::cout << "[SION] ✅ Python 워커 " << pythonWorkers.readyWorkers() << "개 준비 완료" << std::endl;
+    
+    // ASR 직접 연결 (지정 시 인식은 C++ → ASR 서비스, 워커는 NLU/작업만 수행)
+    sion::AsrStreamConfig asrConfig;
+    if (const char* asrUrl = std::getenv("SION_ASR_URL")) {
+        asrConfig.url = asrUrl;  // 예: "ws://localhost:8001/transcribe/stream"
+    }
+    sion::AsrStreamClient asrClient(asrConfig);
+    if (!asrConfig.url.empty() && !asrClient.start()) {
+        std::cerr << "[SION] ⚠️ ASR 서비스에 연결할 수 없어 워커가 인식을 수행합니다 (재연결 시도)" << std::endl;
+    }
     
-    // Python 브릿지 초기화
-    sion::PythonProcessBridge pythonBridge(pythonPath, scriptPath);
-    if (!pythonBridge.start()) {
-        std::cerr << "[SION] ❌ Python 프로세스 시작 실패" << std::endl;
+    // 로컬 ASR (SION_LOCAL_ASR_MODEL 지정 시 짧은 명령과 원격 ASR 연결이 없을 때의 발화를 내장 whisper.cpp로 인식)
+    sion::LocalAsrConfig localAsrConfig;
+    if (const char* model = std::getenv("SION_LOCAL_ASR_MODEL")) {
+        localAsrConfig.modelPath = model;  // 예: "models/ggml-tiny-q5_1.bin"
+    }
+    if (const char* maxLocalMs = std::getenv("SION_LOCAL_ASR_MAX_MS")) {
+        localAsrConfig.maxLocalMs = std::atoi(maxLocalMs);  // 이보다 긴 받아쓰기는 원격 ASR
+    }
+    sion::LocalAsrEngine localAsr(localAsrConfig);
+    if (!localAsrConfig.modelPath.empty() && !localAsr.load()) {
+        std::cerr << "[SION] ⚠️ 로컬 ASR을 사용할 수 없어 원격 ASR만 사용합니다" << std::endl;
+    }
+    
+    // 반복 명령 응답 캐시 (SION_RESPONSE_CACHE 지정 시 재시작 후에도 유지)
+    sion::ResponseCacheConfig cacheConfig;
+    if (const char* cachePath = std::getenv("SION_RESPONSE_CACHE")) {
+        cacheConfig.path = cachePath;
+    }
+    if (const char* fingerprint = std::getenv("SION_CACHE_FINGERPRINT")) {
+        cacheConfig.fingerprint = std::string(fingerprint) == "1";
+    }
+    sion::ResponseCache responseCache(cacheConfig);
+    responseCache.load();
+    
+    // 발화 저널 (SION_JOURNAL_DIR 지정 시 녹음/지연/인식 결과를 세그먼트에 기록, file:<세그먼트>#<번호>로 재생)
+    sion::UtteranceJournalConfig journalConfig;
+    if (const char* journalDir = std::getenv("SION_JOURNAL_DIR")) {
+        journalConfig.directory = journalDir;
+    }
+    if (const char* journalMaxMb = std::getenv("SION_JOURNAL_MAX_MB")) {
+        journalConfig.maxBytes = static_cast<size_t>(std::max(1, std::atoi(journalMaxMb))) << 20;
+    }
+    sion::UtteranceJournal journal(journalConfig);
+    if (!journalConfig.directory.empty() && !journal.open()) {
+        std::cerr << "[SION] ⚠️ 발화 저널을 열 수 없어 기록하지 않습니다: " << journalConfig.directory << std::endl;
+    }
+    
+    // 캡처 세션 (장치마다 녹음 → 전송 → 결과 대기 파이프라인, 단계 작업은 공유 풀에서 겹쳐 실행)
+    sion::SessionManager sessions(sessionConfig, pythonWorkers, sharedAudio.isOpen() ? &sharedAudio : nullptr);
+    if (!sessions.start()) {
+        std::cerr << "[SION] ❌ 오디오 장치 초기화 실패" << std::endl;
         return 1;
     }
-    std::cout << "[SION] ✅ Python 브릿지 연결 완료" << std::endl;
+    std::cout << "[SION] ✅ 오디오 장치 " << sessions.size() << "개 초기화 완료" << std::endl;
+    
+    // ASR 업로드 크기를 줄이도록 압축 전송 (워커가 지원하지 않으면 발화별로 PCM)
+    const sion::protocol::AudioCodec preferredCodec =
+        sion::isCodecAvailable(sion::protocol::AudioCodec::Opus) ? sion::protocol::AudioCodec::Opus
+                                                                 : sion::protocol::AudioCodec::Flac;
+    sion::protocol::AudioCodec codec = preferredCodec;
+    // 중간 인식 결과로 NLU/작업 준비를 미리 시작 (ASR 직접 연결은 PCM으로 전송, SION_SPECULATIVE_NLU=0이면 끔)
+    const char* speculative = std::getenv("SION_SPECULATIVE_NLU");
+    const bool speculativeNlu = !speculative || std::string(speculative) != "0";
+    const bool multiSession = sessions.size() > 1;
+    sessions.forEachPipeline([&](sion::VoicePipeline& pipeline) {
+        codec = pipeline.setCodec(preferredCodec);
+        if (!asrConfig.url.empty()) {
+            pipeline.setAsrClient(&asrClient);
+            pipeline.setSpeculativeNlu(speculativeNlu);
+        }
+        if (localAsr.isLoaded()) {
+            pipeline.setLocalAsr(&localAsr);
+        }
+        pipeline.setResponseCache(&responseCache);
+        if (journal.isOpen()) {
+            pipeline.setJournal(&journal);
+        }
+        pipeline.setPartialCallback([](const std::string& partial) {
+            std::cout << "[SION] 💬 " << partial << std::endl;
+        });
+        pipeline.setResultCallback([multiSession](uint64_t requestId, const std::string& result) {
+            // 세션이 여럿이면 요청 ID 상위 비트의 세션을 함께 표시
+            const std::string label = multiSession
+                ? std::to_string(sion::protocol::sessionOfRequest(requestId)) + "/"
+                  + std::to_string(requestId & 0xFFFFFFFFu)
+                : std::to_string(requestId);
+            if (!result.empty()) {
+                std::cout << "[SION] 📝 결과 #" << label << ": " << result << std::endl;
+            } else {
+                std::cerr << "[SION] ❌ 요청 #" << label << " 처리 실패" << std::endl;
+            }
+        });
+    });
+    std::cout << "[SION] 🎚️ 전송 코덱: " << sion::protocol::audioCodecName(codec)
+              << (!asrConfig.url.empty() && speculativeNlu ? " (ASR 직접 연결은 추측 NLU용 PCM)" : "") << std::endl;
     
-    // 핫키 핸들러 초기화
-    sion::HotkeyHandler hotkeyHandler;
+    // 핫키는 첫 세션(첫 번째 장치)에서 녹음
+    sion::VoicePipeline& pipeline = sessions.pipeline(0);
+    
+    // 핫키 핸들러 초기화 (저수준 훅: 키 뗌 이벤트까지 받아 푸시투토크 지원)
+    sion::HotkeyHandler hotkeyHandler(sion::HotkeyBackend::LowLevelHook);
     
     // 활성화 핫키 등록 (Ctrl+Shift+S)
     int activateHotkeyId = hotkeyHandler.registerHotkey("ctrl+shift+s", [&]() {
+        const int64_t receivedAt = sion::trace::now();
         std::cout << "\n[SION] ⌨️ 핫키 감지: Ctrl+Shift+S" << std::endl;
-        handleVoiceCommand(audioCapture, pythonBridge);
+        // 요청만 넣고 즉시 반환하여 핫키 스레드를 막지 않음
+        const uint64_t requestId = pipeline.submit();
+        sion::trace::record(sion::trace::Stage::HotkeyReceived, requestId, receivedAt, sion::trace::now());
     });
     
     if (activateHotkeyId < 0) {
@@ -120,25 +292,100 @@ int main(int argc, char* argv[]) {
     }
     std::cout << "[SION] ✅ 핫키 등록 완료 (Ctrl+Shift+S)" << std::endl;
     
+    // 푸시투토크 핫키 등록 (Ctrl+Shift+Space: 누르는 동안만 녹음)
+    std::chrono::steady_clock::time_point holdStart;
+    int pushToTalkId = hotkeyHandler.registerPushToTalk("ctrl+shift+space", [&](const sion::HotkeyEvent& event) {
+        if (event.type == sion::KeyEventType::Pressed) {
+            holdStart = event.timestamp;
+            // 훅이 이벤트를 받은 시각부터 측정
+            const uint64_t requestId = pipeline.beginHold();
+            sion::trace::record(sion::trace::Stage::HotkeyReceived, requestId,
+                                sion::trace::toNanoseconds(event.timestamp), sion::trace::now());
+        } else if (pipeline.endHold()) {
+            const auto heldMs = std::chrono::duration_cast<std::chrono::milliseconds>(event.timestamp - holdStart);
+            std::cout << "[SION] ⌨️ 푸시투토크 " << heldMs.count() << " ms" << std::endl;
+        }
+    });
+    if (pushToTalkId >= 0) {
+        std::cout << "[SION] ✅ 푸시투토크 등록 완료 (Ctrl+Shift+Space)" << std::endl;
+    }
+    
     // 취소 핫키 등록 (Escape)
     int cancelHotkeyId = hotkeyHandler.registerHotkey("escape", [&]() {
         std::cout << "\n[SION] ⌨️ 취소 키 감지" << std::endl;
-        // TODO: 현재 진행 중인 작업 취소
+        // 녹음 중이면 스트림 중지, 처리 중이면 CANCEL 전송 (모두 즉시 반환)
+        if (sessions.cancelAll() == 0) {
+            std::cout << "[SION] 취소할 작업이 없습니다" << std::endl;
+        }
+    });
+    
+    // 지연 리포트 핫키 등록 (Ctrl+Shift+T: 구간별 p50/p95/p99)
+    hotkeyHandler.registerHotkey("ctrl+shift+t", [&]() {
+        sion::trace::printReport(std::cout);
+    });
+    
+    // 웨이크워드 검출 시 해당 세션에서 핫키와 같은 파이프라인 실행
+    if (sessions.startWakeWord([&](size_t session, float score) {
+            const int64_t receivedAt = sion::trace::now();
+            std::cout << "\n[SION] 🗣️ 웨이크워드 감지 (세션 " << sessions.sessionId(session) << ", " << score << ")" << std::endl;
+            const uint64_t requestId = sessions.pipeline(session).submit();
+            sion::trace::record(sion::trace::Stage::HotkeyReceived, requestId, receivedAt, sion::trace::now());
+        })) {
+        std::cout << "[SION] ✅ 웨이크워드 검출 시작 (세션 " << sessions.wakeWordSessions() << "개)" << std::endl;
+    } else if (!sessionConfig.wakeWord.modelPath.empty()) {
+        std::cerr << "[SION] ⚠️ 웨이크워드를 사용할 수 없어 핫키로만 동작합니다" << std::endl;
+    }
+    
+    // 메트릭 내보내기 (SION_METRICS_PORT 지정 시 127.0.0.1:<포트>/metrics로 Prometheus 스크레이프)
+    sion::metrics::MetricsServerConfig metricsConfig;
+    if (const char* metricsPort = std::getenv("SION_METRICS_PORT")) {
+        metricsConfig.port = static_cast<uint16_t>(std::atoi(metricsPort));
+    }
+    if (const char* metricsBind = std::getenv("SION_METRICS_BIND")) {
+        metricsConfig.bindAddress = metricsBind;  // 예: "0.0.0.0" (기본은 로컬에서만)
+    }
+    sion::metrics::MetricsServer metricsServer(metricsConfig);
+    // 게이지는 스크레이프 때만 모음 (파이프라인/워커 경로에는 비용 없음)
+    metricsServer.addCollector([&]() {
+        size_t inFlight = 0;
+        sessions.forEachPipeline([&](sion::VoicePipeline& session) { inFlight += session.inFlight(); });
+        sion::metrics::setGauge(sion::metrics::Gauge::PipelineInFlight, static_cast<int64_t>(inFlight));
+        sion::metrics::setGauge(sion::metrics::Gauge::BridgePendingRequests,
+                                static_cast<int64_t>(pythonWorkers.pendingRequests()));
+        sion::metrics::setGauge(sion::metrics::Gauge::WorkersReady, static_cast<int64_t>(pythonWorkers.readyWorkers()));
+        sion::metrics::setGauge(sion::metrics::Gauge::AsrConnected, asrClient.isConnected() ? 1 : 0);
     });
+    if (metricsConfig.port != 0 && !metricsServer.start()) {
+        std::cerr << "[SION] ⚠️ 메트릭 포트를 열 수 없어 내보내지 않습니다: " << metricsConfig.port << std::endl;
+    }
     
     std::cout << "\n[SION] 🚀 대기 중... (Ctrl+Shift+S로 음성 명령)" << std::endl;
     std::cout << "[SION] 종료하려면 Ctrl+C를 누르세요." << std::endl;
     std::cout << "----------------------------------------" << std::endl;
     
-    // 핫키 리스너 시작 (블로킹)
-    while (g_running) {
-        hotkeyHandler.startListening();
-    }
+    // 핫키 리스너 시작 (블로킹, 종료 요청 시 즉시 반환)
+    hotkeyHandler.startListening(&g_shutdown);
     
     // 정리
     std::cout << "\n[SION] 정리 중..." << std::endl;
     hotkeyHandler.unregisterAllHotkeys();
-    pythonBridge.stop();
+    metricsServer.stop();
+    sessions.shutdown();
+    localAsr.stop();
+    journal.close();
+    if (!cacheConfig.path.empty() && !responseCache.save()) {
+        std::cerr << "[SION] ⚠️ 응답 캐시 저장 실패: " << cacheConfig.path << std::endl;
+    }
+    asrClient.stop();
+    pythonWorkers.stop();
+    
+    // 지연 리포트 (SION_TRACE_FILE 지정 시 Chrome trace JSON도 저장)
+    sion::trace::printReport(std::cout);
+    if (const char* tracePath = std::getenv("SION_TRACE_FILE")) {
+        if (sion::trace::writeChromeTrace(tracePath)) {
+            std::cout << "[SION] 지연 trace 저장: " << tracePath << std::endl;
+        }
+    }
     
     std::cout << "[SION] 👋 종료 완료" << std::endl;
     return 0;
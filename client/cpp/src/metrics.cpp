@@ -0,0 +1,467 @@
+/**
+ * @file metrics.cpp
+ * @brief 게이지/고정 버킷 분포와 Prometheus 스크레이프 서버 구현
+ */
+
+#include "metrics.h"
+#include "latency_trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace sion {
+namespace metrics {
+
+namespace {
+
+constexpr const char* kGaugeNames[kGaugeCount] = {
+    "pipeline-in-flight",
+    "bridge-pending-requests",
+    "workers-ready",
+    "asr-connected",
+};
+
+constexpr const char* kHistogramNames[kHistogramCount] = {
+    "vad-utterance",
+    "vad-trimmed",
+};
+
+// 발화 길이 분포 (ms): 짧은 명령 ~ 최대 녹음 길이
+const std::vector<double> kHistogramBoundsMs = {50, 100, 250, 500, 1000, 2000, 3000, 5000, 10000, 20000, 30000};
+
+// 구간 지연 분포 (ms): 프레임/전송 단위 ~ 발화 전체
+const std::vector<double> kStageBoundsMs = {1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+
+constexpr size_t kMaxBuckets = 16;
+
+// 스크레이프 요청 헤더 상한과 읽기 제한 시간
+constexpr size_t kMaxRequestSize = 4 * 1024;
+constexpr int kRequestTimeoutMs = 1000;
+
+/**
+ * @brief 분포 하나 (버킷은 +Inf 포함, 합계는 µs 정수로 원자 덧셈)
+ */
+struct HistogramData {
+    std::atomic<uint64_t> buckets[kMaxBuckets] = {};
+    std::atomic<uint64_t> sumMicros{0};
+};
+
+std::atomic<int64_t> g_gauges[kGaugeCount] = {};
+HistogramData g_histograms[kHistogramCount];
+
+/**
+ * @brief "first-frame" → "first_frame" (Prometheus 이름 규칙)
+ */
+std::string metricName(const char* name) {
+    std::string result = name;
+    std::replace(result.begin(), result.end(), '-', '_');
+    return result;
+}
+
+void writeHistogram(std::ostream& out, const std::string& name, const std::string& labels,
+                    const std::vector<double>& boundsMs, const std::vector<uint64_t>& cumulative,
+                    uint64_t count, double sumMs) {
+    const std::string prefix = labels.empty() ? "{" : "{" + labels + ",";
+    for (size_t k = 0; k < boundsMs.size(); ++k) {
+        out << name << "_bucket" << prefix << "le=\"" << boundsMs[k] / 1000.0 << "\"} " << cumulative[k] << '\n';
+    }
+    out << name << "_bucket" << prefix << "le=\"+Inf\"} " << count << '\n';
+    const std::string suffix = labels.empty() ? "" : "{" + labels + "}";
+    out << name << "_sum" << suffix << ' ' << sumMs / 1000.0 << '\n';
+    out << name << "_count" << suffix << ' ' << count << '\n';
+}
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+const NativeSocket kInvalidSocket = INVALID_SOCKET;
+constexpr int kSendFlags = 0;
+
+#ifndef WSA_FLAG_NO_HANDLE_INHERIT
+#define WSA_FLAG_NO_HANDLE_INHERIT 0x80
+#endif
+
+// 이후 띄우는 워커가 포트를 물려받지 않도록 상속 불가로 생성 (::socket()은 기본이 상속 가능)
+NativeSocket openSocket(int family, int type, int protocol) {
+    return ::WSASocketW(family, type, protocol, nullptr, 0, WSA_FLAG_OVERLAPPED | WSA_FLAG_NO_HANDLE_INHERIT);
+}
+
+void closeNativeSocket(NativeSocket socket) {
+    ::closesocket(socket);
+}
+
+void setReceiveTimeout(NativeSocket socket, int timeoutMs) {
+    const DWORD ms = static_cast<DWORD>(timeoutMs);
+    ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&ms), sizeof(ms));
+}
+
+bool initializeSockets() {
+    static const bool initialized = [] {
+        WSADATA data;
+        return ::WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return initialized;
+}
+#else
+using NativeSocket = int;
+const NativeSocket kInvalidSocket = -1;
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;   // 수집기가 먼저 끊어도 SIGPIPE 대신 EPIPE
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+#ifdef SOCK_CLOEXEC
+constexpr int kSocketTypeFlags = SOCK_CLOEXEC;  // 이후 띄우는 워커가 포트를 물려받지 않도록
+#else
+constexpr int kSocketTypeFlags = 0;             // macOS: 워커 spawn이 POSIX_SPAWN_CLOEXEC_DEFAULT
+#endif
+
+NativeSocket openSocket(int family, int type, int protocol) {
+    return ::socket(family, type | kSocketTypeFlags, protocol);
+}
+
+void closeNativeSocket(NativeSocket socket) {
+    ::close(socket);
+}
+
+bool setNonBlocking(NativeSocket socket, bool enabled) {
+    const int flags = ::fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(socket, F_SETFL, enabled ? flags | O_NONBLOCK : flags & ~O_NONBLOCK) == 0;
+}
+
+// stop() 깨우기 파이프 (이후 띄우는 워커에 상속되지 않도록 close-on-exec)
+bool createWakePipe(int fds[2]) {
+#if defined(__APPLE__)
+    // pipe2 없음: 워커 spawn이 POSIX_SPAWN_CLOEXEC_DEFAULT라 fcntl 전의 틈에도 새지 않음
+    if (::pipe(fds) != 0) {
+        return false;
+    }
+    ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#else
+    return ::pipe2(fds, O_CLOEXEC) == 0;
+#endif
+}
+
+void setReceiveTimeout(NativeSocket socket, int timeoutMs) {
+    timeval tv{};
+    tv.tv_sec = static_cast<time_t>(timeoutMs / 1000);
+    tv.tv_usec = static_cast<suseconds_t>((timeoutMs % 1000) * 1000);
+    ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+bool initializeSockets() {
+    return true;
+}
+#endif
+
+NativeSocket toNative(intptr_t socket) {
+    return static_cast<NativeSocket>(socket);
+}
+
+bool sendAll(NativeSocket socket, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const int n = static_cast<int>(::send(socket, data.data() + sent,
+                                              static_cast<int>(data.size() - sent), kSendFlags));
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief IPv4 주소 (bindAddress가 비었거나 "0.0.0.0"이면 모든 인터페이스)
+ */
+bool makeAddress(const std::string& host, uint16_t port, sockaddr_in& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (host.empty()) {
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        return true;
+    }
+    return ::inet_pton(AF_INET, host.c_str(), &address.sin_addr) == 1;
+}
+
+} // namespace
+
+const char* gaugeName(Gauge gauge) {
+    const size_t index = static_cast<size_t>(gauge);
+    return index < kGaugeCount ? kGaugeNames[index] : "unknown";
+}
+
+void setGauge(Gauge gauge, int64_t value) {
+    if (gauge < Gauge::Count) {
+        g_gauges[static_cast<size_t>(gauge)].store(value, std::memory_order_relaxed);
+    }
+}
+
+int64_t gaugeValue(Gauge gauge) {
+    if (gauge >= Gauge::Count) {
+        return 0;
+    }
+    return g_gauges[static_cast<size_t>(gauge)].load(std::memory_order_relaxed);
+}
+
+const char* histogramName(Histogram histogram) {
+    const size_t index = static_cast<size_t>(histogram);
+    return index < kHistogramCount ? kHistogramNames[index] : "unknown";
+}
+
+const std::vector<double>& histogramBoundsMs() {
+    return kHistogramBoundsMs;
+}
+
+void observe(Histogram histogram, double valueMs) {
+    if (histogram >= Histogram::Count || !trace::isEnabled()) {
+        return;
+    }
+    HistogramData& data = g_histograms[static_cast<size_t>(histogram)];
+    const size_t bucket = static_cast<size_t>(
+        std::lower_bound(kHistogramBoundsMs.begin(), kHistogramBoundsMs.end(), valueMs) - kHistogramBoundsMs.begin());
+    data.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    data.sumMicros.fetch_add(static_cast<uint64_t>(std::max(0.0, valueMs) * 1000.0), std::memory_order_relaxed);
+}
+
+void writePrometheus(std::ostream& out) {
+    for (size_t c = 0; c < trace::kCounterCount; ++c) {
+        const auto counter = static_cast<trace::Counter>(c);
+        const std::string name = "sion_" + metricName(trace::counterName(counter)) + "_total";
+        out << "# TYPE " << name << " counter\n" << name << ' ' << trace::counterValue(counter) << '\n';
+    }
+
+    for (size_t g = 0; g < kGaugeCount; ++g) {
+        const auto gauge = static_cast<Gauge>(g);
+        const std::string name = "sion_" + metricName(gaugeName(gauge));
+        out << "# TYPE " << name << " gauge\n" << name << ' ' << gaugeValue(gauge) << '\n';
+    }
+
+    for (size_t h = 0; h < kHistogramCount; ++h) {
+        const HistogramData& data = g_histograms[h];
+        std::vector<uint64_t> cumulative(kHistogramBoundsMs.size(), 0);
+        uint64_t count = 0;
+        for (size_t k = 0; k <= kHistogramBoundsMs.size(); ++k) {
+            count += data.buckets[k].load(std::memory_order_relaxed);
+            if (k < cumulative.size()) {
+                cumulative[k] = count;
+            }
+        }
+        const std::string name = "sion_" + metricName(histogramName(static_cast<Histogram>(h))) + "_seconds";
+        out << "# TYPE " << name << " histogram\n";
+        writeHistogram(out, name, "", kHistogramBoundsMs, cumulative, count,
+                       data.sumMicros.load(std::memory_order_relaxed) / 1000.0);
+    }
+
+    // 구간 지연은 trace 히스토그램을 그대로 사용 (기록 경로에 비용 추가 없음)
+    out << "# TYPE sion_stage_duration_seconds histogram\n";
+    for (const trace::StageDistribution& stage : trace::distributions(kStageBoundsMs)) {
+        if (stage.count == 0) {
+            continue;
+        }
+        writeHistogram(out, "sion_stage_duration_seconds",
+                       std::string("stage=\"") + trace::stageName(stage.stage) + "\"",
+                       kStageBoundsMs, stage.cumulative, stage.count, stage.sumMs);
+    }
+}
+
+MetricsServer::MetricsServer(MetricsServerConfig config)
+    : m_config(std::move(config))
+    , m_listener(-1)
+#ifndef _WIN32
+    , m_wakeFds{-1, -1}
+#endif
+    , m_stopping(false)
+{
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+void MetricsServer::addCollector(Collector collector) {
+    m_collectors.push_back(std::move(collector));
+}
+
+bool MetricsServer::start() {
+    if (m_thread.joinable() || m_config.port == 0 || !initializeSockets()) {
+        return false;
+    }
+
+    sockaddr_in address{};
+    const std::string host = m_config.bindAddress == "0.0.0.0" ? std::string() : m_config.bindAddress;
+    if (!makeAddress(host, m_config.port, address)) {
+        std::cerr << "[MetricsServer] 잘못된 주소: " << m_config.bindAddress << std::endl;
+        return false;
+    }
+
+    const NativeSocket listener = openSocket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listener == kInvalidSocket) {
+        return false;
+    }
+    // 재시작 직후 TIME_WAIT 포트도 다시 열 수 있도록
+    int reuse = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listener, 4) != 0) {
+        std::cerr << "[MetricsServer] 포트를 열 수 없습니다: " << m_config.bindAddress << ":" << m_config.port
+                  << std::endl;
+        closeNativeSocket(listener);
+        return false;
+    }
+
+#ifndef _WIN32
+    // 리스너는 논블로킹 (poll 뒤 연결이 사라져도 accept에서 멈추지 않음) + 깨우기 파이프
+    if (!setNonBlocking(listener, true) || !createWakePipe(m_wakeFds)) {
+        std::cerr << "[MetricsServer] 서버 설정 실패: " << std::strerror(errno) << std::endl;
+        closeNativeSocket(listener);
+        return false;
+    }
+#endif
+
+    m_listener = static_cast<intptr_t>(listener);
+    m_stopping = false;
+    m_thread = std::thread(&MetricsServer::run, this);
+    std::cout << "[MetricsServer] 메트릭 내보내기: http://" << m_config.bindAddress << ":" << m_config.port
+              << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+
+    // 네트워크 상태와 무관하게 깨움 (자기 자신에 connect하는 방식은 실패하면 종료가 멈춤)
+    m_stopping = true;
+#ifdef _WIN32
+    // 리스너를 닫으면 진행 중인 accept()가 즉시 실패로 돌아옴
+    closeNativeSocket(toNative(m_listener));
+    m_thread.join();
+#else
+    const char wake = 1;
+    while (::write(m_wakeFds[1], &wake, 1) < 0 && errno == EINTR) {
+    }
+    m_thread.join();
+    closeNativeSocket(toNative(m_listener));
+    for (int& fd : m_wakeFds) {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+    m_listener = -1;
+}
+
+void MetricsServer::run() {
+    while (!m_stopping) {
+#ifdef _WIN32
+        const NativeSocket client = ::accept(toNative(m_listener), nullptr, nullptr);
+        if (client != kInvalidSocket) {
+            SetHandleInformation(reinterpret_cast<HANDLE>(client), HANDLE_FLAG_INHERIT, 0);
+        }
+        if (client == kInvalidSocket) {
+#else
+        // 새 연결 또는 stop()의 깨우기를 기다림 (주기적 깨어남 없음)
+        pollfd fds[2] = {{toNative(m_listener), POLLIN, 0}, {m_wakeFds[0], POLLIN, 0}};
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "[MetricsServer] poll 실패, 내보내기를 중단합니다" << std::endl;
+            break;
+        }
+        if (fds[1].revents != 0) {
+            break;
+        }
+#ifdef __linux__
+        const NativeSocket client = ::accept4(toNative(m_listener), nullptr, nullptr, SOCK_CLOEXEC);
+#else
+        const NativeSocket client = ::accept(toNative(m_listener), nullptr, nullptr);
+#endif
+        if (client == kInvalidSocket) {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNABORTED) {
+                continue;
+            }
+#endif
+            if (!m_stopping) {
+                std::cerr << "[MetricsServer] accept 실패, 내보내기를 중단합니다" << std::endl;
+            }
+            break;
+        }
+#ifndef _WIN32
+        // BSD 계열은 리스너의 O_NONBLOCK을 물려주므로 응답은 블로킹 소켓으로 (수신 제한 시간 적용)
+        setNonBlocking(client, false);
+#endif
+        if (!m_stopping) {
+            serve(static_cast<intptr_t>(client));
+        }
+        closeNativeSocket(client);
+    }
+}
+
+void MetricsServer::serve(intptr_t client) {
+    const NativeSocket socket = toNative(client);
+    setReceiveTimeout(socket, kRequestTimeoutMs);
+
+    // 요청 줄과 헤더만 읽음 (본문이 있는 요청은 받지 않음)
+    std::string request;
+    char chunk[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequestSize) {
+        const int n = static_cast<int>(::recv(socket, chunk, sizeof(chunk), 0));
+        if (n <= 0) {
+            return;
+        }
+        request.append(chunk, static_cast<size_t>(n));
+    }
+
+    const bool isMetrics = request.compare(0, 13, "GET /metrics ") == 0
+                        || request.compare(0, 13, "GET /metrics?") == 0;
+    std::string body;
+    std::string status = "200 OK";
+    if (isMetrics) {
+        for (const Collector& collector : m_collectors) {
+            collector();
+        }
+        std::ostringstream out;
+        writePrometheus(out);
+        body = out.str();
+    } else {
+        status = "404 Not Found";
+        body = "GET /metrics\n";
+    }
+
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << "\r\n"
+             << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+    sendAll(socket, response.str());
+}
+
+} // namespace metrics
+} // namespace sion
@@ -0,0 +1,551 @@
+/**
+ * @file pipe_channel.cpp
+ * @brief PipeChannel 클래스 구현 (IOCP / epoll)
+ */
+
+#include "pipe_channel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+namespace sion {
+
+namespace {
+
+// 한 번의 읽기 요청 크기
+constexpr size_t kReadChunkSize = 64 * 1024;
+
+// 수신 버퍼 앞부분을 정리하는 기준 (소비된 바이트)
+constexpr size_t kCompactThreshold = 256 * 1024;
+
+#ifdef _WIN32
+constexpr ULONG_PTR kWriteKey = 1;
+constexpr ULONG_PTR kReadKey = 2;
+constexpr ULONG_PTR kWakeKey = 3;
+#else
+// 한 번의 writev로 내보낼 최대 프레임 수
+constexpr int kMaxIov = 16;
+
+bool setNonBlocking(int fd) {
+    const int flags = ::fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// 깨우기 파이프 (논블로킹, 이후 띄우는 워커에 상속되지 않도록 생성 시 close-on-exec)
+bool createWakePipe(int fds[2]) {
+#if defined(__APPLE__)
+    // pipe2 없음: 워커 spawn이 POSIX_SPAWN_CLOEXEC_DEFAULT라 fcntl 전의 틈에도 새지 않음
+    if (::pipe(fds) != 0) {
+        return false;
+    }
+    ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return setNonBlocking(fds[0]) && setNonBlocking(fds[1]);
+#else
+    return ::pipe2(fds, O_CLOEXEC | O_NONBLOCK) == 0;
+#endif
+}
+
+// 상대가 먼저 종료해도 write가 프로세스를 끝내지 않도록 호출 스레드에서만 SIGPIPE 차단
+// (프로세스 전체의 시그널 처리는 호스트 애플리케이션 몫이라 건드리지 않음)
+void blockSigpipeOnThisThread() {
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+}
+
+// EPIPE와 함께 이 스레드에 보류된 SIGPIPE 회수 (차단이 풀릴 때 전달되지 않도록)
+void consumePendingSigpipe() {
+    sigset_t pending;
+    sigemptyset(&pending);
+    if (sigpending(&pending) != 0 || !sigismember(&pending, SIGPIPE)) {
+        return;
+    }
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPIPE);
+    int signal = 0;
+    sigwait(&set, &signal);
+}
+#endif
+
+} // namespace
+
+PipeChannel::PipeChannel()
+#ifdef _WIN32
+    : m_writeHandle(nullptr)
+    , m_readHandle(nullptr)
+#else
+    : m_writeHandle(-1)
+    , m_readHandle(-1)
+#endif
+    , m_open(false)
+    , m_stopping(false)
+    , m_queuedBytes(0)
+    , m_readChunk(kReadChunkSize)
+    , m_readOffset(0)
+#ifdef _WIN32
+    , m_port(nullptr)
+#else
+    , m_pollFd(-1)
+    , m_wakeFds{-1, -1}
+#endif
+{
+    m_spareBuffers.reserve(kMaxSpareBuffers);
+}
+
+PipeChannel::~PipeChannel() {
+    close();
+}
+
+bool PipeChannel::open(NativeHandle writeHandle, NativeHandle readHandle,
+                       FrameHandler onFrame, CloseHandler onClose) {
+    if (m_ioThread.joinable()) {
+        return false;
+    }
+
+    m_writeHandle = writeHandle;
+    m_readHandle = readHandle;
+    m_onFrame = std::move(onFrame);
+    m_onClose = std::move(onClose);
+    m_readBuffer.clear();
+    m_readOffset = 0;
+
+#ifdef _WIN32
+    // 두 핸들을 같은 완료 포트에 연결 (키로 구분)
+    m_port = CreateIoCompletionPort(static_cast<HANDLE>(writeHandle), nullptr, kWriteKey, 1);
+    if (!m_port || !CreateIoCompletionPort(static_cast<HANDLE>(readHandle),
+                                           static_cast<HANDLE>(m_port), kReadKey, 0)) {
+        std::cerr << "[PipeChannel] I/O 완료 포트 생성 실패: " << GetLastError() << std::endl;
+        close();
+        return false;
+    }
+#else
+    if (!setNonBlocking(writeHandle) || !setNonBlocking(readHandle) ||
+        !createWakePipe(m_wakeFds)) {
+        std::cerr << "[PipeChannel] 파이프 설정 실패: " << std::strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+#ifdef __linux__
+    m_pollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event readEvent = {};
+    readEvent.events = EPOLLIN;
+    readEvent.data.fd = readHandle;
+    struct epoll_event wakeEvent = {};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.fd = m_wakeFds[0];
+    if (m_pollFd < 0 ||
+        ::epoll_ctl(m_pollFd, EPOLL_CTL_ADD, readHandle, &readEvent) != 0 ||
+        ::epoll_ctl(m_pollFd, EPOLL_CTL_ADD, m_wakeFds[0], &wakeEvent) != 0) {
+        std::cerr << "[PipeChannel] epoll 설정 실패: " << std::strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+#endif
+#endif
+
+    m_stopping = false;
+    m_open = true;
+    m_ioThread = std::thread(&PipeChannel::ioLoop, this);
+    return true;
+}
+
+void PipeChannel::close() {
+    if (m_ioThread.joinable()) {
+        m_stopping = true;
+        wake();
+        m_ioThread.join();
+    }
+
+#ifdef _WIN32
+    for (void** handle : {&m_writeHandle, &m_readHandle, &m_port}) {
+        if (*handle) {
+            CloseHandle(static_cast<HANDLE>(*handle));
+            *handle = nullptr;
+        }
+    }
+#else
+    for (int* fd : {&m_writeHandle, &m_readHandle, &m_pollFd, &m_wakeFds[0], &m_wakeFds[1]}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+#endif
+
+    m_open = false;
+}
+
+bool PipeChannel::send(const protocol::FrameHeader& header, const void* payload, size_t size,
+                       Clock::time_point deadline) {
+    if (size > protocol::kMaxPayloadSize) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+
+    // 상대가 읽지 않아 큐가 가득 차면 마감 시각까지만 대기
+    if (!m_spaceCv.wait_until(lock, deadline, [this] {
+            return !m_open || m_queuedBytes < kMaxQueuedBytes;
+        })) {
+        std::cerr << "[PipeChannel] 송신 시간 초과 (미전송 " << m_queuedBytes << " bytes)" << std::endl;
+        return false;
+    }
+    if (!m_open) {
+        return false;
+    }
+
+    protocol::FrameHeader encodedHeader = header;
+    encodedHeader.payloadSize = static_cast<uint32_t>(size);
+
+    OutgoingFrame frame;
+    if (!m_spareBuffers.empty()) {
+        frame.bytes = std::move(m_spareBuffers.back());
+        m_spareBuffers.pop_back();
+    }
+    frame.bytes.resize(protocol::kHeaderSize + size);
+    protocol::encodeHeader(encodedHeader, frame.bytes.data());
+    if (size > 0) {
+        std::memcpy(frame.bytes.data() + protocol::kHeaderSize, payload, size);
+    }
+
+    m_queuedBytes += frame.bytes.size();
+    m_queue.push_back(std::move(frame));
+    lock.unlock();
+
+    wake();
+    return true;
+}
+
+size_t PipeChannel::queuedBytes() const {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_queuedBytes;
+}
+
+void PipeChannel::ioLoop() {
+#ifdef _WIN32
+    HANDLE port = static_cast<HANDLE>(m_port);
+    HANDLE readHandle = static_cast<HANDLE>(m_readHandle);
+    HANDLE writeHandle = static_cast<HANDLE>(m_writeHandle);
+
+    OVERLAPPED readOv;
+    OVERLAPPED writeOv;
+    bool readPending = false;
+    bool writePending = false;
+
+    auto issueRead = [&]() -> bool {
+        ZeroMemory(&readOv, sizeof(readOv));
+        if (!ReadFile(readHandle, m_readChunk.data(), static_cast<DWORD>(m_readChunk.size()),
+                      nullptr, &readOv) && GetLastError() != ERROR_IO_PENDING) {
+            return false;
+        }
+        readPending = true;
+        return true;
+    };
+
+    auto issueWrite = [&]() -> bool {
+        const uint8_t* data = nullptr;
+        DWORD size = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (m_queue.empty()) {
+                return true;
+            }
+            // deque의 push_back은 기존 원소를 옮기지 않으므로 락 밖에서도 유효
+            const OutgoingFrame& front = m_queue.front();
+            data = front.bytes.data() + front.offset;
+            size = static_cast<DWORD>(front.bytes.size() - front.offset);
+        }
+
+        ZeroMemory(&writeOv, sizeof(writeOv));
+        if (!WriteFile(writeHandle, data, size, nullptr, &writeOv) &&
+            GetLastError() != ERROR_IO_PENDING) {
+            return false;
+        }
+        writePending = true;
+        return true;
+    };
+
+    bool failed = !issueRead();
+    while (!failed && !m_stopping) {
+        if (!writePending && !issueWrite()) {
+            failed = true;
+            break;
+        }
+
+        DWORD bytes = 0;
+        ULONG_PTR key = 0;
+        OVERLAPPED* ov = nullptr;
+        const BOOL ok = GetQueuedCompletionStatus(port, &bytes, &key, &ov, INFINITE);
+
+        if (ov == nullptr) {
+            failed = !ok;   // wake() 패킷이면 ok
+            continue;
+        }
+
+        if (ov == &readOv) {
+            readPending = false;
+            if (!ok || bytes == 0) {
+                failed = true;   // ERROR_BROKEN_PIPE: 상대 종료
+                break;
+            }
+            m_readBuffer.insert(m_readBuffer.end(), m_readChunk.begin(), m_readChunk.begin() + bytes);
+            failed = !dispatchFrames() || !issueRead();
+        } else if (ov == &writeOv) {
+            writePending = false;
+            if (!ok) {
+                failed = true;
+                break;
+            }
+            consumeWritten(bytes);
+        }
+    }
+
+    // 버퍼를 해제하기 전에 진행 중인 overlapped 작업을 취소하고 완료 패킷 회수
+    if (readPending) {
+        CancelIoEx(readHandle, &readOv);
+    }
+    if (writePending) {
+        CancelIoEx(writeHandle, &writeOv);
+    }
+    while (readPending || writePending) {
+        DWORD bytes = 0;
+        ULONG_PTR key = 0;
+        OVERLAPPED* ov = nullptr;
+        if (!GetQueuedCompletionStatus(port, &bytes, &key, &ov, INFINITE) && ov == nullptr) {
+            break;
+        }
+        if (ov == &readOv) {
+            readPending = false;
+        } else if (ov == &writeOv) {
+            writePending = false;
+        }
+    }
+#else
+    // 송신(writev)은 이 스레드에서만 하므로 여기서 SIGPIPE를 막으면 EPIPE로 받음
+    blockSigpipeOnThisThread();
+
+    bool failed = false;
+#ifdef __linux__
+    bool writeArmed = false;
+#endif
+
+    while (!failed && !m_stopping) {
+        // 송신 큐를 가능한 만큼 writev (여러 프레임을 한 번의 시스템 콜로)
+        bool wantWrite = false;
+        {
+            struct iovec iov[kMaxIov];
+            int iovCount = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                for (const OutgoingFrame& frame : m_queue) {
+                    if (iovCount == kMaxIov) {
+                        break;
+                    }
+                    // deque의 push_back은 기존 원소를 옮기지 않으므로 락 밖에서도 유효
+                    iov[iovCount].iov_base = const_cast<uint8_t*>(frame.bytes.data() + frame.offset);
+                    iov[iovCount].iov_len = frame.bytes.size() - frame.offset;
+                    ++iovCount;
+                }
+            }
+
+            if (iovCount > 0) {
+                const ssize_t written = ::writev(m_writeHandle, iov, iovCount);
+                if (written > 0) {
+                    consumeWritten(static_cast<size_t>(written));
+                } else if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    const int error = errno;
+                    if (error == EPIPE) {
+                        consumePendingSigpipe();
+                    }
+                    std::cerr << "[PipeChannel] 송신 실패: " << std::strerror(error) << std::endl;
+                    break;
+                }
+
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                wantWrite = !m_queue.empty();
+            }
+        }
+
+        bool readable = false;
+        bool woken = false;
+
+#ifdef __linux__
+        // 파이프가 가득 찼을 때만 EPOLLOUT 등록 (항상 등록하면 바쁜 루프)
+        if (wantWrite != writeArmed) {
+            struct epoll_event writeEvent = {};
+            writeEvent.events = EPOLLOUT;
+            writeEvent.data.fd = m_writeHandle;
+            ::epoll_ctl(m_pollFd, wantWrite ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, m_writeHandle, &writeEvent);
+            writeArmed = wantWrite;
+        }
+
+        struct epoll_event events[3];
+        const int count = ::epoll_wait(m_pollFd, events, 3, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.fd == m_readHandle) {
+                readable = true;
+            } else if (events[i].data.fd == m_wakeFds[0]) {
+                woken = true;
+            }
+            // 송신 fd: 다음 반복에서 writev
+        }
+#else
+        struct pollfd fds[3] = {
+            {m_wakeFds[0], POLLIN, 0},
+            {m_readHandle, POLLIN, 0},
+            {m_writeHandle, POLLOUT, 0},
+        };
+        if (::poll(fds, wantWrite ? 3 : 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        woken = fds[0].revents != 0;
+        readable = fds[1].revents != 0;
+#endif
+
+        if (woken) {
+            char drain[64];
+            while (::read(m_wakeFds[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+
+        if (readable) {
+            // 부분 읽기를 누적하고 EAGAIN까지 읽음, 0은 상대 종료
+            while (true) {
+                const ssize_t n = ::read(m_readHandle, m_readChunk.data(), m_readChunk.size());
+                if (n > 0) {
+                    m_readBuffer.insert(m_readBuffer.end(), m_readChunk.begin(), m_readChunk.begin() + n);
+                    continue;
+                }
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    failed = true;
+                }
+                break;
+            }
+            if (!dispatchFrames()) {
+                failed = true;
+            }
+        }
+    }
+#endif
+
+    markClosed();
+}
+
+bool PipeChannel::dispatchFrames() {
+    while (m_readBuffer.size() - m_readOffset >= protocol::kHeaderSize) {
+        protocol::FrameHeader header;
+        if (!protocol::decodeHeader(m_readBuffer.data() + m_readOffset, header)) {
+            std::cerr << "[PipeChannel] 잘못된 프레임 헤더 수신" << std::endl;
+            return false;
+        }
+
+        const size_t frameSize = protocol::kHeaderSize + header.payloadSize;
+        if (m_readBuffer.size() - m_readOffset < frameSize) {
+            break;   // 페이로드가 아직 다 오지 않음
+        }
+
+        const char* payloadBegin = reinterpret_cast<const char*>(
+            m_readBuffer.data() + m_readOffset + protocol::kHeaderSize);
+        std::string payload(payloadBegin, header.payloadSize);
+        m_readOffset += frameSize;
+
+        if (m_onFrame) {
+            m_onFrame(header, payload);
+        }
+    }
+
+    if (m_readOffset == m_readBuffer.size()) {
+        m_readBuffer.clear();
+        m_readOffset = 0;
+    } else if (m_readOffset >= kCompactThreshold) {
+        m_readBuffer.erase(m_readBuffer.begin(), m_readBuffer.begin() + m_readOffset);
+        m_readOffset = 0;
+    }
+    return true;
+}
+
+void PipeChannel::consumeWritten(size_t written) {
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queuedBytes -= written;
+        while (written > 0 && !m_queue.empty()) {
+            OutgoingFrame& front = m_queue.front();
+            const size_t n = std::min(written, front.bytes.size() - front.offset);
+            front.offset += n;
+            written -= n;
+            if (front.offset == front.bytes.size()) {
+                if (m_spareBuffers.size() < kMaxSpareBuffers) {
+                    m_spareBuffers.push_back(std::move(front.bytes));
+                }
+                m_queue.pop_front();
+            }
+        }
+    }
+    m_spaceCv.notify_all();
+}
+
+void PipeChannel::wake() {
+#ifdef _WIN32
+    if (m_port) {
+        PostQueuedCompletionStatus(static_cast<HANDLE>(m_port), 0, kWakeKey, nullptr);
+    }
+#else
+    if (m_wakeFds[1] >= 0) {
+        const char byte = 1;
+        // 이미 깨울 바이트가 쌓여 있으면 EAGAIN이어도 무방
+        [[maybe_unused]] ssize_t n = ::write(m_wakeFds[1], &byte, 1);
+    }
+#endif
+}
+
+void PipeChannel::markClosed() {
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_open = false;
+        m_queue.clear();
+        m_queuedBytes = 0;
+    }
+    m_spaceCv.notify_all();
+
+    if (m_onClose) {
+        m_onClose();
+    }
+}
+
+} // namespace sion
@@ -4,17 +4,29 @@
  */
 
 #include "python_bridge.h"
+#include "audio_encoder.h"
+#include "cancellation_token.h"
+#include "json_util.h"
+#include "latency_trace.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <cstring>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <windows.h>
+#include <cstdio>
 #else
-#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <spawn.h>
 #include <sys/wait.h>
-#include <signal.h>
+#include <thread>
+#include <unistd.h>
+
+extern char** environ;
 #endif
 
 #ifdef PYTHON_ENABLED
@@ -23,13 +35,147 @@
 
 namespace sion {
 
+namespace {
+
+// 일괄 전송 시 한 AUDIO_CHUNK에 담는 샘플 수 (16 kHz 기준 100 ms)
+constexpr size_t kBulkChunkSamples = 1600;
+
+// WAV 파일 헤더 크기 (RIFF/fmt/data 기본 구성)
+constexpr size_t kWavHeaderSize = 44;
+
+// 요청 마감 시간 기본값 (ASR + NLU + 작업 실행 포함)
+constexpr std::chrono::milliseconds kDefaultRequestTimeout{30000};
+
+// stop() 시 자식이 stdin EOF로 스스로 종료하기를 기다리는 시간
+constexpr std::chrono::milliseconds kExitGracePeriod{500};
+
+#ifdef _WIN32
+// 명명 파이프 커널 버퍼 크기
+constexpr DWORD kPipeBufferSize = 64 * 1024;
+
+/**
+ * @brief 부모 측만 overlapped인 단방향 명명 파이프 생성
+ *
+ * 익명 파이프(CreatePipe)는 overlapped I/O를 지원하지 않으므로 프로세스 고유
+ * 이름의 명명 파이프를 만들고, 자식 측은 동기 핸들(상속 가능)로 엽니다.
+ * 상속 가능한 핸들은 start()가 PROC_THREAD_ATTRIBUTE_HANDLE_LIST로 해당 워커에만
+ * 넘기므로, 동시에 띄우는 다른 워커로는 새지 않습니다.
+ * @param parentWrites true면 부모 → 자식 방향 (자식 stdin)
+ * @param parentEnd 출력: 부모 측 overlapped 핸들
+ * @param childEnd 출력: 자식에게 상속할 핸들
+ * @return 성공 여부
+ */
+bool createOverlappedPipe(bool parentWrites, HANDLE& parentEnd, HANDLE& childEnd) {
+    static std::atomic<unsigned> counter{0};
+    char name[96];
+    std::snprintf(name, sizeof(name), "\\\\.\\pipe\\sion-bridge-%lu-%u",
+                  static_cast<unsigned long>(GetCurrentProcessId()), counter++);
+
+    const DWORD openMode = (parentWrites ? PIPE_ACCESS_OUTBOUND : PIPE_ACCESS_INBOUND)
+                         | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE;
+    parentEnd = CreateNamedPipeA(name, openMode,
+                                 PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                 1, kPipeBufferSize, kPipeBufferSize, 0, nullptr);
+    if (parentEnd == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    SECURITY_ATTRIBUTES sa;
+    sa.nLength = sizeof(SECURITY_ATTRIBUTES);
+    sa.bInheritHandle = TRUE;
+    sa.lpSecurityDescriptor = nullptr;
+
+    // 클라이언트가 열면 곧바로 연결 상태가 되므로 ConnectNamedPipe 불필요
+    childEnd = CreateFileA(name, parentWrites ? GENERIC_READ : GENERIC_WRITE,
+                           0, &sa, OPEN_EXISTING, 0, nullptr);
+    if (childEnd == INVALID_HANDLE_VALUE) {
+        CloseHandle(parentEnd);
+        return false;
+    }
+    return true;
+}
+#else
+/**
+ * @brief 양쪽 끝 모두 close-on-exec인 파이프 생성
+ *
+ * 워커 풀/감시 스레드가 동시에 워커를 띄우므로 pipe() 뒤 fcntl() 사이에 다른 spawn이
+ * 끼면 부모 측 끝이 다른 워커로 새어, 그 워커가 stdin을 쥐고 있는 동안 EOF 종료가
+ * 일어나지 않습니다. 자식 측 끝은 spawn의 dup2(stdin/stdout)에서만 플래그가 풀립니다.
+ * macOS는 pipe2가 없어 fcntl로 설정하고, 대신 spawn을 POSIX_SPAWN_CLOEXEC_DEFAULT로
+ * 수행해 그 사이 새어 나갈 수 있는 fd를 자식이 받지 않게 합니다.
+ */
+bool createCloexecPipe(int fds[2]) {
+#if defined(__APPLE__)
+    if (::pipe(fds) != 0) {
+        return false;
+    }
+    ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#else
+    return ::pipe2(fds, O_CLOEXEC) == 0;
+#endif
+}
+#endif
+
+} // namespace
+
 // ============================================================================
 // PythonBridge 구현 (임베디드 Python)
 // ============================================================================
 
+#ifdef PYTHON_ENABLED
+namespace {
+
+/**
+ * @brief 인터프리터 스레드에서 작업하는 동안만 GIL 획득 (RAII)
+ *
+ * 생성 시 저장해 둔 스레드 상태로 GIL을 다시 잡고, 소멸 시 놓으면서 상태를 돌려줍니다.
+ */
+class InterpreterScope {
+public:
+    explicit InterpreterScope(void*& threadState)
+        : m_threadState(threadState)
+    {
+        PyEval_RestoreThread(static_cast<PyThreadState*>(m_threadState));
+    }
+
+    ~InterpreterScope() {
+        m_threadState = PyEval_SaveThread();
+    }
+
+    InterpreterScope(const InterpreterScope&) = delete;
+    InterpreterScope& operator=(const InterpreterScope&) = delete;
+
+private:
+    void*& m_threadState;
+};
+
+/**
+ * @brief 결과 객체를 문자열로 변환 후 참조 해제
+ */
+std::string takeString(PyObject* result) {
+    std::string resultStr;
+    if (PyUnicode_Check(result)) {
+        Py_ssize_t size = 0;
+        const char* utf8 = PyUnicode_AsUTF8AndSize(result, &size);
+        if (utf8) {
+            resultStr.assign(utf8, static_cast<size_t>(size));
+        } else {
+            PyErr_Clear();
+        }
+    }
+    Py_DECREF(result);
+    return resultStr;
+}
+
+} // namespace
+#endif
+
 PythonBridge::PythonBridge()
     : m_initialized(false)
     , m_module(nullptr)
+    , m_threadState(nullptr)
 {
 }
 
@@ -37,174 +183,338 @@ PythonBridge::~PythonBridge() {
     finalize();
 }
 
+template <typename F>
+auto PythonBridge::runOnInterpreter(F&& fn) -> std::invoke_result_t<F&> {
+    using Result = std::invoke_result_t<F&>;
+
+    // Python 콜백 안에서 다시 호출된 경우 큐에 넣으면 교착되므로 바로 실행
+    if (std::this_thread::get_id() == m_interpreterThreadId) {
+        return fn();
+    }
+    if (!m_interpreter) {
+        setLastError("Python이 초기화되지 않았습니다.");
+        return Result{};
+    }
+
+    std::future<Result> future = m_interpreter->submit([this, &fn]() -> Result {
+#ifdef PYTHON_ENABLED
+        InterpreterScope gil(m_threadState);
+#endif
+        return fn();
+    });
+
+    try {
+        return future.get();
+    } catch (const std::future_error&) {
+        // 종료 중이라 큐에 들어가지 못함
+        setLastError("Python 인터프리터 스레드가 종료되었습니다.");
+        return Result{};
+    }
+}
+
 bool PythonBridge::initialize(const std::string& pythonHome) {
 #ifdef PYTHON_ENABLED
     if (m_initialized) {
         return true;
     }
     
-    if (!pythonHome.empty()) {
-        Py_SetPythonHome(Py_DecodeLocale(pythonHome.c_str(), nullptr));
-    }
+    m_interpreter = std::make_unique<ThreadPool>(1, "python");
     
-    Py_Initialize();
+    // 초기화도 인터프리터 스레드에서 수행하여 메인 스레드 상태를 그 스레드가 소유
+    std::future<bool> started = m_interpreter->submit([this, pythonHome]() {
+        m_interpreterThreadId = std::this_thread::get_id();
+        
+        PyConfig config;
+        PyConfig_InitPythonConfig(&config);
+        config.install_signal_handlers = 0;   // SIGINT는 C++ 쪽이 처리
+        
+        PyStatus status = PyStatus_Ok();
+        if (!pythonHome.empty()) {
+            status = PyConfig_SetBytesString(&config, &config.home, pythonHome.c_str());
+        }
+        if (!PyStatus_Exception(status)) {
+            status = Py_InitializeFromConfig(&config);
+        }
+        PyConfig_Clear(&config);
+        
+        if (PyStatus_Exception(status) || !Py_IsInitialized()) {
+            setLastError(std::string("Python 초기화 실패") +
+                         (status.err_msg ? std::string(": ") + status.err_msg : ""));
+            return false;
+        }
+        
+        // 요청을 기다리는 동안에는 GIL을 놓음
+        m_threadState = PyEval_SaveThread();
+        return true;
+    });
     
-    if (!Py_IsInitialized()) {
-        m_lastError = "Python 초기화 실패";
+    if (!started.get()) {
+        m_interpreter->shutdown();
+        m_interpreter.reset();
+        m_interpreterThreadId = std::thread::id();
         return false;
     }
     
     m_initialized = true;
     return true;
 #else
-    m_lastError = "Python 지원이 비활성화되어 있습니다.";
+    (void)pythonHome;
+    setLastError("Python 지원이 비활성화되어 있습니다.");
     return false;
 #endif
 }
 
 void PythonBridge::finalize() {
 #ifdef PYTHON_ENABLED
-    if (m_initialized) {
+    if (!m_initialized) {
+        return;
+    }
+    m_initialized = false;
+    
+    // 앞서 들어온 호출이 모두 끝난 뒤 같은 스레드에서 종료
+    m_interpreter->post([this]() {
+        PyEval_RestoreThread(static_cast<PyThreadState*>(m_threadState));
+        m_threadState = nullptr;
+        clearCallables();
         if (m_module) {
             Py_DECREF(static_cast<PyObject*>(m_module));
             m_module = nullptr;
         }
-        Py_Finalize();
-        m_initialized = false;
-    }
+        Py_FinalizeEx();
+    });
+    m_interpreter->shutdown();
+    m_interpreter.reset();
+    m_interpreterThreadId = std::thread::id();
 #endif
 }
 
 bool PythonBridge::importModule(const std::string& moduleName) {
 #ifdef PYTHON_ENABLED
     if (!m_initialized) {
-        m_lastError = "Python이 초기화되지 않았습니다.";
+        setLastError("Python이 초기화되지 않았습니다.");
         return false;
     }
     
-    PyObject* module = PyImport_ImportModule(moduleName.c_str());
-    if (!module) {
-        PyErr_Print();
-        m_lastError = "모듈 임포트 실패: " + moduleName;
-        return false;
-    }
-    
-    if (m_module) {
-        Py_DECREF(static_cast<PyObject*>(m_module));
-    }
-    m_module = module;
-    
-    return true;
+    return runOnInterpreter([this, &moduleName]() {
+        PyObject* module = PyImport_ImportModule(moduleName.c_str());
+        if (!module) {
+            PyErr_Print();
+            setLastError("모듈 임포트 실패: " + moduleName);
+            return false;
+        }
+        
+        clearCallables();
+        if (m_module) {
+            Py_DECREF(static_cast<PyObject*>(m_module));
+        }
+        m_module = module;
+        
+        // 첫 발화 때 조회 비용이 없도록 임포트 시점에 미리 확보
+        resolveCallable("process_audio");
+        return true;
+    });
 #else
+    (void)moduleName;
     return false;
 #endif
 }
 
 std::string PythonBridge::processAudio(const std::vector<uint8_t>& audioData) {
 #ifdef PYTHON_ENABLED
-    if (!m_module) {
-        m_lastError = "모듈이 로드되지 않았습니다.";
-        return "";
+    return runOnInterpreter([this, &audioData]() -> std::string {
+        // 바이트 배열을 Python bytes로 변환
+        PyObject* pyBytes = PyBytes_FromStringAndSize(
+            reinterpret_cast<const char*>(audioData.data()),
+            static_cast<Py_ssize_t>(audioData.size()));
+        if (!pyBytes) {
+            PyErr_Print();
+            setLastError("bytes 생성 실패");
+            return "";
+        }
+        
+        std::string result = invokeProcessAudio(pyBytes);
+        Py_DECREF(pyBytes);
+        return result;
+    });
+#else
+    (void)audioData;
+    return "";
+#endif
+}
+
+std::string PythonBridge::processAudio(const WavBuffer& wav) {
+#ifdef PYTHON_ENABLED
+    return runOnInterpreter([this, &wav]() { return processWav(wav); });
+#else
+    (void)wav;
+    return "";
+#endif
+}
+
+std::future<std::string> PythonBridge::submitAudio(const WavBuffer& wav) {
+#ifdef PYTHON_ENABLED
+    if (m_interpreter) {
+        // 호출 스레드는 인터프리터 큐를 기다리지 않고 바로 돌아감
+        const WavBuffer* buffer = &wav;
+        return m_interpreter->submit([this, buffer]() {
+            InterpreterScope gil(m_threadState);
+            return processWav(*buffer);
+        });
     }
-    
-    PyObject* func = PyObject_GetAttrString(
-        static_cast<PyObject*>(m_module), "process_audio");
-    
-    if (!func || !PyCallable_Check(func)) {
-        Py_XDECREF(func);
-        m_lastError = "process_audio 함수를 찾을 수 없습니다.";
-        return "";
+#else
+    (void)wav;
+#endif
+    std::promise<std::string> failed;
+    failed.set_value("");
+    return failed.get_future();
+}
+
+std::string PythonBridge::callFunction(const std::string& functionName, const std::string& arg) {
+#ifdef PYTHON_ENABLED
+    return runOnInterpreter([this, &functionName, &arg]() -> std::string {
+        PyObject* func = static_cast<PyObject*>(resolveCallable(functionName));
+        if (!func) {
+            return "";
+        }
+        
+        PyObject* pyArg = PyUnicode_FromStringAndSize(arg.data(), static_cast<Py_ssize_t>(arg.size()));
+        if (!pyArg) {
+            PyErr_Print();
+            return "";
+        }
+        PyObject* result = PyObject_CallOneArg(func, pyArg);
+        Py_DECREF(pyArg);
+        
+        if (!result) {
+            PyErr_Print();
+            setLastError("함수 호출 실패: " + functionName);
+            return "";
+        }
+        return takeString(result);
+    });
+#else
+    (void)functionName;
+    (void)arg;
+    return "";
+#endif
+}
+
+bool PythonBridge::executeScript(const std::string& scriptPath) {
+#ifdef PYTHON_ENABLED
+    if (!m_initialized) {
+        return false;
     }
     
-    // 바이트 배열을 Python bytes로 변환
-    PyObject* pyBytes = PyBytes_FromStringAndSize(
-        reinterpret_cast<const char*>(audioData.data()),
-        audioData.size());
-    
-    PyObject* args = PyTuple_Pack(1, pyBytes);
-    PyObject* result = PyObject_CallObject(func, args);
-    
-    Py_DECREF(pyBytes);
-    Py_DECREF(args);
-    Py_DECREF(func);
-    
-    if (!result) {
-        PyErr_Print();
-        m_lastError = "함수 호출 실패";
-        return "";
+    std::ifstream file(scriptPath);
+    if (!file.is_open()) {
+        setLastError("스크립트 파일을 열 수 없습니다: " + scriptPath);
+        return false;
     }
     
-    std::string resultStr;
-    if (PyUnicode_Check(result)) {
-        resultStr = PyUnicode_AsUTF8(result);
-    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string code = buffer.str();
     
-    Py_DECREF(result);
-    return resultStr;
+    return runOnInterpreter([&code]() { return PyRun_SimpleString(code.c_str()) == 0; });
 #else
-    return "";
+    (void)scriptPath;
+    return false;
 #endif
 }
 
-std::string PythonBridge::callFunction(const std::string& functionName, const std::string& arg) {
+std::string PythonBridge::getLastError() const {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return m_lastError;
+}
+
+void PythonBridge::setLastError(const std::string& error) {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    m_lastError = error;
+}
+
+void* PythonBridge::resolveCallable(const std::string& name) {
 #ifdef PYTHON_ENABLED
-    if (!m_module) {
-        return "";
+    auto it = m_callables.find(name);
+    if (it != m_callables.end()) {
+        return it->second;
     }
     
-    PyObject* func = PyObject_GetAttrString(
-        static_cast<PyObject*>(m_module), functionName.c_str());
+    if (!m_module) {
+        setLastError("모듈이 로드되지 않았습니다.");
+        return nullptr;
+    }
     
+    PyObject* func = PyObject_GetAttrString(static_cast<PyObject*>(m_module), name.c_str());
     if (!func || !PyCallable_Check(func)) {
+        PyErr_Clear();
         Py_XDECREF(func);
-        return "";
+        setLastError(name + " 함수를 찾을 수 없습니다.");
+        return nullptr;
     }
     
-    PyObject* pyArg = PyUnicode_FromString(arg.c_str());
-    PyObject* args = PyTuple_Pack(1, pyArg);
-    PyObject* result = PyObject_CallObject(func, args);
-    
-    Py_DECREF(pyArg);
-    Py_DECREF(args);
-    Py_DECREF(func);
-    
-    if (!result) {
+    m_callables.emplace(name, func);
+    return func;
+#else
+    (void)name;
+    return nullptr;
+#endif
+}
+
+void PythonBridge::clearCallables() {
+#ifdef PYTHON_ENABLED
+    for (auto& entry : m_callables) {
+        Py_DECREF(static_cast<PyObject*>(entry.second));
+    }
+#endif
+    m_callables.clear();
+}
+
+std::string PythonBridge::processWav(const WavBuffer& wav) {
+#ifdef PYTHON_ENABLED
+    // 복사 없이 버퍼 프로토콜로 노출 (읽기 전용)
+    PyObject* view = PyMemoryView_FromMemory(
+        const_cast<char*>(reinterpret_cast<const char*>(wav.data())),
+        static_cast<Py_ssize_t>(wav.size()),
+        PyBUF_READ);
+    if (!view) {
         PyErr_Print();
+        setLastError("memoryview 생성 실패");
         return "";
     }
     
-    std::string resultStr;
-    if (PyUnicode_Check(result)) {
-        resultStr = PyUnicode_AsUTF8(result);
-    }
+    std::string result = invokeProcessAudio(view);
     
-    Py_DECREF(result);
-    return resultStr;
+    // Python 측이 참조를 보관했더라도 더 이상 버퍼에 접근하지 못하도록 해제
+    PyObject* released = PyObject_CallMethod(view, "release", nullptr);
+    if (!released) {
+        PyErr_Clear();
+    }
+    Py_XDECREF(released);
+    Py_DECREF(view);
+    return result;
 #else
+    (void)wav;
     return "";
 #endif
 }
 
-bool PythonBridge::executeScript(const std::string& scriptPath) {
+std::string PythonBridge::invokeProcessAudio(void* arg) {
 #ifdef PYTHON_ENABLED
-    if (!m_initialized) {
-        return false;
+    PyObject* func = static_cast<PyObject*>(resolveCallable("process_audio"));
+    if (!func) {
+        return "";
     }
     
-    std::ifstream file(scriptPath);
-    if (!file.is_open()) {
-        m_lastError = "스크립트 파일을 열 수 없습니다: " + scriptPath;
-        return false;
+    PyObject* result = PyObject_CallOneArg(func, static_cast<PyObject*>(arg));
+    if (!result) {
+        PyErr_Print();
+        setLastError("함수 호출 실패");
+        return "";
     }
-    
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string code = buffer.str();
-    
-    int result = PyRun_SimpleString(code.c_str());
-    return result == 0;
+    return takeString(result);
 #else
-    return false;
+    (void)arg;
+    return "";
 #endif
 }
 
@@ -214,13 +524,21 @@ bool PythonBridge::executeScript(const std::string& scriptPath) {
 
 PythonProcessBridge::PythonProcessBridge(
     const std::string& pythonPath,
-    const std::string& scriptPath)
+    const std::string& scriptPath,
+    const std::vector<std::string>& extraArgs)
     : m_pythonPath(pythonPath)
     , m_scriptPath(scriptPath)
+    , m_extraArgs(extraArgs)
     , m_processHandle(nullptr)
-    , m_stdinPipe(nullptr)
-    , m_stdoutPipe(nullptr)
+    , m_processId(-1)
     , m_running(false)
+    , m_requestTimeout(kDefaultRequestTimeout)
+    , m_ready(false)
+    , m_codecs(1u << static_cast<uint32_t>(protocol::AudioCodec::Pcm))
+    , m_sendSequence(0)
+    , m_recvSequence(0)
+    , m_recvStarted(false)
+    , m_nextUtteranceId(1)
 {
 }
 
@@ -230,58 +548,85 @@ PythonProcessBridge::~PythonProcessBridge() {
 
 bool PythonProcessBridge::start() {
 #ifdef _WIN32
-    SECURITY_ATTRIBUTES sa;
-    sa.nLength = sizeof(SECURITY_ATTRIBUTES);
-    sa.bInheritHandle = TRUE;
-    sa.lpSecurityDescriptor = nullptr;
-    
     HANDLE hStdinRead, hStdinWrite;
     HANDLE hStdoutRead, hStdoutWrite;
     
-    // stdin 파이프 생성
-    if (!CreatePipe(&hStdinRead, &hStdinWrite, &sa, 0)) {
-        std::cerr << "[PythonProcessBridge] stdin 파이프 생성 실패" << std::endl;
+    // stdin 파이프 생성 (부모: overlapped 쓰기)
+    if (!createOverlappedPipe(true, hStdinWrite, hStdinRead)) {
+        std::cerr << "[PythonProcessBridge] stdin 파이프 생성 실패: " << GetLastError() << std::endl;
         return false;
     }
-    SetHandleInformation(hStdinWrite, HANDLE_FLAG_INHERIT, 0);
     
-    // stdout 파이프 생성
-    if (!CreatePipe(&hStdoutRead, &hStdoutWrite, &sa, 0)) {
+    // stdout 파이프 생성 (부모: overlapped 읽기)
+    if (!createOverlappedPipe(false, hStdoutRead, hStdoutWrite)) {
         CloseHandle(hStdinRead);
         CloseHandle(hStdinWrite);
-        std::cerr << "[PythonProcessBridge] stdout 파이프 생성 실패" << std::endl;
+        std::cerr << "[PythonProcessBridge] stdout 파이프 생성 실패: " << GetLastError() << std::endl;
         return false;
     }
-    SetHandleInformation(hStdoutRead, HANDLE_FLAG_INHERIT, 0);
     
+    // 자식이 물려받는 핸들을 자기 파이프 두 끝(+ 상속 가능한 stderr)으로 제한
+    // (bInheritHandles=TRUE만으로는 다른 워커의 파이프와 소켓까지 상속됨)
+    const HANDLE stderrHandle = GetStdHandle(STD_ERROR_HANDLE);
+    HANDLE inherited[3] = {hStdinRead, hStdoutWrite, nullptr};
+    DWORD inheritedCount = 2;
+    DWORD stderrFlags = 0;
+    if (stderrHandle && stderrHandle != INVALID_HANDLE_VALUE
+        && GetHandleInformation(stderrHandle, &stderrFlags) && (stderrFlags & HANDLE_FLAG_INHERIT)) {
+        inherited[inheritedCount++] = stderrHandle;
+    }
+
+    SIZE_T attributeSize = 0;
+    InitializeProcThreadAttributeList(nullptr, 1, 0, &attributeSize);
+    std::vector<uint8_t> attributeStorage(attributeSize);
+    auto* attributes = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>(attributeStorage.data());
+    if (!InitializeProcThreadAttributeList(attributes, 1, 0, &attributeSize)) {
+        CloseHandle(hStdinRead);
+        CloseHandle(hStdinWrite);
+        CloseHandle(hStdoutRead);
+        CloseHandle(hStdoutWrite);
+        std::cerr << "[PythonProcessBridge] 프로세스 속성 초기화 실패: " << GetLastError() << std::endl;
+        return false;
+    }
+    const bool handleListSet = UpdateProcThreadAttribute(attributes, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST,
+                                                         inherited, inheritedCount * sizeof(HANDLE),
+                                                         nullptr, nullptr) != FALSE;
+
     // 프로세스 시작 정보 설정
-    STARTUPINFOA si;
+    STARTUPINFOEXA si;
     PROCESS_INFORMATION pi;
     
     ZeroMemory(&si, sizeof(si));
-    si.cb = sizeof(si);
-    si.hStdInput = hStdinRead;
-    si.hStdOutput = hStdoutWrite;
-    si.hStdError = hStdoutWrite;
-    si.dwFlags |= STARTF_USESTDHANDLES;
+    si.StartupInfo.cb = sizeof(si);
+    si.StartupInfo.hStdInput = hStdinRead;
+    si.StartupInfo.hStdOutput = hStdoutWrite;
+    // stdout은 프레임 전용이므로 stderr(로그)는 부모 콘솔로 분리
+    si.StartupInfo.hStdError = stderrHandle;
+    si.StartupInfo.dwFlags |= STARTF_USESTDHANDLES;
+    si.lpAttributeList = attributes;
     
     ZeroMemory(&pi, sizeof(pi));
     
     // 명령줄 구성
     std::string cmdLine = m_pythonPath + " " + m_scriptPath + " --pipe-mode";
+    for (const std::string& arg : m_extraArgs) {
+        cmdLine += " " + arg;
+    }
     
     // 프로세스 생성
-    if (!CreateProcessA(
+    const bool created = handleListSet && CreateProcessA(
             nullptr,
             const_cast<char*>(cmdLine.c_str()),
             nullptr,
             nullptr,
             TRUE,
-            CREATE_NO_WINDOW,
+            CREATE_NO_WINDOW | EXTENDED_STARTUPINFO_PRESENT,
             nullptr,
             nullptr,
-            &si,
-            &pi)) {
+            &si.StartupInfo,
+            &pi);
+    DeleteProcThreadAttributeList(attributes);
+    if (!created) {
         CloseHandle(hStdinRead);
         CloseHandle(hStdinWrite);
         CloseHandle(hStdoutRead);
@@ -295,93 +640,514 @@ bool PythonProcessBridge::start() {
     CloseHandle(hStdinRead);
     CloseHandle(hStdoutWrite);
     
+    // 스레드 핸들 닫기 (필요 없음)
+    CloseHandle(pi.hThread);
+    
     m_processHandle = pi.hProcess;
-    m_stdinPipe = hStdinWrite;
-    m_stdoutPipe = hStdoutRead;
     m_running = true;
     
-    // 스레드 핸들 닫기 (필요 없음)
-    CloseHandle(pi.hThread);
+    // 송수신 I/O 스레드 시작 (핸들 소유권은 채널로 이전)
+    if (!m_channel.open(hStdinWrite, hStdoutRead,
+                        [this](const protocol::FrameHeader& header, std::string& payload) {
+                            handleFrame(header, payload);
+                        },
+                        [this] { handleChannelClosed(); })) {
+        stop();
+        return false;
+    }
     
     return true;
 #else
-    // Linux/macOS 구현
-    std::cout << "[PythonProcessBridge] 더미 모드로 시작" << std::endl;
+    int stdinPipe[2];
+    int stdoutPipe[2];
+    if (!createCloexecPipe(stdinPipe)) {
+        std::cerr << "[PythonProcessBridge] stdin 파이프 생성 실패: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (!createCloexecPipe(stdoutPipe)) {
+        ::close(stdinPipe[0]);
+        ::close(stdinPipe[1]);
+        std::cerr << "[PythonProcessBridge] stdout 파이프 생성 실패: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    
+    // 자식: stdin/stdout만 파이프로 교체 (dup2된 fd만 close-on-exec가 풀림), stderr(로그)는 부모와 공유
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, stdinPipe[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, stdoutPipe[1], STDOUT_FILENO);
+    
+    std::string pipeModeArg = "--pipe-mode";
+    std::vector<char*> argv = {
+        const_cast<char*>(m_pythonPath.c_str()),
+        const_cast<char*>(m_scriptPath.c_str()),
+        const_cast<char*>(pipeModeArg.c_str()),
+    };
+    for (const std::string& arg : m_extraArgs) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    
+    // 부모는 종료 시그널을 sigwait 스레드에서만 받도록 막아 두므로 자식은 기본 마스크로 시작
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t emptyMask;
+    sigemptyset(&emptyMask);
+    posix_spawnattr_setsigmask(&attr, &emptyMask);
+    short spawnFlags = POSIX_SPAWN_SETSIGMASK;
+#if defined(__APPLE__)
+    spawnFlags |= POSIX_SPAWN_CLOEXEC_DEFAULT;  // stdin/stdout/stderr 외 fd는 물려주지 않음
+    posix_spawn_file_actions_addinherit_np(&actions, STDERR_FILENO);
+#endif
+    posix_spawnattr_setflags(&attr, spawnFlags);
+    
+    // fork 대신 posix_spawn: 부모 메모리 복제 없이 vfork/clone 경로로 시작
+    pid_t pid = -1;
+    const int spawnError = posix_spawnp(&pid, m_pythonPath.c_str(), &actions, &attr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    
+    // 자식 프로세스 측 끝 닫기
+    ::close(stdinPipe[0]);
+    ::close(stdoutPipe[1]);
+    
+    if (spawnError != 0) {
+        ::close(stdinPipe[1]);
+        ::close(stdoutPipe[0]);
+        std::cerr << "[PythonProcessBridge] 프로세스 생성 실패: " << std::strerror(spawnError) << std::endl;
+        return false;
+    }
+    
+    m_processId = pid;
     m_running = true;
+    
+    // 송수신 I/O 스레드 시작 (fd 소유권은 채널로 이전)
+    if (!m_channel.open(stdinPipe[1], stdoutPipe[0],
+                        [this](const protocol::FrameHeader& header, std::string& payload) {
+                            handleFrame(header, payload);
+                        },
+                        [this] { handleChannelClosed(); })) {
+        stop();
+        return false;
+    }
+    
     return true;
 #endif
 }
 
 void PythonProcessBridge::stop() {
+    m_running = false;
+    
 #ifdef _WIN32
-    if (m_running) {
-        // 프로세스 종료
-        if (m_processHandle) {
-            TerminateProcess(static_cast<HANDLE>(m_processHandle), 0);
-            CloseHandle(static_cast<HANDLE>(m_processHandle));
-            m_processHandle = nullptr;
-        }
-        
-        // 파이프 닫기
-        if (m_stdinPipe) {
-            CloseHandle(static_cast<HANDLE>(m_stdinPipe));
-            m_stdinPipe = nullptr;
+    // 프로세스 종료 (파이프가 끊겨 진행 중인 overlapped 작업이 완료됨)
+    if (m_processHandle) {
+        TerminateProcess(static_cast<HANDLE>(m_processHandle), 0);
+        CloseHandle(static_cast<HANDLE>(m_processHandle));
+        m_processHandle = nullptr;
+    }
+    
+    // I/O 스레드 종료 후 파이프 핸들 닫기
+    m_channel.close();
+#else
+    // 파이프를 먼저 닫으면 자식은 stdin EOF로 정상 종료
+    m_channel.close();
+    
+    if (m_processId > 0) {
+        const pid_t pid = static_cast<pid_t>(m_processId);
+        const auto deadline = std::chrono::steady_clock::now() + kExitGracePeriod;
+        int status = 0;
+        pid_t reaped = 0;
+        while ((reaped = ::waitpid(pid, &status, WNOHANG)) == 0 &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
-        if (m_stdoutPipe) {
-            CloseHandle(static_cast<HANDLE>(m_stdoutPipe));
-            m_stdoutPipe = nullptr;
+        if (reaped == 0) {
+            ::kill(pid, SIGKILL);
+            ::waitpid(pid, &status, 0);
         }
-        
-        m_running = false;
+        m_processId = -1;
     }
-#else
-    m_running = false;
 #endif
+    
+    m_ready = false;
+    m_readyCv.notify_all();
+    failAllRequests();
+}
+
+bool PythonProcessBridge::waitUntilReady(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_readyMutex);
+    m_readyCv.wait_for(lock, timeout, [this] { return m_ready.load() || !m_running.load(); });
+    return isReady();
+}
+
+size_t PythonProcessBridge::pendingRequests() const {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    size_t count = 0;
+    for (const auto& entry : m_pending) {
+        if (!entry.second.completed) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+uint32_t PythonProcessBridge::beginUtterance(PartialResultCallback onPartial) {
+    const uint32_t utteranceId = m_nextUtteranceId.fetch_add(1);
+    
+    const uint64_t traceRequest = trace::currentRequest();
+    
+    // 응답이 요청보다 먼저 도착해도 놓치지 않도록 송신 전에 등록
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        PendingRequest& request = m_pending[utteranceId];
+        request.onPartial = std::move(onPartial);
+        request.future = request.promise.get_future();
+        request.deadline = std::chrono::steady_clock::now() + m_requestTimeout;
+        request.traceRequest = traceRequest;
+        request.sentAt = trace::now();
+    }
+    
+    // 여러 캡처 장치를 쓰면 워커가 결과를 세션별로 구분하도록 발화의 첫 프레임 전에 알림
+    if (const uint32_t session = protocol::sessionOfRequest(traceRequest)) {
+        uint8_t payload[protocol::kSessionPayloadSize];
+        for (size_t i = 0; i < sizeof(payload); ++i) {
+            payload[i] = static_cast<uint8_t>(session >> (8 * i));
+        }
+        writeFrame(protocol::MessageType::Session, utteranceId, payload, sizeof(payload));
+    }
+    
+    return utteranceId;
+}
+
+bool PythonProcessBridge::sendAudioChunk(uint32_t utteranceId, const int16_t* samples, size_t count) {
+    return writeFrame(protocol::MessageType::AudioChunk, utteranceId,
+                      samples, count * sizeof(int16_t));
+}
+
+bool PythonProcessBridge::endUtterance(uint32_t utteranceId) {
+    return writeFrame(protocol::MessageType::EndOfUtterance, utteranceId, nullptr, 0);
+}
+
+bool PythonProcessBridge::cancelUtterance(uint32_t utteranceId) {
+    bool sent = writeFrame(protocol::MessageType::Cancel, utteranceId, nullptr, 0);
+    completeRequest(utteranceId, "");
+    return sent;
+}
+
+std::string PythonProcessBridge::awaitResult(uint32_t utteranceId, CancellationToken* cancel) {
+    std::future<std::string> future;
+    std::chrono::steady_clock::time_point deadline;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        auto it = m_pending.find(utteranceId);
+        if (it == m_pending.end() || !it->second.future.valid()) {
+            return "";
+        }
+        future = std::move(it->second.future);
+        deadline = it->second.deadline;
+    }
+    
+    {
+        // 취소 시 CANCEL 전송 + 빈 결과로 완료되어 future가 즉시 깨어남
+        ScopedCancelCallback onCancel(cancel, [this, utteranceId] { cancelUtterance(utteranceId); });
+        if (future.wait_until(deadline) == std::future_status::timeout) {
+            std::cerr << "[PythonProcessBridge] 발화 " << utteranceId << " 응답 시간 초과 ("
+                      << m_requestTimeout.count() << " ms)" << std::endl;
+            cancelUtterance(utteranceId);
+        }
+    }
+    std::string result = future.get();
+    
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pending.erase(utteranceId);
+    return result;
+}
+
+void PythonProcessBridge::handleFrame(const protocol::FrameHeader& header, std::string& payload) {
+    if (m_recvStarted && header.sequence != m_recvSequence) {
+        std::cerr << "[PythonProcessBridge] 시퀀스 불연속: 예상 " << m_recvSequence
+                  << ", 수신 " << header.sequence << std::endl;
+    }
+    m_recvSequence = header.sequence + 1;
+    m_recvStarted = true;
+    
+    switch (header.type) {
+        case protocol::MessageType::PartialResult: {
+            PartialResultCallback onPartial;
+            {
+                std::lock_guard<std::mutex> lock(m_pendingMutex);
+                auto it = m_pending.find(header.utteranceId);
+                if (it != m_pending.end() && !it->second.completed) {
+                    onPartial = it->second.onPartial;
+                    if (!it->second.partialSeen) {
+                        it->second.partialSeen = true;
+                        trace::record(trace::Stage::FirstPartial, it->second.traceRequest,
+                                      it->second.sentAt, trace::now());
+                    }
+                }
+            }
+            if (onPartial) {
+                onPartial(payload);
+            }
+            break;
+        }
+        case protocol::MessageType::FinalResult:
+            {
+                std::lock_guard<std::mutex> lock(m_pendingMutex);
+                auto it = m_pending.find(header.utteranceId);
+                if (it != m_pending.end() && !it->second.completed) {
+                    trace::record(trace::Stage::FinalResult, it->second.traceRequest,
+                                  it->second.sentAt, trace::now());
+                }
+            }
+            completeRequest(header.utteranceId, payload);
+            break;
+        case protocol::MessageType::CommandResult:
+            completeRequest(header.utteranceId, payload);
+            break;
+        case protocol::MessageType::Error:
+            std::cerr << "[PythonProcessBridge] Python 오류: " << payload << std::endl;
+            completeRequest(header.utteranceId, "");
+            break;
+        case protocol::MessageType::Ready: {
+            m_codecs = protocol::parseCodecList(payload);
+            {
+                std::lock_guard<std::mutex> lock(m_readyMutex);
+                m_ready = true;
+                m_readyCv.notify_all();
+            }
+            notifyStateChanged();
+            break;
+        }
+        default:
+            std::cerr << "[PythonProcessBridge] 예상치 못한 메시지: "
+                      << protocol::messageTypeName(header.type) << std::endl;
+            break;
+    }
+}
+
+void PythonProcessBridge::handleChannelClosed() {
+    // 자식 종료/파이프 오류: 이후 요청은 즉시 실패하고 워커 풀이 재시작
+    if (m_running.exchange(false)) {
+        std::cerr << "[PythonProcessBridge] 응답 파이프가 닫혔습니다." << std::endl;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_readyMutex);
+        m_ready = false;
+        m_readyCv.notify_all();
+    }
+    failAllRequests();
+    notifyStateChanged();
+}
+
+void PythonProcessBridge::setStateCallback(StateCallback callback) {
+    std::lock_guard<std::mutex> lock(m_stateCallbackMutex);
+    m_stateCallback = std::move(callback);
+}
+
+void PythonProcessBridge::notifyStateChanged() {
+    std::lock_guard<std::mutex> lock(m_stateCallbackMutex);
+    if (m_stateCallback) {
+        m_stateCallback();
+    }
+}
+
+void PythonProcessBridge::completeRequest(uint32_t utteranceId, const std::string& result) {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    auto it = m_pending.find(utteranceId);
+    if (it == m_pending.end() || it->second.completed) {
+        return;  // 이미 취소/완료된 발화의 늦은 응답
+    }
+    
+    it->second.completed = true;
+    it->second.promise.set_value(result);
+}
+
+void PythonProcessBridge::failAllRequests() {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    for (auto& [id, request] : m_pending) {
+        if (!request.completed) {
+            request.completed = true;
+            request.promise.set_value("");
+        }
+    }
 }
 
 std::string PythonProcessBridge::sendAudio(const std::vector<uint8_t>& audioData) {
+    // WAV 헤더는 프로토콜상 불필요하므로 건너뛰고 PCM만 전송
+    size_t offset = 0;
+    if (audioData.size() >= kWavHeaderSize && std::memcmp(audioData.data(), "RIFF", 4) == 0) {
+        offset = kWavHeaderSize;
+    }
+    
+    return sendPcm(reinterpret_cast<const int16_t*>(audioData.data() + offset),
+                   (audioData.size() - offset) / sizeof(int16_t));
+}
+
+std::string PythonProcessBridge::sendAudio(const WavBuffer& wav, const PartialResultCallback& onPartial) {
+    return sendPcm(wav.samples(), wav.sampleCount(), onPartial);
+}
+
+std::string PythonProcessBridge::sendPcm(
+    const int16_t* samples, size_t sampleCount,
+    const PartialResultCallback& onPartial)
+{
     if (!m_running) {
         return "";
     }
     
-#ifdef _WIN32
-    // 데이터 크기 전송 (4바이트)
-    uint32_t dataSize = static_cast<uint32_t>(audioData.size());
-    DWORD bytesWritten;
+    return awaitResult(submitPcm(samples, sampleCount, onPartial));
+}
+
+uint32_t PythonProcessBridge::submitPcm(
+    const int16_t* samples, size_t sampleCount,
+    const PartialResultCallback& onPartial,
+    CancellationToken* cancel)
+{
+    const uint32_t utteranceId = beginUtterance(onPartial);
+    trace::Span sendSpan(trace::Stage::BridgeSend);
     
-    if (!WriteFile(static_cast<HANDLE>(m_stdinPipe), 
-                   &dataSize, sizeof(dataSize), &bytesWritten, nullptr)) {
-        return "";
+    bool sent = m_running;
+    for (size_t offset = 0; sent && offset < sampleCount; offset += kBulkChunkSamples) {
+        if (cancel && cancel->isCancelled()) {
+            // 이미 보낸 조각은 Python 측에서 CANCEL로 폐기
+            cancelUtterance(utteranceId);
+            return utteranceId;
+        }
+        const size_t count = std::min(kBulkChunkSamples, sampleCount - offset);
+        sent = sendAudioChunk(utteranceId, samples + offset, count);
     }
     
-    // 오디오 데이터 전송
-    if (!WriteFile(static_cast<HANDLE>(m_stdinPipe),
-                   audioData.data(), dataSize, &bytesWritten, nullptr)) {
-        return "";
+    if (!sent || !endUtterance(utteranceId)) {
+        completeRequest(utteranceId, "");  // 대기자가 즉시 깨어나도록 완료 처리
     }
     
-    FlushFileBuffers(static_cast<HANDLE>(m_stdinPipe));
+    return utteranceId;
+}
+
+uint32_t PythonProcessBridge::submitEncoded(
+    const int16_t* samples, size_t sampleCount, int sampleRate,
+    AudioEncoder& encoder,
+    const PartialResultCallback& onPartial,
+    CancellationToken* cancel)
+{
+    const uint32_t utteranceId = beginUtterance(onPartial);
+    trace::Span sendSpan(trace::Stage::BridgeSend);
+    const uint8_t flags = static_cast<uint8_t>(encoder.codec());
     
-    // 응답 크기 수신
-    uint32_t responseSize;
-    DWORD bytesRead;
+    // 인코딩 시간은 조각별 호출을 합산해 발화당 한 구간으로 기록
+    const int64_t encodeStart = trace::now();
+    int64_t encodeNs = 0;
     
-    if (!ReadFile(static_cast<HANDLE>(m_stdoutPipe),
-                  &responseSize, sizeof(responseSize), &bytesRead, nullptr)) {
-        return "";
+    std::vector<uint8_t> encoded;
+    auto flush = [&]() {
+        if (encoded.empty()) {
+            return true;
+        }
+        const bool ok = writeFrame(protocol::MessageType::AudioChunk, utteranceId,
+                                   encoded.data(), encoded.size(), flags);
+        encoded.clear();
+        return ok;
+    };
+    
+    bool sent = m_running && encoder.begin(sampleRate, 1, encoded);
+    encodeNs += trace::now() - encodeStart;
+    for (size_t offset = 0; sent && offset < sampleCount; offset += kBulkChunkSamples) {
+        if (cancel && cancel->isCancelled()) {
+            cancelUtterance(utteranceId);
+            return utteranceId;
+        }
+        const size_t count = std::min(kBulkChunkSamples, sampleCount - offset);
+        const int64_t chunkStart = trace::now();
+        encoder.encode(samples + offset, count, encoded);
+        encodeNs += trace::now() - chunkStart;
+        sent = flush();
     }
     
-    // 응답 데이터 수신
-    std::string response(responseSize, '\0');
-    if (!ReadFile(static_cast<HANDLE>(m_stdoutPipe),
-                  response.data(), responseSize, &bytesRead, nullptr)) {
-        return "";
+    if (sent) {
+        const int64_t finishStart = trace::now();
+        encoder.finish(encoded);
+        encodeNs += trace::now() - finishStart;
+        sent = flush();
     }
+    trace::record(trace::Stage::Encode, trace::currentRequest(), encodeStart, encodeStart + encodeNs);
     
-    return response;
-#else
-    return "더미 응답";
-#endif
+    if (!sent || !endUtterance(utteranceId)) {
+        completeRequest(utteranceId, "");
+    }
+    
+    return utteranceId;
+}
+
+bool PythonProcessBridge::sendSharedAudioChunk(uint32_t utteranceId, const protocol::ShmAudioRef& ref) {
+    uint8_t encoded[protocol::kShmAudioRefSize];
+    protocol::encodeShmAudioRef(ref, encoded);
+    return writeFrame(protocol::MessageType::AudioShm, utteranceId, encoded, sizeof(encoded));
+}
+
+uint32_t PythonProcessBridge::submitSharedAudio(
+    uint32_t slot, size_t sampleCount,
+    const PartialResultCallback& onPartial,
+    CancellationToken* cancel)
+{
+    const uint32_t utteranceId = beginUtterance(onPartial);
+    trace::Span sendSpan(trace::Stage::BridgeSend);
+    
+    if (cancel && cancel->isCancelled()) {
+        cancelUtterance(utteranceId);
+        return utteranceId;
+    }
+    
+    protocol::ShmAudioRef ref;
+    ref.slot = slot;
+    ref.sampleOffset = 0;
+    ref.sampleCount = static_cast<uint32_t>(sampleCount);
+    
+    // 샘플은 이미 공유 메모리에 있으므로 파이프에는 위치 + 종료 알림만
+    if (!m_running || !sendSharedAudioChunk(utteranceId, ref) || !endUtterance(utteranceId)) {
+        completeRequest(utteranceId, "");
+    }
+    
+    return utteranceId;
+}
+
+uint32_t PythonProcessBridge::submitTranscript(const std::string& transcript, CancellationToken* cancel) {
+    const uint32_t utteranceId = beginUtterance();
+    
+    if (cancel && cancel->isCancelled()) {
+        cancelUtterance(utteranceId);
+        return utteranceId;
+    }
+    
+    if (!m_running || !writeFrame(protocol::MessageType::Transcript, utteranceId,
+                                  transcript.data(), transcript.size())) {
+        completeRequest(utteranceId, "");
+    }
+    
+    return utteranceId;
+}
+
+uint32_t PythonProcessBridge::submitIntent(const std::string& transcript, const std::string& intentJson,
+                                          CancellationToken* cancel) {
+    const uint32_t utteranceId = beginUtterance();
+    
+    if (cancel && cancel->isCancelled()) {
+        cancelUtterance(utteranceId);
+        return utteranceId;
+    }
+    
+    const std::string payload = "{\"transcription\": " + json::quote(transcript) + ", \"intent\": " + intentJson + "}";
+    if (!m_running || !writeFrame(protocol::MessageType::Intent, utteranceId,
+                                  payload.data(), payload.size())) {
+        completeRequest(utteranceId, "");
+    }
+    
+    return utteranceId;
+}
+
+bool PythonProcessBridge::speculate(const std::string& prefix) {
+    // 응답이 없으므로 발화 ID를 등록하지 않음 (READY와 같이 0 사용)
+    return writeFrame(protocol::MessageType::Speculate, 0, prefix.data(), prefix.size());
 }
 
 std::string PythonProcessBridge::sendCommand(const std::string& command) {
@@ -389,9 +1155,37 @@ std::string PythonProcessBridge::sendCommand(const std::string& command) {
         return "";
     }
     
-    // 명령을 UTF-8 바이트로 변환하여 전송
-    std::vector<uint8_t> cmdBytes(command.begin(), command.end());
-    return sendAudio(cmdBytes);  // 동일한 프로토콜 사용
+    // 명령은 오디오 경로와 별도의 COMMAND 프레임으로 전송
+    const uint32_t requestId = beginUtterance();
+    if (!writeFrame(protocol::MessageType::Command, requestId, command.data(), command.size())) {
+        completeRequest(requestId, "");  // 등록된 요청 정리
+    }
+    
+    return awaitResult(requestId);
+}
+
+bool PythonProcessBridge::writeFrame(
+    protocol::MessageType type, uint32_t utteranceId,
+    const void* payload, size_t size, uint8_t flags)
+{
+    if (!m_running || size > protocol::kMaxPayloadSize) {
+        return false;
+    }
+    
+    // 시퀀스 순서 = 송신 큐 순서가 되도록 락 안에서 번호 부여와 큐 삽입
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    
+    protocol::FrameHeader header;
+    header.type = type;
+    header.flags = flags;
+    header.utteranceId = utteranceId;
+    header.sequence = m_sendSequence;
+    
+    if (!m_channel.send(header, payload, size, std::chrono::steady_clock::now() + m_requestTimeout)) {
+        return false;
+    }
+    ++m_sendSequence;
+    return true;
 }
 
 bool PythonProcessBridge::isRunning() const {
@@ -402,11 +1196,12 @@ bool PythonProcessBridge::isRunning() const {
     
     DWORD exitCode;
     if (GetExitCodeProcess(static_cast<HANDLE>(m_processHandle), &exitCode)) {
-        return exitCode == STILL_ACTIVE;
+        return m_running && exitCode == STILL_ACTIVE;
     }
     return false;
 #else
-    return m_running;
+    // 자식이 죽으면 stdout 파이프가 닫혀 채널이 먼저 감지함
+    return m_running && m_channel.isOpen();
 #endif
 }
 
@@ -0,0 +1,279 @@
+/**
+ * @file python_worker_pool.cpp
+ * @brief PythonWorkerPool 클래스 구현
+ */
+
+#include "python_worker_pool.h"
+#include "latency_trace.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace sion {
+
+PythonWorkerPool::PythonWorkerPool(const WorkerPoolConfig& config)
+    : m_config(config)
+    , m_nextIndex(0)
+    , m_stopping(false)
+    , m_stateChanged(false)
+    , m_restartCount(0)
+{
+    if (m_config.numWorkers == 0) {
+        m_config.numWorkers = 1;
+    }
+}
+
+PythonWorkerPool::~PythonWorkerPool() {
+    stop();
+}
+
+bool PythonWorkerPool::start() {
+    if (m_supervisor.joinable()) {
+        return false;
+    }
+
+    m_stopping = false;
+    m_stateChanged = false;
+    m_slots.assign(m_config.numWorkers, Slot{});
+
+    // 모든 워커를 먼저 띄워 예열을 병렬로 진행
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        m_slots[i].bridge = spawnWorker(i);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + m_config.readyTimeout;
+    size_t ready = 0;
+    for (Slot& slot : m_slots) {
+        if (!slot.bridge) {
+            continue;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (slot.bridge->waitUntilReady(std::max(remaining, std::chrono::milliseconds(0)))) {
+            ++ready;
+        }
+    }
+
+    std::cout << "[PythonWorkerPool] 워커 " << ready << "/" << m_slots.size()
+              << " 예열 완료" << std::endl;
+
+    // 준비되지 않은 워커도 감시 스레드가 계속 관리 (늦게 READY 하거나 재시작)
+    m_supervisor = std::thread(&PythonWorkerPool::supervisorLoop, this);
+    return ready > 0;
+}
+
+void PythonWorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+
+    if (m_supervisor.joinable()) {
+        m_supervisor.join();
+    }
+
+    std::vector<WorkerPtr> workers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Slot& slot : m_slots) {
+            if (slot.bridge) {
+                workers.push_back(std::move(slot.bridge));
+            }
+        }
+        m_slots.clear();
+    }
+
+    // 진행 중인 요청이 워커를 잡고 있어도 프로세스는 여기서 정리
+    for (const WorkerPtr& worker : workers) {
+        worker->stop();
+    }
+}
+
+PythonWorkerPool::WorkerPtr PythonWorkerPool::acquire() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t count = m_slots.size();
+    if (count == 0) {
+        return nullptr;
+    }
+
+    WorkerPtr best;
+    WorkerPtr fallback;
+    size_t bestLoad = std::numeric_limits<size_t>::max();
+    size_t bestIndex = 0;
+
+    // round-robin 위치부터 훑어 동률일 때도 워커가 고르게 선택되도록 함
+    for (size_t n = 0; n < count; ++n) {
+        const size_t index = (m_nextIndex + n) % count;
+        const WorkerPtr& worker = m_slots[index].bridge;
+        if (!worker || !worker->isRunning()) {
+            continue;
+        }
+        if (!worker->isReady()) {
+            if (!fallback) {
+                fallback = worker;
+            }
+            continue;
+        }
+
+        if (m_config.policy == DispatchPolicy::RoundRobin) {
+            best = worker;
+            bestIndex = index;
+            break;
+        }
+
+        const size_t load = worker->pendingRequests();
+        if (load < bestLoad) {
+            best = worker;
+            bestLoad = load;
+            bestIndex = index;
+        }
+    }
+
+    if (best) {
+        m_nextIndex = (bestIndex + 1) % count;
+        return best;
+    }
+    return fallback;
+}
+
+std::string PythonWorkerPool::sendCommand(const std::string& command) {
+    WorkerPtr worker = acquire();
+    if (!worker) {
+        std::cerr << "[PythonWorkerPool] 사용 가능한 워커가 없습니다" << std::endl;
+        return "";
+    }
+    return worker->sendCommand(command);
+}
+
+size_t PythonWorkerPool::readyWorkers() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(std::count_if(m_slots.begin(), m_slots.end(), [](const Slot& slot) {
+        return slot.bridge && slot.bridge->isReady();
+    }));
+}
+
+size_t PythonWorkerPool::pendingRequests() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t pending = 0;
+    for (const Slot& slot : m_slots) {
+        if (slot.bridge) {
+            pending += slot.bridge->pendingRequests();
+        }
+    }
+    return pending;
+}
+
+PythonWorkerPool::WorkerPtr PythonWorkerPool::spawnWorker(size_t index) {
+    auto worker = std::make_shared<PythonProcessBridge>(m_config.pythonPath, m_config.scriptPath,
+                                                        m_config.extraArgs);
+    worker->setRequestTimeout(m_config.requestTimeout);
+    // 종료/READY를 감시 스레드에 바로 알림 (I/O 스레드에서 호출, 풀 락을 잡은 채 워커를 stop()하지 않음)
+    worker->setStateCallback([this] {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stateChanged = true;
+        }
+        m_cv.notify_all();
+    });
+    if (!worker->start()) {
+        std::cerr << "[PythonWorkerPool] 워커 " << index << " 시작 실패" << std::endl;
+        return nullptr;
+    }
+    return worker;
+}
+
+void PythonWorkerPool::supervisorLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_stopping) {
+        // 재시작 대기 중인 슬롯이 있으면 가장 이른 예정 시각까지, 없으면 알림이 올 때까지
+        bool restartPending = false;
+        std::chrono::steady_clock::time_point nextRestart = std::chrono::steady_clock::time_point::max();
+        for (const Slot& slot : m_slots) {
+            if (!slot.bridge) {
+                restartPending = true;
+                nextRestart = std::min(nextRestart, slot.nextRestart);
+            }
+        }
+        const auto woken = [this] { return m_stopping || m_stateChanged; };
+        if (restartPending) {
+            m_cv.wait_until(lock, nextRestart, woken);
+        } else {
+            m_cv.wait(lock, woken);
+        }
+        if (m_stopping) {
+            break;
+        }
+        m_stateChanged = false;
+
+        const auto now = std::chrono::steady_clock::now();
+        std::vector<WorkerPtr> dead;
+        std::vector<size_t> toSpawn;
+
+        for (size_t i = 0; i < m_slots.size(); ++i) {
+            Slot& slot = m_slots[i];
+
+            if (slot.bridge) {
+                if (slot.bridge->isRunning()) {
+                    if (slot.bridge->isReady()) {
+                        slot.backoff = std::chrono::milliseconds(0);   // 정상 동작 확인 → 백오프 초기화
+                    }
+                    continue;
+                }
+
+                // 죽은 워커: 연속 실패일수록 재시작 간격을 늘림
+                slot.backoff = slot.backoff.count() == 0
+                    ? m_config.restartBackoff
+                    : std::min(slot.backoff * 2, m_config.maxRestartBackoff);
+                slot.nextRestart = now + slot.backoff;
+                std::cerr << "[PythonWorkerPool] 워커 " << i << " 종료 감지, "
+                          << slot.backoff.count() << " ms 후 재시작" << std::endl;
+                dead.push_back(std::move(slot.bridge));
+                continue;
+            }
+
+            if (now >= slot.nextRestart) {
+                toSpawn.push_back(i);
+                // 시작 실패 시 다음 시도도 백오프를 따름
+                slot.backoff = slot.backoff.count() == 0
+                    ? m_config.restartBackoff
+                    : std::min(slot.backoff * 2, m_config.maxRestartBackoff);
+                slot.nextRestart = now + slot.backoff;
+            }
+        }
+
+        if (dead.empty() && toSpawn.empty()) {
+            continue;
+        }
+
+        // 프로세스 회수와 생성은 락 밖에서 (acquire()를 막지 않도록)
+        lock.unlock();
+        for (const WorkerPtr& worker : dead) {
+            worker->stop();
+        }
+        std::vector<std::pair<size_t, WorkerPtr>> spawned;
+        for (size_t index : toSpawn) {
+            if (WorkerPtr worker = spawnWorker(index)) {
+                spawned.emplace_back(index, std::move(worker));
+            }
+        }
+        lock.lock();
+
+        for (auto& entry : spawned) {
+            if (m_stopping || entry.first >= m_slots.size() || m_slots[entry.first].bridge) {
+                lock.unlock();
+                entry.second->stop();
+                lock.lock();
+                continue;
+            }
+            m_slots[entry.first].bridge = std::move(entry.second);
+            ++m_restartCount;
+            trace::increment(trace::Counter::WorkerRestart);
+            std::cout << "[PythonWorkerPool] 워커 " << entry.first << " 재시작 (예열 중)" << std::endl;
+        }
+    }
+}
+
+} // namespace sion
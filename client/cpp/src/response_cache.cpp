@@ -0,0 +1,509 @@
+/**
+ * @file response_cache.cpp
+ * @brief ResponseCache 클래스 구현
+ */
+
+#include "response_cache.h"
+#include "json_util.h"
+#include "latency_trace.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace sion {
+
+namespace {
+
+constexpr char kFileMagic[4] = {'S', 'R', 'C', '1'};
+constexpr uint32_t kFileVersion = 1;
+
+// 손상된 파일이 큰 할당을 일으키지 않도록 제한
+constexpr uint32_t kMaxStoredEntries = 1u << 20;
+constexpr uint32_t kMaxStoredString = 1u << 20;
+
+// 지문: 유효 구간을 17개 시간 구간 × 9개 멜 대역 평균으로 줄인 뒤
+// (인접 대역 차)의 시간 변화 부호를 비트로 사용 (16 × 8 = 128비트, 음량 변화에 둔감)
+constexpr size_t kFingerprintBands = 9;
+constexpr size_t kFingerprintSegments = 17;
+
+// 가장 큰 프레임보다 30 dB(자연로그 파워 기준 ln 1000) 이상 낮은 앞뒤 프레임은 무음으로 제외
+constexpr float kActiveRange = 6.9f;
+
+// 가장 큰 프레임이 이보다 작으면 발화가 없는 것으로 봄 (약 -50 dBFS 백색 잡음 수준)
+constexpr float kMinPeakEnergy = -4.0f;
+
+int64_t wallClockSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int hammingDistance(const AudioFingerprint& a, const AudioFingerprint& b) {
+    return static_cast<int>(std::bitset<64>(a.bits[0] ^ b.bits[0]).count()
+                          + std::bitset<64>(a.bits[1] ^ b.bits[1]).count());
+}
+
+bool similarDuration(const AudioFingerprint& a, const AudioFingerprint& b, float maxRatio) {
+    const float longer = static_cast<float>(std::max(a.durationMs, b.durationMs));
+    const float shorter = static_cast<float>(std::min(a.durationMs, b.durationMs));
+    return shorter > 0.0f && longer <= shorter * maxRatio;
+}
+
+void writeU32(std::ostream& out, uint32_t value) {
+    const char bytes[4] = {static_cast<char>(value), static_cast<char>(value >> 8),
+                           static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+    out.write(bytes, sizeof(bytes));
+}
+
+void writeU64(std::ostream& out, uint64_t value) {
+    writeU32(out, static_cast<uint32_t>(value));
+    writeU32(out, static_cast<uint32_t>(value >> 32));
+}
+
+void writeString(std::ostream& out, const std::string& text) {
+    writeU32(out, static_cast<uint32_t>(text.size()));
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+bool readU32(std::istream& in, uint32_t& value) {
+    unsigned char bytes[4];
+    if (!in.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+        return false;
+    }
+    value = static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+          | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    return true;
+}
+
+bool readU64(std::istream& in, uint64_t& value) {
+    uint32_t low = 0, high = 0;
+    if (!readU32(in, low) || !readU32(in, high)) {
+        return false;
+    }
+    value = static_cast<uint64_t>(low) | (static_cast<uint64_t>(high) << 32);
+    return true;
+}
+
+bool readString(std::istream& in, std::string& text) {
+    uint32_t size = 0;
+    if (!readU32(in, size) || size > kMaxStoredString) {
+        return false;
+    }
+    text.resize(size);
+    return size == 0 || static_cast<bool>(in.read(&text[0], size));
+}
+
+/**
+ * @brief 의도 JSON의 의도 이름 ({"intent": "..."} 또는 NLU 서비스 응답 {"intent": {"name": "..."}})
+ */
+bool intentName(const std::string& intent, std::string& name) {
+    if (json::getString(intent, "intent", name)) {
+        return true;
+    }
+    std::string nested;
+    return json::getRaw(intent, "intent", nested) && json::getString(nested, "name", name);
+}
+
+bool isAsciiSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+} // namespace
+
+ResponseCache::ResponseCache(ResponseCacheConfig config)
+    : m_config(std::move(config))
+    , m_intentBytes(0)
+{
+}
+
+std::string ResponseCache::normalize(const std::string& transcript) {
+    std::string out;
+    out.reserve(transcript.size());
+    bool pendingSpace = false;
+    for (const char c : transcript) {
+        if (isAsciiSpace(c)) {
+            pendingSpace = !out.empty();
+            continue;
+        }
+        if (pendingSpace) {
+            out.push_back(' ');
+            pendingSpace = false;
+        }
+        out.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c);
+    }
+
+    // ASR이 붙이는 마지막 문장부호는 같은 명령으로 취급
+    while (!out.empty() && (out.back() == '.' || out.back() == '?' || out.back() == '!'
+                            || out.back() == ',' || out.back() == '~' || out.back() == ' ')) {
+        out.pop_back();
+    }
+    return out;
+}
+
+// ============================================================================
+// 인식 텍스트 → 의도
+// ============================================================================
+
+bool ResponseCache::lookupIntent(const std::string& transcript, std::string& intent) {
+    const std::string key = normalize(transcript);
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto found = m_intentIndex.find(key);
+    if (found != m_intentIndex.end() && found->second->expiresAt <= wallClockSeconds()) {
+        eraseIntentLocked(found->second);
+        found = m_intentIndex.end();
+    }
+    if (found == m_intentIndex.end()) {
+        trace::increment(trace::Counter::TranscriptCacheMiss);
+        return false;
+    }
+
+    m_intents.splice(m_intents.begin(), m_intents, found->second);
+    intent = found->second->intent;
+    trace::increment(trace::Counter::TranscriptCacheHit);
+    return true;
+}
+
+void ResponseCache::storeIntent(const std::string& transcript, const std::string& intent) {
+    std::string key = normalize(transcript);
+    if (key.empty() || intent.empty()) {
+        return;
+    }
+    const int64_t now = wallClockSeconds();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_intentIndex.find(key);
+    if (found != m_intentIndex.end() && found->second->expiresAt > now) {
+        // 캐시된 의도로 처리한 발화가 다시 저장되어도 TTL이 계속 늘어나지 않도록 유지
+        m_intents.splice(m_intents.begin(), m_intents, found->second);
+        return;
+    }
+    insertIntentLocked(std::move(key), intent, now + m_config.ttl.count());
+}
+
+void ResponseCache::insertIntentLocked(std::string key, std::string intent, int64_t expiresAt) {
+    auto found = m_intentIndex.find(key);
+    if (found != m_intentIndex.end()) {
+        eraseIntentLocked(found->second);
+    }
+
+    m_intents.push_front(IntentEntry{std::move(key), std::move(intent), expiresAt});
+    m_intentIndex[m_intents.front().key] = m_intents.begin();
+    m_intentBytes += entryBytes(m_intents.front());
+
+    while (!m_intents.empty() && (m_intents.size() > m_config.maxEntries || m_intentBytes > m_config.maxBytes)) {
+        eraseIntentLocked(std::prev(m_intents.end()));
+    }
+}
+
+void ResponseCache::eraseIntentLocked(IntentList::iterator it) {
+    m_intentBytes -= entryBytes(*it);
+    m_intentIndex.erase(it->key);
+    m_intents.erase(it);
+}
+
+size_t ResponseCache::entryBytes(const IntentEntry& entry) {
+    // 목록/색인 노드 오버헤드는 항목 크기로 근사
+    return entry.key.size() + entry.intent.size() + sizeof(IntentEntry);
+}
+
+// ============================================================================
+// 오디오 지문 → 인식 텍스트
+// ============================================================================
+
+bool ResponseCache::computeFingerprint(const int16_t* samples, size_t sampleCount, int sampleRate,
+                                       AudioFingerprint& out) {
+    out = AudioFingerprint{};
+    std::lock_guard<std::mutex> lock(m_frontendMutex);
+
+    if (!m_frontend.isConfigured() || m_frontend.getConfig().sampleRate != sampleRate) {
+        // 25 ms 창 / 10 ms 간격, 음성 대역 위주의 넓은 대역 9개
+        LogMelConfig config;
+        config.sampleRate = sampleRate;
+        config.frameLength = sampleRate / 40;
+        config.hopLength = sampleRate / 100;
+        config.fftSize = 16;
+        while (config.fftSize < config.frameLength) {
+            config.fftSize <<= 1;
+        }
+        config.numMels = static_cast<int>(kFingerprintBands);
+        config.lowHz = 100.0f;
+        config.highHz = std::min(4000.0f, sampleRate / 2.0f);
+        if (!m_frontend.configure(config)) {
+            return false;
+        }
+    }
+
+    const size_t frameLength = static_cast<size_t>(m_frontend.getConfig().frameLength);
+    const size_t hopLength = static_cast<size_t>(m_frontend.getConfig().hopLength);
+    if (sampleCount < frameLength) {
+        return false;
+    }
+    const size_t frames = 1 + (sampleCount - frameLength) / hopLength;
+
+    m_melFrames.resize(frames * kFingerprintBands);
+    m_frameEnergy.resize(frames);
+    for (size_t f = 0; f < frames; ++f) {
+        float* mels = m_melFrames.data() + f * kFingerprintBands;
+        m_frontend.compute(samples + f * hopLength, mels);
+        m_frameEnergy[f] = *std::max_element(mels, mels + kFingerprintBands);
+    }
+
+    const float peak = *std::max_element(m_frameEnergy.begin(), m_frameEnergy.end());
+    if (peak < kMinPeakEnergy) {
+        return false;
+    }
+    const float floor = peak - kActiveRange;
+    size_t first = 0;
+    while (m_frameEnergy[first] < floor) {
+        ++first;
+    }
+    size_t last = frames - 1;
+    while (m_frameEnergy[last] < floor) {
+        --last;
+    }
+    const size_t active = last - first + 1;
+    if (active < kFingerprintSegments) {
+        return false;
+    }
+
+    float bands[kFingerprintSegments][kFingerprintBands] = {};
+    size_t counts[kFingerprintSegments] = {};
+    for (size_t f = first; f <= last; ++f) {
+        const size_t segment = (f - first) * kFingerprintSegments / active;
+        const float* mels = m_melFrames.data() + f * kFingerprintBands;
+        for (size_t b = 0; b < kFingerprintBands; ++b) {
+            bands[segment][b] += mels[b];
+        }
+        ++counts[segment];
+    }
+    for (size_t s = 0; s < kFingerprintSegments; ++s) {
+        for (size_t b = 0; b < kFingerprintBands; ++b) {
+            bands[s][b] /= static_cast<float>(counts[s]);
+        }
+    }
+
+    size_t bit = 0;
+    for (size_t s = 1; s < kFingerprintSegments; ++s) {
+        for (size_t b = 0; b + 1 < kFingerprintBands; ++b, ++bit) {
+            const float delta = (bands[s][b] - bands[s][b + 1]) - (bands[s - 1][b] - bands[s - 1][b + 1]);
+            if (delta > 0.0f) {
+                out.bits[bit / 64] |= uint64_t{1} << (bit % 64);
+            }
+        }
+    }
+    out.durationMs = static_cast<uint32_t>(active * hopLength * 1000 / static_cast<size_t>(sampleRate));
+    return true;
+}
+
+bool ResponseCache::lookupTranscript(const AudioFingerprint& fingerprint, std::string& transcript) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto best = m_fingerprints.end();
+    int bestDistance = m_config.maxHammingDistance + 1;
+    for (auto it = m_fingerprints.begin(); it != m_fingerprints.end(); ++it) {
+        if (!similarDuration(fingerprint, it->fingerprint, m_config.maxDurationRatio)) {
+            continue;
+        }
+        const int distance = hammingDistance(fingerprint, it->fingerprint);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = it;
+        }
+    }
+
+    if (best == m_fingerprints.end()) {
+        trace::increment(trace::Counter::FingerprintCacheMiss);
+        return false;
+    }
+    m_fingerprints.splice(m_fingerprints.begin(), m_fingerprints, best);
+    transcript = best->transcript;
+    trace::increment(trace::Counter::FingerprintCacheHit);
+    return true;
+}
+
+void ResponseCache::storeTranscript(const AudioFingerprint& fingerprint, const std::string& transcript) {
+    if (!fingerprint.isValid() || transcript.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    insertFingerprintLocked(fingerprint, transcript);
+}
+
+void ResponseCache::insertFingerprintLocked(const AudioFingerprint& fingerprint, std::string transcript) {
+    // 같은 텍스트로 이미 가까운 지문이 있으면 최신 지문으로 교체 (같은 명령이 목록을 채우지 않도록)
+    for (auto it = m_fingerprints.begin(); it != m_fingerprints.end(); ++it) {
+        if (it->transcript == transcript
+            && hammingDistance(fingerprint, it->fingerprint) <= m_config.maxHammingDistance) {
+            m_fingerprints.erase(it);
+            break;
+        }
+    }
+
+    m_fingerprints.push_front(FingerprintEntry{fingerprint, std::move(transcript)});
+    while (m_fingerprints.size() > m_config.maxFingerprints) {
+        m_fingerprints.pop_back();
+    }
+}
+
+void ResponseCache::storeResult(const std::string& result, const AudioFingerprint* fingerprint) {
+    std::string transcription;
+    if (!json::getString(result, "transcription", transcription) || transcription.empty()) {
+        return;
+    }
+    if (fingerprint && m_config.fingerprint) {
+        storeTranscript(*fingerprint, transcription);
+    }
+
+    // 의도를 알 수 없는 발화는 다음에 다시 NLU를 거치도록 저장하지 않음
+    std::string intent;
+    std::string name;
+    if (json::getRaw(result, "intent", intent) && !intent.empty() && intent[0] == '{'
+        && intentName(intent, name) && !name.empty() && name != "unknown") {
+        storeIntent(transcription, intent);
+    }
+}
+
+size_t ResponseCache::intentCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_intents.size();
+}
+
+size_t ResponseCache::fingerprintCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fingerprints.size();
+}
+
+// ============================================================================
+// 저장/복원
+// ============================================================================
+//
+// 형식 (리틀 엔디안): "SRC1", version, intentCount, fingerprintCount
+//   의도: expiresAt(u64), key, intent (각 문자열은 u32 길이 + 바이트)
+//   지문: bits0, bits1 (u64), durationMs (u32), transcript
+// 두 목록 모두 최근 사용 순서대로 저장합니다.
+
+bool ResponseCache::save() const {
+    if (m_config.path.empty()) {
+        return false;
+    }
+    const std::string temporary = m_config.path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[ResponseCache] 저장 파일을 열 수 없습니다: " << temporary << std::endl;
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const int64_t now = wallClockSeconds();
+        uint32_t live = 0;
+        for (const IntentEntry& entry : m_intents) {
+            live += entry.expiresAt > now ? 1 : 0;
+        }
+
+        out.write(kFileMagic, sizeof(kFileMagic));
+        writeU32(out, kFileVersion);
+        writeU32(out, live);
+        writeU32(out, static_cast<uint32_t>(m_fingerprints.size()));
+        for (const IntentEntry& entry : m_intents) {
+            if (entry.expiresAt > now) {
+                writeU64(out, static_cast<uint64_t>(entry.expiresAt));
+                writeString(out, entry.key);
+                writeString(out, entry.intent);
+            }
+        }
+        for (const FingerprintEntry& entry : m_fingerprints) {
+            writeU64(out, entry.fingerprint.bits[0]);
+            writeU64(out, entry.fingerprint.bits[1]);
+            writeU32(out, entry.fingerprint.durationMs);
+            writeString(out, entry.transcript);
+        }
+        if (!out.flush()) {
+            std::cerr << "[ResponseCache] 저장 실패: " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    // 기존 파일을 원자적으로 교체 (중간에 종료돼도 이전 파일이나 새 파일 중 하나는 남음)
+#ifdef _WIN32
+    if (!MoveFileExA(temporary.c_str(), m_config.path.c_str(),
+                     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+#else
+    if (std::rename(temporary.c_str(), m_config.path.c_str()) != 0) {
+#endif
+        std::cerr << "[ResponseCache] 저장 파일 교체 실패: " << m_config.path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ResponseCache::load() {
+    if (m_config.path.empty()) {
+        return false;
+    }
+    std::ifstream in(m_config.path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    char magic[sizeof(kFileMagic)] = {};
+    uint32_t version = 0, intentCount = 0, fingerprintCount = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kFileMagic)
+        || !readU32(in, version) || version != kFileVersion
+        || !readU32(in, intentCount) || !readU32(in, fingerprintCount)
+        || intentCount > kMaxStoredEntries || fingerprintCount > kMaxStoredEntries) {
+        std::cerr << "[ResponseCache] 지원하지 않는 캐시 파일: " << m_config.path << std::endl;
+        return false;
+    }
+
+    std::vector<IntentEntry> intents(intentCount);
+    for (IntentEntry& entry : intents) {
+        uint64_t expiresAt = 0;
+        if (!readU64(in, expiresAt) || !readString(in, entry.key) || !readString(in, entry.intent)) {
+            std::cerr << "[ResponseCache] 캐시 파일이 손상되었습니다: " << m_config.path << std::endl;
+            return false;
+        }
+        entry.expiresAt = static_cast<int64_t>(expiresAt);
+    }
+    std::vector<FingerprintEntry> fingerprints(fingerprintCount);
+    for (FingerprintEntry& entry : fingerprints) {
+        if (!readU64(in, entry.fingerprint.bits[0]) || !readU64(in, entry.fingerprint.bits[1])
+            || !readU32(in, entry.fingerprint.durationMs) || !readString(in, entry.transcript)) {
+            std::cerr << "[ResponseCache] 캐시 파일이 손상되었습니다: " << m_config.path << std::endl;
+            return false;
+        }
+    }
+
+    // 오래 쓰지 않은 항목부터 넣어 최근 사용 순서와 상한 적용을 그대로 재현
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const int64_t now = wallClockSeconds();
+    for (auto it = intents.rbegin(); it != intents.rend(); ++it) {
+        if (it->expiresAt > now && !it->key.empty()) {
+            insertIntentLocked(std::move(it->key), std::move(it->intent), it->expiresAt);
+        }
+    }
+    if (m_config.fingerprint) {
+        for (auto it = fingerprints.rbegin(); it != fingerprints.rend(); ++it) {
+            if (it->fingerprint.isValid() && !it->transcript.empty()) {
+                insertFingerprintLocked(it->fingerprint, std::move(it->transcript));
+            }
+        }
+    }
+
+    std::cout << "[ResponseCache] 캐시 로드: 의도 " << m_intents.size() << "개, 지문 "
+              << m_fingerprints.size() << "개" << std::endl;
+    return true;
+}
+
+} // namespace sion
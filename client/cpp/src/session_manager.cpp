@@ -0,0 +1,178 @@
+/**
+ * @file session_manager.cpp
+ * @brief SessionManager 클래스 구현
+ */
+
+#include "session_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace sion {
+
+namespace {
+
+// 세션의 capture/send/result 단계는 각각 직렬이지만 녹음과 응답 대기가 스레드를 오래 잡으므로,
+// 모든 세션이 녹음과 응답 대기 중이어도 send가 밀리지 않도록 단계마다 하나씩
+constexpr size_t kThreadsPerSession = 3;
+
+} // namespace
+
+SessionManager::SessionManager(SessionManagerConfig config, PythonWorkerPool& workers,
+                               SharedAudioRing* sharedAudio)
+    : m_config(std::move(config))
+    , m_workers(workers)
+    , m_sharedAudio(sharedAudio)
+    , m_stopping(false)
+{
+    if (m_config.devices.empty()) {
+        m_config.devices.push_back(m_config.audio.device);
+    }
+}
+
+SessionManager::~SessionManager() {
+    shutdown();
+}
+
+bool SessionManager::start() {
+    if (!m_sessions.empty()) {
+        return true;
+    }
+
+    const size_t count = m_config.devices.size();
+    const size_t required = count * kThreadsPerSession;
+    if (m_config.threads > 0 && m_config.threads < required) {
+        std::cerr << "[SessionManager] 공유 스레드 " << m_config.threads << "개로는 단계가 서로 막을 수 있어 "
+                  << required << "개로 늘립니다" << std::endl;
+    }
+    const size_t threads = std::max(m_config.threads, required);
+    m_executor = std::make_unique<ThreadPool>(threads, "sessions");
+
+    for (size_t i = 0; i < count; ++i) {
+        auto session = std::make_unique<Session>();
+        // 장치가 하나이면 세션 0 (요청 ID와 프로토콜이 단일 장치 때와 같음)
+        session->id = count > 1 ? static_cast<uint32_t>(i + 1) : 0;
+        session->device = m_config.devices[i];
+
+        AudioConfig audio = m_config.audio;
+        audio.device = session->device;
+        session->capture = std::make_unique<AudioCapture>(audio);
+
+        if (!m_config.wakeWord.modelPath.empty()) {
+            session->wakeWord = std::make_unique<WakeWordDetector>(m_config.wakeWord);
+            if (session->wakeWord->load(audio.sampleRate)) {
+                // 스트림이 initialize()에서 시작되므로 그 전에 연결
+                WakeWordDetector* detector = session->wakeWord.get();
+                session->capture->setStandbyCallback([detector](Span<const int16_t> frame) { detector->feed(frame); });
+            } else {
+                std::cerr << "[SessionManager] 세션 " << session->id << " 웨이크워드 모델 로드 실패" << std::endl;
+                session->wakeWord.reset();
+            }
+        }
+
+        const std::string label = session->device.empty() ? "기본 장치" : session->device;
+        if (!session->capture->initialize()) {
+            std::cerr << "[SessionManager] 캡처 장치를 열 수 없어 건너뜁니다: " << label << std::endl;
+            continue;
+        }
+        if (session->wakeWord && !session->capture->isStandby()) {
+            std::cerr << "[SessionManager] 세션 " << session->id
+                      << "은 상시 캡처가 아니어서 웨이크워드를 사용할 수 없습니다" << std::endl;
+            session->wakeWord.reset();
+        }
+
+        session->pipeline = std::make_unique<VoicePipeline>(*session->capture, m_config.vad, m_workers,
+                                                            m_config.maxInFlight, m_sharedAudio,
+                                                            m_executor.get());
+        session->pipeline->setSessionId(session->id);
+
+        std::cout << "[SessionManager] 세션 " << session->id << ": " << label << std::endl;
+        m_sessions.push_back(std::move(session));
+    }
+
+    if (m_sessions.empty()) {
+        m_executor->shutdown();
+        return false;
+    }
+
+    std::cout << "[SessionManager] 세션 " << m_sessions.size() << "개, 공유 스레드 "
+              << m_executor->threadCount() << "개" << std::endl;
+    return true;
+}
+
+bool SessionManager::startWakeWord(WakeWordCallback callback) {
+    if (wakeWordSessions() == 0 || m_wakeThread.joinable()) {
+        return false;
+    }
+
+    m_wakeWordCallback = std::move(callback);
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = false;
+    }
+    m_wakeThread = std::thread(&SessionManager::runWakeWord, this);
+    return true;
+}
+
+size_t SessionManager::wakeWordSessions() const {
+    return static_cast<size_t>(std::count_if(m_sessions.begin(), m_sessions.end(),
+                                             [](const auto& session) { return session->wakeWord != nullptr; }));
+}
+
+void SessionManager::forEachPipeline(const std::function<void(VoicePipeline&)>& fn) {
+    for (const auto& session : m_sessions) {
+        fn(*session->pipeline);
+    }
+}
+
+size_t SessionManager::cancelAll() {
+    size_t cancelled = 0;
+    for (const auto& session : m_sessions) {
+        cancelled += session->pipeline->cancelAll();
+    }
+    return cancelled;
+}
+
+void SessionManager::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wakeCv.notify_all();
+    if (m_wakeThread.joinable()) {
+        m_wakeThread.join();
+    }
+
+    // 파이프라인이 모두 비운 뒤에 공유 풀을 정리
+    for (const auto& session : m_sessions) {
+        session->pipeline->shutdown();
+    }
+    if (m_executor) {
+        m_executor->shutdown();
+    }
+}
+
+void SessionManager::runWakeWord() {
+    const auto pollInterval = std::chrono::milliseconds(std::max(1, m_config.wakeWord.pollIntervalMs));
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+
+    while (!m_stopping) {
+        m_wakeCv.wait_for(lock, pollInterval, [this] { return m_stopping; });
+        if (m_stopping) {
+            break;
+        }
+        lock.unlock();
+
+        for (size_t i = 0; i < m_sessions.size(); ++i) {
+            WakeWordDetector* detector = m_sessions[i]->wakeWord.get();
+            if (detector && detector->drain()) {
+                m_wakeWordCallback(i, detector->lastScore());
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+} // namespace sion
@@ -0,0 +1,185 @@
+/**
+ * @file shared_audio_ring.cpp
+ * @brief SharedAudioRing 클래스 구현
+ */
+
+#include "shared_audio_ring.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace sion {
+
+namespace {
+
+constexpr size_t kSlotAlignment = 64;
+
+void putU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+} // namespace
+
+SharedAudioRing::SharedAudioRing()
+    : m_base(nullptr)
+    , m_mappedSize(0)
+    , m_slotSamples(0)
+    , m_slotStride(0)
+#ifdef _WIN32
+    , m_mapping(nullptr)
+#endif
+{
+}
+
+SharedAudioRing::~SharedAudioRing() {
+    close();
+}
+
+bool SharedAudioRing::create(const std::string& name, size_t slotCount, size_t slotSamples, int sampleRate) {
+    if (isOpen() || slotCount == 0 || slotSamples == 0) {
+        return false;
+    }
+
+    const size_t slotBytes = slotSamples * sizeof(int16_t);
+    const size_t stride = (slotBytes + kSlotAlignment - 1) / kSlotAlignment * kSlotAlignment;
+    const size_t totalSize = kHeaderSize + stride * slotCount;
+
+#ifdef _WIN32
+    const unsigned long long size64 = totalSize;
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(size64 >> 32),
+                                        static_cast<DWORD>(size64 & 0xFFFFFFFFu),
+                                        name.c_str());
+    if (!mapping || GetLastError() == ERROR_ALREADY_EXISTS) {
+        std::cerr << "[SharedAudioRing] 파일 매핑 생성 실패: " << GetLastError() << std::endl;
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, totalSize);
+    if (!view) {
+        std::cerr << "[SharedAudioRing] MapViewOfFile 실패: " << GetLastError() << std::endl;
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+#else
+    const std::string shmName = "/" + name;
+    const int fd = ::shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << "[SharedAudioRing] shm_open 실패: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(totalSize)) != 0) {
+        std::cerr << "[SharedAudioRing] ftruncate 실패: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        ::shm_unlink(shmName.c_str());
+        return false;
+    }
+
+    void* view = ::mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);   // 매핑은 fd와 무관하게 유지됨
+    if (view == MAP_FAILED) {
+        std::cerr << "[SharedAudioRing] mmap 실패: " << std::strerror(errno) << std::endl;
+        ::shm_unlink(shmName.c_str());
+        return false;
+    }
+#endif
+
+    m_name = name;
+    m_base = static_cast<uint8_t*>(view);
+    m_mappedSize = totalSize;
+    m_slotSamples = slotSamples;
+    m_slotStride = stride;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inUse.assign(slotCount, false);
+    }
+
+    // 워커가 레이아웃을 검증할 수 있도록 헤더 기록
+    std::memset(m_base, 0, kHeaderSize);
+    putU32(m_base, kMagic);
+    putU32(m_base + 4, kVersion);
+    putU32(m_base + 8, static_cast<uint32_t>(slotCount));
+    putU32(m_base + 12, static_cast<uint32_t>(slotSamples));
+    putU32(m_base + 16, static_cast<uint32_t>(sampleRate));
+    putU32(m_base + 20, static_cast<uint32_t>(kHeaderSize));
+    putU32(m_base + 24, static_cast<uint32_t>(stride));
+
+    return true;
+}
+
+void SharedAudioRing::close() {
+    if (!m_base) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_base);
+    if (m_mapping) {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        m_mapping = nullptr;
+    }
+#else
+    ::munmap(m_base, m_mappedSize);
+    ::shm_unlink(("/" + m_name).c_str());
+#endif
+
+    m_base = nullptr;
+    m_mappedSize = 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inUse.clear();
+}
+
+int SharedAudioRing::acquireSlot() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_inUse.size(); ++i) {
+        if (!m_inUse[i]) {
+            m_inUse[i] = true;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void SharedAudioRing::releaseSlot(int slot) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (slot >= 0 && static_cast<size_t>(slot) < m_inUse.size()) {
+        m_inUse[slot] = false;
+    }
+}
+
+int16_t* SharedAudioRing::slotData(int slot) {
+    if (!m_base || slot < 0 || static_cast<size_t>(slot) >= slotCount()) {
+        return nullptr;
+    }
+    return reinterpret_cast<int16_t*>(m_base + kHeaderSize + m_slotStride * static_cast<size_t>(slot));
+}
+
+size_t SharedAudioRing::freeSlots() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(std::count(m_inUse.begin(), m_inUse.end(), false));
+}
+
+} // namespace sion
@@ -0,0 +1,159 @@
+/**
+ * @file thread_pool.cpp
+ * @brief ThreadPool 클래스 구현
+ */
+
+#include "thread_pool.h"
+
+#include <exception>
+#include <iostream>
+
+namespace sion {
+
+ThreadPool::ThreadPool(size_t numThreads, std::string name)
+    : m_name(std::move(name))
+    , m_stopping(false)
+{
+    if (numThreads == 0) {
+        numThreads = 1;
+    }
+
+    m_threads.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    shutdown();
+}
+
+bool ThreadPool::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return false;
+        }
+        m_queue.push_back(std::move(task));
+    }
+    m_cv.notify_one();
+    return true;
+}
+
+void ThreadPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping && m_threads.empty()) {
+            return;
+        }
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+size_t ThreadPool::pendingTasks() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;  // 종료 요청 + 남은 작업 없음
+            }
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "[ThreadPool:" << m_name << "] 작업 예외: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "[ThreadPool:" << m_name << "] 알 수 없는 작업 예외" << std::endl;
+        }
+    }
+}
+
+SerialQueue::SerialQueue(ThreadPool& pool, std::string name)
+    : m_pool(pool)
+    , m_name(std::move(name))
+    , m_scheduled(false)
+    , m_stopping(false)
+{
+}
+
+SerialQueue::~SerialQueue() {
+    shutdown();
+}
+
+bool SerialQueue::post(Task task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) {
+        return false;
+    }
+    m_queue.push_back(std::move(task));
+    if (m_scheduled) {
+        return true;
+    }
+
+    // 풀 작업은 이 락을 잡은 채 풀 락을 잡지 않으므로 락 안에서 예약해도 교착 없음
+    if (!m_pool.post([this] { runNext(); })) {
+        m_queue.pop_back();
+        return false;
+    }
+    m_scheduled = true;
+    return true;
+}
+
+void SerialQueue::shutdown() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stopping = true;
+    m_idleCv.wait(lock, [this] { return !m_scheduled; });
+}
+
+void SerialQueue::runNext() {
+    while (true) {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "[SerialQueue:" << m_name << "] 작업 예외: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "[SerialQueue:" << m_name << "] 알 수 없는 작업 예외" << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_queue.empty()) {
+                m_scheduled = false;
+                m_idleCv.notify_all();
+                return;
+            }
+        }
+
+        // 다른 직렬 큐와 번갈아 실행되도록 풀 큐 뒤로 (풀이 종료 중이면 이 스레드에서 이어서 실행)
+        if (m_pool.post([this] { runNext(); })) {
+            return;
+        }
+    }
+}
+
+} // namespace sion
@@ -0,0 +1,585 @@
+/**
+ * @file utterance_journal.cpp
+ * @brief UtteranceJournal 클래스 구현 (메모리 매핑 세그먼트)
+ */
+
+#include "utterance_journal.h"
+#include "json_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sion {
+
+namespace {
+
+// 세그먼트 헤더 (32바이트) 뒤에 구간 이름 목록(NUL 구분)이 오고, 이후 8바이트 정렬 레코드가 이어짐:
+//   "SIONJRNL" | u32 version | u32 headerBytes | u32 stageCount | u32 reserved[3]
+// 레코드 헤더 (56바이트):
+//   u32 magic | u32 recordBytes | u64 requestId | i64 wallClockMs | i64 startedAtNs
+//   | u32 sampleRate | u32 sampleCount | u32 transcriptBytes | u32 intentBytes | u32 resultBytes | u32 reserved
+// 이후 i64 구간 지연 × stageCount, 샘플(s16le), 인식 텍스트, 의도 JSON, 결과 JSON
+// 구간은 인덱스가 아닌 이름으로 대응하므로 Stage가 바뀌어도 이전 세그먼트를 읽을 수 있음
+constexpr char kFileMagic[8] = {'S', 'I', 'O', 'N', 'J', 'R', 'N', 'L'};
+constexpr uint32_t kFileVersion = 1;
+constexpr size_t kFileHeaderBytes = 32;
+constexpr uint32_t kRecordMagic = 0x31524A53;   // "SJR1"
+constexpr size_t kRecordHeaderBytes = 56;
+constexpr size_t kAlignment = 8;
+
+constexpr const char* kSegmentPrefix = "utterances-";
+
+size_t alignUp(size_t value) {
+    return (value + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+void putU32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+void putU64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint32_t getU32(const uint8_t* in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t getU64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief 세그먼트 헤더 크기 (구간 이름 목록 포함)
+ */
+size_t segmentHeaderBytes() {
+    size_t bytes = kFileHeaderBytes;
+    for (size_t s = 0; s < trace::kStageCount; ++s) {
+        bytes += std::strlen(trace::stageName(static_cast<trace::Stage>(s))) + 1;
+    }
+    return alignUp(bytes);
+}
+
+/**
+ * @brief 파일 이름의 세그먼트 번호 (utterances-NNNNNN.sionj, 아니면 false)
+ */
+bool segmentIndex(const std::filesystem::path& path, size_t& index) {
+    const std::string stem = path.stem().string();
+    const size_t prefix = std::strlen(kSegmentPrefix);
+    if (path.extension() != UtteranceJournal::kExtension || stem.compare(0, prefix, kSegmentPrefix) != 0
+        || stem.size() == prefix || stem.find_first_not_of("0123456789", prefix) != std::string::npos) {
+        return false;
+    }
+    index = static_cast<size_t>(std::strtoull(stem.c_str() + prefix, nullptr, 10));
+    return true;
+}
+
+/**
+ * @brief 읽기 전용 세그먼트 매핑 (기록 중인 파일도 열 수 있도록 쓰기 공유 허용)
+ */
+class SegmentView {
+public:
+    ~SegmentView() {
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+#else
+        if (m_data) {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+#endif
+    }
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                             nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        LARGE_INTEGER size{};
+        if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+            return false;
+        }
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        m_data = m_mapping ? static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info {};
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            m_size = static_cast<size_t>(info.st_size);
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED) {
+                m_data = static_cast<const uint8_t*>(data);
+                madvise(data, m_size, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+#endif
+        return m_data != nullptr;
+    }
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+};
+
+} // namespace
+
+UtteranceJournal::UtteranceJournal(UtteranceJournalConfig config)
+    : m_config(std::move(config))
+    , m_open(false)
+    , m_pendingBytes(0)
+    , m_totalBytes(0)
+    , m_nextIndex(1)
+    , m_base(nullptr)
+    , m_capacity(0)
+    , m_used(0)
+#ifdef _WIN32
+    , m_file(INVALID_HANDLE_VALUE)
+    , m_mapping(nullptr)
+#else
+    , m_fd(-1)
+#endif
+    , m_writer(1, "journal")
+{
+}
+
+UtteranceJournal::~UtteranceJournal() {
+    close();
+}
+
+bool UtteranceJournal::open() {
+    if (m_open) {
+        return true;
+    }
+    if (m_config.directory.empty()) {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(m_config.directory, error);
+
+    // 이전 실행의 세그먼트를 번호 순으로 이어 받아 전체 상한에 포함
+    std::vector<std::pair<size_t, std::filesystem::path>> existing;
+    for (const auto& entry : std::filesystem::directory_iterator(m_config.directory, error)) {
+        size_t index = 0;
+        if (entry.is_regular_file() && segmentIndex(entry.path(), index)) {
+            existing.emplace_back(index, entry.path());
+        }
+    }
+    if (error) {
+        std::cerr << "[UtteranceJournal] 디렉토리를 열 수 없습니다: " << m_config.directory << std::endl;
+        return false;
+    }
+    std::sort(existing.begin(), existing.end());
+    for (const auto& segment : existing) {
+        const size_t bytes = static_cast<size_t>(std::filesystem::file_size(segment.second, error));
+        m_segments.push_back({segment.second.string(), error ? 0 : bytes});
+        m_totalBytes += m_segments.back().bytes;
+        m_nextIndex = segment.first + 1;
+    }
+
+    if (!openSegment(0)) {
+        return false;
+    }
+    m_open = true;
+    std::cout << "[UtteranceJournal] 발화 저널 기록: " << m_segments.back().path << " (상한 "
+              << (m_config.maxBytes >> 20) << " MB)" << std::endl;
+    return true;
+}
+
+bool UtteranceJournal::begin(uint64_t requestId, const int16_t* samples, size_t sampleCount, int sampleRate,
+                             int64_t startedAtNs) {
+    if (!m_open || sampleCount == 0) {
+        return false;
+    }
+
+    const size_t bytes = sampleCount * sizeof(int16_t);
+    JournalRecord record;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pendingBytes + bytes > m_config.maxPendingBytes) {
+            trace::increment(trace::Counter::JournalDropped);
+            return false;
+        }
+        m_pendingBytes += bytes;
+        if (!m_spare.empty()) {
+            record.samples = std::move(m_spare.back());
+            m_spare.pop_back();
+        }
+    }
+
+    // 복사는 락 밖에서 (다른 세션의 begin()/commit()을 막지 않도록)
+    record.samples.assign(samples, samples + sampleCount);
+    record.requestId = requestId;
+    record.sampleRate = sampleRate;
+    record.startedAtNs = startedAtNs;
+    record.wallClockMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending[requestId] = std::move(record);
+    return true;
+}
+
+void UtteranceJournal::commit(uint64_t requestId, const std::string& result) {
+    auto record = std::make_shared<JournalRecord>();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pending.find(requestId);
+        if (it == m_pending.end()) {
+            return;
+        }
+        *record = std::move(it->second);
+        m_pending.erase(it);
+    }
+    record->result = result;
+
+    const bool posted = m_writer.post([this, record]() {
+        // 구간 지연과 JSON 필드 추출은 저널 스레드에서 (결과 단계를 붙잡지 않도록)
+        record->stageNs = trace::requestDurations(record->requestId);
+        json::getString(record->result, "transcription", record->transcript);
+        json::getRaw(record->result, "intent", record->intent);
+        write(*record);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingBytes -= record->samples.size() * sizeof(int16_t);
+        m_spare.push_back(std::move(record->samples));
+    });
+    if (!posted) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingBytes -= record->samples.size() * sizeof(int16_t);
+        trace::increment(trace::Counter::JournalDropped);
+    }
+}
+
+void UtteranceJournal::discard(uint64_t requestId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_pending.find(requestId);
+    if (it == m_pending.end()) {
+        return;
+    }
+    m_pendingBytes -= it->second.samples.size() * sizeof(int16_t);
+    m_spare.push_back(std::move(it->second.samples));
+    m_pending.erase(it);
+}
+
+void UtteranceJournal::close() {
+    m_writer.shutdown();
+    closeSegment();
+    m_open = false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+    m_pendingBytes = 0;
+    m_spare.clear();
+}
+
+void UtteranceJournal::write(const JournalRecord& record) {
+    const size_t stageBytes = trace::kStageCount * sizeof(int64_t);
+    const size_t sampleBytes = record.samples.size() * sizeof(int16_t);
+    const size_t bytes = alignUp(kRecordHeaderBytes + stageBytes + sampleBytes + record.transcript.size()
+                                 + record.intent.size() + record.result.size());
+
+    if (m_used + bytes > m_capacity) {
+        // 가득 찬 세그먼트는 쓴 만큼 잘라 닫고 다음 세그먼트로 (레코드가 더 크면 그 크기로)
+        closeSegment();
+        if (!openSegment(bytes)) {
+            trace::increment(trace::Counter::JournalDropped);
+            return;
+        }
+    }
+
+    uint8_t* out = m_base + m_used;
+    uint8_t* header = out;
+    putU32(header + 4, static_cast<uint32_t>(bytes));
+    putU64(header + 8, record.requestId);
+    putU64(header + 16, static_cast<uint64_t>(record.wallClockMs));
+    putU64(header + 24, static_cast<uint64_t>(record.startedAtNs));
+    putU32(header + 32, static_cast<uint32_t>(record.sampleRate));
+    putU32(header + 36, static_cast<uint32_t>(record.samples.size()));
+    putU32(header + 40, static_cast<uint32_t>(record.transcript.size()));
+    putU32(header + 44, static_cast<uint32_t>(record.intent.size()));
+    putU32(header + 48, static_cast<uint32_t>(record.result.size()));
+    putU32(header + 52, 0);
+    out += kRecordHeaderBytes;
+
+    for (size_t s = 0; s < trace::kStageCount; ++s) {
+        putU64(out, static_cast<uint64_t>(record.stageNs[s]));
+        out += sizeof(int64_t);
+    }
+    std::memcpy(out, record.samples.data(), sampleBytes);   // 캡처 형식과 같은 리틀 엔디안
+    out += sampleBytes;
+    for (const std::string* text : {&record.transcript, &record.intent, &record.result}) {
+        std::memcpy(out, text->data(), text->size());
+        out += text->size();
+    }
+
+    // 표식을 마지막에 써서 같은 파일을 읽는 쪽이 완성된 레코드만 보게 함
+    std::atomic_thread_fence(std::memory_order_release);
+    putU32(header, kRecordMagic);
+    m_used += bytes;
+    trace::increment(trace::Counter::JournalWritten);
+}
+
+bool UtteranceJournal::openSegment(size_t minBytes) {
+    const size_t headerBytes = segmentHeaderBytes();
+    const size_t capacity = std::max(m_config.segmentBytes, headerBytes + minBytes);
+
+    // 새 세그먼트가 들어갈 자리를 오래된 세그먼트부터 비움
+    while (!m_segments.empty() && m_totalBytes + capacity > m_config.maxBytes) {
+        std::error_code error;
+        std::filesystem::remove(m_segments.front().path, error);
+        m_totalBytes -= m_segments.front().bytes;
+        m_segments.pop_front();
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s%06zu", kSegmentPrefix, m_nextIndex++);
+    const std::string path = (std::filesystem::path(m_config.directory) / (std::string(name) + kExtension)).string();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "[UtteranceJournal] 세그먼트 생성 실패: " << path << " (" << GetLastError() << ")" << std::endl;
+        return false;
+    }
+    const unsigned long long size64 = capacity;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32),
+                                        static_cast<DWORD>(size64 & 0xFFFFFFFFu), nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, capacity) : nullptr;
+    if (!view) {
+        std::cerr << "[UtteranceJournal] 세그먼트 매핑 실패: " << GetLastError() << std::endl;
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        DeleteFileA(path.c_str());
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+#else
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[UtteranceJournal] 세그먼트 생성 실패: " << path << " (" << std::strerror(errno) << ")"
+                  << std::endl;
+        return false;
+    }
+    // 미리 늘려 둔 영역은 0으로 읽히므로 표식이 없는 곳에서 레코드가 끝남
+    void* view = ::ftruncate(fd, static_cast<off_t>(capacity)) == 0
+        ? ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+        : MAP_FAILED;
+    if (view == MAP_FAILED) {
+        std::cerr << "[UtteranceJournal] 세그먼트 매핑 실패: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        ::unlink(path.c_str());
+        return false;
+    }
+    m_fd = fd;
+#endif
+
+    m_base = static_cast<uint8_t*>(view);
+    m_capacity = capacity;
+    m_segments.push_back({path, capacity});
+    m_totalBytes += capacity;
+
+    // 헤더와 구간 이름 목록 (읽는 쪽이 이름으로 구간을 대응)
+    std::memcpy(m_base, kFileMagic, sizeof(kFileMagic));
+    putU32(m_base + 8, kFileVersion);
+    putU32(m_base + 12, static_cast<uint32_t>(headerBytes));
+    putU32(m_base + 16, static_cast<uint32_t>(trace::kStageCount));
+    size_t offset = kFileHeaderBytes;
+    for (size_t s = 0; s < trace::kStageCount; ++s) {
+        const char* stage = trace::stageName(static_cast<trace::Stage>(s));
+        const size_t length = std::strlen(stage) + 1;
+        std::memcpy(m_base + offset, stage, length);
+        offset += length;
+    }
+    m_used = headerBytes;
+    return true;
+}
+
+void UtteranceJournal::closeSegment() {
+    if (!m_base) {
+        return;
+    }
+
+    // 쓰지 않은 꼬리를 잘라 디스크 사용량을 실제 기록만큼으로
+#ifdef _WIN32
+    UnmapViewOfFile(m_base);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    LARGE_INTEGER end{};
+    end.QuadPart = static_cast<LONGLONG>(m_used);
+    if (SetFilePointerEx(static_cast<HANDLE>(m_file), end, nullptr, FILE_BEGIN)) {
+        SetEndOfFile(static_cast<HANDLE>(m_file));
+    }
+    CloseHandle(static_cast<HANDLE>(m_file));
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = nullptr;
+#else
+    ::munmap(m_base, m_capacity);
+    if (::ftruncate(m_fd, static_cast<off_t>(m_used)) != 0) {
+        m_used = m_capacity;
+    }
+    ::close(m_fd);
+    m_fd = -1;
+#endif
+
+    m_totalBytes -= m_segments.back().bytes - m_used;
+    m_segments.back().bytes = m_used;
+    m_base = nullptr;
+    m_capacity = 0;
+    m_used = 0;
+}
+
+size_t UtteranceJournal::forEachRecord(const std::string& path,
+                                       const std::function<bool(size_t index, const JournalRecord& record)>& fn) {
+    SegmentView view;
+    if (!view.open(path) || view.size() < kFileHeaderBytes
+        || std::memcmp(view.data(), kFileMagic, sizeof(kFileMagic)) != 0
+        || getU32(view.data() + 8) != kFileVersion) {
+        return 0;
+    }
+    const uint8_t* data = view.data();
+    const size_t size = view.size();
+    const size_t headerBytes = getU32(data + 12);
+    const size_t stageCount = getU32(data + 16);
+    // 구간 이름은 각각 NUL로 끝나므로 이름 영역보다 많을 수 없음 (손상된 값으로 큰 할당 방지)
+    if (headerBytes < kFileHeaderBytes || headerBytes > size
+        || stageCount > headerBytes - kFileHeaderBytes) {
+        std::cerr << "[UtteranceJournal] 손상된 세그먼트 헤더, 건너뜀: " << path << std::endl;
+        return 0;
+    }
+
+    // 파일의 구간 순서 → 현재 빌드의 Stage (모르는 구간은 버림)
+    std::vector<int> stageMap(stageCount, -1);
+    size_t offset = kFileHeaderBytes;
+    for (size_t s = 0; s < stageCount; ++s) {
+        const char* name = reinterpret_cast<const char*>(data + offset);
+        const size_t length = strnlen(name, headerBytes - offset);
+        if (offset + length >= headerBytes) {
+            std::cerr << "[UtteranceJournal] 손상된 구간 이름 목록, 건너뜀: " << path << std::endl;
+            return 0;
+        }
+        for (size_t known = 0; known < trace::kStageCount; ++known) {
+            if (std::strlen(trace::stageName(static_cast<trace::Stage>(known))) == length
+                && std::memcmp(trace::stageName(static_cast<trace::Stage>(known)), name, length) == 0) {
+                stageMap[s] = static_cast<int>(known);
+            }
+        }
+        offset += length + 1;
+    }
+
+    size_t count = 0;
+    offset = headerBytes;
+    JournalRecord record;
+    while (offset + kRecordHeaderBytes <= size && getU32(data + offset) == kRecordMagic) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint8_t* header = data + offset;
+        const size_t bytes = getU32(header + 4);
+        const size_t sampleCount = getU32(header + 36);
+        const size_t transcriptBytes = getU32(header + 40);
+        const size_t intentBytes = getU32(header + 44);
+        const size_t resultBytes = getU32(header + 48);
+        const size_t needed = kRecordHeaderBytes + stageCount * sizeof(int64_t) + sampleCount * sizeof(int16_t)
+                            + transcriptBytes + intentBytes + resultBytes;
+        if (bytes < needed || bytes % kAlignment != 0 || offset + bytes > size) {
+            std::cerr << "[UtteranceJournal] 손상된 레코드에서 읽기 중단: " << path << " #" << count << std::endl;
+            break;
+        }
+
+        record.requestId = getU64(header + 8);
+        record.wallClockMs = static_cast<int64_t>(getU64(header + 16));
+        record.startedAtNs = static_cast<int64_t>(getU64(header + 24));
+        record.sampleRate = static_cast<int>(getU32(header + 32));
+
+        const uint8_t* in = header + kRecordHeaderBytes;
+        record.stageNs.fill(0);
+        for (size_t s = 0; s < stageCount; ++s) {
+            if (stageMap[s] >= 0) {
+                record.stageNs[static_cast<size_t>(stageMap[s])] = static_cast<int64_t>(getU64(in));
+            }
+            in += sizeof(int64_t);
+        }
+        record.samples.resize(sampleCount);
+        std::memcpy(record.samples.data(), in, sampleCount * sizeof(int16_t));
+        in += sampleCount * sizeof(int16_t);
+        record.transcript.assign(reinterpret_cast<const char*>(in), transcriptBytes);
+        in += transcriptBytes;
+        record.intent.assign(reinterpret_cast<const char*>(in), intentBytes);
+        in += intentBytes;
+        record.result.assign(reinterpret_cast<const char*>(in), resultBytes);
+
+        offset += bytes;
+        if (!fn(count++, record)) {
+            break;
+        }
+    }
+    return count;
+}
+
+bool UtteranceJournal::readRecord(const std::string& path, size_t index, JournalRecord& record) {
+    bool found = false;
+    forEachRecord(path, [&](size_t current, const JournalRecord& candidate) {
+        if (current != index) {
+            return true;
+        }
+        record = candidate;
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+} // namespace sion
@@ -0,0 +1,127 @@
+/**
+ * @file voice_activity_detector.cpp
+ * @brief VoiceActivityDetector 클래스 구현
+ */
+
+#include "voice_activity_detector.h"
+#include "audio_kernels.h"
+
+#include <algorithm>
+
+namespace sion {
+
+namespace {
+
+// 발화 구간 밖에서 잡음 레벨을 따라가는 속도
+constexpr float kNoiseAdaptRate = 0.05f;
+
+} // namespace
+
+VoiceActivityDetector::VoiceActivityDetector(const VadConfig& config)
+    : m_config(config)
+{
+    reset();
+}
+
+void VoiceActivityDetector::reset() {
+    m_state = State::Waiting;
+    m_position = 0;
+    m_calibrationSamples = msToSamples(m_config.calibrationMs);
+    m_noiseSum = 0.0;
+    m_noiseFrames = 0;
+    m_noiseFloor = 0.0f;
+    m_speechRun = 0;
+    m_silenceRun = 0;
+    m_speechStart = 0;
+    m_speechEnd = 0;
+    m_speechDetected = false;
+}
+
+VadEvent VoiceActivityDetector::process(const int16_t* samples, size_t count) {
+    if (m_state == State::Finished || count == 0) {
+        return VadEvent::None;
+    }
+
+    const kernels::FrameFeatures features = kernels::computeFrameFeatures(samples, count);
+    const size_t frameStart = m_position;
+    m_position += count;
+
+    const bool speech = isSpeechFrame(features.rms, features.zcr);
+
+    // 잡음 레벨 추정: 초기 구간은 평균, 이후 무음 프레임으로 천천히 갱신
+    if (!speech && m_state == State::Waiting) {
+        if (frameStart < m_calibrationSamples) {
+            m_noiseSum += features.rms;
+            ++m_noiseFrames;
+            m_noiseFloor = static_cast<float>(m_noiseSum / m_noiseFrames);
+        } else {
+            m_noiseFloor += kNoiseAdaptRate * (features.rms - m_noiseFloor);
+        }
+    }
+
+    if (m_state == State::Waiting) {
+        if (speech) {
+            m_speechRun += count;
+            if (m_speechRun >= msToSamples(m_config.minSpeechMs)) {
+                m_state = State::Speech;
+                m_speechStart = m_position - m_speechRun;
+                m_speechEnd = m_position;
+                m_silenceRun = 0;
+                m_speechDetected = true;
+                return VadEvent::SpeechStart;
+            }
+        } else {
+            m_speechRun = 0;
+            const size_t timeoutSamples =
+                static_cast<size_t>(m_config.noSpeechTimeout * m_config.sampleRate);
+            if (m_position >= timeoutSamples) {
+                m_state = State::Finished;
+                return VadEvent::NoSpeech;
+            }
+        }
+        return VadEvent::None;
+    }
+
+    // State::Speech
+    if (speech) {
+        m_silenceRun = 0;
+        m_speechEnd = m_position;
+    } else {
+        m_silenceRun += count;
+        if (m_silenceRun >= msToSamples(m_config.trailingSilenceMs)) {
+            m_state = State::Finished;
+            return VadEvent::SpeechEnd;
+        }
+    }
+    return VadEvent::None;
+}
+
+size_t VoiceActivityDetector::trimBegin() const {
+    if (!m_speechDetected) {
+        return 0;
+    }
+    const size_t padding = msToSamples(m_config.leadingPaddingMs);
+    return m_speechStart > padding ? m_speechStart - padding : 0;
+}
+
+size_t VoiceActivityDetector::trimEnd(size_t totalSamples) const {
+    if (!m_speechDetected) {
+        return 0;
+    }
+    return std::min(totalSamples, m_speechEnd + msToSamples(m_config.trailingPaddingMs));
+}
+
+size_t VoiceActivityDetector::msToSamples(int ms) const {
+    return static_cast<size_t>(ms) * static_cast<size_t>(m_config.sampleRate) / 1000;
+}
+
+bool VoiceActivityDetector::isSpeechFrame(float rms, float zcr) const {
+    const float threshold = std::max(m_config.minRms, m_noiseFloor * m_config.noiseRatio);
+    if (rms < threshold) {
+        return false;
+    }
+    // 에너지가 임계값의 두 배 이상이면 영교차율과 무관하게 음성으로 판단
+    return zcr <= m_config.maxZcr || rms >= 2.0f * threshold;
+}
+
+} // namespace sion
@@ -0,0 +1,555 @@
+/**
+ * @file voice_pipeline.cpp
+ * @brief VoicePipeline 클래스 구현
+ */
+
+#include "voice_pipeline.h"
+#include "latency_trace.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace sion {
+
+namespace {
+
+// 추측 NLU: 너무 짧은 앞부분(한글 두 글자 미만)은 의도를 알기 어렵고, 요청당 횟수를 제한해 NLU 부하를 묶음
+constexpr size_t kMinSpeculationBytes = 6;
+constexpr size_t kMaxSpeculations = 4;
+
+/**
+ * @brief 연속한 두 중간 결과에서 바뀌지 않은 앞부분 (같으면 전체, 아니면 단어 경계까지)
+ *
+ * 공백에서 자르므로 ASR이 고쳐 쓰는 중인 마지막 단어와 UTF-8 중간 바이트가 빠집니다.
+ */
+std::string stablePrefix(const std::string& previous, const std::string& current) {
+    if (previous == current) {
+        return current;
+    }
+
+    const size_t limit = std::min(previous.size(), current.size());
+    size_t length = 0;
+    while (length < limit && previous[length] == current[length]) {
+        ++length;
+    }
+    const bool wordEnds = (length == current.size() || current[length] == ' ')
+                       && (length == previous.size() || previous[length] == ' ');
+    if (!wordEnds) {
+        const size_t space = length == 0 ? std::string::npos : current.rfind(' ', length - 1);
+        length = space == std::string::npos ? 0 : space;
+    }
+    while (length > 0 && current[length - 1] == ' ') {
+        --length;
+    }
+    return current.substr(0, length);
+}
+
+} // namespace
+
+VoicePipeline::VoicePipeline(AudioCapture& capture, const VadConfig& vadConfig,
+                             PythonWorkerPool& workers, size_t maxInFlight,
+                             SharedAudioRing* sharedAudio, ThreadPool* executor)
+    : m_capture(capture)
+    , m_workers(workers)
+    , m_vad(vadConfig)
+    , m_sharedAudio(sharedAudio && sharedAudio->isOpen() ? sharedAudio : nullptr)
+    // 녹음 중 할당이 없도록 버퍼를 미리 최대 녹음 길이로 확보 (공유 메모리 모드에서는 슬롯이 풀 역할)
+    , m_buffers(m_sharedAudio ? 0 : std::max<size_t>(maxInFlight, 1), capture.maxCaptureSamples())
+    , m_captureBusy(false)
+    , m_inFlight(0)
+    , m_nextRequestId(1)
+    // 단계마다 한 스레드씩이면 기존처럼 세 단계가 서로 막지 않음
+    , m_ownedExecutor(executor ? nullptr : std::make_unique<ThreadPool>(3, "pipeline"))
+    , m_captureStage(executor ? *executor : *m_ownedExecutor, "capture")
+    , m_sendStage(executor ? *executor : *m_ownedExecutor, "send")
+    , m_resultStage(executor ? *executor : *m_ownedExecutor, "result")
+{
+}
+
+VoicePipeline::~VoicePipeline() {
+    shutdown();
+}
+
+uint64_t VoicePipeline::submit() {
+    return startRequest(nullptr);
+}
+
+uint64_t VoicePipeline::beginHold() {
+    auto stop = std::make_shared<CancellationToken>();
+    const uint64_t requestId = startRequest(stop);
+    if (requestId != 0) {
+        std::lock_guard<std::mutex> lock(m_tokenMutex);
+        m_holdStop = stop;
+    }
+    return requestId;
+}
+
+bool VoicePipeline::endHold() {
+    TokenPtr stop;
+    {
+        std::lock_guard<std::mutex> lock(m_tokenMutex);
+        stop = std::move(m_holdStop);
+    }
+    if (!stop) {
+        return false;
+    }
+    stop->cancel();   // capture 단계의 대기를 깨움
+    return true;
+}
+
+uint64_t VoicePipeline::startRequest(TokenPtr stop) {
+    // 녹음은 한 번에 하나만 (파이프라인마다 장치가 하나이므로)
+    bool expected = false;
+    if (!m_captureBusy.compare_exchange_strong(expected, true)) {
+        std::cerr << "[VoicePipeline] 이미 녹음 중입니다" << std::endl;
+        return 0;
+    }
+
+    UtterancePtr utterance = acquireUtterance();
+    if (!utterance) {
+        m_captureBusy = false;
+        std::cerr << "[VoicePipeline] 처리 중인 요청이 너무 많습니다" << std::endl;
+        return 0;
+    }
+    utterance->stop = std::move(stop);
+    utterance->startedAt = trace::now();
+
+    const uint64_t requestId = m_nextRequestId.fetch_add(1);
+    auto token = std::make_shared<CancellationToken>();
+    {
+        std::lock_guard<std::mutex> lock(m_tokenMutex);
+        m_tokens.emplace(requestId, token);
+    }
+    ++m_inFlight;
+
+    if (!m_captureStage.post([this, requestId, token, utterance]() {
+            runCapture(requestId, token, utterance);
+        })) {
+        releaseUtterance(*utterance);
+        {
+            std::lock_guard<std::mutex> lock(m_tokenMutex);
+            m_tokens.erase(requestId);
+        }
+        --m_inFlight;
+        m_captureBusy = false;
+        return 0;
+    }
+
+    return requestId;
+}
+
+size_t VoicePipeline::cancelAll() {
+    std::vector<TokenPtr> tokens;
+    {
+        std::lock_guard<std::mutex> lock(m_tokenMutex);
+        tokens.reserve(m_tokens.size());
+        for (const auto& entry : m_tokens) {
+            tokens.push_back(entry.second);
+        }
+    }
+
+    // 콜백(스트림 중지, CANCEL 전송)은 락 밖에서 실행
+    for (const auto& token : tokens) {
+        token->cancel();
+    }
+    return tokens.size();
+}
+
+protocol::AudioCodec VoicePipeline::setCodec(protocol::AudioCodec codec) {
+    m_encoder = createAudioEncoder(codec);
+    if (!m_encoder) {
+        if (codec != protocol::AudioCodec::Pcm) {
+            std::cerr << "[VoicePipeline] " << protocol::audioCodecName(codec)
+                      << " 인코더가 빌드에 없어 PCM으로 전송합니다" << std::endl;
+        }
+        return protocol::AudioCodec::Pcm;
+    }
+    return codec;
+}
+
+bool VoicePipeline::cancel(uint64_t requestId) {
+    TokenPtr token;
+    {
+        std::lock_guard<std::mutex> lock(m_tokenMutex);
+        auto it = m_tokens.find(requestId);
+        if (it == m_tokens.end()) {
+            return false;
+        }
+        token = it->second;
+    }
+
+    token->cancel();
+    return true;
+}
+
+void VoicePipeline::setPartialCallback(PartialResultCallback callback) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_partialCallback = std::move(callback);
+}
+
+void VoicePipeline::setResultCallback(ResultCallback callback) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_resultCallback = std::move(callback);
+}
+
+void VoicePipeline::shutdown() {
+    // 앞 단계부터 비워야 뒤 단계로 넘어간 작업이 유실되지 않음
+    m_captureStage.shutdown();
+    m_sendStage.shutdown();
+    m_resultStage.shutdown();
+    if (m_ownedExecutor) {
+        m_ownedExecutor->shutdown();
+    }
+}
+
+void VoicePipeline::runCapture(uint64_t requestId, TokenPtr token, UtterancePtr utterance) {
+    trace::RequestScope traceScope(requestId);
+    std::cout << "[SION] 🎤 음성 녹음 시작..." << std::endl;
+
+    // 후행 무음 또는 취소까지 녹음 (앞뒤 무음 제거, WAV 또는 공유 슬롯에 바로 기록)
+    bool captured = false;
+    if (utterance->stop) {
+        // 푸시투토크: 키를 뗄 때까지 전체 구간
+        if (utterance->wav) {
+            captured = m_capture.captureUntilStopped(*utterance->stop, *utterance->wav, token.get());
+            utterance->sampleCount = captured ? utterance->wav->sampleCount() : 0;
+        } else {
+            utterance->sampleCount = m_capture.captureUntilStopped(
+                *utterance->stop, m_sharedAudio->slotData(utterance->slot), m_sharedAudio->slotCapacity(),
+                token.get());
+            captured = utterance->sampleCount > 0;
+        }
+    } else if (utterance->wav) {
+        captured = m_capture.captureUtterance(m_vad, *utterance->wav, token.get());
+        utterance->sampleCount = captured ? utterance->wav->sampleCount() : 0;
+    } else {
+        utterance->sampleCount = m_capture.captureUtterance(
+            m_vad, m_sharedAudio->slotData(utterance->slot), m_sharedAudio->slotCapacity(), token.get());
+        captured = utterance->sampleCount > 0;
+    }
+    m_captureBusy = false;
+
+    if (!captured) {
+        if (!token->isCancelled()) {
+            std::cerr << "[SION] ❌ 음성이 감지되지 않았습니다" << std::endl;
+        }
+        releaseUtterance(*utterance);
+        finishRequest(requestId, *token, *utterance, "");
+        return;
+    }
+
+    std::cout << "[SION] ✅ 녹음 완료 ("
+              << utterance->sampleCount << " samples)" << std::endl;
+
+    if (m_journal) {
+        // 버퍼는 전송 후 바로 재사용되므로 샘플만 복사해 두고 기록은 결과와 함께 저널 스레드에서
+        const int16_t* samples = utterance->wav ? utterance->wav->samples()
+                                                : m_sharedAudio->slotData(utterance->slot);
+        m_journal->begin(requestId, samples, utterance->sampleCount, m_capture.getConfig().sampleRate,
+                         utterance->startedAt);
+    }
+
+    if (!m_sendStage.post([this, requestId, token, utterance]() { runSend(requestId, token, utterance); })) {
+        // 종료 중: 슬롯/버퍼, 저널 항목, 처리 중 카운트를 여기서 정리
+        releaseUtterance(*utterance);
+        finishRequest(requestId, *token, *utterance, "");
+    }
+}
+
+void VoicePipeline::runSend(uint64_t requestId, TokenPtr token, UtterancePtr utterance) {
+    trace::RequestScope traceScope(requestId);
+    if (token->isCancelled()) {
+        releaseUtterance(*utterance);
+        finishRequest(requestId, *token, *utterance, "");
+        return;
+    }
+
+    PartialResultCallback onPartial;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        onPartial = m_partialCallback;
+    }
+
+    const int16_t* samples = utterance->wav ? utterance->wav->samples()
+                                            : m_sharedAudio->slotData(utterance->slot);
+    const int sampleRate = m_capture.getConfig().sampleRate;
+
+    if (m_cache && m_cache->fingerprintEnabled()) {
+        std::string transcript;
+        if (m_cache->computeFingerprint(samples, utterance->sampleCount, sampleRate, utterance->fingerprint)
+            && m_cache->lookupTranscript(utterance->fingerprint, transcript)) {
+            // 같은 발화로 보면 ASR을 생략 (적중한 지문은 다시 저장하지 않아 기준 지문이 흘러가지 않음)
+            releaseUtterance(*utterance);
+            utterance->fingerprint = AudioFingerprint{};
+            if (!m_resultStage.post([this, requestId, token, transcript, utterance]() {
+                    trace::RequestScope traceScope(requestId);
+                    respondToTranscript(requestId, token, transcript, utterance, nullptr);
+                })) {
+                finishRequest(requestId, *token, *utterance, "");
+            }
+            return;
+        }
+    }
+
+    // 짧은 명령은 네트워크 왕복 없이 내장 엔진으로 (워커 경로는 원격 ASR 상태를 알 수 없어 길이로만 결정)
+    const bool remoteReachable = !m_asr || m_asr->isConnected();
+    if (m_localAsr && !utterance->remoteOnly
+        && m_localAsr->route(utterance->sampleCount, sampleRate, remoteReachable)) {
+        std::shared_future<std::string> transcript =
+            m_localAsr->transcribe(samples, utterance->sampleCount, token).share();
+        trace::increment(trace::Counter::LocalAsrRouted);
+        if (!m_resultStage.post([this, requestId, token, transcript, utterance]() {
+                runLocalResult(requestId, token, transcript, utterance);
+            })) {
+            // 추론은 토큰으로 중단하고 결과는 버림
+            token->cancel();
+            releaseUtterance(*utterance);
+            finishRequest(requestId, *token, *utterance, "");
+        }
+        return;
+    }
+
+    if (m_asr && m_asr->ensureConnected()) {
+        // 중간 결과마다 안정된 앞부분을 워커에 미리 보냄 (ASR 수신 스레드에서 호출)
+        SpeculationPtr speculation;
+        PartialResultCallback onAsrPartial = onPartial;
+        if (m_speculate) {
+            speculation = std::make_shared<Speculation>();
+            onAsrPartial = [this, onPartial, speculation](const std::string& partial) {
+                if (onPartial) {
+                    onPartial(partial);
+                }
+                speculate(*speculation, partial);
+            };
+        }
+
+        // ASR 서비스로 직접 스트리밍 (전송 후 버퍼/슬롯 반환, 워커는 result 단계에서 선택)
+        // 서버는 PCM 스트림에서만 앞부분을 인식해 중간 결과를 주므로 추측 NLU를 쓰면 PCM으로 전송
+        AudioEncoder* encoder = m_speculate ? nullptr : m_encoder.get();
+        const uint32_t streamId = m_asr->submit(samples, utterance->sampleCount,
+                                                sampleRate, encoder,
+                                                onAsrPartial, token.get());
+        if (streamId != 0) {
+            releaseUtterance(*utterance);
+            if (!m_resultStage.post([this, requestId, token, streamId, utterance, speculation]() {
+                    runTranscriptResult(requestId, token, streamId, utterance, speculation);
+                })) {
+                // 취소된 토큰으로 기다리면 cancel 전송 후 바로 돌아오며 대기 항목도 정리됨
+                token->cancel();
+                m_asr->awaitTranscript(streamId, token.get());
+                finishRequest(requestId, *token, *utterance, "");
+            }
+            return;
+        }
+        // 연결이 방금 끊겼으면 아래 워커 경로로 전송
+    }
+
+    PythonWorkerPool::WorkerPtr worker = m_workers.acquire();
+    if (!worker) {
+        std::cerr << "[SION] ❌ 사용 가능한 Python 워커가 없습니다" << std::endl;
+        releaseUtterance(*utterance);
+        finishRequest(requestId, *token, *utterance, "");
+        return;
+    }
+
+    uint32_t utteranceId = 0;
+    if (m_encoder && worker->supportsCodec(m_encoder->codec())) {
+        // 인코딩된 바이트가 파이프로 복사되므로 전송 후 버퍼/슬롯 모두 반환 가능
+        utteranceId = worker->submitEncoded(samples, utterance->sampleCount,
+                                            sampleRate, *m_encoder,
+                                            onPartial, token.get());
+        releaseUtterance(*utterance);
+    } else if (utterance->wav) {
+        // 파이프 전송이 끝나면 버퍼는 바로 다음 녹음에 재사용 가능
+        utteranceId = worker->submitPcm(utterance->wav->samples(), utterance->sampleCount,
+                                        onPartial, token.get());
+        releaseUtterance(*utterance);
+    } else {
+        // 워커가 슬롯을 읽는 시점을 알 수 없으므로 슬롯은 결과까지 유지
+        utteranceId = worker->submitSharedAudio(static_cast<uint32_t>(utterance->slot),
+                                                utterance->sampleCount, onPartial, token.get());
+    }
+
+    // 응답은 요청을 보낸 워커에서만 받을 수 있으므로 함께 전달
+    if (!m_resultStage.post([this, requestId, token, worker, utteranceId, utterance]() {
+            runResult(requestId, token, worker, utteranceId, utterance);
+        })) {
+        // 취소된 토큰으로 기다리면 CANCEL 전송 후 바로 돌아오며 대기 항목도 정리됨
+        token->cancel();
+        worker->awaitResult(utteranceId, token.get());
+        releaseUtterance(*utterance);
+        finishRequest(requestId, *token, *utterance, "");
+    }
+}
+
+void VoicePipeline::runResult(uint64_t requestId, TokenPtr token, PythonWorkerPool::WorkerPtr worker,
+                              uint32_t utteranceId, UtterancePtr utterance) {
+    trace::RequestScope traceScope(requestId);
+    const std::string result = worker->awaitResult(utteranceId, token.get());
+    releaseUtterance(*utterance);
+    if (m_cache && !result.empty() && !token->isCancelled()) {
+        m_cache->storeResult(result, &utterance->fingerprint);
+    }
+    finishRequest(requestId, *token, *utterance, result);
+}
+
+void VoicePipeline::runLocalResult(uint64_t requestId, TokenPtr token, std::shared_future<std::string> transcript,
+                                   UtterancePtr utterance) {
+    trace::RequestScope traceScope(requestId);
+    std::string text;
+    try {
+        text = transcript.get();
+    } catch (const std::exception&) {
+        // 엔진 종료 중 (broken_promise): 원격 경로로
+    }
+    if (token->isCancelled()) {
+        releaseUtterance(*utterance);
+        finishRequest(requestId, *token, *utterance, "");
+        return;
+    }
+
+    if (text.empty()) {
+        // 녹음을 아직 들고 있으므로 원격 경로로 다시 전송
+        std::cerr << "[SION] ⚠️ 로컬 인식 실패, 원격 ASR로 다시 보냅니다" << std::endl;
+        trace::increment(trace::Counter::LocalAsrFallback);
+        utterance->remoteOnly = true;
+        if (!m_sendStage.post([this, requestId, token, utterance]() { runSend(requestId, token, utterance); })) {
+            releaseUtterance(*utterance);
+            finishRequest(requestId, *token, *utterance, "");
+        }
+        return;
+    }
+
+    releaseUtterance(*utterance);
+    respondToTranscript(requestId, token, text, utterance, nullptr);
+}
+
+void VoicePipeline::runTranscriptResult(uint64_t requestId, TokenPtr token, uint32_t streamId,
+                                        UtterancePtr utterance, SpeculationPtr speculation) {
+    trace::RequestScope traceScope(requestId);
+    bool failed = false;
+    const std::string transcript = m_asr->awaitTranscript(streamId, token.get(), &failed);
+    if (transcript.empty() || token->isCancelled()) {
+        if (!failed && !token->isCancelled()) {
+            std::cerr << "[SION] ❌ 인식된 텍스트가 없습니다" << std::endl;
+        }
+        finishRequest(requestId, *token, *utterance, "");
+        return;
+    }
+
+    // 추측을 보낸 워커가 추측 NLU 결과를 들고 있으므로 최종 텍스트도 같은 워커로
+    PythonWorkerPool::WorkerPtr worker;
+    if (speculation) {
+        std::lock_guard<std::mutex> lock(speculation->mutex);
+        worker = speculation->worker;
+    }
+    respondToTranscript(requestId, token, transcript, utterance, worker);
+}
+
+void VoicePipeline::respondToTranscript(uint64_t requestId, TokenPtr token, const std::string& transcript,
+                                        UtterancePtr utterance, PythonWorkerPool::WorkerPtr worker) {
+    PartialResultCallback onPartial;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        onPartial = m_partialCallback;
+    }
+    if (onPartial) {
+        onPartial(transcript);   // 워커 경로의 PARTIAL_RESULT(인식 텍스트)와 같은 시점
+    }
+
+    if (!worker || !worker->isRunning()) {
+        worker = m_workers.acquire();
+    }
+    if (!worker) {
+        std::cerr << "[SION] ❌ 사용 가능한 Python 워커가 없습니다" << std::endl;
+        finishRequest(requestId, *token, *utterance, "");
+        return;
+    }
+
+    // 같은 인식 텍스트의 의도가 캐시에 있으면 NLU 왕복 생략
+    std::string intent;
+    const uint32_t utteranceId = m_cache && m_cache->lookupIntent(transcript, intent)
+        ? worker->submitIntent(transcript, intent, token.get())
+        : worker->submitTranscript(transcript, token.get());
+    const std::string result = worker->awaitResult(utteranceId, token.get());
+    if (m_cache && !result.empty() && !token->isCancelled()) {
+        m_cache->storeResult(result, &utterance->fingerprint);
+    }
+    finishRequest(requestId, *token, *utterance, result);
+}
+
+void VoicePipeline::speculate(Speculation& speculation, const std::string& partial) {
+    std::lock_guard<std::mutex> lock(speculation.mutex);
+    const std::string prefix = stablePrefix(speculation.lastPartial, partial);
+    speculation.lastPartial = partial;
+
+    // 앞부분이 늘어났을 때만 전송 (같은 텍스트를 반복해 보내지 않음)
+    if (prefix.size() < kMinSpeculationBytes || prefix.size() <= speculation.sent.size()
+        || speculation.count >= kMaxSpeculations) {
+        return;
+    }
+    if (!speculation.worker) {
+        speculation.worker = m_workers.acquire();
+        if (!speculation.worker) {
+            return;
+        }
+    }
+    if (speculation.worker->speculate(prefix)) {
+        speculation.sent = prefix;
+        ++speculation.count;
+        trace::increment(trace::Counter::SpeculativeNluSent);
+    }
+}
+
+void VoicePipeline::finishRequest(uint64_t requestId, const CancellationToken& token,
+                                  const Utterance& utterance, const std::string& result) {
+    {
+        std::lock_guard<std::mutex> lock(m_tokenMutex);
+        m_tokens.erase(requestId);
+    }
+
+    if (token.isCancelled()) {
+        std::cout << "[SION] ⛔ 요청 #" << requestId << " 취소됨" << std::endl;
+        if (m_journal) {
+            m_journal->discard(requestId);
+        }
+    } else {
+        trace::record(trace::Stage::EndToEnd, requestId, utterance.startedAt, trace::now());
+        if (m_journal) {
+            m_journal->commit(requestId, result);
+        }
+
+        ResultCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(m_callbackMutex);
+            callback = m_resultCallback;
+        }
+
+        if (callback) {
+            callback(requestId, result);
+        }
+    }
+    --m_inFlight;
+}
+
+VoicePipeline::UtterancePtr VoicePipeline::acquireUtterance() {
+    auto utterance = std::make_shared<Utterance>();
+
+    if (m_sharedAudio) {
+        utterance->slot = m_sharedAudio->acquireSlot();
+        return utterance->slot >= 0 ? utterance : nullptr;
+    }
+
+    utterance->wav = m_buffers.acquire();
+    return utterance->wav ? utterance : nullptr;
+}
+
+void VoicePipeline::releaseUtterance(Utterance& utterance) {
+    utterance.wav.reset();
+    if (utterance.slot >= 0) {
+        m_sharedAudio->releaseSlot(utterance.slot);
+        utterance.slot = -1;
+    }
+}
+
+} // namespace sion
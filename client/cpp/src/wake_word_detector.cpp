@@ -0,0 +1,220 @@
+/**
+ * @file wake_word_detector.cpp
+ * @brief WakeWordDetector 클래스 구현
+ */
+
+#include "wake_word_detector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace sion {
+
+WakeWordDetector::WakeWordDetector(WakeWordConfig config)
+    : m_config(std::move(config))
+    , m_threshold(0.0f)
+    , m_frameLength(0)
+    , m_hopLength(0)
+    , m_numMels(0)
+    , m_inferenceStride(1)
+    , m_refractoryFrames(0)
+    , m_droppedSamples(0)
+    , m_hopFill(0)
+    , m_featurePos(0)
+    , m_framesFilled(0)
+    , m_framesSinceInference(0)
+    , m_refractoryLeft(0)
+    , m_scorePos(0)
+    , m_scoreCount(0)
+    , m_lastScore(0.0f)
+    , m_detected(false)
+    , m_running(false)
+{
+}
+
+WakeWordDetector::~WakeWordDetector() {
+    stop();
+}
+
+bool WakeWordDetector::load(int sampleRate) {
+    if (m_config.modelPath.empty()) {
+        return false;
+    }
+    if (!m_spotter.load(m_config.modelPath)) {
+        return false;
+    }
+
+    const LogMelConfig& frontend = m_spotter.frontendConfig();
+    if (frontend.sampleRate != sampleRate) {
+        std::cerr << "[WakeWordDetector] 모델 샘플링 레이트(" << frontend.sampleRate
+                  << " Hz)가 캡처(" << sampleRate << " Hz)와 다릅니다" << std::endl;
+        return false;
+    }
+    if (!m_frontend.configure(frontend)) {
+        return false;
+    }
+
+    m_threshold = m_config.threshold > 0.0f ? m_config.threshold : m_spotter.threshold();
+    m_frameLength = static_cast<size_t>(frontend.frameLength);
+    m_hopLength = static_cast<size_t>(frontend.hopLength);
+    m_numMels = static_cast<size_t>(frontend.numMels);
+
+    const size_t samplesPerMs = static_cast<size_t>(sampleRate) / 1000;
+    m_inferenceStride = std::max<size_t>(1, std::max(0, m_config.inferenceIntervalMs) * samplesPerMs / m_hopLength);
+    m_refractoryFrames = std::max(0, m_config.refractoryMs) * samplesPerMs / m_hopLength;
+
+    m_ring.reserve(std::max<size_t>(m_hopLength, std::max(0, m_config.bufferMs) * samplesPerMs));
+    m_chunk.assign(std::max<size_t>(m_hopLength, std::max(0, m_config.pollIntervalMs) * samplesPerMs), 0);
+    m_frame.assign(m_frameLength, 0);
+    m_mels.assign(m_numMels, 0.0f);
+    m_features.assign(m_spotter.numFrames() * m_numMels, 0);
+    m_scores.assign(m_spotter.smoothing(), 0.0f);
+    m_hopFill = 0;
+    reset();
+
+    std::cout << "[WakeWordDetector] 웨이크워드 준비 (임계값 " << m_threshold << ", 추론 "
+              << m_inferenceStride * m_hopLength * 1000 / static_cast<size_t>(sampleRate) << " ms 간격)" << std::endl;
+    return true;
+}
+
+void WakeWordDetector::feed(Span<const int16_t> frame) {
+    const size_t written = m_ring.write(frame.data(), frame.size());
+    if (written < frame.size()) {
+        m_droppedSamples.fetch_add(frame.size() - written, std::memory_order_relaxed);
+    }
+}
+
+bool WakeWordDetector::start(WakeWordCallback callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!isLoaded() || m_running) {
+        return false;
+    }
+
+    // start() 이전에 쌓인 샘플은 버리고 빈 창에서 시작
+    m_ring.clear();
+    reset();
+    m_callback = std::move(callback);
+    m_running = true;
+    m_thread = std::thread(&WakeWordDetector::run, this);
+    return true;
+}
+
+void WakeWordDetector::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+    }
+    m_wakeup.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void WakeWordDetector::run() {
+    const auto pollInterval = std::chrono::milliseconds(std::max(1, m_config.pollIntervalMs));
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (m_running) {
+        m_wakeup.wait_for(lock, pollInterval, [this] { return !m_running; });
+        if (!m_running) {
+            break;
+        }
+        lock.unlock();
+
+        if (drain() && m_callback) {
+            m_callback(m_lastScore);
+        }
+
+        lock.lock();
+    }
+}
+
+bool WakeWordDetector::drain() {
+    bool detected = false;
+    size_t count;
+    while ((count = m_ring.read(m_chunk.data(), m_chunk.size())) > 0) {
+        detected = process(m_chunk.data(), count) || detected;
+    }
+    return detected;
+}
+
+bool WakeWordDetector::process(const int16_t* samples, size_t count) {
+    if (!isLoaded()) {
+        return false;
+    }
+
+    m_detected = false;
+    const size_t history = m_frameLength - m_hopLength;
+    while (count > 0) {
+        const size_t n = std::min(count, m_hopLength - m_hopFill);
+        std::memcpy(m_frame.data() + history + m_hopFill, samples, n * sizeof(int16_t));
+        m_hopFill += n;
+        samples += n;
+        count -= n;
+
+        if (m_hopFill == m_hopLength) {
+            processFrame();
+            std::memmove(m_frame.data(), m_frame.data() + m_hopLength, history * sizeof(int16_t));
+            m_hopFill = 0;
+        }
+    }
+    return m_detected;
+}
+
+void WakeWordDetector::processFrame() {
+    const size_t numFrames = m_spotter.numFrames();
+
+    m_frontend.compute(m_frame.data(), m_mels.data());
+    m_spotter.quantizeFrame(m_mels.data(), m_features.data() + m_featurePos * m_numMels);
+    m_featurePos = (m_featurePos + 1) % numFrames;
+    m_framesFilled = std::min(m_framesFilled + 1, numFrames);
+    ++m_framesSinceInference;
+
+    if (m_refractoryLeft > 0) {
+        --m_refractoryLeft;
+        return;
+    }
+    if (m_framesFilled < numFrames || m_framesSinceInference < m_inferenceStride) {
+        return;
+    }
+    m_framesSinceInference = 0;
+
+    // 순환 버퍼를 가장 오래된 프레임부터 모델 입력으로 펼침
+    int8_t* input = m_spotter.input();
+    const size_t older = (numFrames - m_featurePos) * m_numMels;
+    std::memcpy(input, m_features.data() + m_featurePos * m_numMels, older);
+    std::memcpy(input + older, m_features.data(), m_featurePos * m_numMels);
+    const float probability = m_spotter.infer();
+
+    // 순간적인 오검출을 줄이도록 최근 smoothing회 평균으로 판정
+    m_scores[m_scorePos] = probability;
+    m_scorePos = (m_scorePos + 1) % m_scores.size();
+    m_scoreCount = std::min(m_scoreCount + 1, m_scores.size());
+    float sum = 0.0f;
+    for (size_t i = 0; i < m_scoreCount; ++i) {
+        sum += m_scores[i];
+    }
+    m_lastScore = sum / static_cast<float>(m_scoreCount);
+
+    if (m_scoreCount == m_scores.size() && m_lastScore >= m_threshold) {
+        m_detected = true;
+        reset();
+        m_refractoryLeft = m_refractoryFrames;
+    }
+}
+
+void WakeWordDetector::reset() {
+    m_featurePos = 0;
+    m_framesFilled = 0;
+    m_framesSinceInference = 0;
+    m_refractoryLeft = 0;
+    m_scorePos = 0;
+    m_scoreCount = 0;
+}
+
+} // namespace sion
@@ -0,0 +1,561 @@
+/**
+ * @file wasapi_capture.cpp
+ * @brief WASAPI 이벤트 기반 캡처 백엔드 구현 (Windows 전용)
+ */
+
+#include "capture_backend.h"
+#include "audio_resampler.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+#include <mmreg.h>
+#include <avrt.h>
+#include <initguid.h>                      // PKEY_Device_FriendlyName 정의를 이 파일에 생성
+#include <functiondiscoverykeys_devpkey.h>
+
+#pragma comment(lib, "ole32.lib")
+#pragma comment(lib, "avrt.lib")
+
+namespace sion {
+
+namespace {
+
+// 100ns 단위 (REFERENCE_TIME)
+constexpr REFERENCE_TIME kHnsPerMs = 10000;
+
+template <typename T>
+void safeRelease(T*& ptr) {
+    if (ptr) {
+        ptr->Release();
+        ptr = nullptr;
+    }
+}
+
+/**
+ * @brief UTF-8 → UTF-16 (엔드포인트 ID)
+ */
+std::wstring toWide(const std::string& text) {
+    const int length = MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0);
+    std::wstring out(static_cast<size_t>(std::max(0, length)), L'\0');
+    if (length > 0) {
+        MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), &out[0], length);
+    }
+    return out;
+}
+
+/**
+ * @brief UTF-16 → UTF-8 (엔드포인트 ID, 장치 이름)
+ */
+std::string toUtf8(const wchar_t* text) {
+    if (!text) {
+        return std::string();
+    }
+    const int length = WideCharToMultiByte(CP_UTF8, 0, text, -1, nullptr, 0, nullptr, nullptr);
+    if (length <= 1) {
+        return std::string();
+    }
+    std::string out(static_cast<size_t>(length), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text, -1, &out[0], length, nullptr, nullptr);
+    out.resize(static_cast<size_t>(length) - 1);   // 종료 NUL 제외
+    return out;
+}
+
+/**
+ * @brief 엔드포인트 ID (UTF-8, 실패 시 빈 문자열)
+ */
+std::string endpointId(IMMDevice* device) {
+    LPWSTR id = nullptr;
+    if (FAILED(device->GetId(&id))) {
+        return std::string();
+    }
+    std::string out = toUtf8(id);
+    CoTaskMemFree(id);
+    return out;
+}
+
+/**
+ * @brief 믹스 포맷을 AudioResampler 입력 형식으로 해석
+ *
+ * KSDATAFORMAT_SUBTYPE_* GUID는 Data1이 포맷 태그이므로 태그만 비교합니다.
+ * @return 지원하는 형식인지 여부 (24비트 packed 등은 false)
+ */
+bool toInputFormat(const WAVEFORMATEX& wfx, InputFormat& input) {
+    WORD tag = wfx.wFormatTag;
+    if (tag == WAVE_FORMAT_EXTENSIBLE && wfx.cbSize >= sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX)) {
+        tag = static_cast<WORD>(reinterpret_cast<const WAVEFORMATEXTENSIBLE&>(wfx).SubFormat.Data1);
+    }
+
+    input.sampleRate = static_cast<int>(wfx.nSamplesPerSec);
+    input.channels = wfx.nChannels;
+
+    if (tag == WAVE_FORMAT_IEEE_FLOAT && wfx.wBitsPerSample == 32) {
+        input.format = SampleFormat::Float32;
+    } else if (tag == WAVE_FORMAT_PCM && wfx.wBitsPerSample == 16) {
+        input.format = SampleFormat::Int16;
+    } else if (tag == WAVE_FORMAT_PCM && wfx.wBitsPerSample == 32) {
+        input.format = SampleFormat::Int32;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief WASAPI 공유/배타 모드 캡처
+ *
+ * AUDCLNT_STREAMFLAGS_EVENTCALLBACK으로 장치 주기마다 이벤트를 받아
+ * 패킷을 읽고, frameDurationMs 크기의 프레임이 채워질 때마다 콜백을 호출합니다.
+ * 폴링 대기가 없으므로 프레임 지연은 장치 주기 + 프레임 길이로 제한됩니다.
+ *
+ * 공유 모드(nativeFormat)에서는 엔진 믹스 포맷(보통 48 kHz 스테레오 float)
+ * 그대로 열어 OS 내부 변환을 피하고, 캡처 스레드에서 AudioResampler로
+ * 설정된 레이트의 모노 int16으로 변환합니다.
+ */
+class WasapiCaptureBackend : public CaptureBackend {
+public:
+    WasapiCaptureBackend() = default;
+
+    ~WasapiCaptureBackend() override {
+        stop();
+        close();
+    }
+
+    bool open(const AudioConfig& config) override {
+        if (m_audioClient) {
+            return true;
+        }
+
+        m_config = config;
+
+        HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        m_comInitialized = SUCCEEDED(hr);
+
+        hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL,
+                              __uuidof(IMMDeviceEnumerator),
+                              reinterpret_cast<void**>(&m_enumerator));
+        if (FAILED(hr)) {
+            std::cerr << "[WASAPI] MMDeviceEnumerator 생성 실패: 0x" << std::hex << hr << std::dec << std::endl;
+            close();
+            return false;
+        }
+
+        if (config.device.empty()) {
+            hr = m_enumerator->GetDefaultAudioEndpoint(eCapture, eCommunications, &m_device);
+            if (FAILED(hr)) {
+                std::cerr << "[WASAPI] 기본 캡처 장치를 찾을 수 없습니다: 0x" << std::hex << hr << std::dec << std::endl;
+                close();
+                return false;
+            }
+        } else {
+            // enumerateCaptureDevices()가 돌려준 엔드포인트 ID
+            hr = m_enumerator->GetDevice(toWide(config.device).c_str(), &m_device);
+            if (FAILED(hr)) {
+                std::cerr << "[WASAPI] 캡처 장치를 찾을 수 없습니다 (" << config.device << "): 0x"
+                          << std::hex << hr << std::dec << std::endl;
+                close();
+                return false;
+            }
+        }
+
+        if (!initializeClient()) {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool start(AudioCallback onFrame) override {
+        if (!m_audioClient || m_thread.joinable()) {
+            return false;
+        }
+
+        m_onFrame = std::move(onFrame);
+        m_assembler.configure(static_cast<size_t>(m_config.sampleRate) * m_config.channels
+                              * m_config.frameDurationMs / 1000);
+        if (m_convert) {
+            // 캡처 스레드에서 재할당이 없도록 장치 버퍼 한 개 분량을 미리 확보
+            m_resampler.reset();
+            m_converted.reserve(static_cast<size_t>(m_bufferFrames) * m_config.sampleRate
+                                / m_nativeRate + 64);
+        }
+
+        ResetEvent(m_stopEvent);
+
+        HRESULT hr = m_audioClient->Start();
+        if (FAILED(hr)) {
+            std::cerr << "[WASAPI] IAudioClient::Start 실패: 0x" << std::hex << hr << std::dec << std::endl;
+            return false;
+        }
+
+        m_thread = std::thread(&WasapiCaptureBackend::captureLoop, this);
+        return true;
+    }
+
+    void stop() override {
+        if (!m_thread.joinable()) {
+            return;
+        }
+
+        SetEvent(m_stopEvent);
+        m_thread.join();
+
+        if (m_audioClient) {
+            m_audioClient->Stop();
+            m_audioClient->Reset();
+        }
+        m_onFrame = nullptr;
+    }
+
+    void close() override {
+        safeRelease(m_captureClient);
+        safeRelease(m_audioClient);
+        safeRelease(m_device);
+        safeRelease(m_enumerator);
+
+        if (m_dataEvent) {
+            CloseHandle(m_dataEvent);
+            m_dataEvent = nullptr;
+        }
+        if (m_stopEvent) {
+            CloseHandle(m_stopEvent);
+            m_stopEvent = nullptr;
+        }
+        if (m_comInitialized) {
+            CoUninitialize();
+            m_comInitialized = false;
+        }
+    }
+
+    bool isOpen() const override {
+        return m_audioClient != nullptr;
+    }
+
+    const char* name() const override {
+        return m_config.exclusiveMode ? "WASAPI (exclusive)" : "WASAPI (shared)";
+    }
+
+private:
+    bool initializeClient() {
+        HRESULT hr = m_device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr,
+                                        reinterpret_cast<void**>(&m_audioClient));
+        if (FAILED(hr)) {
+            std::cerr << "[WASAPI] IAudioClient 활성화 실패: 0x" << std::hex << hr << std::dec << std::endl;
+            return false;
+        }
+
+        // 공유 모드: 가능하면 믹스 포맷 그대로 열고 직접 변환
+        if (!m_config.exclusiveMode && m_config.nativeFormat && openNativeFormat()) {
+            return finishInitialize();
+        }
+        if (m_convert) {
+            // 믹스 포맷 초기화에 실패한 클라이언트는 재사용할 수 없음
+            m_convert = false;
+            safeRelease(m_audioClient);
+            hr = m_device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr,
+                                    reinterpret_cast<void**>(&m_audioClient));
+            if (FAILED(hr)) {
+                std::cerr << "[WASAPI] IAudioClient 활성화 실패: 0x" << std::hex << hr << std::dec << std::endl;
+                return false;
+            }
+        }
+
+        WAVEFORMATEX wfx{};
+        wfx.wFormatTag = WAVE_FORMAT_PCM;
+        wfx.nChannels = static_cast<WORD>(m_config.channels);
+        wfx.nSamplesPerSec = static_cast<DWORD>(m_config.sampleRate);
+        wfx.wBitsPerSample = static_cast<WORD>(m_config.bitsPerSample);
+        wfx.nBlockAlign = wfx.nChannels * wfx.wBitsPerSample / 8;
+        wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+        wfx.cbSize = 0;
+
+        const AUDCLNT_SHAREMODE shareMode = m_config.exclusiveMode
+            ? AUDCLNT_SHAREMODE_EXCLUSIVE : AUDCLNT_SHAREMODE_SHARED;
+
+        DWORD streamFlags = AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
+        REFERENCE_TIME bufferDuration = m_config.frameDurationMs * kHnsPerMs;
+        REFERENCE_TIME periodicity = 0;
+
+        if (m_config.exclusiveMode) {
+            // 배타 모드: 장치 주기 = 버퍼 길이, 포맷 변환 없음
+            REFERENCE_TIME defaultPeriod = 0;
+            REFERENCE_TIME minimumPeriod = 0;
+            m_audioClient->GetDevicePeriod(&defaultPeriod, &minimumPeriod);
+            if (bufferDuration < minimumPeriod) {
+                bufferDuration = minimumPeriod;
+            }
+            periodicity = bufferDuration;
+        } else {
+            // 공유 모드: 엔진 믹스 포맷과 다르면 OS가 16k 모노로 변환
+            streamFlags |= AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM
+                         | AUDCLNT_STREAMFLAGS_SRC_DEFAULT_QUALITY;
+        }
+
+        hr = m_audioClient->Initialize(shareMode, streamFlags, bufferDuration,
+                                       periodicity, &wfx, nullptr);
+
+        if (hr == AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED) {
+            // 배타 모드 버퍼를 장치 정렬 크기로 다시 맞춤
+            UINT32 alignedFrames = 0;
+            m_audioClient->GetBufferSize(&alignedFrames);
+            safeRelease(m_audioClient);
+
+            bufferDuration = static_cast<REFERENCE_TIME>(
+                10000.0 * 1000 * alignedFrames / wfx.nSamplesPerSec + 0.5);
+            periodicity = bufferDuration;
+
+            hr = m_device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr,
+                                    reinterpret_cast<void**>(&m_audioClient));
+            if (SUCCEEDED(hr)) {
+                hr = m_audioClient->Initialize(shareMode, streamFlags, bufferDuration,
+                                               periodicity, &wfx, nullptr);
+            }
+        }
+
+        if (FAILED(hr)) {
+            std::cerr << "[WASAPI] IAudioClient::Initialize 실패: 0x" << std::hex << hr << std::dec << std::endl;
+            return false;
+        }
+
+        m_blockAlign = wfx.nBlockAlign;
+        m_nativeRate = wfx.nSamplesPerSec;
+        return finishInitialize();
+    }
+
+    /**
+     * @brief 믹스 포맷으로 공유 모드 초기화 (변환은 AudioResampler가 담당)
+     * @return 성공 여부 (실패 시 호출자가 자동 변환 경로로 재시도)
+     */
+    bool openNativeFormat() {
+        if (m_config.channels != 1 || m_config.bitsPerSample != 16) {
+            return false;   // 변환 단계는 모노 int16 출력만 지원
+        }
+
+        WAVEFORMATEX* mixFormat = nullptr;
+        HRESULT hr = m_audioClient->GetMixFormat(&mixFormat);
+        if (FAILED(hr) || !mixFormat) {
+            return false;
+        }
+
+        InputFormat input;
+        const bool supported = toInputFormat(*mixFormat, input)
+                            && m_resampler.configure(input, m_config.sampleRate);
+        if (!supported) {
+            std::cerr << "[WASAPI] 믹스 포맷 변환 미지원, OS 변환 사용" << std::endl;
+            CoTaskMemFree(mixFormat);
+            return false;
+        }
+
+        m_convert = true;
+        hr = m_audioClient->Initialize(AUDCLNT_SHAREMODE_SHARED, AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                                       m_config.frameDurationMs * kHnsPerMs, 0, mixFormat, nullptr);
+        m_blockAlign = mixFormat->nBlockAlign;
+        m_nativeRate = mixFormat->nSamplesPerSec;
+        CoTaskMemFree(mixFormat);
+
+        if (FAILED(hr)) {
+            std::cerr << "[WASAPI] 믹스 포맷 Initialize 실패: 0x" << std::hex << hr << std::dec << std::endl;
+            return false;
+        }
+
+        std::cout << "[WASAPI] 네이티브 포맷 " << input.sampleRate << " Hz × " << input.channels
+                  << "ch → " << m_config.sampleRate << " Hz 모노 (" << m_resampler.description() << ")"
+                  << std::endl;
+        return true;
+    }
+
+    /**
+     * @brief 이벤트/캡처 클라이언트 준비 (Initialize 이후 공통)
+     */
+    bool finishInitialize() {
+        m_dataEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        m_stopEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        if (!m_dataEvent || !m_stopEvent) {
+            return false;
+        }
+
+        HRESULT hr = m_audioClient->SetEventHandle(m_dataEvent);
+        if (FAILED(hr)) {
+            std::cerr << "[WASAPI] SetEventHandle 실패: 0x" << std::hex << hr << std::dec << std::endl;
+            return false;
+        }
+
+        hr = m_audioClient->GetService(__uuidof(IAudioCaptureClient),
+                                       reinterpret_cast<void**>(&m_captureClient));
+        if (FAILED(hr)) {
+            std::cerr << "[WASAPI] IAudioCaptureClient 획득 실패: 0x" << std::hex << hr << std::dec << std::endl;
+            return false;
+        }
+
+        m_audioClient->GetBufferSize(&m_bufferFrames);
+        return true;
+    }
+
+    void captureLoop() {
+        CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        // MMCSS 등록으로 스케줄링 지터 감소
+        DWORD taskIndex = 0;
+        HANDLE mmcss = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+
+        HANDLE waitHandles[2] = {m_stopEvent, m_dataEvent};
+
+        while (true) {
+            DWORD waitResult = WaitForMultipleObjects(2, waitHandles, FALSE, INFINITE);
+            if (waitResult != WAIT_OBJECT_0 + 1) {
+                break;  // 중지 이벤트 또는 오류
+            }
+
+            if (!drainPackets()) {
+                break;
+            }
+        }
+
+        if (mmcss) {
+            AvRevertMmThreadCharacteristics(mmcss);
+        }
+        CoUninitialize();
+    }
+
+    bool drainPackets() {
+        UINT32 packetFrames = 0;
+        HRESULT hr = m_captureClient->GetNextPacketSize(&packetFrames);
+
+        while (SUCCEEDED(hr) && packetFrames > 0) {
+            BYTE* data = nullptr;
+            UINT32 numFrames = 0;
+            DWORD flags = 0;
+
+            hr = m_captureClient->GetBuffer(&data, &numFrames, &flags, nullptr, nullptr);
+            if (FAILED(hr)) {
+                break;
+            }
+
+            const bool silent = (flags & AUDCLNT_BUFFERFLAGS_SILENT) != 0;
+            if (m_convert) {
+                // 다운믹스 + 리샘플링 (무음 패킷도 필터 상태를 이어가도록 통과)
+                m_converted.clear();
+                m_resampler.process(silent ? nullptr : data, numFrames, m_converted);
+                m_assembler.append(m_converted.data(), m_converted.size(), m_onFrame);
+            } else {
+                const size_t numSamples = static_cast<size_t>(numFrames) * m_blockAlign / sizeof(int16_t);
+                m_assembler.append(silent ? nullptr : reinterpret_cast<const int16_t*>(data), numSamples, m_onFrame);
+            }
+
+            m_captureClient->ReleaseBuffer(numFrames);
+            hr = m_captureClient->GetNextPacketSize(&packetFrames);
+        }
+
+        if (FAILED(hr)) {
+            std::cerr << "[WASAPI] 캡처 오류: 0x" << std::hex << hr << std::dec << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    AudioConfig m_config;
+    bool m_comInitialized = false;
+
+    IMMDeviceEnumerator* m_enumerator = nullptr;
+    IMMDevice* m_device = nullptr;
+    IAudioClient* m_audioClient = nullptr;
+    IAudioCaptureClient* m_captureClient = nullptr;
+
+    HANDLE m_dataEvent = nullptr;
+    HANDLE m_stopEvent = nullptr;
+    UINT32 m_blockAlign = 0;
+    UINT32 m_bufferFrames = 0;
+    DWORD m_nativeRate = 16000;
+
+    // 네이티브 포맷 변환 (공유 모드)
+    bool m_convert = false;
+    AudioResampler m_resampler;
+    std::vector<int16_t> m_converted;
+
+    std::thread m_thread;
+    AudioCallback m_onFrame;
+    FrameAssembler m_assembler;
+};
+
+} // namespace
+
+std::unique_ptr<CaptureBackend> createWasapiBackend() {
+    return std::make_unique<WasapiCaptureBackend>();
+}
+
+std::vector<CaptureDeviceInfo> enumerateWasapiDevices() {
+    std::vector<CaptureDeviceInfo> devices;
+
+    const bool comInitialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED));
+    IMMDeviceEnumerator* enumerator = nullptr;
+    IMMDeviceCollection* collection = nullptr;
+    IMMDevice* defaultDevice = nullptr;
+
+    HRESULT hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL,
+                                  __uuidof(IMMDeviceEnumerator),
+                                  reinterpret_cast<void**>(&enumerator));
+    if (SUCCEEDED(hr)) {
+        hr = enumerator->EnumAudioEndpoints(eCapture, DEVICE_STATE_ACTIVE, &collection);
+    }
+    if (FAILED(hr)) {
+        std::cerr << "[WASAPI] 캡처 장치 목록 조회 실패: 0x" << std::hex << hr << std::dec << std::endl;
+    } else {
+        // open()이 장치를 지정하지 않았을 때 여는 장치와 같은 역할
+        std::string defaultId;
+        if (SUCCEEDED(enumerator->GetDefaultAudioEndpoint(eCapture, eCommunications, &defaultDevice))) {
+            defaultId = endpointId(defaultDevice);
+        }
+
+        UINT count = 0;
+        collection->GetCount(&count);
+        for (UINT i = 0; i < count; ++i) {
+            IMMDevice* device = nullptr;
+            if (FAILED(collection->Item(i, &device))) {
+                continue;
+            }
+
+            CaptureDeviceInfo info;
+            info.id = endpointId(device);
+            IPropertyStore* properties = nullptr;
+            if (SUCCEEDED(device->OpenPropertyStore(STGM_READ, &properties))) {
+                PROPVARIANT value;
+                PropVariantInit(&value);
+                if (SUCCEEDED(properties->GetValue(PKEY_Device_FriendlyName, &value)) && value.vt == VT_LPWSTR) {
+                    info.name = toUtf8(value.pwszVal);
+                }
+                PropVariantClear(&value);
+                safeRelease(properties);
+            }
+            safeRelease(device);
+
+            if (info.id.empty()) {
+                continue;
+            }
+            if (info.name.empty()) {
+                info.name = info.id;
+            }
+            info.isDefault = info.id == defaultId;
+            devices.push_back(std::move(info));
+        }
+    }
+
+    safeRelease(defaultDevice);
+    safeRelease(collection);
+    safeRelease(enumerator);
+    if (comInitialized) {
+        CoUninitialize();
+    }
+    return devices;
+}
+
+} // namespace sion
@@ -0,0 +1,38 @@
+/**
+ * @file wav_buffer.cpp
+ * @brief WavBuffer 클래스 구현
+ */
+
+#include "wav_buffer.h"
+
+#include <cstring>
+#include <new>
+
+namespace sion {
+
+WavBuffer::WavBuffer(size_t capacitySamples) {
+    reset(capacitySamples);
+}
+
+void WavBuffer::PageDeleter::operator()(uint8_t* storage) const {
+    ::operator delete(storage, std::align_val_t{kPageSize});
+}
+
+void WavBuffer::reset(size_t capacitySamples) {
+    if (!m_storage || capacitySamples > m_capacitySamples) {
+        const size_t bytes = (kSampleAlignment + capacitySamples * sizeof(int16_t) + kPageSize - 1)
+                             / kPageSize * kPageSize;
+        m_storage.reset(static_cast<uint8_t*>(::operator new(bytes, std::align_val_t{kPageSize})));
+        m_capacitySamples = (bytes - kSampleAlignment) / sizeof(int16_t);
+
+        // 할당 시점에 모든 페이지를 확정해 두어 녹음 중 페이지 폴트 방지
+        std::memset(m_storage.get(), 0, bytes);
+    }
+    m_sampleCount = 0;
+}
+
+void WavBuffer::setSampleCount(size_t count) {
+    m_sampleCount = count < m_capacitySamples ? count : m_capacitySamples;
+}
+
+} // namespace sion
@@ -0,0 +1,1025 @@
+/**
+ * @file websocket_client.cpp
+ * @brief WebSocketClient 클래스 구현 (RFC 6455, TCP / OpenSSL TLS)
+ */
+
+#include "websocket_client.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef SION_HAVE_OPENSSL
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#endif
+
+namespace sion {
+
+namespace {
+
+// 한 번의 소켓 읽기 크기
+constexpr size_t kReadChunkSize = 16 * 1024;
+
+// 핸드셰이크 응답 헤더 상한
+constexpr size_t kMaxHandshakeSize = 8 * 1024;
+
+// 수신 메시지 상한 (잘못된 스트림으로 인한 과대 할당 방지)
+constexpr uint64_t kMaxMessageSize = 16 * 1024 * 1024;
+
+// TLS 송신이 읽기를 요구할 때(재협상) 수신 스레드가 먼저 소켓을 비웠을 수 있어 다시 시도하는 주기
+constexpr int kTlsWriteRetryMs = 50;
+
+// Sec-WebSocket-Accept 계산용 고정 GUID (RFC 6455 1.3)
+constexpr char kHandshakeGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+const NativeSocket kInvalidSocket = INVALID_SOCKET;
+
+#ifndef WSA_FLAG_NO_HANDLE_INHERIT
+#define WSA_FLAG_NO_HANDLE_INHERIT 0x80
+#endif
+
+// 이후 띄우는 워커가 연결을 물려받지 않도록 상속 불가로 생성 (::socket()은 기본이 상속 가능)
+NativeSocket openSocket(int family, int type, int protocol) {
+    return ::WSASocketW(family, type, protocol, nullptr, 0, WSA_FLAG_OVERLAPPED | WSA_FLAG_NO_HANDLE_INHERIT);
+}
+
+void closeNativeSocket(NativeSocket socket) {
+    ::closesocket(socket);
+}
+
+int pollSocket(NativeSocket socket, short events, int timeoutMs) {
+    WSAPOLLFD fd{};
+    fd.fd = socket;
+    fd.events = events;
+    return ::WSAPoll(&fd, 1, timeoutMs);
+}
+
+bool setSocketBlocking(NativeSocket socket, bool blocking) {
+    u_long mode = blocking ? 0 : 1;
+    return ::ioctlsocket(socket, FIONBIO, &mode) == 0;
+}
+
+void setSocketTimeout(NativeSocket socket, std::chrono::milliseconds timeout) {
+    const DWORD ms = static_cast<DWORD>(timeout.count());
+    ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&ms), sizeof(ms));
+    ::setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&ms), sizeof(ms));
+}
+
+bool connectInProgress() {
+    return ::WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+bool wouldBlock() {
+    return ::WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+// 깨우기 채널: 루프백에 바인딩하고 자기 자신에 연결한 UDP 소켓 (Windows는 파이프를 poll할 수 없음)
+bool createWakeChannel(intptr_t fds[2]) {
+    SOCKET socket = openSocket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (socket == INVALID_SOCKET) {
+        return false;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int length = sizeof(address);
+    u_long nonBlocking = 1;
+    if (::bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::getsockname(socket, reinterpret_cast<sockaddr*>(&address), &length) != 0
+        || ::connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::ioctlsocket(socket, FIONBIO, &nonBlocking) != 0) {
+        ::closesocket(socket);
+        return false;
+    }
+    fds[0] = fds[1] = static_cast<intptr_t>(socket);
+    return true;
+}
+
+void closeWakeChannel(intptr_t fds[2]) {
+    if (fds[0] != -1) {
+        ::closesocket(static_cast<SOCKET>(fds[0]));
+    }
+    fds[0] = fds[1] = -1;
+}
+
+void signalWake(intptr_t fd) {
+    const char byte = 1;
+    ::send(static_cast<SOCKET>(fd), &byte, 1, 0);
+}
+
+void drainWake(intptr_t fd) {
+    char buffer[64];
+    while (::recv(static_cast<SOCKET>(fd), buffer, sizeof(buffer), 0) > 0) {
+    }
+}
+
+/**
+ * @brief 소켓 이벤트 또는 깨우기 신호까지 대기 (제한 시간 없음)
+ */
+void waitSocketOrWake(NativeSocket socket, short events, intptr_t wakeFd) {
+    WSAPOLLFD fds[2] = {};
+    fds[0].fd = socket;
+    fds[0].events = events;
+    fds[1].fd = static_cast<SOCKET>(wakeFd);
+    fds[1].events = POLLIN;
+    if (::WSAPoll(fds, 2, -1) > 0 && fds[1].revents != 0) {
+        drainWake(wakeFd);
+    }
+}
+
+/**
+ * @brief Winsock 초기화 (프로세스당 한 번)
+ */
+bool initializeSockets() {
+    static const bool initialized = [] {
+        WSADATA data;
+        return ::WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return initialized;
+}
+#else
+using NativeSocket = int;
+const NativeSocket kInvalidSocket = -1;
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;   // 끊긴 연결에 쓸 때 SIGPIPE 대신 EPIPE
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+#ifdef SOCK_CLOEXEC
+constexpr int kSocketTypeFlags = SOCK_CLOEXEC;  // 이후 띄우는 워커에 연결이 상속되지 않도록
+#else
+constexpr int kSocketTypeFlags = 0;             // macOS: 워커 spawn이 POSIX_SPAWN_CLOEXEC_DEFAULT
+#endif
+
+NativeSocket openSocket(int family, int type, int protocol) {
+    return ::socket(family, type | kSocketTypeFlags, protocol);
+}
+
+void closeNativeSocket(NativeSocket socket) {
+    ::close(socket);
+}
+
+int pollSocket(NativeSocket socket, short events, int timeoutMs) {
+    pollfd fd{socket, events, 0};
+    int result;
+    do {
+        result = ::poll(&fd, 1, timeoutMs);
+    } while (result < 0 && errno == EINTR);
+    return result;
+}
+
+bool setSocketBlocking(NativeSocket socket, bool blocking) {
+    const int flags = ::fcntl(socket, F_GETFL, 0);
+    if (flags < 0) {
+        return false;
+    }
+    return ::fcntl(socket, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK)) == 0;
+}
+
+void setSocketTimeout(NativeSocket socket, std::chrono::milliseconds timeout) {
+    timeval tv{};
+    tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+    ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+bool connectInProgress() {
+    return errno == EINPROGRESS;
+}
+
+bool wouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+bool initializeSockets() {
+    return true;
+}
+
+// 깨우기 파이프 (논블로킹, 이후 띄우는 워커에 상속되지 않도록 생성 시 close-on-exec)
+bool createWakeChannel(intptr_t fds[2]) {
+    int pipeFds[2];
+#if defined(__APPLE__)
+    // pipe2 없음: 워커 spawn이 POSIX_SPAWN_CLOEXEC_DEFAULT라 fcntl 전의 틈에도 새지 않음
+    if (::pipe(pipeFds) != 0) {
+        return false;
+    }
+    for (int fd : pipeFds) {
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+#else
+    if (::pipe2(pipeFds, O_CLOEXEC | O_NONBLOCK) != 0) {
+        return false;
+    }
+#endif
+    fds[0] = pipeFds[0];
+    fds[1] = pipeFds[1];
+    return true;
+}
+
+void closeWakeChannel(intptr_t fds[2]) {
+    for (int i = 0; i < 2; ++i) {
+        if (fds[i] != -1) {
+            ::close(static_cast<int>(fds[i]));
+            fds[i] = -1;
+        }
+    }
+}
+
+void signalWake(intptr_t fd) {
+    // 파이프가 가득 차 실패해도 이미 깨울 바이트가 남아 있음
+    const uint8_t byte = 1;
+    [[maybe_unused]] ssize_t n = ::write(static_cast<int>(fd), &byte, 1);
+}
+
+void drainWake(intptr_t fd) {
+    uint8_t buffer[64];
+    while (::read(static_cast<int>(fd), buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+/**
+ * @brief 소켓 이벤트 또는 깨우기 신호까지 대기 (제한 시간 없음)
+ */
+void waitSocketOrWake(NativeSocket socket, short events, intptr_t wakeFd) {
+    pollfd fds[2] = {{socket, events, 0}, {static_cast<int>(wakeFd), POLLIN, 0}};
+    int result;
+    do {
+        result = ::poll(fds, 2, -1);
+    } while (result < 0 && errno == EINTR);
+    if (result > 0 && fds[1].revents != 0) {
+        drainWake(wakeFd);
+    }
+}
+#endif
+
+#if !defined(_WIN32) && !defined(SO_NOSIGPIPE)
+/**
+ * @brief 범위 동안 호출 스레드의 SIGPIPE 차단
+ *
+ * OpenSSL은 소켓에 write()로 쓰므로 MSG_NOSIGNAL을 줄 수 없습니다. 프로세스 전체의
+ * 시그널 처리를 바꾸는 대신 TLS 호출 동안 이 스레드에서만 막고, 끊긴 연결에 써서
+ * 보류된 SIGPIPE는 차단을 풀기 전에 회수합니다. (SO_NOSIGPIPE가 있는 macOS는 불필요)
+ */
+class ScopedSigpipeBlock {
+public:
+    ScopedSigpipeBlock() {
+        sigemptyset(&m_set);
+        sigaddset(&m_set, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &m_set, &m_previous);
+        m_wasPending = isPending();
+    }
+
+    ~ScopedSigpipeBlock() {
+        if (!m_wasPending && !sigismember(&m_previous, SIGPIPE) && isPending()) {
+            int signal = 0;
+            sigwait(&m_set, &signal);
+        }
+        pthread_sigmask(SIG_SETMASK, &m_previous, nullptr);
+    }
+
+    ScopedSigpipeBlock(const ScopedSigpipeBlock&) = delete;
+    ScopedSigpipeBlock& operator=(const ScopedSigpipeBlock&) = delete;
+
+private:
+    static bool isPending() {
+        sigset_t pending;
+        sigemptyset(&pending);
+        return sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE);
+    }
+
+    sigset_t m_set;
+    sigset_t m_previous;
+    bool m_wasPending;
+};
+#else
+struct ScopedSigpipeBlock {
+    ScopedSigpipeBlock() {}
+};
+#endif
+
+NativeSocket toNative(intptr_t socket) {
+    return static_cast<NativeSocket>(socket);
+}
+
+/**
+ * @brief ws/wss URL 구성 요소
+ */
+struct ParsedUrl {
+    bool secure = false;
+    std::string host;
+    std::string port;
+    std::string path;
+    std::string hostHeader;   // Host 헤더 값 (URL에 적힌 그대로)
+};
+
+bool parseUrl(const std::string& url, ParsedUrl& out) {
+    std::string rest;
+    if (url.compare(0, 5, "ws://") == 0) {
+        rest = url.substr(5);
+    } else if (url.compare(0, 6, "wss://") == 0) {
+        out.secure = true;
+        rest = url.substr(6);
+    } else {
+        return false;
+    }
+
+    const size_t slash = rest.find('/');
+    const std::string authority = rest.substr(0, slash);
+    out.path = slash == std::string::npos ? "/" : rest.substr(slash);
+    out.port = out.secure ? "443" : "80";
+
+    if (!authority.empty() && authority[0] == '[') {
+        // IPv6 리터럴: [::1]:8000
+        const size_t close = authority.find(']');
+        if (close == std::string::npos) {
+            return false;
+        }
+        out.host = authority.substr(1, close - 1);
+        if (close + 1 < authority.size() && authority[close + 1] == ':') {
+            out.port = authority.substr(close + 2);
+        }
+    } else {
+        const size_t colon = authority.rfind(':');
+        out.host = authority.substr(0, colon);
+        if (colon != std::string::npos) {
+            out.port = authority.substr(colon + 1);
+        }
+    }
+
+    if (out.host.empty() || out.port.empty()) {
+        return false;
+    }
+    out.hostHeader = authority;
+    return true;
+}
+
+/**
+ * @brief SHA-1 (핸드셰이크 검증 전용, FIPS 180-1)
+ */
+void sha1(const std::string& message, uint8_t digest[20]) {
+    uint32_t h[5] = {0x67452301u, 0xEFCDAB89u, 0x98BADCFEu, 0x10325476u, 0xC3D2E1F0u};
+
+    std::string data = message;
+    const uint64_t bitLength = static_cast<uint64_t>(message.size()) * 8;
+    data.push_back(static_cast<char>(0x80));
+    while (data.size() % 64 != 56) {
+        data.push_back('\0');
+    }
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        data.push_back(static_cast<char>((bitLength >> shift) & 0xFF));
+    }
+
+    auto rotl = [](uint32_t value, int bits) { return (value << bits) | (value >> (32 - bits)); };
+
+    for (size_t block = 0; block < data.size(); block += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const auto* p = reinterpret_cast<const uint8_t*>(data.data() + block + i * 4);
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999u;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1u;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDCu;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6u;
+            }
+            const uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        digest[i * 4 + 0] = static_cast<uint8_t>(h[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+    }
+}
+
+std::string base64Encode(const uint8_t* data, size_t size) {
+    static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((size + 2) / 3 * 4);
+    for (size_t i = 0; i < size; i += 3) {
+        const uint32_t n = (uint32_t(data[i]) << 16)
+                         | (i + 1 < size ? uint32_t(data[i + 1]) << 8 : 0)
+                         | (i + 2 < size ? uint32_t(data[i + 2]) : 0);
+        out.push_back(kAlphabet[(n >> 18) & 63]);
+        out.push_back(kAlphabet[(n >> 12) & 63]);
+        out.push_back(i + 1 < size ? kAlphabet[(n >> 6) & 63] : '=');
+        out.push_back(i + 2 < size ? kAlphabet[n & 63] : '=');
+    }
+    return out;
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+#ifdef SION_HAVE_OPENSSL
+std::string tlsError() {
+    char buffer[256];
+    ERR_error_string_n(ERR_get_error(), buffer, sizeof(buffer));
+    return buffer;
+}
+#endif
+
+} // namespace
+
+WebSocketClient::WebSocketClient()
+    : m_socket(-1)
+    , m_tlsContext(nullptr)
+    , m_tls(nullptr)
+    , m_wakeFds{-1, -1}
+    , m_open(false)
+    , m_maskState(std::random_device{}() | 1u)
+    , m_recvOffset(0)
+{
+}
+
+WebSocketClient::~WebSocketClient() {
+    shutdown();
+    close();
+}
+
+bool WebSocketClient::connect(const std::string& url, std::chrono::milliseconds timeout) {
+    if (m_socket != -1) {
+        return m_open;
+    }
+
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
+        std::cerr << "[WebSocket] 잘못된 URL: " << url << std::endl;
+        return false;
+    }
+#ifndef SION_HAVE_OPENSSL
+    if (parsed.secure) {
+        std::cerr << "[WebSocket] wss://는 OpenSSL 빌드에서만 지원됩니다: " << url << std::endl;
+        return false;
+    }
+#endif
+    if (!initializeSockets()) {
+        std::cerr << "[WebSocket] 소켓 초기화 실패" << std::endl;
+        return false;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (::getaddrinfo(parsed.host.c_str(), parsed.port.c_str(), &hints, &addresses) != 0 || !addresses) {
+        std::cerr << "[WebSocket] 호스트를 찾을 수 없습니다: " << parsed.host << std::endl;
+        return false;
+    }
+
+    // 주소마다 논블로킹 connect + poll로 제한 시간 적용
+    const int timeoutMs = static_cast<int>(timeout.count());
+    NativeSocket socket = kInvalidSocket;
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        socket = openSocket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socket == kInvalidSocket) {
+            continue;
+        }
+        setSocketBlocking(socket, false);
+        int result = ::connect(socket, address->ai_addr, static_cast<int>(address->ai_addrlen));
+        if (result != 0 && connectInProgress() && pollSocket(socket, POLLOUT, timeoutMs) > 0) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            ::getsockopt(socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length);
+            result = error == 0 ? 0 : -1;
+        }
+        if (result == 0) {
+            break;
+        }
+        closeNativeSocket(socket);
+        socket = kInvalidSocket;
+    }
+    ::freeaddrinfo(addresses);
+
+    if (socket == kInvalidSocket) {
+        std::cerr << "[WebSocket] 연결 실패: " << parsed.host << ":" << parsed.port << std::endl;
+        return false;
+    }
+
+    // 핸드셰이크까지는 블로킹 + 소켓 제한 시간, 이후 음성 조각은 바로 내보내도록 Nagle 끔
+    setSocketBlocking(socket, true);
+    setSocketTimeout(socket, timeout);
+    int noDelay = 1;
+    ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+#if defined(SO_NOSIGPIPE)
+    int noSigPipe = 1;
+    ::setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+    m_socket = static_cast<intptr_t>(socket);
+
+#ifdef SION_HAVE_OPENSSL
+    if (parsed.secure) {
+        SSL_CTX* context = SSL_CTX_new(TLS_client_method());
+        SSL* tls = context ? SSL_new(context) : nullptr;
+        m_tlsContext = context;
+        m_tls = tls;
+        if (tls) {
+            SSL_CTX_set_default_verify_paths(context);
+            SSL_CTX_set_verify(context, SSL_VERIFY_PEER, nullptr);
+            SSL_set_fd(tls, static_cast<int>(socket));
+            SSL_set_tlsext_host_name(tls, parsed.host.c_str());
+            SSL_set1_host(tls, parsed.host.c_str());
+        }
+        bool connected = false;
+        if (tls) {
+            ScopedSigpipeBlock noSigpipe;
+            connected = SSL_connect(tls) == 1;
+        }
+        if (!connected) {
+            std::cerr << "[WebSocket] TLS 핸드셰이크 실패: " << tlsError() << std::endl;
+            releaseSocket();
+            return false;
+        }
+    }
+#endif
+
+    if (!handshake(parsed.host, parsed.hostHeader, parsed.path)) {
+        releaseSocket();
+        return false;
+    }
+
+    setSocketTimeout(socket, std::chrono::milliseconds(0));
+    if (m_tls) {
+        // SSL 객체는 락으로 직렬화하므로 수신 대기 중에도 송신할 수 있도록 논블로킹,
+        // 수신 스레드는 소켓과 깨우기 채널을 제한 시간 없이 기다림
+        if (!createWakeChannel(m_wakeFds)) {
+            std::cerr << "[WebSocket] 깨우기 채널 생성 실패" << std::endl;
+            releaseSocket();
+            return false;
+        }
+        setSocketBlocking(socket, false);
+    }
+    m_open = true;
+    return true;
+}
+
+bool WebSocketClient::handshake(const std::string& host, const std::string& hostHeader,
+                                const std::string& path) {
+    uint8_t nonce[16];
+    std::random_device random;
+    for (uint8_t& byte : nonce) {
+        byte = static_cast<uint8_t>(random());
+    }
+    const std::string key = base64Encode(nonce, sizeof(nonce));
+
+    std::string request;
+    request += "GET " + path + " HTTP/1.1\r\n";
+    request += "Host: " + hostHeader + "\r\n";
+    request += "Upgrade: websocket\r\n";
+    request += "Connection: Upgrade\r\n";
+    request += "Sec-WebSocket-Key: " + key + "\r\n";
+    request += "Sec-WebSocket-Version: 13\r\n";
+    request += "User-Agent: SionHotkey/0.1\r\n\r\n";
+    // writeAll()은 연결 상태를 확인하므로 핸드셰이크 동안만 열린 것으로 표시
+    m_open = true;
+    const bool sent = writeAll(request.data(), request.size());
+    m_open = false;
+    if (!sent) {
+        std::cerr << "[WebSocket] 핸드셰이크 전송 실패: " << host << std::endl;
+        return false;
+    }
+
+    // 헤더 끝(\r\n\r\n)까지 읽고, 뒤에 붙은 바이트는 첫 프레임으로 남김
+    std::string response;
+    m_recvBuffer.clear();
+    m_recvOffset = 0;
+    size_t headerEnd = std::string::npos;
+    while (headerEnd == std::string::npos) {
+        if (response.size() > kMaxHandshakeSize) {
+            std::cerr << "[WebSocket] 핸드셰이크 응답이 너무 깁니다" << std::endl;
+            return false;
+        }
+        char chunk[1024];
+        m_open = true;
+        const size_t n = readSome(chunk, sizeof(chunk));
+        m_open = false;
+        if (n == 0) {
+            std::cerr << "[WebSocket] 핸드셰이크 응답 없음: " << host << std::endl;
+            return false;
+        }
+        response.append(chunk, n);
+        headerEnd = response.find("\r\n\r\n");
+    }
+    m_recvBuffer.assign(response.begin() + static_cast<std::ptrdiff_t>(headerEnd + 4), response.end());
+    response.resize(headerEnd + 2);
+
+    if (response.compare(0, 12, "HTTP/1.1 101") != 0) {
+        std::cerr << "[WebSocket] 업그레이드 거절: " << response.substr(0, response.find("\r\n")) << std::endl;
+        return false;
+    }
+
+    // 헤더 이름은 대소문자 무관, base64 값은 대소문자 구분
+    const std::string lowered = toLower(response);
+    const std::string name = "\r\nsec-websocket-accept:";
+    const size_t field = lowered.find(name);
+    if (field == std::string::npos) {
+        std::cerr << "[WebSocket] Sec-WebSocket-Accept 헤더 없음" << std::endl;
+        return false;
+    }
+    size_t valueStart = field + name.size();
+    while (valueStart < response.size() && response[valueStart] == ' ') {
+        ++valueStart;
+    }
+    std::string accept = response.substr(valueStart, response.find("\r\n", valueStart) - valueStart);
+    while (!accept.empty() && accept.back() == ' ') {
+        accept.pop_back();
+    }
+
+    uint8_t digest[20];
+    sha1(key + kHandshakeGuid, digest);
+    if (accept != base64Encode(digest, sizeof(digest))) {
+        std::cerr << "[WebSocket] Sec-WebSocket-Accept 불일치" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool WebSocketClient::sendText(const std::string& text) {
+    return sendFrame(Opcode::Text, text.data(), text.size());
+}
+
+bool WebSocketClient::sendBinary(const void* data, size_t size) {
+    return sendFrame(Opcode::Binary, data, size);
+}
+
+bool WebSocketClient::sendFrame(Opcode opcode, const void* data, size_t size) {
+    if (!m_open) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+
+    // 헤더(최대 14바이트)와 마스킹한 페이로드를 한 버퍼에 모아 한 번에 기록
+    m_sendBuffer.clear();
+    m_sendBuffer.push_back(static_cast<uint8_t>(0x80 | static_cast<uint8_t>(opcode)));
+    if (size < 126) {
+        m_sendBuffer.push_back(static_cast<uint8_t>(0x80 | size));
+    } else if (size <= 0xFFFF) {
+        m_sendBuffer.push_back(0x80 | 126);
+        m_sendBuffer.push_back(static_cast<uint8_t>(size >> 8));
+        m_sendBuffer.push_back(static_cast<uint8_t>(size));
+    } else {
+        m_sendBuffer.push_back(0x80 | 127);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            m_sendBuffer.push_back(static_cast<uint8_t>(static_cast<uint64_t>(size) >> shift));
+        }
+    }
+
+    // 마스킹 키 (xorshift32, 프레임마다 새 값)
+    m_maskState ^= m_maskState << 13;
+    m_maskState ^= m_maskState >> 17;
+    m_maskState ^= m_maskState << 5;
+    uint8_t mask[4];
+    std::memcpy(mask, &m_maskState, sizeof(mask));
+    m_sendBuffer.insert(m_sendBuffer.end(), mask, mask + 4);
+
+    const size_t headerSize = m_sendBuffer.size();
+    m_sendBuffer.resize(headerSize + size);
+    const auto* in = static_cast<const uint8_t*>(data);
+    uint8_t* out = m_sendBuffer.data() + headerSize;
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = in[i] ^ mask[i & 3];
+    }
+
+    if (!writeAll(m_sendBuffer.data(), m_sendBuffer.size())) {
+        m_open = false;
+        return false;
+    }
+    return true;
+}
+
+bool WebSocketClient::receive(Opcode& opcode, std::string& payload) {
+    std::string message;
+    Opcode messageOpcode = Opcode::Binary;
+    bool inMessage = false;
+
+    auto fail = [this]() {
+        m_open = false;
+        return false;
+    };
+
+    while (true) {
+        uint8_t head[2];
+        if (!readExact(head, sizeof(head))) {
+            return fail();
+        }
+
+        const bool fin = (head[0] & 0x80) != 0;
+        const auto frameOpcode = static_cast<Opcode>(head[0] & 0x0F);
+        const bool masked = (head[1] & 0x80) != 0;
+        uint64_t length = head[1] & 0x7F;
+
+        if (head[0] & 0x70) {
+            std::cerr << "[WebSocket] 협상하지 않은 확장 비트" << std::endl;
+            return fail();
+        }
+
+        if (length == 126 || length == 127) {
+            uint8_t extended[8];
+            const size_t bytes = length == 126 ? 2 : 8;
+            if (!readExact(extended, bytes)) {
+                return fail();
+            }
+            length = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                length = (length << 8) | extended[i];
+            }
+        }
+
+        if (length > kMaxMessageSize || message.size() + length > kMaxMessageSize) {
+            std::cerr << "[WebSocket] 메시지가 너무 큽니다: " << length << " bytes" << std::endl;
+            return fail();
+        }
+
+        uint8_t mask[4] = {0, 0, 0, 0};
+        if (masked && !readExact(mask, sizeof(mask))) {
+            return fail();
+        }
+
+        const bool control = (static_cast<uint8_t>(frameOpcode) & 0x08) != 0;
+        if (control && (!fin || length > 125)) {
+            std::cerr << "[WebSocket] 잘못된 제어 프레임" << std::endl;
+            return fail();
+        }
+
+        // 제어 프레임은 조각 메시지 사이에 끼어들 수 있으므로 별도 버퍼
+        std::string controlPayload;
+        std::string& target = control ? controlPayload : message;
+        const size_t offset = target.size();
+        target.resize(offset + static_cast<size_t>(length));
+        if (length > 0 && !readExact(&target[offset], static_cast<size_t>(length))) {
+            return fail();
+        }
+        if (masked) {
+            for (size_t i = 0; i < length; ++i) {
+                target[offset + i] = static_cast<char>(target[offset + i] ^ mask[i & 3]);
+            }
+        }
+
+        switch (frameOpcode) {
+            case Opcode::Ping:
+                sendFrame(Opcode::Pong, controlPayload.data(), controlPayload.size());
+                continue;
+            case Opcode::Pong:
+                continue;
+            case Opcode::Close:
+                // 상태 코드를 그대로 돌려보내 종료 핸드셰이크 완료
+                sendFrame(Opcode::Close, controlPayload.data(), std::min<size_t>(controlPayload.size(), 2));
+                return fail();
+            case Opcode::Continuation:
+                if (!inMessage) {
+                    return fail();
+                }
+                break;
+            case Opcode::Text:
+            case Opcode::Binary:
+                if (inMessage) {
+                    return fail();
+                }
+                messageOpcode = frameOpcode;
+                inMessage = true;
+                break;
+            default:
+                std::cerr << "[WebSocket] 알 수 없는 opcode: " << static_cast<int>(frameOpcode) << std::endl;
+                return fail();
+        }
+
+        if (fin) {
+            opcode = messageOpcode;
+            payload.swap(message);
+            return true;
+        }
+    }
+}
+
+void WebSocketClient::shutdown() {
+    if (m_socket == -1) {
+        return;
+    }
+    if (m_open) {
+        const uint8_t normalClosure[2] = {0x03, 0xE8};   // 1000
+        sendFrame(Opcode::Close, normalClosure, sizeof(normalClosure));
+    }
+    m_open = false;
+#ifdef _WIN32
+    ::shutdown(toNative(m_socket), SD_BOTH);
+#else
+    ::shutdown(toNative(m_socket), SHUT_RDWR);
+#endif
+    if (m_wakeFds[1] != -1) {
+        signalWake(m_wakeFds[1]);
+    }
+}
+
+void WebSocketClient::close() {
+    m_open = false;
+    releaseSocket();
+}
+
+void WebSocketClient::releaseSocket() {
+#ifdef SION_HAVE_OPENSSL
+    if (m_tls) {
+        SSL_free(static_cast<SSL*>(m_tls));
+        m_tls = nullptr;
+    }
+    if (m_tlsContext) {
+        SSL_CTX_free(static_cast<SSL_CTX*>(m_tlsContext));
+        m_tlsContext = nullptr;
+    }
+#endif
+    if (m_socket != -1) {
+        closeNativeSocket(toNative(m_socket));
+        m_socket = -1;
+    }
+    closeWakeChannel(m_wakeFds);
+    m_recvBuffer.clear();
+    m_recvOffset = 0;
+}
+
+bool WebSocketClient::writeAll(const void* data, size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+
+#ifdef SION_HAVE_OPENSSL
+    if (m_tls) {
+        SSL* tls = static_cast<SSL*>(m_tls);
+        while (size > 0 && m_open) {
+            int written;
+            int error;
+            bool pending;
+            {
+                std::lock_guard<std::mutex> lock(m_tlsMutex);
+                ScopedSigpipeBlock noSigpipe;
+                written = SSL_write(tls, bytes, static_cast<int>(std::min<size_t>(size, 1 << 30)));
+                error = written > 0 ? SSL_ERROR_NONE : SSL_get_error(tls, written);
+                pending = SSL_has_pending(tls) == 1;
+            }
+            if (pending && m_wakeFds[1] != -1) {
+                // 송신 중 읽어 둔 레코드는 소켓에 다시 나타나지 않으므로 수신 스레드를 깨움
+                signalWake(m_wakeFds[1]);
+            }
+            if (written > 0) {
+                bytes += written;
+                size -= static_cast<size_t>(written);
+            } else if (m_wakeFds[0] == -1) {
+                // 핸드셰이크 중 (블로킹 + SO_SNDTIMEO): 재시도 요구는 제한 시간 만료
+                return false;
+            } else if (error == SSL_ERROR_WANT_WRITE) {
+                pollSocket(toNative(m_socket), POLLOUT, -1);
+            } else if (error == SSL_ERROR_WANT_READ) {
+                pollSocket(toNative(m_socket), POLLIN, kTlsWriteRetryMs);
+            } else {
+                return false;
+            }
+        }
+        return size == 0;
+    }
+#endif
+
+    while (size > 0) {
+#ifdef _WIN32
+        const int written = ::send(toNative(m_socket), bytes, static_cast<int>(std::min<size_t>(size, 1 << 30)), 0);
+#else
+        const ssize_t written = ::send(toNative(m_socket), bytes, size, kSendFlags);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+size_t WebSocketClient::readSome(void* data, size_t size) {
+#ifdef SION_HAVE_OPENSSL
+    if (m_tls) {
+        SSL* tls = static_cast<SSL*>(m_tls);
+        while (m_open) {
+            int n;
+            int error;
+            {
+                std::lock_guard<std::mutex> lock(m_tlsMutex);
+                ScopedSigpipeBlock noSigpipe;   // 읽는 중에도 키 갱신 등으로 쓸 수 있음
+                n = SSL_read(tls, data, static_cast<int>(std::min<size_t>(size, 1 << 30)));
+                error = n > 0 ? SSL_ERROR_NONE : SSL_get_error(tls, n);
+            }
+            if (n > 0) {
+                return static_cast<size_t>(n);
+            }
+            if (m_wakeFds[0] == -1) {
+                // 핸드셰이크 중 (블로킹 + SO_RCVTIMEO): 재시도 요구는 제한 시간 만료
+                return 0;
+            }
+            // 송신 스레드가 레코드를 대신 읽었거나 shutdown()이면 깨우기 채널로 깨어남
+            if (error == SSL_ERROR_WANT_READ) {
+                waitSocketOrWake(toNative(m_socket), POLLIN, m_wakeFds[0]);
+            } else if (error == SSL_ERROR_WANT_WRITE) {
+                waitSocketOrWake(toNative(m_socket), POLLOUT, m_wakeFds[0]);
+            } else {
+                return 0;
+            }
+        }
+        return 0;
+    }
+#endif
+
+    while (true) {
+#ifdef _WIN32
+        const int n = ::recv(toNative(m_socket), static_cast<char*>(data), static_cast<int>(size), 0);
+#else
+        const ssize_t n = ::recv(toNative(m_socket), data, size, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (n < 0 && wouldBlock()) {
+            // SO_RCVTIMEO 만료 (핸드셰이크 제한 시간)
+            return 0;
+        }
+        return n > 0 ? static_cast<size_t>(n) : 0;
+    }
+}
+
+bool WebSocketClient::readExact(void* data, size_t size) {
+    auto* out = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        if (m_recvOffset == m_recvBuffer.size()) {
+            m_recvBuffer.resize(kReadChunkSize);
+            const size_t n = readSome(m_recvBuffer.data(), m_recvBuffer.size());
+            m_recvBuffer.resize(n);
+            m_recvOffset = 0;
+            if (n == 0) {
+                return false;
+            }
+        }
+        const size_t take = std::min(size, m_recvBuffer.size() - m_recvOffset);
+        std::memcpy(out, m_recvBuffer.data() + m_recvOffset, take);
+        m_recvOffset += take;
+        out += take;
+        size -= take;
+    }
+    return true;
+}
+
+} // namespace sion
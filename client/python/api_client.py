@@ -10,9 +10,17 @@ import httpx
 
 logger = logging.getLogger(__name__)
 
+# 유휴 연결 유지 시간 (초, 서버가 먼저 닫으면 다음 요청에서 다시 연결)
+KEEPALIVE_EXPIRY = 60.0
+
 
 class SionAPIClient:
-    """SION 백엔드 API 클라이언트"""
+    """
+    SION 백엔드 API 클라이언트
+
+    httpx.AsyncClient 하나를 처음 요청할 때 만들어 aclose()까지 재사용하므로,
+    연결(DNS/TCP/TLS)은 요청마다 새로 맺지 않고 유휴 연결로 남아 다음 요청이 씁니다.
+    """
     
     def __init__(
         self,
@@ -35,28 +43,46 @@ class SionAPIClient:
         }
         if api_key:
             self._headers["Authorization"] = f"Bearer {api_key}"
+        self._client: Optional[httpx.AsyncClient] = None
+    
+    def _http(self) -> httpx.AsyncClient:
+        """공유 HTTP 클라이언트 (첫 호출 시 생성)"""
+        if self._client is None or self._client.is_closed:
+            self._client = httpx.AsyncClient(
+                timeout=self.timeout,
+                limits=httpx.Limits(keepalive_expiry=KEEPALIVE_EXPIRY),
+            )
+        return self._client
+    
+    async def aclose(self) -> None:
+        """유지 중인 연결 닫기"""
+        if self._client is not None:
+            await self._client.aclose()
+            self._client = None
     
-    async def transcribe(self, audio_data: bytes) -> str:
+    async def transcribe(self, audio_data: bytes, filename: str = "audio.wav",
+                         content_type: str = "audio/wav") -> str:
         """
         음성을 텍스트로 변환 (ASR)
         
         Args:
-            audio_data: WAV 형식의 오디오 바이트
+            audio_data: 오디오 파일 바이트 (WAV, FLAC, Ogg Opus)
+            filename: 업로드 파일 이름 (확장자로 형식 구분)
+            content_type: 업로드 MIME 타입
             
         Returns:
             인식된 텍스트
         """
         url = f"{self.base_url}/asr/transcribe"
         
-        async with httpx.AsyncClient(timeout=self.timeout) as client:
-            files = {"audio": ("audio.wav", audio_data, "audio/wav")}
-            headers = {k: v for k, v in self._headers.items() if k != "Content-Type"}
-            
-            response = await client.post(url, files=files, headers=headers)
-            response.raise_for_status()
-            
-            result = response.json()
-            return result.get("text", "")
+        files = {"audio": (filename, audio_data, content_type)}
+        headers = {k: v for k, v in self._headers.items() if k != "Content-Type"}
+        
+        response = await self._http().post(url, files=files, headers=headers)
+        response.raise_for_status()
+        
+        result = response.json()
+        return result.get("text", "")
     
     async def analyze_intent(self, text: str) -> dict:
         """
@@ -70,13 +96,12 @@ class SionAPIClient:
         """
         url = f"{self.base_url}/nlu/analyze"
         
-        async with httpx.AsyncClient(timeout=self.timeout) as client:
-            payload = {"text": text}
-            
-            response = await client.post(url, json=payload, headers=self._headers)
-            response.raise_for_status()
-            
-            return response.json()
+        payload = {"text": text}
+        
+        response = await self._http().post(url, json=payload, headers=self._headers)
+        response.raise_for_status()
+        
+        return response.json()
     
     async def execute_task(self, intent: str, entities: dict) -> dict:
         """
@@ -91,16 +116,38 @@ class SionAPIClient:
         """
         url = f"{self.base_url}/tasks/execute"
         
-        async with httpx.AsyncClient(timeout=self.timeout) as client:
-            payload = {
-                "intent": intent,
-                "entities": entities
-            }
-            
-            response = await client.post(url, json=payload, headers=self._headers)
-            response.raise_for_status()
+        payload = {
+            "intent": intent,
+            "entities": entities
+        }
+        
+        response = await self._http().post(url, json=payload, headers=self._headers)
+        response.raise_for_status()
+        
+        return response.json()
+    
+    async def prefetch_task(self, intent: str, entities: dict) -> dict:
+        """
+        작업 준비 요청 (추측 NLU 결과로 실행 전에 호출)
+        
+        Args:
+            intent: 예상 작업 의도
+            entities: 지금까지 추출된 엔티티
             
-            return response.json()
+        Returns:
+            준비 결과 ({"intent", "prefetched"})
+        """
+        url = f"{self.base_url}/tasks/prefetch"
+        
+        payload = {
+            "intent": intent,
+            "entities": entities
+        }
+        
+        response = await self._http().post(url, json=payload, headers=self._headers)
+        response.raise_for_status()
+        
+        return response.json()
     
     async def chat(self, message: str, conversation_id: Optional[str] = None) -> dict:
         """
@@ -115,16 +162,15 @@ class SionAPIClient:
         """
         url = f"{self.base_url}/tasks/chat"
         
-        async with httpx.AsyncClient(timeout=self.timeout) as client:
-            payload = {
-                "message": message,
-                "conversation_id": conversation_id
-            }
-            
-            response = await client.post(url, json=payload, headers=self._headers)
-            response.raise_for_status()
-            
-            return response.json()
+        payload = {
+            "message": message,
+            "conversation_id": conversation_id
+        }
+        
+        response = await self._http().post(url, json=payload, headers=self._headers)
+        response.raise_for_status()
+        
+        return response.json()
     
     async def health_check(self) -> dict:
         """
@@ -136,20 +182,20 @@ class SionAPIClient:
         results = {}
         services = ["asr", "nlu", "tasks"]
         
-        async with httpx.AsyncClient(timeout=5.0) as client:
-            for service in services:
-                try:
-                    url = f"{self.base_url}/{service}/health"
-                    response = await client.get(url)
-                    results[service] = {
-                        "status": "healthy" if response.status_code == 200 else "unhealthy",
-                        "code": response.status_code
-                    }
-                except Exception as e:
-                    results[service] = {
-                        "status": "unreachable",
-                        "error": str(e)
-                    }
+        client = self._http()
+        for service in services:
+            try:
+                url = f"{self.base_url}/{service}/health"
+                response = await client.get(url, timeout=5.0)
+                results[service] = {
+                    "status": "healthy" if response.status_code == 200 else "unhealthy",
+                    "code": response.status_code
+                }
+            except Exception as e:
+                results[service] = {
+                    "status": "unreachable",
+                    "error": str(e)
+                }
         
         return results
 
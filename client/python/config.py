@@ -51,6 +51,16 @@ class Settings(BaseSettings):
         default=10.0,
         description="최대 녹음 시간 (초)"
     )
+    AUDIO_CODECS: str = Field(
+        default="pcm,flac,opus",
+        description="파이프 모드에서 받을 수 있는 오디오 코덱 (READY로 C++에 전달)"
+    )
+    
+    # 추측 NLU 설정 (파이프 모드 SPECULATE)
+    SPECULATIVE_CONFIDENCE: float = Field(
+        default=0.8,
+        description="중간 인식 텍스트의 의도로 작업 준비를 요청할 최소 NLU 신뢰도"
+    )
     
     # 로깅 설정
     LOG_LEVEL: str = Field(
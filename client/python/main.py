@@ -3,13 +3,17 @@ Personal Assistant SION - Main Client Entry Point
 음성 녹음 및 AWS API 호출을 담당하는 메인 클라이언트
 """
 
+import argparse
 import asyncio
 import logging
 from pathlib import Path
+from typing import Optional, Tuple
 
 from audio_recorder import AudioRecorder
 from api_client import SionAPIClient
 from config import settings
+from pipe_server import PipeServer
+from shared_audio import SharedAudioRing
 
 # 로깅 설정
 logging.basicConfig(
@@ -18,6 +22,12 @@ logging.basicConfig(
 )
 logger = logging.getLogger(__name__)
 
+# 추측 NLU 결과로 미리 준비할 의도 (Google API 예열, 오늘 일정 조회)
+PREFETCH_INTENTS = {
+    "schedule_check", "schedule_add", "schedule_delete",
+    "email_check", "email_send",
+}
+
 
 class PersonalAssistant:
     """개인 비서 메인 클래스"""
@@ -75,8 +85,7 @@ class PersonalAssistant:
         - 로컬 작업: 파일 탐색, 앱 실행 등
         - 원격 작업: 이메일, 일정, LLM 질의 등
         """
-        intent = nlu_result.get("intent", "unknown")
-        entities = nlu_result.get("entities", {})
+        intent, _, entities = self.parse_intent(nlu_result)
         
         # 로컬에서 처리할 작업
         local_intents = ["file_search", "open_app", "system_control"]
@@ -87,6 +96,41 @@ class PersonalAssistant:
             # AWS에서 처리할 작업
             return await self.api_client.execute_task(intent, entities)
     
+    async def prefetch(self, nlu_result: dict) -> bool:
+        """
+        추측 NLU 결과로 작업 준비 (발화가 끝나기 전, 파이프 모드 SPECULATE)
+        
+        신뢰도가 SPECULATIVE_CONFIDENCE 이상인 일정/이메일 의도만 백엔드에 준비를
+        요청합니다. 최종 의도가 달라도 준비한 상태는 짧은 시간 뒤 만료될 뿐입니다.
+        
+        Returns:
+            준비를 요청했는지 여부
+        """
+        intent, confidence, entities = self.parse_intent(nlu_result)
+        if intent not in PREFETCH_INTENTS or confidence < settings.SPECULATIVE_CONFIDENCE:
+            return False
+        await self.api_client.prefetch_task(intent, entities)
+        return True
+    
+    @staticmethod
+    def parse_intent(nlu_result: dict) -> Tuple[str, float, dict]:
+        """
+        NLU 결과에서 (의도, 신뢰도, 엔티티) 추출
+        
+        NLU 서비스 응답({"intent": {"name", "confidence"}, "entities": [{"type", "value"}]})과
+        단순 형식({"intent": "...", "entities": {...}}) 모두 받습니다.
+        """
+        intent = nlu_result.get("intent", "unknown")
+        confidence = 1.0
+        if isinstance(intent, dict):
+            confidence = float(intent.get("confidence", 0.0))
+            intent = intent.get("name", "unknown")
+        
+        entities = nlu_result.get("entities") or {}
+        if isinstance(entities, list):
+            entities = {e["type"]: e["value"] for e in entities if "type" in e and "value" in e}
+        return intent, confidence, entities
+    
     async def _execute_local_task(self, intent: str, entities: dict) -> dict:
         """로컬에서 실행되는 작업"""
         # TODO: 로컬 작업 구현
@@ -98,27 +142,58 @@ class PersonalAssistant:
         logger.info("🚀 Personal Assistant SION 시작")
         logger.info(f"📡 API 서버: {settings.API_BASE_URL}")
         
+    async def warm_up(self):
+        """
+        첫 요청 전 예열 (파이프 모드 워커)
+        
+        모듈 임포트는 프로세스 시작 시 끝나므로, 여기서는 백엔드 서비스에
+        미리 연결해 DNS/TLS 비용과 서버 측 모델 로딩을 첫 명령 전에 치릅니다.
+        api_client는 워커 수명 동안 같은 HTTP 클라이언트를 쓰므로 이 연결이 유휴
+        연결로 남아 첫 명령이 재사용합니다 (KEEPALIVE_EXPIRY 안, 서버가 닫지 않은 경우).
+        """
+        status = await self.api_client.health_check()
+        logger.info(f"🔥 예열 완료: {status}")
+    
     def stop(self):
         """비서 종료"""
         logger.info("👋 Personal Assistant SION 종료")
 
 
-async def main():
+async def main(pipe_mode: bool = False, shm_name: Optional[str] = None):
     """메인 함수"""
     assistant = PersonalAssistant()
     assistant.start()
     
     try:
-        # 예시: 단일 음성 명령 처리
-        result = await assistant.process_voice_command()
-        print(f"결과: {result}")
+        if pipe_mode:
+            # C++ Hotkey 모듈의 파이프 요청 처리 (stdout은 프레임 전용)
+            shared_audio = SharedAudioRing(shm_name) if shm_name else None
+            try:
+                codecs = [c.strip() for c in settings.AUDIO_CODECS.split(",") if c.strip()]
+                await PipeServer(assistant, sample_rate=settings.AUDIO_SAMPLE_RATE,
+                                 shared_audio=shared_audio, codecs=codecs).serve()
+            finally:
+                if shared_audio:
+                    shared_audio.close()
+        else:
+            # 예시: 단일 음성 명령 처리
+            result = await assistant.process_voice_command()
+            print(f"결과: {result}")
     except KeyboardInterrupt:
         pass
     finally:
+        await assistant.api_client.aclose()
         assistant.stop()
 
 
 if __name__ == "__main__":
-    asyncio.run(main())
+    parser = argparse.ArgumentParser(description="Personal Assistant SION Client")
+    parser.add_argument("--pipe-mode", action="store_true",
+                        help="C++ Hotkey 모듈과 파이프 프로토콜로 통신")
+    parser.add_argument("--shm", metavar="NAME",
+                        help="C++가 만든 공유 메모리 오디오 링 이름 (AUDIO_SHM 수신)")
+    args = parser.parse_args()
+    
+    asyncio.run(main(pipe_mode=args.pipe_mode, shm_name=args.shm))
 
 
@@ -0,0 +1,422 @@
+"""
+Pipe Server Module
+C++ Hotkey 모듈과 파이프 프레임 프로토콜로 통신하는 서버 (--pipe-mode)
+
+프레임 형식 (client/cpp/include/bridge_protocol.h와 동일, 리틀 엔디언 16바이트 헤더):
+    magic(1) | version(1) | type(1) | flags(1) | utterance_id(4) | sequence(4) | payload_size(4)
+"""
+
+import asyncio
+import io
+import json
+import logging
+import re
+import struct
+import sys
+import wave
+from collections import OrderedDict
+from enum import IntEnum
+from typing import BinaryIO, Dict, List, Optional, Set, Tuple, Union
+
+logger = logging.getLogger(__name__)
+
+HEADER = struct.Struct("<BBBBIII")
+MAGIC = ord("S")
+VERSION = 1
+MAX_PAYLOAD_SIZE = 16 * 1024 * 1024
+
+
+class MessageType(IntEnum):
+    """브릿지 메시지 타입"""
+    AUDIO_CHUNK = 1
+    END_OF_UTTERANCE = 2
+    PARTIAL_RESULT = 3
+    FINAL_RESULT = 4
+    CANCEL = 5
+    COMMAND = 6
+    COMMAND_RESULT = 7
+    ERROR = 8
+    READY = 9
+    AUDIO_SHM = 10
+    TRANSCRIPT = 11
+    INTENT = 12
+    SPECULATE = 13
+    SESSION = 14
+
+
+class AudioCodec(IntEnum):
+    """AUDIO_CHUNK 페이로드 코덱 (헤더 flags)"""
+    PCM = 0
+    FLAC = 1
+    OPUS = 2
+
+
+# 코덱별 ASR 업로드 파일 이름 / MIME 타입 (PCM은 WAV로 감쌈)
+CODEC_UPLOADS = {
+    AudioCodec.FLAC: ("audio.flac", "audio/flac"),
+    AudioCodec.OPUS: ("audio.ogg", "audio/ogg"),
+}
+
+
+Frame = Tuple[Union[MessageType, int], int, int, int, bytes]
+
+SHM_AUDIO_REF = struct.Struct("<III")  # slot | sample_offset | sample_count
+SESSION_ID = struct.Struct("<I")  # 캡처 세션 ID (세션 0이면 프레임 없음)
+
+# 워커당 보관하는 추측 NLU 수 (오래된 것부터 취소)
+MAX_SPECULATIONS = 8
+
+
+def normalize_transcript(text: str) -> str:
+    """추측과 최종 인식 텍스트 비교용 정규화 (앞뒤 공백/문장부호 제거, 공백 축약, 소문자)"""
+    return re.sub(r"\s+", " ", text).strip().rstrip(".?!,~ ").lower()
+
+
+def read_exact(stream: BinaryIO, size: int) -> Optional[bytes]:
+    """정확히 size 바이트를 읽음 (EOF 시 None)"""
+    chunks = []
+    remaining = size
+    while remaining > 0:
+        chunk = stream.read(remaining)
+        if not chunk:
+            return None
+        chunks.append(chunk)
+        remaining -= len(chunk)
+    return b"".join(chunks)
+
+
+def read_frame(stream: BinaryIO) -> Optional[Frame]:
+    """
+    프레임 한 개 수신
+
+    알 수 없는 타입(새 버전 상대의 확장 메시지)도 페이로드까지 읽어 int 타입으로 반환하므로,
+    호출 측은 건너뛰기만 하면 이후 프레임 경계가 유지됩니다.
+
+    Returns:
+        (type, flags, utterance_id, sequence, payload) 또는 EOF 시 None
+    """
+    raw = read_exact(stream, HEADER.size)
+    if raw is None:
+        return None
+
+    magic, version, msg_type, flags, utterance_id, sequence, size = HEADER.unpack(raw)
+    if magic != MAGIC or version != VERSION or size > MAX_PAYLOAD_SIZE:
+        raise ValueError("잘못된 프레임 헤더")
+
+    payload = read_exact(stream, size) if size else b""
+    if payload is None:
+        return None
+
+    try:
+        msg_type = MessageType(msg_type)
+    except ValueError:
+        pass
+    return msg_type, flags, utterance_id, sequence, payload
+
+
+class FrameWriter:
+    """프레임 송신기 (송신 시퀀스 관리)"""
+
+    def __init__(self, stream: BinaryIO):
+        self._stream = stream
+        self._sequence = 0
+
+    def write(self, msg_type: MessageType, utterance_id: int, payload: bytes = b"") -> None:
+        header = HEADER.pack(MAGIC, VERSION, int(msg_type), 0,
+                             utterance_id, self._sequence, len(payload))
+        self._sequence = (self._sequence + 1) & 0xFFFFFFFF
+        self._stream.write(header + payload)
+        self._stream.flush()
+
+
+def pcm_to_wav(pcm: bytes, sample_rate: int = 16000) -> bytes:
+    """PCM s16le 모노 데이터를 WAV 바이트로 변환"""
+    buffer = io.BytesIO()
+    with wave.open(buffer, "wb") as wav_file:
+        wav_file.setnchannels(1)
+        wav_file.setsampwidth(2)
+        wav_file.setframerate(sample_rate)
+        wav_file.writeframes(pcm)
+    return buffer.getvalue()
+
+
+class PipeServer:
+    """
+    C++ 브릿지 요청 처리 서버
+
+    stdin에서 프레임을 읽어 발화별로 오디오를 모으고, END_OF_UTTERANCE가 오면
+    ASR → NLU → Task 파이프라인을 비동기 작업으로 실행합니다.
+    인식된 텍스트는 PARTIAL_RESULT로, 전체 결과는 FINAL_RESULT(JSON)로 응답합니다.
+    CANCEL은 해당 발화의 버퍼와 진행 중인 작업을 즉시 폐기합니다.
+    요청을 받기 전에 assistant.warm_up()을 실행하고 READY를 보내므로,
+    C++ 워커 풀은 예열이 끝난 워커에만 요청을 보냅니다.
+    READY 페이로드에는 받을 수 있는 코덱 목록("pcm,flac,opus")을 싣고,
+    압축된 발화는 디코딩 없이 그대로 ASR 서버에 업로드합니다.
+    C++가 ASR 서비스에 직접 스트리밍한 발화는 인식 텍스트만 TRANSCRIPT로 오며,
+    NLU → Task만 실행해 같은 형식의 FINAL_RESULT로 응답합니다.
+    C++ 응답 캐시에 의도가 있는 발화는 INTENT({"transcription", "intent"})로 오며,
+    NLU 없이 Task만 실행합니다.
+    SPECULATE는 아직 말하는 중인 발화의 안정된 중간 인식 텍스트로, 응답 없이 NLU를
+    미리 실행하고 의도가 확실하면 작업 준비(assistant.prefetch)를 요청합니다.
+    같은 텍스트의 TRANSCRIPT가 오면 추측한 NLU 결과를 그대로 쓰고, 아니면 버립니다.
+    C++가 여러 캡처 장치(세션)를 쓰면 발화의 첫 프레임 전에 SESSION이 오며,
+    해당 발화의 FINAL_RESULT에 "session"을 담아 어느 장치의 명령인지 알립니다.
+    """
+
+    def __init__(self, assistant, sample_rate: int = 16000, shared_audio=None,
+                 codecs: Optional[List[str]] = None):
+        """
+        Args:
+            assistant: PersonalAssistant 인스턴스
+            sample_rate: AUDIO_CHUNK의 샘플링 레이트 (Hz)
+            shared_audio: AUDIO_SHM을 읽을 SharedAudioRing (선택)
+            codecs: READY로 알릴 코덱 이름 목록 (기본 PCM만)
+        """
+        self.assistant = assistant
+        self.sample_rate = sample_rate
+        self.shared_audio = shared_audio
+        self.codecs = codecs or ["pcm"]
+        self._reader = sys.stdin.buffer
+        self._writer = FrameWriter(sys.stdout.buffer)
+        self._buffers: Dict[int, bytearray] = {}
+        self._codecs: Dict[int, AudioCodec] = {}
+        self._tasks: Dict[int, asyncio.Task] = {}
+        self._sessions: Dict[int, int] = {}
+        self._last_sequence: Optional[int] = None
+        self._speculations: "OrderedDict[str, asyncio.Task]" = OrderedDict()
+        self._prefetches: Set[asyncio.Task] = set()
+
+    async def serve(self) -> None:
+        """EOF까지 요청 처리"""
+        loop = asyncio.get_running_loop()
+        logger.info("🔌 파이프 모드 시작")
+
+        await self._warm_up()
+        self._writer.write(MessageType.READY, 0, ",".join(self.codecs).encode("ascii"))
+
+        while True:
+            # 블로킹 읽기는 별도 스레드에서 수행하여 처리 중에도 CANCEL을 받음
+            frame = await loop.run_in_executor(None, read_frame, self._reader)
+            if frame is None:
+                break
+            self._dispatch(*frame)
+
+        for task in self._tasks.values():
+            task.cancel()
+        logger.info("🔌 파이프 종료")
+
+    async def _warm_up(self) -> None:
+        """첫 요청 전 예열 (실패해도 서비스는 계속)"""
+        warm_up = getattr(self.assistant, "warm_up", None)
+        if warm_up is None:
+            return
+        try:
+            await warm_up()
+        except Exception as e:
+            logger.warning(f"⚠️ 예열 실패: {e}")
+
+    def _dispatch(self, msg_type: Union[MessageType, int], flags: int, utterance_id: int,
+                  sequence: int, payload: bytes) -> None:
+        if self._last_sequence is not None and sequence != (self._last_sequence + 1) & 0xFFFFFFFF:
+            logger.warning(f"시퀀스 불연속: {self._last_sequence} → {sequence}")
+        self._last_sequence = sequence
+
+        if msg_type == MessageType.AUDIO_CHUNK:
+            if flags not in tuple(AudioCodec):
+                logger.error(f"❌ 알 수 없는 오디오 코덱: {flags}")
+                self._buffers.pop(utterance_id, None)
+                self._sessions.pop(utterance_id, None)
+                self._writer.write(MessageType.ERROR, utterance_id, f"unsupported codec {flags}".encode("utf-8"))
+                return
+            self._codecs.setdefault(utterance_id, AudioCodec(flags))
+            self._buffers.setdefault(utterance_id, bytearray()).extend(payload)
+
+        elif msg_type == MessageType.AUDIO_SHM:
+            self._read_shared_audio(utterance_id, payload)
+
+        elif msg_type == MessageType.END_OF_UTTERANCE:
+            audio = bytes(self._buffers.pop(utterance_id, b""))
+            codec = self._codecs.pop(utterance_id, AudioCodec.PCM)
+            self._start(utterance_id, self._process_utterance(utterance_id, audio, codec))
+
+        elif msg_type == MessageType.TRANSCRIPT:
+            self._start(utterance_id, self._process_transcript(utterance_id, payload.decode("utf-8")))
+
+        elif msg_type == MessageType.INTENT:
+            self._start(utterance_id, self._process_intent(utterance_id, payload))
+
+        elif msg_type == MessageType.SPECULATE:
+            self._speculate(payload.decode("utf-8"))
+
+        elif msg_type == MessageType.SESSION:
+            if len(payload) != SESSION_ID.size:
+                logger.warning(f"잘못된 SESSION 페이로드 크기: {len(payload)}")
+                return
+            self._sessions[utterance_id] = SESSION_ID.unpack(payload)[0]
+
+        elif msg_type == MessageType.COMMAND:
+            self._start(utterance_id, self._process_command(utterance_id, payload.decode("utf-8")))
+
+        elif msg_type == MessageType.CANCEL:
+            self._buffers.pop(utterance_id, None)
+            self._codecs.pop(utterance_id, None)
+            self._sessions.pop(utterance_id, None)
+            task = self._tasks.pop(utterance_id, None)
+            if task:
+                task.cancel()
+            logger.info(f"⛔ 발화 {utterance_id} 취소")
+
+        else:
+            logger.warning(f"알 수 없는 메시지 타입 {msg_type} (페이로드 {len(payload)}바이트), 건너뜀")
+
+    def _read_shared_audio(self, utterance_id: int, payload: bytes) -> None:
+        """AUDIO_SHM 구간을 발화 버퍼에 누적 (슬롯은 결과 전까지 C++가 유지)"""
+        try:
+            if self.shared_audio is None:
+                raise RuntimeError("공유 메모리가 연결되지 않았습니다 (--shm 없음)")
+            slot, offset, count = SHM_AUDIO_REF.unpack(payload)
+            with self.shared_audio.read(slot, offset, count) as samples:
+                self._buffers.setdefault(utterance_id, bytearray()).extend(samples)
+        except Exception as e:
+            logger.error(f"❌ 공유 메모리 오디오 읽기 실패: {e}")
+            self._buffers.pop(utterance_id, None)
+            self._writer.write(MessageType.ERROR, utterance_id, str(e).encode("utf-8"))
+
+    def _start(self, utterance_id: int, coro) -> None:
+        task = asyncio.ensure_future(coro)
+        self._tasks[utterance_id] = task
+        task.add_done_callback(lambda _: self._finish(utterance_id))
+
+    def _finish(self, utterance_id: int) -> None:
+        """발화 작업 종료 시 발화별 상태 정리"""
+        self._tasks.pop(utterance_id, None)
+        self._sessions.pop(utterance_id, None)
+
+    async def _process_utterance(self, utterance_id: int, audio: bytes,
+                                 codec: AudioCodec = AudioCodec.PCM) -> None:
+        try:
+            if codec == AudioCodec.PCM:
+                transcription = await self.assistant.api_client.transcribe(
+                    pcm_to_wav(audio, self.sample_rate))
+            else:
+                filename, content_type = CODEC_UPLOADS[codec]
+                transcription = await self.assistant.api_client.transcribe(
+                    audio, filename=filename, content_type=content_type)
+            self._writer.write(MessageType.PARTIAL_RESULT, utterance_id,
+                               transcription.encode("utf-8"))
+            await self._respond(utterance_id, transcription)
+        except asyncio.CancelledError:
+            raise
+        except Exception as e:
+            logger.error(f"❌ 발화 처리 오류: {e}")
+            self._writer.write(MessageType.ERROR, utterance_id, str(e).encode("utf-8"))
+
+    async def _process_transcript(self, utterance_id: int, transcription: str) -> None:
+        try:
+            await self._respond(utterance_id, transcription)
+        except asyncio.CancelledError:
+            raise
+        except Exception as e:
+            logger.error(f"❌ 인식 텍스트 처리 오류: {e}")
+            self._writer.write(MessageType.ERROR, utterance_id, str(e).encode("utf-8"))
+
+    async def _process_intent(self, utterance_id: int, payload: bytes) -> None:
+        try:
+            request = json.loads(payload.decode("utf-8"))
+            await self._respond(utterance_id, request["transcription"], request["intent"])
+        except asyncio.CancelledError:
+            raise
+        except Exception as e:
+            logger.error(f"❌ 캐시된 의도 처리 오류: {e}")
+            self._writer.write(MessageType.ERROR, utterance_id, str(e).encode("utf-8"))
+
+    def _speculate(self, prefix: str) -> None:
+        """SPECULATE: 중간 인식 텍스트로 NLU를 미리 시작 (같은 텍스트는 한 번만)"""
+        key = normalize_transcript(prefix)
+        if not key or key in self._speculations:
+            return
+        self._speculations[key] = asyncio.ensure_future(self._run_speculation(prefix))
+        while len(self._speculations) > MAX_SPECULATIONS:
+            _, stale = self._speculations.popitem(last=False)
+            stale.cancel()
+
+    async def _run_speculation(self, prefix: str) -> dict:
+        nlu_result = await self.assistant.api_client.analyze_intent(prefix)
+        # 작업 준비는 확정 대기와 분리 (준비가 느려도 최종 응답을 늦추지 않음)
+        task = asyncio.ensure_future(self._prefetch(prefix, nlu_result))
+        self._prefetches.add(task)
+        task.add_done_callback(self._prefetches.discard)
+        return nlu_result
+
+    async def _prefetch(self, prefix: str, nlu_result: dict) -> None:
+        try:
+            if await self.assistant.prefetch(nlu_result):
+                logger.info(f"🔮 작업 준비: {prefix}")
+        except Exception as e:
+            logger.warning(f"작업 준비 실패 (무시): {e}")
+
+    async def _take_speculation(self, transcription: str) -> Optional[dict]:
+        """
+        최종 인식 텍스트로 추측 확정/폐기
+
+        같은 텍스트의 추측이 있으면 그 NLU 결과를 반환하고, 최종 텍스트의 앞부분이던
+        (같은 발화의) 나머지 추측은 취소합니다.
+        """
+        key = normalize_transcript(transcription)
+        confirmed = self._speculations.pop(key, None)
+        for stale in [k for k in self._speculations if key.startswith(k)]:
+            self._speculations.pop(stale).cancel()
+        if confirmed is None:
+            return None
+
+        # shield: 발화 작업이 취소(CANCEL)돼도 추측 future로 전파하지 않고, 취소를 그대로
+        # 올려 보내 NLU/작업 실행이 이어지지 않게 함. 추측만 취소된 경우에만 다시 분석.
+        try:
+            nlu_result = await asyncio.shield(confirmed)
+        except asyncio.CancelledError:
+            cancelling = getattr(asyncio.current_task(), "cancelling", None)  # 3.11+
+            if not confirmed.cancelled() or (cancelling is not None and cancelling()):
+                confirmed.cancel()
+                raise
+            return None
+        except Exception as e:
+            logger.warning(f"추측 NLU 실패, 다시 분석: {e}")
+            return None
+        logger.info(f"🔮 추측 NLU 확정: {transcription}")
+        return nlu_result
+
+    async def _respond(self, utterance_id: int, transcription: str,
+                       nlu_result: Optional[dict] = None) -> None:
+        """
+        인식 텍스트로 NLU → Task 실행 후 FINAL_RESULT 응답
+
+        nlu_result가 있거나(INTENT) 같은 텍스트의 추측이 확정되면 NLU를 생략합니다.
+        """
+        if nlu_result is None:
+            nlu_result = await self._take_speculation(transcription)
+        if nlu_result is None:
+            nlu_result = await self.assistant.api_client.analyze_intent(transcription)
+        task_result = await self.assistant.execute_task(nlu_result)
+
+        result = {
+            "transcription": transcription,
+            "intent": nlu_result,
+            "result": task_result,
+        }
+        session = self._sessions.get(utterance_id)
+        if session is not None:
+            result["session"] = session
+        self._writer.write(MessageType.FINAL_RESULT, utterance_id,
+                           json.dumps(result, ensure_ascii=False).encode("utf-8"))
+
+    async def _process_command(self, utterance_id: int, command: str) -> None:
+        try:
+            nlu_result = await self.assistant.api_client.analyze_intent(command)
+            task_result = await self.assistant.execute_task(nlu_result)
+            self._writer.write(MessageType.COMMAND_RESULT, utterance_id,
+                               json.dumps(task_result, ensure_ascii=False).encode("utf-8"))
+        except asyncio.CancelledError:
+            raise
+        except Exception as e:
+            logger.error(f"❌ 명령 처리 오류: {e}")
+            self._writer.write(MessageType.ERROR, utterance_id, str(e).encode("utf-8"))
@@ -0,0 +1,83 @@
+"""
+Shared Audio Module
+C++ 클라이언트가 만든 공유 메모리 오디오 슬롯 링을 여는 모듈 (--shm)
+
+레이아웃 (client/cpp/include/shared_audio_ring.h와 동일, 리틀 엔디언):
+    [헤더 64B: magic | version | slot_count | slot_samples | sample_rate | data_offset | slot_stride]
+    [슬롯 0][슬롯 1]... (각 슬롯은 slot_samples개의 int16)
+"""
+
+import logging
+import struct
+import sys
+from multiprocessing import shared_memory
+
+logger = logging.getLogger(__name__)
+
+HEADER = struct.Struct("<7I")
+MAGIC = 0x31524153  # "SAR1"
+VERSION = 1
+SAMPLE_SIZE = 2
+
+
+class SharedAudioRing:
+    """
+    공유 메모리 오디오 링 (읽기 전용 사용)
+
+    영역의 생성/삭제와 슬롯 소유권은 C++ 쪽이 관리합니다.
+    AUDIO_SHM 프레임이 가리키는 구간은 해당 발화의 최종 결과를 보낼 때까지 유효합니다.
+    """
+
+    def __init__(self, name: str):
+        """
+        Args:
+            name: C++가 전달한 영역 이름 (--shm 인자)
+        """
+        if sys.version_info >= (3, 13):
+            self._shm = shared_memory.SharedMemory(name=name, create=False, track=False)
+        else:
+            self._shm = shared_memory.SharedMemory(name=name, create=False)
+            # 소유자가 아니므로 종료 시 resource_tracker가 unlink하지 않도록 해제
+            if sys.platform != "win32":
+                from multiprocessing import resource_tracker
+                resource_tracker.unregister(self._shm._name, "shared_memory")
+
+        (magic, version, self.slot_count, self.slot_samples,
+         self.sample_rate, self._data_offset, self._slot_stride) = HEADER.unpack_from(self._shm.buf, 0)
+
+        if magic != MAGIC or version != VERSION:
+            self._shm.close()
+            raise ValueError(f"공유 메모리 헤더 불일치: magic={magic:#x} version={version}")
+
+        logger.info(f"🧩 공유 메모리 오디오 링 연결: {name} "
+                    f"({self.slot_count}슬롯 × {self.slot_samples}샘플)")
+
+    def read(self, slot: int, sample_offset: int, sample_count: int) -> memoryview:
+        """
+        슬롯 구간을 복사 없이 반환
+
+        Args:
+            slot: 슬롯 번호
+            sample_offset: 슬롯 내 시작 샘플
+            sample_count: 샘플 수
+
+        Returns:
+            int16 PCM 바이트에 대한 memoryview
+        """
+        if slot >= self.slot_count or sample_offset + sample_count > self.slot_samples:
+            raise ValueError(f"잘못된 공유 메모리 구간: slot={slot} "
+                             f"offset={sample_offset} count={sample_count}")
+
+        start = self._data_offset + slot * self._slot_stride + sample_offset * SAMPLE_SIZE
+        return self._shm.buf[start:start + sample_count * SAMPLE_SIZE]
+
+    def view(self, slot: int, sample_offset: int, sample_count: int):
+        """
+        슬롯 구간을 복사 없는 numpy int16 배열로 반환 (numpy 필요)
+        """
+        import numpy as np
+        return np.frombuffer(self.read(slot, sample_offset, sample_count), dtype="<i2")
+
+    def close(self) -> None:
+        """매핑 해제 (영역 삭제는 C++ 쪽 책임)"""
+        self._shm.close()
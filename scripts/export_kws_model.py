@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""
+KWS Model Exporter
+학습된 float 키워드 인식 CNN을 C++ KeywordSpotter용 int8 모델(.kws)로 변환하는 스크립트
+
+입력 (.npz):
+    layer_types   문자열 배열, 각 원소는 "conv" | "dense" | "gap"
+    w{i}, b{i}    i번째 conv/dense 레이어 가중치와 편향
+                  conv: [out][kh][kw][in] (PyTorch [out][in][kh][kw]면 transpose(0, 2, 3, 1))
+                  dense: [out][in] (입력은 HWC 순서로 펼친 벡터)
+    stride{i}     conv 스트라이드 [sh, sw] (생략 시 [1, 1])
+    relu{i}       0/1 (생략 시 마지막 레이어를 제외하고 1)
+
+보정 데이터 (--calibration, .npy):
+    [N][numFrames][numMels] 로그 멜 특징 (client/cpp/src/log_mel_frontend.cpp와 같은 방식:
+    Hann 창, HTK 멜 필터, ln(파워 + 1e-6), 입력은 [-1, 1] 정규화)
+    레이어별 활성값 배율을 정하는 데 사용합니다.
+
+사용법:
+    python scripts/export_kws_model.py model.npz calib.npy -o sion.kws --keyword-index 1
+    SION_WAKEWORD_MODEL=sion.kws ./build/sion_client
+"""
+
+import argparse
+import struct
+import sys
+
+import numpy as np
+
+MAGIC = b"SKWS"
+VERSION = 1
+LAYER_CONV = 1
+LAYER_DENSE = 2
+LAYER_GAP = 3
+
+
+def _symmetric_scale(values: np.ndarray, percentile: float = 99.99) -> float:
+    """대칭 int8 배율 (이상치에 끌려가지 않도록 상위 백분위 사용)"""
+    bound = float(np.percentile(np.abs(values), percentile)) if values.size else 0.0
+    return max(bound, 1e-8) / 127.0
+
+
+def _quantize(values: np.ndarray, scale) -> np.ndarray:
+    return np.clip(np.rint(values / scale), -128, 127).astype(np.int8)
+
+
+def _conv_forward(x: np.ndarray, w: np.ndarray, b: np.ndarray, stride) -> np.ndarray:
+    """valid 패딩 HWC 합성곱 (배치 [N][H][W][C])"""
+    kh, kw = w.shape[1], w.shape[2]
+    sh, sw = stride
+    out_h = (x.shape[1] - kh) // sh + 1
+    out_w = (x.shape[2] - kw) // sw + 1
+    out = np.empty((x.shape[0], out_h, out_w, w.shape[0]), dtype=np.float32)
+    flat = w.reshape(w.shape[0], -1)
+    for oy in range(out_h):
+        for ox in range(out_w):
+            patch = x[:, oy * sh:oy * sh + kh, ox * sw:ox * sw + kw, :].reshape(x.shape[0], -1)
+            out[:, oy, ox, :] = patch @ flat.T + b
+    return out
+
+
+def load_layers(path: str):
+    data = np.load(path, allow_pickle=False)
+    types = [str(t) for t in data["layer_types"]]
+    layers = []
+    for i, kind in enumerate(types):
+        if kind not in ("conv", "dense", "gap"):
+            raise ValueError(f"알 수 없는 레이어 종류: {kind}")
+        layer = {"type": kind}
+        if kind != "gap":
+            layer["w"] = data[f"w{i}"].astype(np.float32)
+            layer["b"] = data[f"b{i}"].astype(np.float32)
+            layer["relu"] = bool(data[f"relu{i}"]) if f"relu{i}" in data else i + 1 < len(types)
+        if kind == "conv":
+            if layer["w"].ndim != 4:
+                raise ValueError(f"w{i}는 [out][kh][kw][in] 형태여야 합니다")
+            layer["stride"] = tuple(int(s) for s in data[f"stride{i}"]) if f"stride{i}" in data else (1, 1)
+        layers.append(layer)
+    if not layers or layers[-1]["type"] != "dense":
+        raise ValueError("마지막 레이어는 dense여야 합니다")
+    return layers
+
+
+def export(layers, calibration: np.ndarray, args) -> bytes:
+    # 입력 정규화: 보정 데이터 평균을 빼고 대칭 양자화
+    mean = float(calibration.mean())
+    x = (calibration - mean)[..., np.newaxis].astype(np.float32)
+    in_scale = _symmetric_scale(x)
+    x = _quantize(x, in_scale).astype(np.float32) * in_scale
+
+    out = bytearray()
+    out += MAGIC
+    out += struct.pack("<5I", VERSION, args.sample_rate, args.frame_length, args.hop_length, args.fft_size)
+    out += struct.pack("<2f", args.low_hz, args.high_hz)
+    out += struct.pack("<2I", calibration.shape[1], calibration.shape[2])
+    out += struct.pack("<3f", mean, in_scale, args.threshold)
+    out += struct.pack("<3I", args.smoothing, args.keyword_index, len(layers))
+
+    for i, layer in enumerate(layers):
+        kind = layer["type"]
+        if kind == "gap":
+            # int8 평균도 입력 배율을 그대로 유지
+            x = x.mean(axis=(1, 2), keepdims=True)
+            out += struct.pack("<I", LAYER_GAP)
+            continue
+
+        w = layer["w"] if kind == "conv" else layer["w"].reshape(layer["w"].shape[0], 1, 1, -1)
+        if kind == "dense":
+            x = x.reshape(x.shape[0], 1, 1, -1)
+        if w.shape[3] != x.shape[3]:
+            raise ValueError(f"레이어 {i} 입력 채널 수가 맞지 않습니다 ({w.shape[3]} != {x.shape[3]})")
+
+        # 채널별 가중치 배율, 편향은 입력 배율 * 가중치 배율 단위의 int32
+        w_scale = np.array([_symmetric_scale(w[c], 100.0) for c in range(w.shape[0])], dtype=np.float32)
+        w_q = _quantize(w, w_scale[:, None, None, None])
+        bias_q = np.rint(layer["b"] / (in_scale * w_scale)).astype(np.int32)
+
+        stride = layer.get("stride", (1, 1))
+        y = _conv_forward(x, w_q.astype(np.float32) * w_scale[:, None, None, None], layer["b"], stride)
+        if layer["relu"]:
+            y = np.maximum(y, 0.0)
+        out_scale = _symmetric_scale(y)
+
+        if kind == "conv":
+            out += struct.pack("<6I", LAYER_CONV, w.shape[0], w.shape[1], w.shape[2], stride[0], stride[1])
+        else:
+            out += struct.pack("<2I", LAYER_DENSE, w.shape[0])
+        out += struct.pack("<If", int(layer["relu"]), out_scale)
+        out += w_q.tobytes()
+        out += w_scale.astype("<f4").tobytes()
+        out += bias_q.astype("<i4").tobytes()
+
+        # 다음 레이어 보정은 C++과 같은 양자화 값으로 진행
+        x = _quantize(y, out_scale).astype(np.float32) * out_scale
+        in_scale = out_scale
+
+    if args.keyword_index >= x.shape[-1]:
+        raise ValueError(f"keyword-index {args.keyword_index}가 출력 수 {x.shape[-1]} 이상입니다")
+    return bytes(out)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="키워드 인식 CNN을 SION .kws 모델로 변환")
+    parser.add_argument("weights", help="float 가중치 .npz")
+    parser.add_argument("calibration", help="보정용 로그 멜 특징 .npy [N][frames][mels]")
+    parser.add_argument("-o", "--output", required=True, help="출력 .kws 경로")
+    parser.add_argument("--keyword-index", type=int, default=1, help="키워드 클래스 인덱스")
+    parser.add_argument("--threshold", type=float, default=0.8, help="평활화된 확률 임계값")
+    parser.add_argument("--smoothing", type=int, default=3, help="평균할 연속 추론 횟수")
+    parser.add_argument("--sample-rate", type=int, default=16000)
+    parser.add_argument("--frame-length", type=int, default=400)
+    parser.add_argument("--hop-length", type=int, default=160)
+    parser.add_argument("--fft-size", type=int, default=512)
+    parser.add_argument("--low-hz", type=float, default=20.0)
+    parser.add_argument("--high-hz", type=float, default=7600.0)
+    args = parser.parse_args()
+
+    try:
+        layers = load_layers(args.weights)
+        calibration = np.load(args.calibration, allow_pickle=False).astype(np.float32)
+        if calibration.ndim != 3:
+            raise ValueError("보정 데이터는 [N][frames][mels] 형태여야 합니다")
+        model = export(layers, calibration, args)
+    except (OSError, KeyError, ValueError) as e:
+        print(f"변환 실패: {e}", file=sys.stderr)
+        return 1
+
+    with open(args.output, "wb") as f:
+        f.write(model)
+    print(f"저장: {args.output} ({len(model)} bytes, {len(layers)}개 레이어)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,253 @@
+"""
+ASR Streaming (WebSocket) Tests
+"""
+
+import asyncio
+import json
+import struct
+import threading
+import wave
+
+import pytest
+from unittest.mock import Mock, patch
+
+
+class FakeWebSocket:
+    """transcribe_stream에 넣을 메모리 WebSocket (보낸 텍스트 메시지를 JSON으로 모음)"""
+
+    def __init__(self):
+        self.inbound: asyncio.Queue = asyncio.Queue()
+        self.sent = []
+        self._changed = asyncio.Event()
+
+    async def accept(self):
+        pass
+
+    async def receive(self):
+        return await self.inbound.get()
+
+    async def send_text(self, text):
+        self.sent.append(json.loads(text))
+        self._changed.set()
+
+    def text(self, message):
+        self.inbound.put_nowait({"type": "websocket.receive", "text": json.dumps(message)})
+
+    def raw_text(self, text):
+        self.inbound.put_nowait({"type": "websocket.receive", "text": text})
+
+    def audio(self, stream_id, data):
+        self.inbound.put_nowait({"type": "websocket.receive",
+                                 "bytes": struct.pack("<I", stream_id) + data})
+
+    def disconnect(self):
+        self.inbound.put_nowait({"type": "websocket.disconnect"})
+
+    async def wait_for(self, count, timeout=2.0):
+        """응답이 count개 이상 쌓일 때까지 대기"""
+        async def wait():
+            while len(self.sent) < count:
+                self._changed.clear()
+                await self._changed.wait()
+        await asyncio.wait_for(wait(), timeout)
+        return self.sent
+
+
+def wav_samples(path):
+    """_transcribe_bytes가 넘긴 임시 WAV의 샘플 수 (앞부분/전체 인식 구분용)"""
+    with wave.open(path, "rb") as wav_file:
+        return wav_file.getnframes()
+
+
+class TestTranscribeStream:
+    """/transcribe/stream 테스트"""
+
+    @pytest.fixture
+    def model(self):
+        """실제 Whisper 없이 고정 텍스트를 돌려주는 모델"""
+        model = Mock()
+        model.is_loaded = True
+        model.transcribe = Mock(return_value={"text": "오늘 일정 알려줘", "language": "ko", "duration": 1.0})
+        return model
+
+    async def run(self, model, scenario):
+        """scenario(ws)를 실행하는 동안 스트리밍 엔드포인트 구동"""
+        from backend.asr.app import main
+
+        ws = FakeWebSocket()
+        with patch.object(main, "asr_model", model):
+            server = asyncio.create_task(main.transcribe_stream(ws))
+            try:
+                await scenario(ws)
+            finally:
+                ws.disconnect()
+                await asyncio.wait_for(server, 2.0)
+        return ws.sent
+
+    @pytest.mark.asyncio
+    async def test_final_result(self, model):
+        """start → 오디오 → end 순서면 final 응답"""
+        async def scenario(ws):
+            ws.text({"type": "start", "id": 7, "codec": "pcm", "sample_rate": 16000})
+            ws.audio(7, b"\x00\x00" * 1600)
+            ws.text({"type": "end", "id": 7})
+            await ws.wait_for(1)
+
+        sent = await self.run(model, scenario)
+        assert sent[-1]["type"] == "final"
+        assert sent[-1]["id"] == 7
+        assert sent[-1]["text"] == "오늘 일정 알려줘"
+
+    @pytest.mark.asyncio
+    async def test_audio_over_limit(self, model):
+        """최대 길이를 넘으면 해당 스트림만 error로 끝나고 end는 무시"""
+        from backend.asr.app import main
+
+        async def scenario(ws):
+            with patch.object(main, "STREAM_MAX_SECONDS", 0.1):
+                ws.text({"type": "start", "id": 1, "codec": "pcm", "sample_rate": 16000})
+                ws.audio(1, b"\x00\x00" * 1000)
+                ws.audio(1, b"\x00\x00" * 1000)
+                ws.audio(1, b"\x00\x00" * 1000)
+                ws.text({"type": "end", "id": 1})
+                await ws.wait_for(1)
+
+                ws.text({"type": "start", "id": 2, "codec": "pcm", "sample_rate": 16000})
+                ws.audio(2, b"\x00\x00" * 1000)
+                ws.text({"type": "end", "id": 2})
+                await ws.wait_for(2)
+
+        sent = await self.run(model, scenario)
+        assert [(m["type"], m["id"]) for m in sent] == [("error", 1), ("final", 2)]
+        model.transcribe.assert_called_once()
+
+    @pytest.mark.asyncio
+    async def test_malformed_control_keeps_connection(self, model):
+        """형식이 틀린 제어 메시지는 error로 답하고 같은 연결의 다른 스트림은 계속 처리"""
+        async def scenario(ws):
+            ws.text({"type": "start", "id": 3, "codec": "pcm", "sample_rate": 16000})
+            ws.raw_text("{not json")
+            ws.text({"type": "end", "id": "abc"})
+            ws.text(["end", 3])
+            ws.text({"type": "start", "id": 4, "codec": "pcm", "sample_rate": "fast"})
+            ws.text({"type": "start", "id": 5, "codec": "mp3"})
+            ws.audio(3, b"\x00\x00" * 1600)
+            ws.text({"type": "end", "id": 3})
+            await ws.wait_for(6)
+
+        sent = await self.run(model, scenario)
+        assert [(m["type"], m["id"]) for m in sent] == [
+            ("error", 0), ("error", 0), ("error", 0), ("error", 4), ("error", 5), ("final", 3)]
+
+    @pytest.mark.asyncio
+    async def test_end_without_start(self, model):
+        """시작하지 않은 스트림의 end는 error"""
+        async def scenario(ws):
+            ws.text({"type": "end", "id": 9})
+            await ws.wait_for(1)
+
+        sent = await self.run(model, scenario)
+        assert sent == [{"type": "error", "id": 9, "message": "시작되지 않은 스트림"}]
+        model.transcribe.assert_not_called()
+
+    @pytest.mark.asyncio
+    async def test_partial_results(self, model):
+        """PCM 오디오가 ASR_STREAM_PARTIAL_SECONDS만큼 쌓이면 partial, end 뒤에는 final"""
+        from backend.asr.app import main
+
+        model.transcribe.side_effect = [
+            {"text": " 오늘 일정 "},
+            {"text": "오늘 일정 알려줘", "language": "ko", "duration": 1.0},
+        ]
+
+        async def scenario(ws):
+            with patch.object(main, "STREAM_PARTIAL_SECONDS", 0.05):
+                ws.text({"type": "start", "id": 1, "codec": "pcm", "sample_rate": 16000})
+                ws.audio(1, b"\x00\x00" * 1000)
+                await ws.wait_for(1)
+                ws.text({"type": "end", "id": 1})
+                await ws.wait_for(2)
+
+        sent = await self.run(model, scenario)
+        assert sent[0] == {"type": "partial", "id": 1, "text": "오늘 일정"}
+        assert (sent[1]["type"], sent[1]["text"]) == ("final", "오늘 일정 알려줘")
+
+    @pytest.mark.asyncio
+    async def test_no_partial_after_final(self, model):
+        """final보다 늦게 끝난 중간 인식 결과는 보내지 않음"""
+        from backend.asr.app import main
+
+        release = threading.Event()
+
+        def transcribe(path):
+            if wav_samples(path) < 1000:
+                release.wait(2.0)  # 앞부분 인식은 final이 나간 뒤에 끝남
+                return {"text": "오늘"}
+            return {"text": "오늘 일정 알려줘", "language": "ko", "duration": 1.0}
+
+        model.transcribe.side_effect = transcribe
+
+        async def scenario(ws):
+            with patch.object(main, "STREAM_PARTIAL_SECONDS", 0.05):
+                ws.text({"type": "start", "id": 1, "codec": "pcm", "sample_rate": 16000})
+                ws.audio(1, b"\x00\x00" * 800)
+                ws.audio(1, b"\x00\x00" * 200)
+                ws.text({"type": "end", "id": 1})
+                await ws.wait_for(1)
+                release.set()
+                await asyncio.sleep(0.05)
+
+        sent = await self.run(model, scenario)
+        assert [m["type"] for m in sent] == ["final"]
+
+    @pytest.mark.asyncio
+    async def test_prefix_partials_before_final(self, model):
+        """발화를 end와 한 번에 보내도 final 전에 더 긴 앞부분 순으로 partial 전송"""
+        from backend.asr.app import main
+
+        # 앞부분(1600샘플) → 더 긴 앞부분(2400) → 전체(3200) 순으로 끝나도록 단계별로 풀어 줌
+        gates = {2400: threading.Event(), 3200: threading.Event()}
+        texts = {1600: "오늘 일정", 2400: "오늘 일정 알려"}
+
+        def transcribe(path):
+            samples = wav_samples(path)
+            if samples in gates:
+                gates[samples].wait(2.0)
+            if samples in texts:
+                return {"text": texts[samples]}
+            return {"text": "오늘 일정 알려줘", "language": "ko", "duration": 0.2}
+
+        model.transcribe.side_effect = transcribe
+
+        async def scenario(ws):
+            with patch.object(main, "STREAM_PARTIAL_SECONDS", 0.1):
+                # C++ 클라이언트처럼 녹음이 끝난 뒤 조각과 end를 한꺼번에 보냄
+                ws.text({"type": "start", "id": 1, "codec": "pcm", "sample_rate": 16000})
+                for _ in range(4):
+                    ws.audio(1, b"\x00\x00" * 800)
+                ws.text({"type": "end", "id": 1})
+                await ws.wait_for(1)
+                gates[2400].set()
+                await ws.wait_for(2)
+                gates[3200].set()
+                await ws.wait_for(3)
+
+        sent = await self.run(model, scenario)
+        assert [(m["type"], m["text"]) for m in sent] == [
+            ("partial", "오늘 일정"), ("partial", "오늘 일정 알려"), ("final", "오늘 일정 알려줘")]
+
+    @pytest.mark.asyncio
+    async def test_no_partial_for_compressed_codec(self, model):
+        """압축 코덱은 중간에 디코딩하지 않고 final만 보냄"""
+        from backend.asr.app import main
+
+        async def scenario(ws):
+            with patch.object(main, "STREAM_PARTIAL_SECONDS", 0.05):
+                ws.text({"type": "start", "id": 1, "codec": "flac", "sample_rate": 16000})
+                ws.audio(1, b"fLaC" + b"\x00" * 4000)
+                ws.text({"type": "end", "id": 1})
+                await ws.wait_for(1)
+
+        sent = await self.run(model, scenario)
+        assert [m["type"] for m in sent] == ["final"]
+        model.transcribe.assert_called_once()
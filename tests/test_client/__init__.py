@@ -0,0 +1,3 @@
+"""
+Python Client Tests
+"""
@@ -0,0 +1,251 @@
+"""
+Pipe Server Tests
+"""
+
+import asyncio
+import io
+import json
+import threading
+
+import pytest
+from unittest.mock import AsyncMock, Mock, patch
+
+
+def read_frames(buffer):
+    """FrameWriter가 쓴 프레임 목록 [(type, utterance_id, payload)]"""
+    from client.python.pipe_server import read_frame
+
+    stream = io.BytesIO(buffer.getvalue())
+    frames = []
+    while True:
+        frame = read_frame(stream)
+        if frame is None:
+            return frames
+        msg_type, _, utterance_id, _, payload = frame
+        frames.append((msg_type, utterance_id, payload))
+
+
+class TestFrames:
+    """프레임 송수신 테스트"""
+
+    def test_round_trip(self):
+        """FrameWriter가 쓴 프레임을 순서대로 읽고 시퀀스가 연결 단위로 증가"""
+        from client.python.pipe_server import FrameWriter, MessageType, read_frame
+
+        buffer = io.BytesIO()
+        writer = FrameWriter(buffer)
+        writer.write(MessageType.PARTIAL_RESULT, 3, "안녕".encode("utf-8"))
+        writer.write(MessageType.FINAL_RESULT, 4, b"{}")
+
+        buffer.seek(0)
+        assert read_frame(buffer) == (MessageType.PARTIAL_RESULT, 0, 3, 0, "안녕".encode("utf-8"))
+        assert read_frame(buffer) == (MessageType.FINAL_RESULT, 0, 4, 1, b"{}")
+        assert read_frame(buffer) is None
+
+    def test_unknown_type_is_skipped(self):
+        """알 수 없는 타입의 프레임은 페이로드까지 건너뛰고 다음 프레임을 이어서 읽음"""
+        from client.python.pipe_server import HEADER, MAGIC, VERSION, MessageType, read_frame
+
+        stream = io.BytesIO(
+            HEADER.pack(MAGIC, VERSION, 200, 0, 1, 0, 5) + b"12345"
+            + HEADER.pack(MAGIC, VERSION, int(MessageType.CANCEL), 0, 1, 1, 0))
+
+        assert read_frame(stream) == (200, 0, 1, 0, b"12345")
+        assert read_frame(stream) == (MessageType.CANCEL, 0, 1, 1, b"")
+
+    @pytest.mark.asyncio
+    async def test_dispatch_unknown_type(self):
+        """서버는 알 수 없는 타입을 무시하고 응답하지 않음"""
+        from client.python.pipe_server import FrameWriter, PipeServer
+
+        server = PipeServer(Mock())
+        server._output = io.BytesIO()
+        server._writer = FrameWriter(server._output)
+
+        server._dispatch(200, 0, 1, 0, b"12345")
+        assert server._output.getvalue() == b""
+        assert not server._tasks
+
+
+class TestPipeServerSpeculation:
+    """SPECULATE → TRANSCRIPT 확정/취소 테스트"""
+
+    @pytest.fixture
+    def server(self):
+        """파이프 대신 메모리 버퍼에 쓰는 서버 (NLU는 release가 set될 때까지 대기)"""
+        from client.python.pipe_server import PipeServer, FrameWriter
+
+        release = asyncio.Event()
+
+        async def analyze_intent(text):
+            await release.wait()
+            return {"intent": "email_send", "entities": {"text": text}}
+
+        assistant = Mock()
+        assistant.api_client.analyze_intent = AsyncMock(side_effect=analyze_intent)
+        assistant.execute_task = AsyncMock(return_value={"success": True})
+        assistant.prefetch = AsyncMock(return_value=False)
+
+        server = PipeServer(assistant)
+        server._output = io.BytesIO()
+        server._writer = FrameWriter(server._output)
+        server.release = release
+        return server
+
+    @pytest.mark.asyncio
+    async def test_confirmed_speculation_skips_nlu(self, server):
+        """같은 텍스트의 추측이 있으면 NLU를 다시 호출하지 않음"""
+        from client.python.pipe_server import MessageType
+
+        server._dispatch(MessageType.SPECULATE, 0, 0, 0, "메일 보내줘".encode("utf-8"))
+        server._dispatch(MessageType.TRANSCRIPT, 0, 1, 1, "메일 보내줘.".encode("utf-8"))
+        server.release.set()
+        await server._tasks[1]
+
+        assert server.assistant.api_client.analyze_intent.await_count == 1
+        server.assistant.execute_task.assert_awaited_once()
+        frames = read_frames(server._output)
+        assert frames[-1][0] == MessageType.FINAL_RESULT
+        assert json.loads(frames[-1][2])["intent"]["intent"] == "email_send"
+
+    @pytest.mark.asyncio
+    async def test_cancel_during_speculation(self, server):
+        """추측 확정을 기다리는 중 CANCEL이 오면 작업을 실행하지 않음"""
+        from client.python.pipe_server import MessageType
+
+        server._dispatch(MessageType.SPECULATE, 0, 0, 0, "메일 보내줘".encode("utf-8"))
+        server._dispatch(MessageType.TRANSCRIPT, 0, 1, 1, "메일 보내줘".encode("utf-8"))
+        task = server._tasks[1]
+        await asyncio.sleep(0)  # _respond가 추측 future에서 대기하도록
+
+        server._dispatch(MessageType.CANCEL, 0, 1, 2, b"")
+        server.release.set()
+        with pytest.raises(asyncio.CancelledError):
+            await task
+        await asyncio.sleep(0)
+
+        assert server.assistant.api_client.analyze_intent.await_count <= 1
+        server.assistant.execute_task.assert_not_awaited()
+        assert read_frames(server._output) == []
+
+    @pytest.mark.asyncio
+    async def test_cancelled_speculation_falls_back(self, server):
+        """추측만 취소되면 최종 텍스트로 다시 분석"""
+        from client.python.pipe_server import MessageType
+
+        server._dispatch(MessageType.SPECULATE, 0, 0, 0, "메일 보내줘".encode("utf-8"))
+        speculation = server._speculations["메일 보내줘"]
+        server._dispatch(MessageType.TRANSCRIPT, 0, 1, 1, "메일 보내줘".encode("utf-8"))
+        task = server._tasks[1]
+        await asyncio.sleep(0)
+
+        speculation.cancel()
+        server.release.set()
+        await task
+
+        assert server.assistant.api_client.analyze_intent.await_count == 2
+        server.assistant.execute_task.assert_awaited_once()
+        assert read_frames(server._output)[-1][0] == MessageType.FINAL_RESULT
+
+
+def stable_prefix(previous, current):
+    """VoicePipeline의 stablePrefix와 같은 규칙 (단어 경계까지의 공통 앞부분)"""
+    if previous == current:
+        return current
+    length = 0
+    limit = min(len(previous), len(current))
+    while length < limit and previous[length] == current[length]:
+        length += 1
+    word_ends = ((length == len(current) or current[length] == " ")
+                 and (length == len(previous) or previous[length] == " "))
+    if not word_ends:
+        space = current.rfind(" ", 0, length)
+        length = max(space, 0)
+    return current[:length].rstrip(" ")
+
+
+class TestSpeculationEndToEnd:
+    """ASR 스트림 partial → SPECULATE → 작업 준비(prefetch) → TRANSCRIPT 흐름"""
+
+    @pytest.mark.asyncio
+    async def test_partials_reach_prefetch_before_final(self):
+        """발화와 end를 한 번에 보내도 final 전에 추측 NLU와 작업 준비가 실행됨"""
+        from backend.asr.app import main
+        from client.python.pipe_server import FrameWriter, MessageType, PipeServer
+        from tests.test_asr.test_stream import FakeWebSocket, wav_samples
+
+        # 앞부분(2400샘플)은 첫 partial을 받은 뒤, 전체는 작업 준비를 확인한 뒤 인식
+        gates = {2400: threading.Event(), 3200: threading.Event()}
+        texts = {1600: "오늘 일정", 2400: "오늘 일정 알려"}
+
+        def transcribe(path):
+            samples = wav_samples(path)
+            if samples in gates:
+                gates[samples].wait(2.0)
+            if samples in texts:
+                return {"text": texts[samples]}
+            return {"text": "오늘 일정 알려줘", "language": "ko", "duration": 0.2}
+
+        model = Mock()
+        model.is_loaded = True
+        model.transcribe = Mock(side_effect=transcribe)
+
+        nlu_result = {"intent": {"name": "schedule_check", "confidence": 0.9}, "entities": []}
+        assistant = Mock()
+        assistant.api_client.analyze_intent = AsyncMock(return_value=nlu_result)
+        assistant.execute_task = AsyncMock(return_value={"success": True})
+        assistant.prefetch = AsyncMock(return_value=True)
+
+        server = PipeServer(assistant)
+        server._output = io.BytesIO()
+        server._writer = FrameWriter(server._output)
+
+        # C++ 클라이언트(VoicePipeline::onPartial)처럼 앞부분이 늘어날 때만 SPECULATE
+        last_partial, speculated = "", ""
+
+        def on_partial(text):
+            nonlocal last_partial, speculated
+            prefix = stable_prefix(last_partial, text)
+            last_partial = text
+            if len(prefix.encode("utf-8")) >= 6 and len(prefix) > len(speculated):
+                server._dispatch(MessageType.SPECULATE, 0, 0, 0, prefix.encode("utf-8"))
+                speculated = prefix
+
+        ws = FakeWebSocket()
+        with patch.object(main, "asr_model", model), \
+                patch.object(main, "STREAM_PARTIAL_SECONDS", 0.1):
+            asr = asyncio.create_task(main.transcribe_stream(ws))
+            try:
+                # 녹음이 끝난 뒤 PCM 조각과 end를 한꺼번에 보냄 (추측 NLU 켜진 클라이언트)
+                ws.text({"type": "start", "id": 1, "codec": "pcm", "sample_rate": 16000})
+                for _ in range(4):
+                    ws.audio(1, b"\x00\x00" * 800)
+                ws.text({"type": "end", "id": 1})
+
+                sent = await ws.wait_for(1)
+                on_partial(sent[0]["text"])
+                gates[2400].set()
+                sent = await ws.wait_for(2)
+                on_partial(sent[1]["text"])
+
+                await asyncio.wait_for(server._speculations["오늘 일정"], 2.0)
+                await asyncio.wait_for(asyncio.gather(*server._prefetches), 2.0)
+                assistant.prefetch.assert_awaited_once_with(nlu_result)
+                assert [m["type"] for m in ws.sent] == ["partial", "partial"]
+
+                gates[3200].set()
+                sent = await ws.wait_for(3)
+                assert sent[-1]["type"] == "final"
+                server._dispatch(MessageType.TRANSCRIPT, 0, 1, 1, sent[-1]["text"].encode("utf-8"))
+                await asyncio.wait_for(server._tasks[1], 2.0)
+            finally:
+                for gate in gates.values():
+                    gate.set()
+                ws.disconnect()
+                await asyncio.wait_for(asr, 2.0)
+
+        assistant.api_client.analyze_intent.assert_any_await("오늘 일정")
+        assistant.execute_task.assert_awaited_once()
+        frames = read_frames(server._output)
+        assert frames[-1][0] == MessageType.FINAL_RESULT
+        assert json.loads(frames[-1][2])["transcription"] == "오늘 일정 알려줘"
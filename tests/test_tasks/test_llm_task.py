@@ -122,6 +122,14 @@ class TestCalendarTask:
         
         assert "events" in result
         assert "데모 모드" in result["message"]
+    
+    @pytest.mark.asyncio
+    async def test_prefetch_demo_mode(self, calendar_task):
+        """인증 정보 없이 prefetch하면 준비 없이 끝나고 실행에 영향 없음"""
+        assert await calendar_task.prefetch("check", {"date": "오늘"}) is False
+        
+        result = await calendar_task.execute("check", {"date": "오늘"})
+        assert "데모 모드" in result["message"]
 
 
 class TestTaskExecutorAPI:
@@ -153,3 +161,42 @@ class TestTaskExecutorAPI:
         assert "handlers" in data
 
 
+    
+    @pytest.fixture
+    def calendar_handler(self):
+        """prefetch만 기록하는 캘린더 핸들러"""
+        from backend.task_executor.app import main
+        
+        handler = Mock()
+        handler.prefetch = AsyncMock(return_value=True)
+        with patch.dict(main.task_handlers, {"calendar": handler}, clear=True):
+            yield handler
+    
+    def test_prefetch_dispatches_to_handler(self, client, calendar_handler):
+        """의도에 맞는 핸들러의 prefetch를 액션/엔티티와 함께 호출"""
+        response = client.post("/prefetch", json={
+            "intent": "schedule_check",
+            "entities": {"date": "내일"}
+        })
+        
+        assert response.status_code == 200
+        assert response.json() == {"intent": "schedule_check", "prefetched": True}
+        calendar_handler.prefetch.assert_awaited_once_with("check", {"date": "내일"})
+    
+    def test_prefetch_unknown_intent(self, client, calendar_handler):
+        """매핑되지 않은(또는 핸들러가 없는) 의도는 준비 없이 prefetched=False"""
+        for intent in ("unknown_intent", "email_check"):
+            response = client.post("/prefetch", json={"intent": intent})
+            
+            assert response.status_code == 200
+            assert response.json() == {"intent": intent, "prefetched": False}
+        calendar_handler.prefetch.assert_not_awaited()
+    
+    def test_prefetch_failure_is_ignored(self, client, calendar_handler):
+        """핸들러 준비가 실패해도 오류 대신 prefetched=False"""
+        calendar_handler.prefetch.side_effect = RuntimeError("API 오류")
+        
+        response = client.post("/prefetch", json={"intent": "schedule_check"})
+        
+        assert response.status_code == 200
+        assert response.json() == {"intent": "schedule_check", "prefetched": False}